@@ -483,6 +483,46 @@ gst_alsa_open_iec958_pcm (GstObject * obj, gchar * device)
 }
 
 
+/* process-wide cache of probed device caps. Probing walks the full
+ * format/rate/channel space with hw_params ioctls, which adds up when
+ * many elements start on the same device, so remember the result per
+ * direction and device string. Caps are immutable, so cache hits can
+ * just hand out another ref. */
+static GMutex caps_cache_lock;
+static GHashTable *caps_cache;  /* key: "direction:device", value: GstCaps */
+
+static GstCaps *
+gst_alsa_caps_cache_lookup (snd_pcm_stream_t stream, const gchar * device)
+{
+  GstCaps *caps = NULL;
+  gchar *key;
+
+  key = g_strdup_printf ("%d:%s", (gint) stream, device);
+  g_mutex_lock (&caps_cache_lock);
+  if (caps_cache != NULL && (caps = g_hash_table_lookup (caps_cache, key)))
+    gst_caps_ref (caps);
+  g_mutex_unlock (&caps_cache_lock);
+  g_free (key);
+
+  return caps;
+}
+
+static void
+gst_alsa_caps_cache_insert (snd_pcm_stream_t stream, const gchar * device,
+    GstCaps * caps)
+{
+  gchar *key;
+
+  key = g_strdup_printf ("%d:%s", (gint) stream, device);
+  g_mutex_lock (&caps_cache_lock);
+  if (caps_cache == NULL) {
+    caps_cache = g_hash_table_new_full (g_str_hash, g_str_equal, g_free,
+        (GDestroyNotify) gst_caps_unref);
+  }
+  g_hash_table_replace (caps_cache, key, gst_caps_ref (caps));
+  g_mutex_unlock (&caps_cache_lock);
+}
+
 /*
  * gst_alsa_probe_supported_formats:
  *
@@ -500,12 +540,17 @@ gst_alsa_probe_supported_formats (GstObject * obj, gchar * device,
   GstCaps *caps;
   gint err;
 
+  stream_type = snd_pcm_stream (handle);
+
+  if ((caps = gst_alsa_caps_cache_lookup (stream_type, device))) {
+    GST_LOG_OBJECT (obj, "returning cached caps %" GST_PTR_FORMAT, caps);
+    return caps;
+  }
+
   snd_pcm_hw_params_malloc (&hw_params);
   if ((err = snd_pcm_hw_params_any (handle, hw_params)) < 0)
     goto error;
 
-  stream_type = snd_pcm_stream (handle);
-
   caps = gst_alsa_detect_formats (obj, hw_params,
       gst_caps_copy (template_caps), G_BYTE_ORDER);
 
@@ -539,6 +584,9 @@ gst_alsa_probe_supported_formats (GstObject * obj, gchar * device,
   }
 
   snd_pcm_hw_params_free (hw_params);
+
+  gst_alsa_caps_cache_insert (stream_type, device, caps);
+
   return caps;
 
   /* ERRORS */
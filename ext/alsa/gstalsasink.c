@@ -443,7 +443,13 @@ set_hwparams (GstAlsaSink * alsa)
 retry:
   /* choose all parameters */
   CHECK (snd_pcm_hw_params_any (alsa->handle, params), no_config);
-  /* set the interleaved read/write format */
+  /* set the interleaved access mode, dropping back from mmap to plain
+   * read/write when the device can't do mmap */
+  if (alsa->access == SND_PCM_ACCESS_MMAP_INTERLEAVED &&
+      snd_pcm_hw_params_set_access (alsa->handle, params, alsa->access) < 0) {
+    GST_DEBUG_OBJECT (alsa, "mmap access not available, using rw");
+    alsa->access = SND_PCM_ACCESS_RW_INTERLEAVED;
+  }
   CHECK (snd_pcm_hw_params_set_access (alsa->handle, params, alsa->access),
       wrong_access);
   /* set the sample format */
@@ -819,7 +825,14 @@ alsasink_parse_spec (GstAlsaSink * alsa, GstAudioRingBufferSpec * spec)
   alsa->channels = GST_AUDIO_INFO_CHANNELS (&spec->info);
   alsa->buffer_time = spec->buffer_time;
   alsa->period_time = spec->latency_time;
-  alsa->access = SND_PCM_ACCESS_RW_INTERLEAVED;
+  /* prefer mmap access for raw audio so periods are committed from the
+   * ringbuffer segment without going through the kernel write path;
+   * set_hwparams falls back to plain read/write when the device cannot
+   * mmap. Passthrough formats stay on the conservative rw path. */
+  if (alsa->iec958)
+    alsa->access = SND_PCM_ACCESS_RW_INTERLEAVED;
+  else
+    alsa->access = SND_PCM_ACCESS_MMAP_INTERLEAVED;
 
   if (spec->type == GST_AUDIO_RING_BUFFER_FORMAT_TYPE_RAW && alsa->channels < 9)
     gst_audio_ring_buffer_set_channel_positions (GST_AUDIO_BASE_SINK
@@ -1041,7 +1054,10 @@ gst_alsasink_write (GstAudioSink * asink, gpointer data, guint length)
       GST_DEBUG_OBJECT (asink, "wait error, %d", err);
     } else {
       GST_DELAY_SINK_LOCK (asink);
-      err = snd_pcm_writei (alsa->handle, ptr, cptr);
+      if (alsa->access == SND_PCM_ACCESS_MMAP_INTERLEAVED)
+        err = snd_pcm_mmap_writei (alsa->handle, ptr, cptr);
+      else
+        err = snd_pcm_writei (alsa->handle, ptr, cptr);
       GST_DELAY_SINK_UNLOCK (asink);
     }
 
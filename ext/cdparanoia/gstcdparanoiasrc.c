@@ -45,7 +45,9 @@ enum
   PROP_PARANOIA_MODE,
   PROP_SEARCH_OVERLAP,
   PROP_GENERIC_DEVICE,
-  PROP_CACHE_SIZE
+  PROP_CACHE_SIZE,
+  PROP_READAHEAD,
+  PROP_STATS
 };
 
 #define DEFAULT_READ_SPEED              -1
@@ -53,6 +55,7 @@ enum
 #define DEFAULT_PARANOIA_MODE            PARANOIA_MODE_FRAGMENT
 #define DEFAULT_GENERIC_DEVICE           NULL
 #define DEFAULT_CACHE_SIZE              -1
+#define DEFAULT_READAHEAD               300     /* 4 seconds */
 
 GST_DEBUG_CATEGORY_STATIC (gst_cd_paranoia_src_debug);
 #define GST_CAT_DEFAULT gst_cd_paranoia_src_debug
@@ -70,6 +73,7 @@ static GstBuffer *gst_cd_paranoia_src_read_sector (GstAudioCdSrc * src,
 static gboolean gst_cd_paranoia_src_open (GstAudioCdSrc * src,
     const gchar * device);
 static void gst_cd_paranoia_src_close (GstAudioCdSrc * src);
+static gpointer gst_cd_paranoia_src_read_thread (gpointer data);
 
 /* We use these to serialize calls to paranoia_read() among several
  * cdparanoiasrc instances. We do this because it's the only reasonably
@@ -78,6 +82,11 @@ static void gst_cd_paranoia_src_close (GstAudioCdSrc * src);
 static GstCdParanoiaSrc *cur_cb_source;
 static GMutex cur_cb_mutex;
 
+/* With a readahead thread each instance has its own dedicated reader, so
+ * the calling object can be found thread-locally and paranoia_read calls
+ * on different drives don't have to be serialized against each other */
+static GPrivate cur_thread_source;
+
 static gint cdpsrc_signals[NUM_SIGNALS];        /* all 0 */
 
 #define GST_TYPE_CD_PARANOIA_MODE (gst_cd_paranoia_mode_get_type())
@@ -115,6 +124,11 @@ gst_cd_paranoia_src_init (GstCdParanoiaSrc * src)
   src->read_speed = DEFAULT_READ_SPEED;
   src->generic_device = g_strdup (DEFAULT_GENERIC_DEVICE);
   src->cache_size = DEFAULT_CACHE_SIZE;
+  src->readahead = DEFAULT_READAHEAD;
+
+  g_mutex_init (&src->ring_lock);
+  g_cond_init (&src->ring_cond);
+  g_queue_init (&src->ring);
 }
 
 static void
@@ -165,6 +179,29 @@ gst_cd_paranoia_src_class_init (GstCdParanoiaSrcClass * klass)
           "Set CD cache size to n sectors (-1 = auto)", -1,
           G_MAXINT, DEFAULT_CACHE_SIZE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstCdParanoiaSrc:readahead:
+   *
+   * Number of sectors to read ahead of the streaming thread on a
+   * separate reader thread, so that retries on a bad sector don't
+   * stall downstream while already-read sectors are being consumed
+   * (0 = read synchronously). Only evaluated when the device is opened.
+   */
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_READAHEAD,
+      g_param_spec_int ("readahead", "Readahead",
+          "Number of sectors to read ahead on a reader thread (0 = off)",
+          0, G_MAXINT, DEFAULT_READAHEAD,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstCdParanoiaSrc:stats:
+   *
+   * Read statistics as a #GstStructure with the guint fields
+   * sectors-read, transport-errors and uncorrected-errors.
+   */
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Sector read and retry statistics", GST_TYPE_STRUCTURE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
   /* FIXME: we don't really want signals for this, but messages on the bus,
    * but then we can't check any longer whether anyone is interested in them */
@@ -268,6 +305,19 @@ gst_cd_paranoia_src_open (GstAudioCdSrc * audiocdsrc, const gchar * device)
 
   src->next_sector = -1;
 
+  src->sectors_read = 0;
+  src->transport_errors = 0;
+  src->uncorrected_errors = 0;
+
+  if (src->readahead > 0) {
+    src->ring_sector = -1;
+    src->ring_error = FALSE;
+    src->ring_stop = FALSE;
+    src->read_thread = g_thread_new ("cdparanoia-read",
+        gst_cd_paranoia_src_read_thread, src);
+    GST_INFO_OBJECT (src, "reading ahead up to %d sectors", src->readahead);
+  }
+
   return TRUE;
 
   /* ERRORS */
@@ -298,6 +348,20 @@ gst_cd_paranoia_src_close (GstAudioCdSrc * audiocdsrc)
 {
   GstCdParanoiaSrc *src = GST_CD_PARANOIA_SRC (audiocdsrc);
 
+  if (src->read_thread) {
+    GstBuffer *buf;
+
+    g_mutex_lock (&src->ring_lock);
+    src->ring_stop = TRUE;
+    g_cond_broadcast (&src->ring_cond);
+    g_mutex_unlock (&src->ring_lock);
+    g_thread_join (src->read_thread);
+    src->read_thread = NULL;
+
+    while ((buf = g_queue_pop_head (&src->ring)))
+      gst_buffer_unref (buf);
+  }
+
   if (src->p) {
     paranoia_free (src->p);
     src->p = NULL;
@@ -326,10 +390,36 @@ gst_cd_paranoia_paranoia_callback (long inpos, int function)
   switch (function) {
     case PARANOIA_CB_SKIP:
       GST_INFO_OBJECT (src, "Skip at sector %d", sector);
+      g_atomic_int_inc (&src->uncorrected_errors);
+      g_signal_emit (src, cdpsrc_signals[UNCORRECTED_ERROR], 0, sector);
+      break;
+    case PARANOIA_CB_READERR:
+      GST_INFO_OBJECT (src, "Transport error at sector %d", sector);
+      g_atomic_int_inc (&src->transport_errors);
+      g_signal_emit (src, cdpsrc_signals[TRANSPORT_ERROR], 0, sector);
+      break;
+    default:
+      break;
+  }
+}
+
+/* callback used on the readahead thread; the source is stored
+ * thread-locally, so no cross-instance serialisation is needed */
+static void
+gst_cd_paranoia_thread_callback (long inpos, int function)
+{
+  GstCdParanoiaSrc *src = g_private_get (&cur_thread_source);
+  gint sector = (gint) (inpos / CD_FRAMEWORDS);
+
+  switch (function) {
+    case PARANOIA_CB_SKIP:
+      GST_INFO_OBJECT (src, "Skip at sector %d", sector);
+      g_atomic_int_inc (&src->uncorrected_errors);
       g_signal_emit (src, cdpsrc_signals[UNCORRECTED_ERROR], 0, sector);
       break;
     case PARANOIA_CB_READERR:
       GST_INFO_OBJECT (src, "Transport error at sector %d", sector);
+      g_atomic_int_inc (&src->transport_errors);
       g_signal_emit (src, cdpsrc_signals[TRANSPORT_ERROR], 0, sector);
       break;
     default:
@@ -343,6 +433,119 @@ gst_cd_paranoia_src_signal_is_being_watched (GstCdParanoiaSrc * src, gint sig)
   return g_signal_has_handler_pending (src, cdpsrc_signals[sig], 0, FALSE);
 }
 
+/* sequentially reads sectors into the ring until it is full, the end of
+ * the disc is reached or a read fails; repositioned from the streaming
+ * thread by updating ring_sector and flushing the ring */
+static gpointer
+gst_cd_paranoia_src_read_thread (gpointer data)
+{
+  GstCdParanoiaSrc *src = GST_CD_PARANOIA_SRC (data);
+  gint last_sector = cdda_disc_lastsector (src->d);
+
+  g_private_set (&cur_thread_source, src);
+
+  g_mutex_lock (&src->ring_lock);
+
+  while (!src->ring_stop) {
+    gint16 *cdda_buf;
+    GstBuffer *buf;
+    gint sector;
+
+    if (src->ring_sector < 0 || src->ring_sector > last_sector ||
+        src->ring_error || src->ring.length >= (guint) src->readahead) {
+      g_cond_wait (&src->ring_cond, &src->ring_lock);
+      continue;
+    }
+
+    sector = src->ring_sector;
+    g_mutex_unlock (&src->ring_lock);
+
+    buf = NULL;
+    if (src->next_sector == sector ||
+        paranoia_seek (src->p, sector, SEEK_SET) != -1) {
+      src->next_sector = sector;
+
+      cdda_buf = paranoia_read (src->p, gst_cd_paranoia_thread_callback);
+      if (cdda_buf != NULL) {
+        buf = gst_buffer_new_and_alloc (CD_FRAMESIZE_RAW);
+        gst_buffer_fill (buf, 0, cdda_buf, CD_FRAMESIZE_RAW);
+        GST_BUFFER_OFFSET (buf) = sector;
+        src->next_sector = sector + 1;
+        g_atomic_int_inc (&src->sectors_read);
+      }
+    } else {
+      GST_WARNING_OBJECT (src, "seek to sector %d failed!", sector);
+    }
+
+    g_mutex_lock (&src->ring_lock);
+
+    if (src->ring_sector != sector) {
+      /* the streaming thread repositioned us while we were reading */
+      if (buf)
+        gst_buffer_unref (buf);
+      continue;
+    }
+
+    if (buf != NULL) {
+      g_queue_push_tail (&src->ring, buf);
+      src->ring_sector = sector + 1;
+    } else {
+      src->ring_error = TRUE;
+    }
+    g_cond_broadcast (&src->ring_cond);
+  }
+
+  g_mutex_unlock (&src->ring_lock);
+
+  return NULL;
+}
+
+/* takes the next sector from the ring, repositioning the readahead
+ * thread first if the request is not sequential */
+static GstBuffer *
+gst_cd_paranoia_src_ring_pop (GstCdParanoiaSrc * src, gint sector)
+{
+  GstBuffer *buf, *head;
+
+  g_mutex_lock (&src->ring_lock);
+
+  head = g_queue_peek_head (&src->ring);
+  if ((head != NULL && GST_BUFFER_OFFSET (head) != (guint64) sector) ||
+      (head == NULL && src->ring_sector != sector)) {
+    GST_DEBUG_OBJECT (src, "flushing readahead, restarting at sector %d",
+        sector);
+    while ((buf = g_queue_pop_head (&src->ring)))
+      gst_buffer_unref (buf);
+    src->ring_sector = sector;
+    src->ring_error = FALSE;
+    g_cond_broadcast (&src->ring_cond);
+  }
+
+  while (g_queue_is_empty (&src->ring) && !src->ring_error)
+    g_cond_wait (&src->ring_cond, &src->ring_lock);
+
+  buf = g_queue_pop_head (&src->ring);
+  /* popping made room for more readahead */
+  g_cond_broadcast (&src->ring_cond);
+
+  g_mutex_unlock (&src->ring_lock);
+
+  if (buf == NULL)
+    goto read_failed;
+
+  return buf;
+
+  /* ERRORS */
+read_failed:
+  {
+    GST_WARNING_OBJECT (src, "read at sector %d failed!", sector);
+    GST_ELEMENT_ERROR (src, RESOURCE, READ,
+        (_("Could not read CD.")),
+        ("paranoia_read at %d failed: %s", sector, g_strerror (errno)));
+    return NULL;
+  }
+}
+
 static GstBuffer *
 gst_cd_paranoia_src_read_sector (GstAudioCdSrc * audiocdsrc, gint sector)
 {
@@ -363,6 +566,11 @@ gst_cd_paranoia_src_read_sector (GstAudioCdSrc * audiocdsrc, gint sector)
   }
 #endif
 
+  /* with a readahead thread all paranoia calls happen on that thread
+   * and we only take finished sectors out of the ring */
+  if (src->read_thread != NULL)
+    return gst_cd_paranoia_src_ring_pop (src, sector);
+
   if (src->next_sector == -1 || src->next_sector != sector) {
     if (paranoia_seek (src->p, sector, SEEK_SET) == -1)
       goto seek_failed;
@@ -393,6 +601,8 @@ gst_cd_paranoia_src_read_sector (GstAudioCdSrc * audiocdsrc, gint sector)
   if (cdda_buf == NULL)
     goto read_failed;
 
+  g_atomic_int_inc (&src->sectors_read);
+
   buf = gst_buffer_new_and_alloc (CD_FRAMESIZE_RAW);
   gst_buffer_fill (buf, 0, cdda_buf, CD_FRAMESIZE_RAW);
 
@@ -427,6 +637,9 @@ gst_cd_paranoia_src_finalize (GObject * obj)
 
   g_free (src->generic_device);
 
+  g_mutex_clear (&src->ring_lock);
+  g_cond_clear (&src->ring_cond);
+
   G_OBJECT_CLASS (parent_class)->finalize (obj);
 }
 
@@ -466,6 +679,10 @@ gst_cd_paranoia_src_set_property (GObject * object, guint prop_id,
       src->cache_size = g_value_get_int (value);
       break;
     }
+    case PROP_READAHEAD:{
+      src->readahead = g_value_get_int (value);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -498,6 +715,22 @@ gst_cd_paranoia_src_get_property (GObject * object, guint prop_id,
     case PROP_CACHE_SIZE:
       g_value_set_int (value, src->cache_size);
       break;
+    case PROP_READAHEAD:
+      g_value_set_int (value, src->readahead);
+      break;
+    case PROP_STATS:{
+      GstStructure *s;
+
+      s = gst_structure_new ("application/x-cdparanoiasrc-stats",
+          "sectors-read", G_TYPE_UINT,
+          (guint) g_atomic_int_get (&src->sectors_read),
+          "transport-errors", G_TYPE_UINT,
+          (guint) g_atomic_int_get (&src->transport_errors),
+          "uncorrected-errors", G_TYPE_UINT,
+          (guint) g_atomic_int_get (&src->uncorrected_errors), NULL);
+      g_value_take_boxed (value, s);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -66,8 +66,25 @@ struct _GstCdParanoiaSrc {
   gint             read_speed;
   gint             search_overlap;
   gint             cache_size;
+  gint             readahead;    /* max sectors to read ahead, 0 = sync */
 
   gchar           *generic_device;
+
+  /* readahead thread; reads sectors ahead of the streaming thread into
+   * a ring of buffers so retry storms don't stall the pipeline */
+  GThread         *read_thread;
+  GMutex           ring_lock;
+  GCond            ring_cond;
+  GQueue           ring;         /* consecutive sectors, oldest first */
+  gint             ring_sector;  /* next sector the thread will read,
+                                  * or -1 if it should idle */
+  gboolean         ring_error;   /* thread failed to read ring_sector */
+  gboolean         ring_stop;
+
+  /* read statistics, updated atomically */
+  gint             sectors_read;
+  gint             transport_errors;
+  gint             uncorrected_errors;
 };
 
 struct _GstCdParanoiaSrcClass {
@@ -213,6 +213,11 @@ gst_ogg_pad_dispose (GObject * object)
   g_free (pad->map.index);
   pad->map.index = NULL;
 
+  if (pad->pending_list) {
+    gst_buffer_list_unref (pad->pending_list);
+    pad->pending_list = NULL;
+  }
+
   /* clear continued pages */
   g_list_foreach (pad->continued, (GFunc) gst_ogg_page_free, NULL);
   g_list_free (pad->continued);
@@ -485,6 +490,28 @@ gst_ogg_demux_queue_data (GstOggPad * pad, ogg_packet * packet)
   return GST_FLOW_OK;
 }
 
+/* push the buffers batched for this pad downstream as one buffer list,
+ * combining the flow return like a regular push would. Returns
+ * GST_FLOW_OK when nothing was pending. */
+static GstFlowReturn
+gst_ogg_pad_flush_pending_list (GstOggPad * pad)
+{
+  GstOggDemux *ogg = pad->ogg;
+  GstBufferList *list;
+  GstFlowReturn ret;
+
+  list = pad->pending_list;
+  if (list == NULL)
+    return GST_FLOW_OK;
+  pad->pending_list = NULL;
+
+  GST_LOG_OBJECT (ogg, "Pushing %u batched buffers on pad %p",
+      gst_buffer_list_length (list), pad);
+  ret = gst_pad_push_list (GST_PAD_CAST (pad), list);
+
+  return gst_ogg_demux_combine_flows (ogg, pad, ret);
+}
+
 static GstFlowReturn
 gst_ogg_demux_chain_peer (GstOggPad * pad, ogg_packet * packet,
     gboolean push_headers)
@@ -827,8 +854,19 @@ gst_ogg_demux_chain_peer (GstOggPad * pad, ogg_packet * packet,
   /* don't push the header packets when we are asked to skip them */
   if (!packet->b_o_s || push_headers) {
     if (pad->last_ret == GST_FLOW_OK) {
-      GST_LOG_OBJECT (ogg, "Pushing buf %" GST_PTR_FORMAT, buf);
-      ret = gst_pad_push (GST_PAD_CAST (pad), buf);
+      if (!ogg->pullmode) {
+        /* in streaming mode buffers are batched per page and pushed as
+         * one buffer list when the page is drained, saving a pad-push
+         * round trip per packet */
+        GST_LOG_OBJECT (ogg, "Batching buf %" GST_PTR_FORMAT, buf);
+        if (pad->pending_list == NULL)
+          pad->pending_list = gst_buffer_list_new ();
+        gst_buffer_list_add (pad->pending_list, buf);
+        ret = GST_FLOW_OK;
+      } else {
+        GST_LOG_OBJECT (ogg, "Pushing buf %" GST_PTR_FORMAT, buf);
+        ret = gst_pad_push (GST_PAD_CAST (pad), buf);
+      }
     } else {
       GST_DEBUG_OBJECT (ogg, "not pushing buffer on error pad");
       ret = pad->last_ret;
@@ -1306,6 +1344,13 @@ gst_ogg_pad_stream_out (GstOggPad * pad, gint npackets)
       done = (npackets == 0);
     }
   }
+  /* push what was batched for this page in one go */
+  {
+    GstFlowReturn cret = gst_ogg_pad_flush_pending_list (pad);
+
+    if (result == GST_FLOW_OK)
+      result = cret;
+  }
   return result;
 
   /* ERRORS */
@@ -1314,6 +1359,7 @@ could_not_submit:
     GST_WARNING_OBJECT (ogg,
         "could not submit packet for stream %08x, "
         "error: %d", pad->map.serialno, result);
+    gst_ogg_pad_flush_pending_list (pad);
     gst_ogg_pad_reset (pad);
     return result;
   }
@@ -2092,6 +2138,7 @@ gst_ogg_chain_new (GstOggDemux * ogg)
   chain->bytes = -1;
   chain->have_bos = FALSE;
   chain->streams = g_array_new (FALSE, TRUE, sizeof (GstOggPad *));
+  chain->seek_index = g_array_new (FALSE, FALSE, sizeof (GstOggSeekSample));
   chain->begin_time = GST_CLOCK_TIME_NONE;
   chain->segment_start = GST_CLOCK_TIME_NONE;
   chain->segment_stop = GST_CLOCK_TIME_NONE;
@@ -2111,6 +2158,7 @@ gst_ogg_chain_free (GstOggChain * chain)
     gst_object_unref (pad);
   }
   g_array_free (chain->streams, TRUE);
+  g_array_free (chain->seek_index, TRUE);
   g_slice_free (GstOggChain, chain);
 }
 
@@ -2553,6 +2601,7 @@ gst_ogg_demux_get_data (GstOggDemux * ogg, gint64 end_offset)
   GstBuffer *buffer;
   gchar *oggbuffer;
   gsize size;
+  gint64 read_size = ogg->chunk_size;
 
   GST_LOG_OBJECT (ogg,
       "get data %" G_GINT64_FORMAT " %" G_GINT64_FORMAT " %" G_GINT64_FORMAT,
@@ -2564,17 +2613,23 @@ gst_ogg_demux_get_data (GstOggDemux * ogg, gint64 end_offset)
   if (ogg->read_offset == ogg->length)
     goto eos;
 
-  oggbuffer = ogg_sync_buffer (&ogg->sync, ogg->chunk_size);
+  /* when scanning the tail of a chain we are going to parse everything
+   * up to the boundary anyway, so fetch it in one larger read instead
+   * of paying a round trip per chunk on remote sources */
+  if (ogg->tail_scan && end_offset > 0)
+    read_size = CLAMP (end_offset - ogg->read_offset, read_size,
+        2 * MAX_OGG_PAGE_SIZE);
+
+  oggbuffer = ogg_sync_buffer (&ogg->sync, read_size);
   if (G_UNLIKELY (oggbuffer == NULL))
     goto no_buffer;
 
   buffer =
-      gst_buffer_new_wrapped_full (0, oggbuffer, ogg->chunk_size, 0,
-      ogg->chunk_size, NULL, NULL);
+      gst_buffer_new_wrapped_full (0, oggbuffer, read_size, 0,
+      read_size, NULL, NULL);
 
   ret =
-      gst_pad_pull_range (ogg->sinkpad, ogg->read_offset, ogg->chunk_size,
-      &buffer);
+      gst_pad_pull_range (ogg->sinkpad, ogg->read_offset, read_size, &buffer);
   if (ret != GST_FLOW_OK)
     goto error;
 
@@ -2720,6 +2775,8 @@ gst_ogg_demux_get_prev_page (GstOggDemux * ogg, ogg_page * og, gint64 * offset)
 
   GST_LOG_OBJECT (ogg, "getting page before %" G_GINT64_FORMAT, begin);
 
+  ogg->tail_scan = TRUE;
+
   while (cur_offset == -1) {
     begin -= ogg->chunk_size;
     if (begin < 0)
@@ -2758,7 +2815,7 @@ gst_ogg_demux_get_prev_page (GstOggDemux * ogg, ogg_page * og, gint64 * offset)
         goto beach;
       } else if (ret != GST_FLOW_OK) {
         GST_LOG_OBJECT (ogg, "got error %d", ret);
-        return ret;
+        goto beach;
       }
 
       GST_LOG_OBJECT (ogg, "found page at %" G_GINT64_FORMAT, new_offset);
@@ -2777,13 +2834,14 @@ gst_ogg_demux_get_prev_page (GstOggDemux * ogg, ogg_page * og, gint64 * offset)
     GST_WARNING_OBJECT (ogg, "can't get last page at %" G_GINT64_FORMAT,
         cur_offset);
     /* this shouldn't be possible */
-    return ret;
+    goto beach;
   }
 
   if (offset)
     *offset = cur_offset;
 
 beach:
+  ogg->tail_scan = FALSE;
   return ret;
 }
 
@@ -2806,6 +2864,9 @@ gst_ogg_demux_deactivate_current_chain (GstOggDemux * ogg)
     if (!pad->added)
       continue;
 
+    /* make sure no batched buffers are left behind the EOS */
+    gst_ogg_pad_flush_pending_list (pad);
+
     event = gst_event_new_eos ();
     gst_event_set_seqnum (event, ogg->seqnum);
     gst_pad_push_event (GST_PAD_CAST (pad), event);
@@ -2890,6 +2951,8 @@ gst_ogg_demux_push_queued_buffers (GstOggDemux * ogg, GstOggPad * pad)
   /* and free the queued buffers */
   g_list_free (pad->map.queued);
   pad->map.queued = NULL;
+
+  gst_ogg_pad_flush_pending_list (pad);
 }
 
 static gboolean
@@ -3034,6 +3097,73 @@ gst_ogg_demux_activate_chain (GstOggDemux * ogg, GstOggChain * chain,
   return TRUE;
 }
 
+/* keep at most one seek index sample per this much chain time; nearby
+ * samples narrow the bisection window just as well */
+#define GST_OGG_SEEK_INDEX_GRANULARITY (500 * GST_MSECOND)
+
+/* record one bisection probe result into the chain's seek index,
+ * keeping the array sorted by time */
+static void
+gst_ogg_chain_record_seek_sample (GstOggChain * chain, gint64 page_start,
+    gint64 page_end, GstClockTime time)
+{
+  GArray *index = chain->seek_index;
+  GstOggSeekSample sample;
+  guint lo = 0, hi = index->len;
+
+  while (lo < hi) {
+    guint mid = (lo + hi) / 2;
+
+    if (g_array_index (index, GstOggSeekSample, mid).time < time)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  /* don't grow without bound */
+  if (lo > 0) {
+    GstOggSeekSample *prev = &g_array_index (index, GstOggSeekSample, lo - 1);
+
+    if (time - prev->time < GST_OGG_SEEK_INDEX_GRANULARITY)
+      return;
+  }
+  if (lo < index->len) {
+    GstOggSeekSample *next = &g_array_index (index, GstOggSeekSample, lo);
+
+    if (next->time - time < GST_OGG_SEEK_INDEX_GRANULARITY)
+      return;
+  }
+
+  sample.page_start = page_start;
+  sample.page_end = page_end;
+  sample.time = time;
+  g_array_insert_val (index, lo, sample);
+}
+
+/* find the recorded samples closest below and at-or-above @target,
+ * NULL when there is none on that side */
+static void
+gst_ogg_chain_lookup_seek_bounds (GstOggChain * chain, gint64 target,
+    GstOggSeekSample ** below, GstOggSeekSample ** above)
+{
+  GArray *index = chain->seek_index;
+  guint lo = 0, hi = index->len;
+
+  /* first sample with time >= target */
+  while (lo < hi) {
+    guint mid = (lo + hi) / 2;
+
+    if (g_array_index (index, GstOggSeekSample, mid).time < target)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  *below = (lo > 0) ? &g_array_index (index, GstOggSeekSample, lo - 1) : NULL;
+  *above = (lo < index->len) ?
+      &g_array_index (index, GstOggSeekSample, lo) : NULL;
+}
+
 static gboolean
 do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
     gint64 end, gint64 begintime, gint64 endtime, gint64 target,
@@ -3045,6 +3175,29 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
 
   best = begin;
 
+  /* Narrow the search window with whatever earlier bisections learned
+   * about this chain. Each sample replays a probe decision the loop
+   * below would make again, so once the index is warm a repeated seek
+   * into the same region converges with little or no I/O. This is not
+   * done for the serialno-restricted keyframe bisection because the
+   * samples may stem from pages of any stream. */
+  if (!only_serial_no && chain->seek_index->len > 0) {
+    GstOggSeekSample *below, *above;
+
+    gst_ogg_chain_lookup_seek_bounds (chain, target, &below, &above);
+    if (below && below->page_end > begin) {
+      best = below->page_start;
+      begin = below->page_end;
+      begintime = below->time;
+    }
+    if (above && above->page_start < end && above->page_start > begin) {
+      end = above->page_start;
+      endtime = above->time;
+    }
+    GST_DEBUG_OBJECT (ogg, "seek index narrowed window to %" G_GINT64_FORMAT
+        " .. %" G_GINT64_FORMAT, begin, end);
+  }
+
   GST_DEBUG_OBJECT (ogg,
       "chain offset %" G_GINT64_FORMAT ", end offset %" G_GINT64_FORMAT,
       begin, end);
@@ -3138,6 +3291,11 @@ do_binary_search (GstOggDemux * ogg, GstOggChain * chain, gint64 begin,
             "found page with granule %" G_GINT64_FORMAT " and time %"
             GST_TIME_FORMAT, granulepos, GST_TIME_ARGS (granuletime));
 
+        /* remember what this probe cost us to learn so that later seeks
+         * into the same chain can start from a narrower window */
+        gst_ogg_chain_record_seek_sample (chain, result, ogg->offset,
+            granuletime);
+
         if (granuletime < target) {
           best = result;        /* raw offset of packet with granulepos */
           begin = ogg->offset;  /* raw offset of next page */
@@ -4199,6 +4357,8 @@ gst_ogg_demux_read_end_chain (GstOggDemux * ogg, GstOggChain * chain)
   ogg_page og;
   gint i;
 
+  ogg->tail_scan = TRUE;
+
   while (!done) {
     begin -= ogg->chunk_size;
     if (begin < 0)
@@ -4214,8 +4374,10 @@ gst_ogg_demux_read_end_chain (GstOggDemux * ogg, GstOggChain * chain)
 
       if (ret == GST_FLOW_LIMIT)
         break;
-      if (ret != GST_FLOW_OK)
+      if (ret != GST_FLOW_OK) {
+        ogg->tail_scan = FALSE;
         return ret;
+      }
 
       for (i = 0; i < chain->streams->len; i++) {
         GstOggPad *pad = g_array_index (chain->streams, GstOggPad *, i);
@@ -4237,6 +4399,8 @@ gst_ogg_demux_read_end_chain (GstOggDemux * ogg, GstOggChain * chain)
     }
   }
 
+  ogg->tail_scan = FALSE;
+
   if (last_pad) {
     chain->segment_stop =
         gst_ogg_stream_get_end_time_for_granulepos (&last_pad->map,
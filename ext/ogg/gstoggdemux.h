@@ -51,6 +51,16 @@ GType gst_ogg_demux_get_type (void);
 typedef struct _GstOggDemux GstOggDemux;
 typedef struct _GstOggDemuxClass GstOggDemuxClass;
 typedef struct _GstOggChain GstOggChain;
+typedef struct _GstOggSeekSample GstOggSeekSample;
+
+/* one granuletime/byte-offset sample learned from a bisection probe,
+ * used to narrow the search window of later seeks */
+struct _GstOggSeekSample
+{
+  gint64 page_start;            /* byte offset of the probed page */
+  gint64 page_end;              /* byte offset just after the probed page */
+  GstClockTime time;            /* chain time of the page's granulepos */
+};
 
 /* all information needed for one ogg chain (relevant for chained bitstreams) */
 struct _GstOggChain
@@ -73,6 +83,9 @@ struct _GstOggChain
                                    the start times of all streams. */
   GstClockTime segment_stop;    /* the timestamp of the last page, this is the MAX of the
                                    streams. */
+
+  GArray *seek_index;           /* GstOggSeekSample array sorted by time, grown
+                                   incrementally from bisection probes */
 };
 
 /* all information needed for one ogg stream */
@@ -108,6 +121,10 @@ struct _GstOggPad
 
   gboolean added;
 
+  GstBufferList *pending_list;  /* in push mode, buffers batched for this pad
+                                   while draining the packets of one page, or
+                                   NULL. Pushed as one buffer list. */
+
   /* push mode seeking */
   GstClockTime push_kf_time;
   GstClockTime push_sync_time;
@@ -203,6 +220,12 @@ struct _GstOggDemux
   ogg_sync_state sync;
   long chunk_size;
 
+  /* TRUE while scanning backwards for the last page(s) of a chain;
+   * makes bounded reads fetch the whole scan window in one pull so
+   * that remote sources see one range request instead of one per
+   * chunk */
+  gboolean tail_scan;
+
   /* Seek events set up by the streaming thread in push mode */
   GstEvent *seek_event;
   GThread *seek_event_thread;
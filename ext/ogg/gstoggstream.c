@@ -146,8 +146,29 @@ gst_ogg_stream_granule_to_time (GstOggStream * pad, gint64 granule)
   if (granule < 0)
     return 0;
 
-  return gst_util_uint64_scale (granule, GST_SECOND * pad->granulerate_d,
-      pad->granulerate_n);
+  /* reduce GST_SECOND * granulerate_d / granulerate_n once per rate;
+   * the smaller factors keep gst_util_uint64_scale() on its cheaper
+   * paths for typical granule values */
+  if (G_UNLIKELY (pad->time_scale_rate_n != pad->granulerate_n
+          || pad->time_scale_rate_d != pad->granulerate_d)) {
+    guint64 num = GST_SECOND * pad->granulerate_d;
+    guint64 denom = pad->granulerate_n;
+    guint64 a = num, b = denom;
+
+    while (b != 0) {
+      guint64 t = a % b;
+
+      a = b;
+      b = t;
+    }
+    pad->time_scale_num = num / a;
+    pad->time_scale_denom = denom / a;
+    pad->time_scale_rate_n = pad->granulerate_n;
+    pad->time_scale_rate_d = pad->granulerate_d;
+  }
+
+  return gst_util_uint64_scale (granule, pad->time_scale_num,
+      pad->time_scale_denom);
 }
 
 gint64
@@ -60,6 +60,13 @@ struct _GstOggStream
   gboolean have_fisbone;
   gint granulerate_n;
   gint granulerate_d;
+  /* granule->time scale factors, GST_SECOND * granulerate_d /
+   * granulerate_n reduced to lowest terms; lazily recomputed whenever
+   * the granulerate they were derived from changes */
+  gint time_scale_rate_n;
+  gint time_scale_rate_d;
+  guint64 time_scale_num;
+  guint64 time_scale_denom;
   gint64 granule_offset;
   guint32 preroll;
   guint granuleshift;
@@ -168,6 +168,10 @@ gst_opus_dec_reset (GstOpusDec * dec)
   dec->n_channels = 0;
   dec->leftover_plc_duration = 0;
   dec->last_known_buffer_duration = GST_CLOCK_TIME_NONE;
+
+  g_free (dec->decode_arena);
+  dec->decode_arena = NULL;
+  dec->decode_arena_size = 0;
 }
 
 static void
@@ -596,20 +600,21 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
        not constant over the stream. */
     samples = 120 * dec->sample_rate / 1000;
   }
-  packet_size = samples * dec->n_channels * 2;
-
-  outbuf =
-      gst_audio_decoder_allocate_output_buffer (GST_AUDIO_DECODER (dec),
-      packet_size);
-  if (!outbuf) {
-    goto buffer_failed;
+  /* decode into a per-decoder arena preallocated at the Opus maximum
+   * frame size (120 ms); the output buffer is allocated at the actually
+   * decoded size afterwards, and growing the request on
+   * OPUS_BUFFER_TOO_SMALL needs no reallocation either */
+  packet_size = (120 * dec->sample_rate / 1000) * dec->n_channels * 2;
+  if (dec->decode_arena_size < packet_size) {
+    g_free (dec->decode_arena);
+    dec->decode_arena = g_malloc (packet_size);
+    dec->decode_arena_size = packet_size;
   }
 
   if (size > 0)
     dec->last_known_buffer_duration = packet_duration_opus (data, size);
 
-  gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
-  out_data = (gint16 *) omap.data;
+  out_data = (gint16 *) dec->decode_arena;
 
   do {
     if (dec->use_inband_fec) {
@@ -632,37 +637,31 @@ opus_dec_chain_parse_data (GstOpusDec * dec, GstBuffer * buffer)
     }
     if (n == OPUS_BUFFER_TOO_SMALL) {
       /* if too small, add 2.5 milliseconds and try again, up to the
-       * Opus max size of 120 milliseconds */
+       * Opus max size of 120 milliseconds the arena is sized for */
       if (samples >= 120 * dec->sample_rate / 1000)
         break;
       samples += 25 * dec->sample_rate / 10000;
-      packet_size = samples * dec->n_channels * 2;
-      gst_buffer_unmap (outbuf, &omap);
-      gst_buffer_unref (outbuf);
-      outbuf =
-          gst_audio_decoder_allocate_output_buffer (GST_AUDIO_DECODER (dec),
-          packet_size);
-      if (!outbuf) {
-        goto buffer_failed;
-      }
-      gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
-      out_data = (gint16 *) omap.data;
     }
   } while (n == OPUS_BUFFER_TOO_SMALL);
-  gst_buffer_unmap (outbuf, &omap);
   if (data != NULL)
     gst_buffer_unmap (buf, &map);
 
   if (n < 0) {
     GstFlowReturn ret = GST_FLOW_ERROR;
 
-    gst_buffer_unref (outbuf);
     GST_AUDIO_DECODER_ERROR (dec, 1, STREAM, DECODE, (NULL),
         ("Decoding error (%d): %s", n, opus_strerror (n)), ret);
     return ret;
   }
   GST_DEBUG_OBJECT (dec, "decoded %d samples", n);
-  gst_buffer_set_size (outbuf, n * 2 * dec->n_channels);
+
+  outbuf =
+      gst_audio_decoder_allocate_output_buffer (GST_AUDIO_DECODER (dec),
+      n * 2 * dec->n_channels);
+  if (!outbuf) {
+    goto buffer_failed;
+  }
+  gst_buffer_fill (outbuf, 0, dec->decode_arena, n * 2 * dec->n_channels);
   GST_BUFFER_DURATION (outbuf) = samples * GST_SECOND / dec->sample_rate;
   samples = n;
 
@@ -754,7 +753,7 @@ creation_failed:
 
 buffer_failed:
   GST_ELEMENT_ERROR (dec, STREAM, DECODE, (NULL),
-      ("Failed to create %u byte buffer", packet_size));
+      ("Failed to create %u byte buffer", (guint) (n * 2 * dec->n_channels)));
   return GST_FLOW_ERROR;
 }
 
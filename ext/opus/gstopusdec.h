@@ -75,6 +75,11 @@ struct _GstOpusDec {
   guint64 leftover_plc_duration;
 
   GstClockTime last_known_buffer_duration;
+
+  /* reusable decode arena preallocated at the Opus maximum frame size,
+   * so output buffers can be allocated at the actually decoded size */
+  guint8 *decode_arena;
+  gsize decode_arena_size;
 };
 
 struct _GstOpusDecClass {
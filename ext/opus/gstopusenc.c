@@ -403,6 +403,9 @@ gst_opus_enc_stop (GstAudioEncoder * benc)
     opus_multistream_encoder_destroy (enc->state);
     enc->state = NULL;
   }
+  g_free (enc->encode_scratch);
+  enc->encode_scratch = NULL;
+  enc->encode_scratch_size = 0;
   gst_tag_setter_reset_tags (GST_TAG_SETTER (enc));
 
   return TRUE;
@@ -903,7 +906,6 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
   gsize bytes;
   gint ret = GST_FLOW_OK;
   GstMapInfo map;
-  GstMapInfo omap;
   gint outsize;
   GstBuffer *outbuf;
   guint64 trim_start = 0, trim_end = 0;
@@ -1001,30 +1003,21 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
 
   g_assert (size == bytes);
 
-  outbuf =
-      gst_audio_encoder_allocate_output_buffer (GST_AUDIO_ENCODER (enc),
-      max_payload_size * enc->n_channels);
-  if (!outbuf)
-    goto done;
-
   GST_DEBUG_OBJECT (enc, "encoding %d samples (%d bytes)",
       frame_samples, (int) bytes);
 
-  if (trim_start || trim_end) {
-    GST_DEBUG_OBJECT (enc,
-        "Adding trim-start %" G_GUINT64_FORMAT " trim-end %" G_GUINT64_FORMAT,
-        trim_start, trim_end);
-    gst_buffer_add_audio_clipping_meta (outbuf, GST_FORMAT_DEFAULT, trim_start,
-        trim_end);
+  /* encode into a reusable per-encoder arena first, so the output buffer
+   * can be allocated at the real packet size instead of the worst-case
+   * payload size and needs no mapping for the encoder to write into */
+  if (enc->encode_scratch_size < max_payload_size * enc->n_channels) {
+    g_free (enc->encode_scratch);
+    enc->encode_scratch_size = max_payload_size * enc->n_channels;
+    enc->encode_scratch = g_malloc (enc->encode_scratch_size);
   }
 
-  gst_buffer_map (outbuf, &omap, GST_MAP_WRITE);
-
   outsize =
       opus_multistream_encode (enc->state, (const gint16 *) data,
-      frame_samples, omap.data, max_payload_size * enc->n_channels);
-
-  gst_buffer_unmap (outbuf, &omap);
+      frame_samples, enc->encode_scratch, max_payload_size * enc->n_channels);
 
   if (outsize < 0) {
     GST_ELEMENT_ERROR (enc, STREAM, ENCODE, (NULL),
@@ -1040,8 +1033,22 @@ gst_opus_enc_encode (GstOpusEnc * enc, GstBuffer * buf)
   }
 
   GST_DEBUG_OBJECT (enc, "Output packet is %u bytes", outsize);
-  gst_buffer_set_size (outbuf, outsize);
 
+  outbuf =
+      gst_audio_encoder_allocate_output_buffer (GST_AUDIO_ENCODER (enc),
+      outsize);
+  if (!outbuf)
+    goto done;
+
+  gst_buffer_fill (outbuf, 0, enc->encode_scratch, outsize);
+
+  if (trim_start || trim_end) {
+    GST_DEBUG_OBJECT (enc,
+        "Adding trim-start %" G_GUINT64_FORMAT " trim-end %" G_GUINT64_FORMAT,
+        trim_start, trim_end);
+    gst_buffer_add_audio_clipping_meta (outbuf, GST_FORMAT_DEFAULT, trim_start,
+        trim_end);
+  }
 
   ret =
       gst_audio_encoder_finish_frame (GST_AUDIO_ENCODER (enc), outbuf,
@@ -79,6 +79,11 @@ struct _GstOpusEnc {
   gint                  n_channels;
   gint                  sample_rate;
 
+  /* reusable encode arena; packets are encoded here first so the output
+   * buffer can be allocated at the real packet size */
+  guint8               *encode_scratch;
+  gsize                 encode_scratch_size;
+
   guint64               encoded_samples, consumed_samples;
   guint16               lookahead, pending_lookahead;
 
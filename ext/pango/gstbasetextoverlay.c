@@ -1052,6 +1052,10 @@ gst_base_text_overlay_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
 {
   GstBaseTextOverlay *overlay = GST_BASE_TEXT_OVERLAY (object);
+  /* most properties change what render_text() draws, but the ones that
+   * only take effect when blending onto the video frame must not throw
+   * away the cached text composition */
+  gboolean need_render = TRUE;
 
   GST_BASE_TEXT_OVERLAY_LOCK (overlay);
   switch (prop_id) {
@@ -1061,6 +1065,7 @@ gst_base_text_overlay_set_property (GObject * object, guint prop_id,
       break;
     case PROP_SHADING:
       overlay->want_shading = g_value_get_boolean (value);
+      need_render = FALSE;
       break;
     case PROP_XPAD:
       overlay->xpad = g_value_get_int (value);
@@ -1123,6 +1128,7 @@ gst_base_text_overlay_set_property (GObject * object, guint prop_id,
       break;
     case PROP_SILENT:
       overlay->silent = g_value_get_boolean (value);
+      need_render = FALSE;
       break;
     case PROP_DRAW_SHADOW:
       overlay->draw_shadow = g_value_get_boolean (value);
@@ -1139,6 +1145,7 @@ gst_base_text_overlay_set_property (GObject * object, guint prop_id,
       break;
     case PROP_WAIT_TEXT:
       overlay->wait_text = g_value_get_boolean (value);
+      need_render = FALSE;
       break;
     case PROP_AUTO_ADJUST_SIZE:
       overlay->auto_adjust_size = g_value_get_boolean (value);
@@ -1164,13 +1171,15 @@ gst_base_text_overlay_set_property (GObject * object, guint prop_id,
       break;
     case PROP_SHADING_VALUE:
       overlay->shading_value = g_value_get_uint (value);
+      need_render = FALSE;
       break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
   }
 
-  overlay->need_render = TRUE;
+  if (need_render)
+    overlay->need_render = TRUE;
   GST_BASE_TEXT_OVERLAY_UNLOCK (overlay);
 }
 
@@ -1289,7 +1298,6 @@ gst_base_text_overlay_get_property (GObject * object, guint prop_id,
       break;
   }
 
-  overlay->need_render = TRUE;
   GST_BASE_TEXT_OVERLAY_UNLOCK (overlay);
 }
 
@@ -2255,6 +2263,65 @@ gst_base_text_overlay_render_text (GstBaseTextOverlay * overlay,
   overlay->need_render = FALSE;
 }
 
+/* Renders the text of the currently queued text buffer. Takes care of
+ * UTF-8 validation and markup escaping; empty buffers render a single
+ * space so that any previous text is cleared. Must be called with the
+ * overlay lock held and a non-NULL text_buffer */
+static void
+gst_base_text_overlay_render_text_buffer (GstBaseTextOverlay * overlay)
+{
+  GstMapInfo map;
+  gchar *in_text, *text = NULL;
+  gsize in_size;
+
+  gst_buffer_map (overlay->text_buffer, &map, GST_MAP_READ);
+  in_text = (gchar *) map.data;
+  in_size = map.size;
+
+  if (in_size > 0) {
+    /* g_markup_escape_text() absolutely requires valid UTF8 input, it
+     * might crash otherwise. We don't fall back on GST_SUBTITLE_ENCODING
+     * here on purpose, this is something that needs fixing upstream */
+    if (!g_utf8_validate (in_text, in_size, NULL)) {
+      const gchar *end = NULL;
+
+      GST_WARNING_OBJECT (overlay, "received invalid UTF-8");
+      in_text = g_strndup (in_text, in_size);
+      while (!g_utf8_validate (in_text, in_size, &end) && end)
+        *((gchar *) end) = '*';
+    }
+
+    /* Get the string */
+    if (overlay->have_pango_markup) {
+      text = g_strndup (in_text, in_size);
+    } else {
+      text = g_markup_escape_text (in_text, in_size);
+    }
+
+    if (text != NULL && *text != '\0') {
+      gint text_len = strlen (text);
+
+      while (text_len > 0 && (text[text_len - 1] == '\n' ||
+              text[text_len - 1] == '\r')) {
+        --text_len;
+      }
+      GST_DEBUG_OBJECT (overlay, "Rendering text '%*s'", text_len, text);
+      gst_base_text_overlay_render_text (overlay, text, text_len);
+    } else {
+      GST_DEBUG_OBJECT (overlay, "No text to render (empty buffer)");
+      gst_base_text_overlay_render_text (overlay, " ", 1);
+    }
+    g_free (text);
+    if (in_text != (gchar *) map.data)
+      g_free (in_text);
+  } else {
+    GST_DEBUG_OBJECT (overlay, "No text to render (empty buffer)");
+    gst_base_text_overlay_render_text (overlay, " ", 1);
+  }
+
+  gst_buffer_unmap (overlay->text_buffer, &map);
+}
+
 /* FIXME: should probably be relative to width/height (adjusted for PAR) */
 #define BOX_XPAD  6
 #define BOX_YPAD  6
@@ -2730,6 +2797,14 @@ gst_base_text_overlay_text_chain (GstPad * pad, GstObject * parent,
     /* That's a new text buffer we need to render */
     overlay->need_render = TRUE;
 
+    /* Render it ahead of time on this thread, which typically runs well
+     * before the cue's display time: the video streaming thread then
+     * finds the text image already rasterized at cue onset and only has
+     * to attach or blend it. Needs negotiated video, and is pointless
+     * when nothing will be displayed */
+    if (overlay->width > 0 && !overlay->silent)
+      gst_base_text_overlay_render_text_buffer (overlay);
+
     /* in case the video chain is waiting for a text buffer, wake it up */
     GST_BASE_TEXT_OVERLAY_BROADCAST (overlay);
   }
@@ -2925,55 +3000,10 @@ wait_for_text_buf:
         /* Push the video frame */
         ret = gst_pad_push (overlay->srcpad, buffer);
       } else {
-        GstMapInfo map;
-        gchar *in_text;
-        gsize in_size;
-
-        gst_buffer_map (overlay->text_buffer, &map, GST_MAP_READ);
-        in_text = (gchar *) map.data;
-        in_size = map.size;
-
-        if (in_size > 0) {
-          /* g_markup_escape_text() absolutely requires valid UTF8 input, it
-           * might crash otherwise. We don't fall back on GST_SUBTITLE_ENCODING
-           * here on purpose, this is something that needs fixing upstream */
-          if (!g_utf8_validate (in_text, in_size, NULL)) {
-            const gchar *end = NULL;
-
-            GST_WARNING_OBJECT (overlay, "received invalid UTF-8");
-            in_text = g_strndup (in_text, in_size);
-            while (!g_utf8_validate (in_text, in_size, &end) && end)
-              *((gchar *) end) = '*';
-          }
-
-          /* Get the string */
-          if (overlay->have_pango_markup) {
-            text = g_strndup (in_text, in_size);
-          } else {
-            text = g_markup_escape_text (in_text, in_size);
-          }
-
-          if (text != NULL && *text != '\0') {
-            gint text_len = strlen (text);
-
-            while (text_len > 0 && (text[text_len - 1] == '\n' ||
-                    text[text_len - 1] == '\r')) {
-              --text_len;
-            }
-            GST_DEBUG_OBJECT (overlay, "Rendering text '%*s'", text_len, text);
-            gst_base_text_overlay_render_text (overlay, text, text_len);
-          } else {
-            GST_DEBUG_OBJECT (overlay, "No text to render (empty buffer)");
-            gst_base_text_overlay_render_text (overlay, " ", 1);
-          }
-          if (in_text != (gchar *) map.data)
-            g_free (in_text);
-        } else {
-          GST_DEBUG_OBJECT (overlay, "No text to render (empty buffer)");
-          gst_base_text_overlay_render_text (overlay, " ", 1);
-        }
-
-        gst_buffer_unmap (overlay->text_buffer, &map);
+        /* Normally a no-op: the text chain pre-rendered this buffer when
+         * it was queued, unless something invalidated the rendering
+         * since (property or caps change) */
+        gst_base_text_overlay_render_text_buffer (overlay);
 
         GST_BASE_TEXT_OVERLAY_UNLOCK (overlay);
         ret = gst_base_text_overlay_push_frame (overlay, buffer);
@@ -721,11 +721,18 @@ theora_handle_image (GstTheoraDec * dec, th_ycbcr_buffer buf,
         * buf[comp].stride;
     src += (width == pic_width) ? offset_x : offset_x / 2;
 
-    for (i = 0; i < height; i++) {
-      memcpy (dest, src, width);
-
-      dest += stride;
-      src += buf[comp].stride;
+    if (stride == buf[comp].stride && height > 0) {
+      /* same row layout on both sides, collapse the per-line copies
+       * into one; the bytes between rows are plane padding on both
+       * sides so copying them along is harmless */
+      memcpy (dest, src, stride * (height - 1) + width);
+    } else {
+      for (i = 0; i < height; i++) {
+        memcpy (dest, src, width);
+
+        dest += stride;
+        src += buf[comp].stride;
+      }
     }
   }
   gst_video_frame_unmap (&vframe);
@@ -71,11 +71,18 @@ copy_samples (vorbis_sample_t * out, vorbis_sample_t ** in, guint samples,
     out += samples;
   }
 #else
+  vorbis_sample_t *src[8];
   gint i, j;
 
+  /* resolve the channel reordering to plain source pointers once,
+   * instead of a map lookup per sample; this also leaves a tight
+   * interleave loop the compiler can vectorize */
+  for (i = 0; i < channels; i++)
+    src[i] = in[gst_vorbis_reorder_map[channels - 1][i]];
+
   for (j = 0; j < samples; j++) {
     for (i = 0; i < channels; i++) {
-      *out++ = in[gst_vorbis_reorder_map[channels - 1][i]][j];
+      *out++ = src[i][j];
     }
   }
 #endif
@@ -193,11 +200,21 @@ copy_samples_16 (vorbis_sample_t * _out, vorbis_sample_t ** _in, guint samples,
 {
   gint16 *out = (gint16 *) _out;
   ogg_int32_t **in = (ogg_int32_t **) _in;
+  ogg_int32_t *src[8];
   gint i, j;
 
+  /* resolve the channel reordering once instead of per sample; the
+   * reorder map only covers up to 8 channels, more than that is
+   * passed through in vorbis order */
+  if (channels <= 8) {
+    for (i = 0; i < channels; i++)
+      src[i] = in[gst_vorbis_reorder_map[channels - 1][i]];
+    in = src;
+  }
+
   for (j = 0; j < samples; j++) {
     for (i = 0; i < channels; i++) {
-      *out++ = CLIP_TO_15 (in[gst_vorbis_reorder_map[channels - 1][i]][j] >> 9);
+      *out++ = CLIP_TO_15 (in[i][j] >> 9);
     }
   }
 }
@@ -31,6 +31,18 @@
  * @short_description: Memory wrapper for Linux dmabuf memory
  * @see_also: #GstMemory
  *
+ * Importers that receive the same small set of dmabufs over and over again,
+ * such as rotating capture buffers, should not wrap the same fd into a new
+ * #GstMemory for every frame. Instead, import each fd once with
+ * gst_dmabuf_allocator_alloc_with_flags() using
+ * %GST_FD_MEMORY_FLAG_DONT_CLOSE and %GST_FD_MEMORY_FLAG_KEEP_MAPPED, keep
+ * the resulting memories in a table keyed by whatever identifies the
+ * upstream buffer (e.g. the V4L2 buffer index), and ref the cached memory on
+ * re-import. This way the dup/mmap syscalls happen once per buffer instead
+ * of once per frame. The cache has to live in the importer because only the
+ * importer knows when an fd is closed and its number may be reused; the
+ * allocator itself cannot tell two generations of the same fd number apart.
+ *
  * Since: 1.2
  */
 
@@ -103,6 +115,40 @@ gst_dmabuf_allocator_alloc (GstAllocator * allocator, gint fd, gsize size)
   return gst_fd_allocator_alloc (allocator, fd, size, GST_FD_MEMORY_FLAG_NONE);
 }
 
+/**
+ * gst_dmabuf_allocator_alloc_with_flags:
+ * @allocator: allocator to be used for this memory
+ * @fd: dmabuf file descriptor
+ * @size: memory size
+ * @flags: extra #GstFdMemoryFlags
+ *
+ * Return a %GstMemory that wraps a dmabuf file descriptor.
+ *
+ * Unlike gst_dmabuf_allocator_alloc(), this function lets the caller pass
+ * #GstFdMemoryFlags. In particular, passing
+ * %GST_FD_MEMORY_FLAG_KEEP_MAPPED makes the memory stay mmapped after the
+ * first map until it is freed. This avoids repeated mmap/munmap system
+ * calls, and the cache maintenance they imply, when the same dmabuf is
+ * mapped over and over again, e.g. in capture pipelines that only inspect
+ * a few lines of every frame.
+ *
+ * Returns: (transfer full): a GstMemory based on @allocator.
+ *
+ * When the buffer will be released the allocator will close the @fd unless
+ * the %GST_FD_MEMORY_FLAG_DONT_CLOSE flag is specified.
+ * The memory is only mmapped on gst_buffer_map() request.
+ *
+ * Since: 1.14
+ */
+GstMemory *
+gst_dmabuf_allocator_alloc_with_flags (GstAllocator * allocator, gint fd,
+    gsize size, GstFdMemoryFlags flags)
+{
+  g_return_val_if_fail (GST_IS_DMABUF_ALLOCATOR (allocator), NULL);
+
+  return gst_fd_allocator_alloc (allocator, fd, size, flags);
+}
+
 /**
  * gst_dmabuf_memory_get_fd:
  * @mem: the memory to get the file descriptor
@@ -0,0 +1,258 @@
+/* GStreamer huge page backed memory
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:gsthugepagememory
+ * @title: GstHugePageAllocator
+ * @short_description: Allocator for huge page eligible memory
+ * @see_also: #GstMemory
+ *
+ * #GstHugePageAllocator allocates anonymous memory in multiples of the
+ * huge page size, aligned to a huge page boundary, and advises the kernel
+ * to back it with transparent huge pages. Large video frames allocated
+ * this way need far fewer TLB entries, which speeds up memory-bound
+ * operations like frame copies and conversion.
+ *
+ * Whether huge pages are actually used depends on the kernel
+ * configuration; when they are not available the memory behaves like
+ * normal anonymous memory. Allocations are rounded up to the huge page
+ * size, so this allocator is wasteful for small blocks and is best
+ * configured in a #GstBufferPool for large frames only.
+ *
+ * Since: 1.14
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include "gsthugepagememory.h"
+
+#ifdef HAVE_MMAP
+#include <sys/mman.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+GST_DEBUG_CATEGORY_STATIC (gst_hugepagememory_debug);
+#define GST_CAT_DEFAULT gst_hugepagememory_debug
+
+/* most common huge page size; madvise() is a hint, so being wrong here
+ * only costs some rounding, never correctness */
+#define GST_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+
+typedef struct
+{
+  GstMemory mem;
+
+  gpointer data;
+} GstHugePageMemory;
+
+#ifdef HAVE_MMAP
+static GstMemory *
+gst_huge_page_mem_alloc (GstAllocator * allocator, gsize size,
+    GstAllocationParams * params)
+{
+  GstHugePageMemory *mem;
+  gsize maxsize, offset, padding;
+  gpointer reserved, data;
+  gsize align, skip;
+
+  align = params->align;
+  /* the region below starts on a huge page boundary, rounding the prefix
+   * up keeps the data pointer aligned too */
+  offset = (params->prefix + align) & ~align;
+  padding = params->padding;
+
+  maxsize = offset + size + padding;
+  maxsize = (maxsize + GST_HUGE_PAGE_SIZE - 1) & ~(GST_HUGE_PAGE_SIZE - 1);
+
+  /* mmap() only aligns to the normal page size; reserve one extra huge
+   * page and trim the mapping so that it starts on a huge page boundary,
+   * otherwise the kernel cannot use huge pages for it */
+  reserved = mmap (NULL, maxsize + GST_HUGE_PAGE_SIZE,
+      PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (reserved == MAP_FAILED)
+    goto mmap_failed;
+
+  skip = ((gsize) reserved) & (GST_HUGE_PAGE_SIZE - 1);
+  if (skip)
+    skip = GST_HUGE_PAGE_SIZE - skip;
+
+  data = (guint8 *) reserved + skip;
+  if (skip)
+    munmap (reserved, skip);
+  if (GST_HUGE_PAGE_SIZE - skip)
+    munmap ((guint8 *) data + maxsize, GST_HUGE_PAGE_SIZE - skip);
+
+#ifdef MADV_HUGEPAGE
+  if (madvise (data, maxsize, MADV_HUGEPAGE) < 0)
+    GST_DEBUG ("madvise (MADV_HUGEPAGE) failed: %s", g_strerror (errno));
+#endif
+
+  mem = g_slice_new0 (GstHugePageMemory);
+  /* anonymous mappings are zero-filled, ZERO_PREFIXED and ZERO_PADDED
+   * need no extra work */
+  gst_memory_init (GST_MEMORY_CAST (mem), params->flags, allocator, NULL,
+      maxsize, align, offset, size);
+
+  mem->data = data;
+
+  GST_DEBUG ("%p: allocated %" G_GSIZE_FORMAT " at %p", mem, maxsize, data);
+
+  return GST_MEMORY_CAST (mem);
+
+  /* ERRORS */
+mmap_failed:
+  {
+    GST_ERROR ("mmap of %" G_GSIZE_FORMAT " bytes failed: %s",
+        maxsize + GST_HUGE_PAGE_SIZE, g_strerror (errno));
+    return NULL;
+  }
+}
+#endif
+
+static void
+gst_huge_page_mem_free (GstAllocator * allocator, GstMemory * gmem)
+{
+#ifdef HAVE_MMAP
+  GstHugePageMemory *mem = (GstHugePageMemory *) gmem;
+
+  if (gmem->parent == NULL)
+    munmap (mem->data, gmem->maxsize);
+  g_slice_free (GstHugePageMemory, mem);
+  GST_DEBUG ("%p: freed", mem);
+#endif
+}
+
+static gpointer
+gst_huge_page_mem_map (GstMemory * gmem, gsize maxsize, GstMapFlags flags)
+{
+  return ((GstHugePageMemory *) gmem)->data;
+}
+
+static void
+gst_huge_page_mem_unmap (GstMemory * gmem)
+{
+}
+
+static GstMemory *
+gst_huge_page_mem_share (GstMemory * gmem, gssize offset, gssize size)
+{
+  GstHugePageMemory *mem = (GstHugePageMemory *) gmem;
+  GstHugePageMemory *sub;
+  GstMemory *parent;
+
+  GST_DEBUG ("%p: share %" G_GSSIZE_FORMAT " %" G_GSIZE_FORMAT, mem, offset,
+      size);
+
+  /* find the real parent */
+  if ((parent = mem->mem.parent) == NULL)
+    parent = (GstMemory *) mem;
+
+  if (size == -1)
+    size = gmem->maxsize - offset;
+
+  sub = g_slice_new0 (GstHugePageMemory);
+  /* the shared memory is always readonly */
+  gst_memory_init (GST_MEMORY_CAST (sub), GST_MINI_OBJECT_FLAGS (parent) |
+      GST_MINI_OBJECT_FLAG_LOCK_READONLY, mem->mem.allocator, parent,
+      mem->mem.maxsize, mem->mem.align, mem->mem.offset + offset, size);
+
+  sub->data = mem->data;
+
+  return GST_MEMORY_CAST (sub);
+}
+
+G_DEFINE_TYPE (GstHugePageAllocator, gst_huge_page_allocator,
+    GST_TYPE_ALLOCATOR);
+
+static void
+gst_huge_page_allocator_class_init (GstHugePageAllocatorClass * klass)
+{
+  GstAllocatorClass *allocator_class;
+
+  allocator_class = (GstAllocatorClass *) klass;
+
+#ifdef HAVE_MMAP
+  allocator_class->alloc = gst_huge_page_mem_alloc;
+#else
+  allocator_class->alloc = NULL;
+#endif
+  allocator_class->free = gst_huge_page_mem_free;
+
+  GST_DEBUG_CATEGORY_INIT (gst_hugepagememory_debug, "hugepagememory", 0,
+      "GstHugePageMemory and GstHugePageAllocator");
+}
+
+static void
+gst_huge_page_allocator_init (GstHugePageAllocator * allocator)
+{
+  GstAllocator *alloc = GST_ALLOCATOR_CAST (allocator);
+
+  alloc->mem_type = GST_ALLOCATOR_HUGE_PAGE;
+
+  alloc->mem_map = gst_huge_page_mem_map;
+  alloc->mem_unmap = gst_huge_page_mem_unmap;
+  alloc->mem_share = gst_huge_page_mem_share;
+}
+
+/**
+ * gst_huge_page_allocator_new:
+ *
+ * Return a new huge page allocator.
+ *
+ * Returns: (transfer full): a new huge page allocator, or NULL if the
+ *    allocator isn't available. Use gst_object_unref() to release the
+ *    allocator after usage
+ *
+ * Since: 1.14
+ */
+GstAllocator *
+gst_huge_page_allocator_new (void)
+{
+#ifdef HAVE_MMAP
+  GstAllocator *alloc;
+
+  alloc = g_object_new (GST_TYPE_HUGE_PAGE_ALLOCATOR, NULL);
+  gst_object_ref_sink (alloc);
+
+  return alloc;
+#else /* !HAVE_MMAP */
+  return NULL;
+#endif
+}
+
+/**
+ * gst_is_huge_page_memory:
+ * @mem: #GstMemory
+ *
+ * Check if @mem is memory allocated from huge page eligible memory.
+ *
+ * Returns: %TRUE when @mem was allocated by a #GstHugePageAllocator
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_is_huge_page_memory (GstMemory * mem)
+{
+  g_return_val_if_fail (mem != NULL, FALSE);
+
+  return GST_IS_HUGE_PAGE_ALLOCATOR (mem->allocator);
+}
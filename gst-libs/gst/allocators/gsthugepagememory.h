@@ -0,0 +1,79 @@
+/* GStreamer huge page backed memory
+ * Copyright (C) 2017 GStreamer developers
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_HUGE_PAGE_MEMORY_H__
+#define __GST_HUGE_PAGE_MEMORY_H__
+
+#include <gst/gst.h>
+
+G_BEGIN_DECLS
+
+#define GST_ALLOCATOR_HUGE_PAGE "hugepage"
+
+#define GST_TYPE_HUGE_PAGE_ALLOCATOR              (gst_huge_page_allocator_get_type())
+#define GST_IS_HUGE_PAGE_ALLOCATOR(obj)           (G_TYPE_CHECK_INSTANCE_TYPE ((obj), GST_TYPE_HUGE_PAGE_ALLOCATOR))
+#define GST_IS_HUGE_PAGE_ALLOCATOR_CLASS(klass)   (G_TYPE_CHECK_CLASS_TYPE ((klass), GST_TYPE_HUGE_PAGE_ALLOCATOR))
+#define GST_HUGE_PAGE_ALLOCATOR_GET_CLASS(obj)    (G_TYPE_INSTANCE_GET_CLASS ((obj), GST_TYPE_HUGE_PAGE_ALLOCATOR, GstHugePageAllocatorClass))
+#define GST_HUGE_PAGE_ALLOCATOR(obj)              (G_TYPE_CHECK_INSTANCE_CAST ((obj), GST_TYPE_HUGE_PAGE_ALLOCATOR, GstHugePageAllocator))
+#define GST_HUGE_PAGE_ALLOCATOR_CLASS(klass)      (G_TYPE_CHECK_CLASS_CAST ((klass), GST_TYPE_HUGE_PAGE_ALLOCATOR, GstHugePageAllocatorClass))
+#define GST_HUGE_PAGE_ALLOCATOR_CAST(obj)         ((GstHugePageAllocator *)(obj))
+
+typedef struct _GstHugePageAllocator GstHugePageAllocator;
+typedef struct _GstHugePageAllocatorClass GstHugePageAllocatorClass;
+
+/**
+ * GstHugePageAllocator:
+ *
+ * Allocator for anonymous memory that is eligible for transparent
+ * huge pages
+ *
+ * Since: 1.14
+ */
+struct _GstHugePageAllocator
+{
+  GstAllocator parent;
+
+  /*< private >*/
+  gpointer _gst_reserved[GST_PADDING];
+};
+
+struct _GstHugePageAllocatorClass
+{
+  GstAllocatorClass parent_class;
+
+  /*< private >*/
+  gpointer _gst_reserved[GST_PADDING];
+};
+
+GST_EXPORT
+GType          gst_huge_page_allocator_get_type (void);
+
+GST_EXPORT
+GstAllocator * gst_huge_page_allocator_new (void);
+
+GST_EXPORT
+gboolean       gst_is_huge_page_memory (GstMemory * mem);
+
+#ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
+G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstHugePageAllocator, gst_object_unref)
+#endif
+
+G_END_DECLS
+
+#endif /* __GST_HUGE_PAGE_MEMORY_H__ */
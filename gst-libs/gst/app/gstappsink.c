@@ -139,6 +139,7 @@ enum
   PROP_DROP,
   PROP_WAIT_ON_EOS,
   PROP_BUFFER_LIST,
+  PROP_CURRENT_LEVEL_BUFFERS,
   PROP_LAST
 };
 
@@ -245,6 +246,20 @@ gst_app_sink_class_init (GstAppSinkClass * klass)
           DEFAULT_PROP_WAIT_ON_EOS,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAppSink::current-level-buffers:
+   *
+   * The number of buffers currently queued inside appsink, waiting to be
+   * pulled by the application. Useful to find out whether the application
+   * keeps up with the stream without pulling a sample.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_BUFFERS,
+      g_param_spec_uint ("current-level-buffers", "Current Level Buffers",
+          "The number of currently queued buffers",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstAppSink::eos:
    * @appsink: the appsink element that emitted the signal
@@ -571,6 +586,10 @@ gst_app_sink_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_WAIT_ON_EOS:
       g_value_set_boolean (value, gst_app_sink_get_wait_on_eos (appsink));
       break;
+    case PROP_CURRENT_LEVEL_BUFFERS:
+      g_value_set_uint (value,
+          gst_app_sink_get_current_level_buffers (appsink));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -817,6 +836,29 @@ dequeue_buffer (GstAppSink * appsink)
   return obj;
 }
 
+/* must be called with the appsink mutex and a non-empty queue */
+static GstSample *
+dequeue_sample (GstAppSink * appsink)
+{
+  GstAppSinkPrivate *priv = appsink->priv;
+  GstMiniObject *obj;
+  GstSample *sample;
+
+  obj = dequeue_buffer (appsink);
+  if (GST_IS_BUFFER (obj)) {
+    GST_DEBUG_OBJECT (appsink, "we have a buffer %p", obj);
+    sample = gst_sample_new (GST_BUFFER_CAST (obj), priv->last_caps,
+        &priv->last_segment, NULL);
+  } else {
+    GST_DEBUG_OBJECT (appsink, "we have a list %p", obj);
+    sample = gst_sample_new (NULL, priv->last_caps, &priv->last_segment, NULL);
+    gst_sample_set_buffer_list (sample, GST_BUFFER_LIST_CAST (obj));
+  }
+  gst_mini_object_unref (obj);
+
+  return sample;
+}
+
 static GstFlowReturn
 gst_app_sink_render_common (GstBaseSink * psink, GstMiniObject * data,
     gboolean is_list)
@@ -1190,6 +1232,33 @@ gst_app_sink_get_max_buffers (GstAppSink * appsink)
   return result;
 }
 
+/**
+ * gst_app_sink_get_current_level_buffers:
+ * @appsink: a #GstAppSink
+ *
+ * Get the number of currently queued buffers inside @appsink.
+ *
+ * Returns: The number of currently queued buffers.
+ *
+ * Since: 1.14
+ */
+guint
+gst_app_sink_get_current_level_buffers (GstAppSink * appsink)
+{
+  guint result;
+  GstAppSinkPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SINK (appsink), 0);
+
+  priv = appsink->priv;
+
+  g_mutex_lock (&priv->mutex);
+  result = priv->num_buffers;
+  g_mutex_unlock (&priv->mutex);
+
+  return result;
+}
+
 /**
  * gst_app_sink_set_drop:
  * @appsink: a #GstAppSink
@@ -1532,7 +1601,6 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
 {
   GstAppSinkPrivate *priv;
   GstSample *sample = NULL;
-  GstMiniObject *obj;
   gboolean timeout_valid;
   gint64 end_time;
 
@@ -1569,17 +1637,7 @@ gst_app_sink_try_pull_sample (GstAppSink * appsink, GstClockTime timeout)
     }
   }
 
-  obj = dequeue_buffer (appsink);
-  if (GST_IS_BUFFER (obj)) {
-    GST_DEBUG_OBJECT (appsink, "we have a buffer %p", obj);
-    sample = gst_sample_new (GST_BUFFER_CAST (obj), priv->last_caps,
-        &priv->last_segment, NULL);
-  } else {
-    GST_DEBUG_OBJECT (appsink, "we have a list %p", obj);
-    sample = gst_sample_new (NULL, priv->last_caps, &priv->last_segment, NULL);
-    gst_sample_set_buffer_list (sample, GST_BUFFER_LIST_CAST (obj));
-  }
-  gst_mini_object_unref (obj);
+  sample = dequeue_sample (appsink);
 
   g_cond_signal (&priv->cond);
   g_mutex_unlock (&priv->mutex);
@@ -1607,6 +1665,107 @@ not_started:
   }
 }
 
+/**
+ * gst_app_sink_try_pull_samples:
+ * @appsink: a #GstAppSink
+ * @samples: (out caller-allocates) (array length=max_samples): an array to
+ *     store the pulled samples in
+ * @max_samples: the size of @samples
+ * @timeout: the maximum amount of time to wait for the first sample
+ *
+ * Like gst_app_sink_try_pull_sample(), but drains up to @max_samples queued
+ * samples with a single lock acquisition. This function waits at most
+ * @timeout for the first sample to become available and then takes whatever
+ * else is already queued without waiting again, which is considerably
+ * cheaper than pulling many small samples one by one.
+ *
+ * The samples are stored in @samples in the order they were rendered; call
+ * gst_sample_unref() on each of them after usage.
+ *
+ * If an EOS event was received before any buffers or the timeout expires,
+ * this function returns 0. Use gst_app_sink_is_eos () to check for the EOS
+ * condition.
+ *
+ * Returns: the number of samples stored in @samples, or 0 when the appsink
+ * is stopped or EOS or the timeout expires.
+ *
+ * Since: 1.14
+ */
+guint
+gst_app_sink_try_pull_samples (GstAppSink * appsink, GstSample ** samples,
+    guint max_samples, GstClockTime timeout)
+{
+  GstAppSinkPrivate *priv;
+  gboolean timeout_valid;
+  gint64 end_time;
+  guint n = 0;
+
+  g_return_val_if_fail (GST_IS_APP_SINK (appsink), 0);
+  g_return_val_if_fail (samples != NULL, 0);
+  g_return_val_if_fail (max_samples > 0, 0);
+
+  timeout_valid = GST_CLOCK_TIME_IS_VALID (timeout);
+
+  if (timeout_valid)
+    end_time =
+        g_get_monotonic_time () + timeout / (GST_SECOND / G_TIME_SPAN_SECOND);
+
+  priv = appsink->priv;
+
+  g_mutex_lock (&priv->mutex);
+
+  while (TRUE) {
+    GST_DEBUG_OBJECT (appsink, "trying to grab buffers");
+    if (!priv->started)
+      goto not_started;
+
+    if (priv->num_buffers > 0)
+      break;
+
+    if (priv->is_eos)
+      goto eos;
+
+    /* nothing to return, wait */
+    GST_DEBUG_OBJECT (appsink, "waiting for a buffer");
+    if (timeout_valid) {
+      if (!g_cond_wait_until (&priv->cond, &priv->mutex, end_time))
+        goto expired;
+    } else {
+      g_cond_wait (&priv->cond, &priv->mutex);
+    }
+  }
+
+  while (n < max_samples && priv->num_buffers > 0)
+    samples[n++] = dequeue_sample (appsink);
+
+  GST_DEBUG_OBJECT (appsink, "we have %u samples", n);
+
+  g_cond_signal (&priv->cond);
+  g_mutex_unlock (&priv->mutex);
+
+  return n;
+
+  /* special conditions */
+expired:
+  {
+    GST_DEBUG_OBJECT (appsink, "timeout expired, return 0");
+    g_mutex_unlock (&priv->mutex);
+    return 0;
+  }
+eos:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are EOS, return 0");
+    g_mutex_unlock (&priv->mutex);
+    return 0;
+  }
+not_started:
+  {
+    GST_DEBUG_OBJECT (appsink, "we are stopped, return 0");
+    g_mutex_unlock (&priv->mutex);
+    return 0;
+  }
+}
+
 /**
  * gst_app_sink_set_callbacks: (skip)
  * @appsink: a #GstAppSink
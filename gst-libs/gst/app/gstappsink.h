@@ -125,6 +125,9 @@ void            gst_app_sink_set_max_buffers  (GstAppSink *appsink, guint max);
 GST_EXPORT
 guint           gst_app_sink_get_max_buffers  (GstAppSink *appsink);
 
+GST_EXPORT
+guint           gst_app_sink_get_current_level_buffers (GstAppSink *appsink);
+
 GST_EXPORT
 void            gst_app_sink_set_drop         (GstAppSink *appsink, gboolean drop);
 
@@ -155,6 +158,12 @@ GstSample *     gst_app_sink_try_pull_preroll (GstAppSink *appsink, GstClockTime
 GST_EXPORT
 GstSample *     gst_app_sink_try_pull_sample  (GstAppSink *appsink, GstClockTime timeout);
 
+GST_EXPORT
+guint           gst_app_sink_try_pull_samples (GstAppSink *appsink,
+                                               GstSample **samples,
+                                               guint max_samples,
+                                               GstClockTime timeout);
+
 GST_EXPORT
 void            gst_app_sink_set_callbacks    (GstAppSink * appsink,
                                                GstAppSinkCallbacks *callbacks,
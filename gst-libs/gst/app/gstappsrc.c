@@ -44,7 +44,9 @@
  * gst_app_src_push_buffer() method or by emitting the push-buffer action signal.
  * This will put the buffer onto a queue from which appsrc will read from in its
  * streaming thread. It is important to note that data transport will not happen
- * from the thread that performed the push-buffer call.
+ * from the thread that performed the push-buffer call. Applications that
+ * produce many small buffers at once can queue them all with a single
+ * gst_app_src_push_buffer_list() call instead.
  *
  * The "max-bytes" property controls how much data can be queued in appsrc
  * before appsrc considers the queue full. A filled internal queue will always
@@ -121,7 +123,12 @@ struct _GstAppSrcPrivate
   gboolean flushing;
   gboolean started;
   gboolean is_eos;
+  /* TRUE after enough-data was signalled; re-armed when the queue drains
+   * below min-percent (or runs empty), so the signal fires at most once
+   * per crossing of the high watermark */
+  gboolean enough_data_emitted;
   guint64 queued_bytes;
+  guint64 queued_buffers;
   guint64 offset;
   GstAppStreamType current_type;
 
@@ -149,6 +156,7 @@ enum
   SIGNAL_PUSH_BUFFER,
   SIGNAL_END_OF_STREAM,
   SIGNAL_PUSH_SAMPLE,
+  SIGNAL_PUSH_BUFFER_LIST,
 
   LAST_SIGNAL
 };
@@ -164,6 +172,7 @@ enum
 #define DEFAULT_PROP_EMIT_SIGNALS  TRUE
 #define DEFAULT_PROP_MIN_PERCENT   0
 #define DEFAULT_PROP_CURRENT_LEVEL_BYTES   0
+#define DEFAULT_PROP_CURRENT_LEVEL_BUFFERS 0
 #define DEFAULT_PROP_DURATION      GST_CLOCK_TIME_NONE
 
 enum
@@ -181,6 +190,7 @@ enum
   PROP_EMIT_SIGNALS,
   PROP_MIN_PERCENT,
   PROP_CURRENT_LEVEL_BYTES,
+  PROP_CURRENT_LEVEL_BUFFERS,
   PROP_DURATION,
   PROP_LAST
 };
@@ -224,6 +234,8 @@ static gboolean gst_app_src_event (GstBaseSrc * src, GstEvent * event);
 
 static GstFlowReturn gst_app_src_push_buffer_action (GstAppSrc * appsrc,
     GstBuffer * buffer);
+static GstFlowReturn gst_app_src_push_buffer_list_action (GstAppSrc * appsrc,
+    GstBufferList * buffer_list);
 static GstFlowReturn gst_app_src_push_sample_action (GstAppSrc * appsrc,
     GstSample * sample);
 
@@ -385,6 +397,19 @@ gst_app_src_class_init (GstAppSrcClass * klass)
           0, G_MAXUINT64, DEFAULT_PROP_CURRENT_LEVEL_BYTES,
           G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAppSrc::current-level-buffers:
+   *
+   * The number of currently queued buffers and buffer lists inside appsrc.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_CURRENT_LEVEL_BUFFERS,
+      g_param_spec_uint64 ("current-level-buffers", "Current Level Buffers",
+          "The number of currently queued buffers",
+          0, G_MAXUINT64, DEFAULT_PROP_CURRENT_LEVEL_BUFFERS,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstAppSrc::duration:
    *
@@ -465,6 +490,27 @@ gst_app_src_class_init (GstAppSrcClass * klass)
           push_buffer), NULL, NULL, NULL,
       GST_TYPE_FLOW_RETURN, 1, GST_TYPE_BUFFER);
 
+   /**
+    * GstAppSrc::push-buffer-list:
+    * @appsrc: the appsrc
+    * @buffer_list: a buffer list to push
+    *
+    * Adds a buffer list to the queue of buffers and buffer lists that the
+    * appsrc element will push to its source pad. This function does not take
+    * ownership of the buffer list so the buffer list needs to be unreffed
+    * after calling this function.
+    *
+    * When the block property is TRUE, this function can block until free space
+    * becomes available in the queue.
+    *
+    * Since: 1.14
+    */
+  gst_app_src_signals[SIGNAL_PUSH_BUFFER_LIST] =
+      g_signal_new ("push-buffer-list", G_TYPE_FROM_CLASS (klass),
+      G_SIGNAL_RUN_LAST | G_SIGNAL_ACTION, G_STRUCT_OFFSET (GstAppSrcClass,
+          push_buffer_list), NULL, NULL, NULL,
+      GST_TYPE_FLOW_RETURN, 1, GST_TYPE_BUFFER_LIST);
+
   /**
     * GstAppSrc::push-sample:
     * @appsrc: the appsrc
@@ -527,6 +573,7 @@ gst_app_src_class_init (GstAppSrcClass * klass)
   basesrc_class->event = gst_app_src_event;
 
   klass->push_buffer = gst_app_src_push_buffer_action;
+  klass->push_buffer_list = gst_app_src_push_buffer_list_action;
   klass->push_sample = gst_app_src_push_sample_action;
   klass->end_of_stream = gst_app_src_end_of_stream;
 
@@ -582,6 +629,8 @@ gst_app_src_flush_queued (GstAppSrc * src, gboolean retain_last_caps)
   }
 
   priv->queued_bytes = 0;
+  priv->queued_buffers = 0;
+  priv->enough_data_emitted = FALSE;
 }
 
 static void
@@ -762,6 +811,10 @@ gst_app_src_get_property (GObject * object, guint prop_id, GValue * value,
     case PROP_CURRENT_LEVEL_BYTES:
       g_value_set_uint64 (value, gst_app_src_get_current_level_bytes (appsrc));
       break;
+    case PROP_CURRENT_LEVEL_BUFFERS:
+      g_value_set_uint64 (value,
+          gst_app_src_get_current_level_buffers (appsrc));
+      break;
     case PROP_DURATION:
       g_value_set_uint64 (value, gst_app_src_get_duration (appsrc));
       break;
@@ -1146,9 +1199,10 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
     /* return data as long as we have some */
     if (!g_queue_is_empty (priv->queue)) {
       guint buf_size;
+      guint64 prev_queued_bytes;
       GstMiniObject *obj = g_queue_pop_head (priv->queue);
 
-      if (!GST_IS_BUFFER (obj)) {
+      if (GST_IS_CAPS (obj)) {
         GstCaps *next_caps = GST_CAPS (obj);
         gboolean caps_changed = TRUE;
 
@@ -1177,12 +1231,33 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
         continue;
       }
 
-      *buf = GST_BUFFER (obj);
-      buf_size = gst_buffer_get_size (*buf);
+      if (GST_IS_BUFFER (obj)) {
+        *buf = GST_BUFFER (obj);
+        buf_size = gst_buffer_get_size (*buf);
+
+        GST_DEBUG_OBJECT (appsrc, "we have buffer %p of size %u", *buf,
+            buf_size);
+      } else {
+        GstBufferList *buffer_list;
+
+        g_assert (GST_IS_BUFFER_LIST (obj));
 
-      GST_DEBUG_OBJECT (appsrc, "we have buffer %p of size %u", *buf, buf_size);
+        buffer_list = GST_BUFFER_LIST (obj);
+        buf_size = gst_buffer_list_calculate_size (buffer_list);
 
+        GST_DEBUG_OBJECT (appsrc, "we have buffer list %p of size %u",
+            buffer_list, buf_size);
+
+        /* basesrc takes ownership of the list and pushes the buffers
+         * downstream one after the other without going through create()
+         * again */
+        gst_base_src_submit_buffer_list (bsrc, buffer_list);
+        *buf = NULL;
+      }
+
+      prev_queued_bytes = priv->queued_bytes;
       priv->queued_bytes -= buf_size;
+      priv->queued_buffers--;
 
       /* only update the offset when in random_access mode */
       if (priv->stream_type == GST_APP_STREAM_TYPE_RANDOM_ACCESS)
@@ -1191,16 +1266,22 @@ gst_app_src_create (GstBaseSrc * bsrc, guint64 offset, guint size,
       /* signal that we removed an item */
       g_cond_broadcast (&priv->cond);
 
-      /* see if we go lower than the empty-percent */
+      /* see if we crossed the empty-percent watermark; only signal on the
+       * crossing so that popping more buffers while already below does not
+       * spam the application with need-data */
       if (priv->min_percent && priv->max_bytes) {
-        if (priv->queued_bytes * 100 / priv->max_bytes <= priv->min_percent)
+        if (priv->queued_bytes * 100 / priv->max_bytes <= priv->min_percent &&
+            prev_queued_bytes * 100 / priv->max_bytes > priv->min_percent) {
           /* ignore flushing state, we got a buffer and we will return it now.
            * Errors will be handled in the next round */
+          priv->enough_data_emitted = FALSE;
           gst_app_src_emit_need_data (appsrc, size);
+        }
       }
       ret = GST_FLOW_OK;
       break;
     } else {
+      priv->enough_data_emitted = FALSE;
       gst_app_src_emit_need_data (appsrc, size);
 
       /* we can be flushing now because we released the lock above */
@@ -1562,6 +1643,36 @@ gst_app_src_get_current_level_bytes (GstAppSrc * appsrc)
   return queued;
 }
 
+/**
+ * gst_app_src_get_current_level_buffers:
+ * @appsrc: a #GstAppSrc
+ *
+ * Get the number of currently queued buffers and buffer lists inside
+ * @appsrc.
+ *
+ * Returns: The number of currently queued buffers.
+ *
+ * Since: 1.14
+ */
+guint64
+gst_app_src_get_current_level_buffers (GstAppSrc * appsrc)
+{
+  gint64 queued;
+  GstAppSrcPrivate *priv;
+
+  g_return_val_if_fail (GST_IS_APP_SRC (appsrc), -1);
+
+  priv = appsrc->priv;
+
+  GST_OBJECT_LOCK (appsrc);
+  queued = priv->queued_buffers;
+  GST_DEBUG_OBJECT (appsrc, "current level buffers is %" G_GUINT64_FORMAT,
+      queued);
+  GST_OBJECT_UNLOCK (appsrc);
+
+  return queued;
+}
+
 static void
 gst_app_src_set_latencies (GstAppSrc * appsrc, gboolean do_min, guint64 min,
     gboolean do_max, guint64 max)
@@ -1677,17 +1788,28 @@ gst_app_src_get_emit_signals (GstAppSrc * appsrc)
 }
 
 static GstFlowReturn
-gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
-    gboolean steal_ref)
+gst_app_src_push_internal (GstAppSrc * appsrc, GstBuffer * buffer,
+    GstBufferList * buflist, gboolean steal_ref)
 {
   gboolean first = TRUE;
   GstAppSrcPrivate *priv;
 
   g_return_val_if_fail (GST_IS_APP_SRC (appsrc), GST_FLOW_ERROR);
-  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
 
   priv = appsrc->priv;
 
+  g_assert ((buffer && !buflist) || (!buffer && buflist));
+
+  if (buflist != NULL) {
+    if (gst_buffer_list_length (buflist) == 0) {
+      if (steal_ref)
+        gst_buffer_list_unref (buflist);
+      return GST_FLOW_OK;
+    }
+
+    buffer = gst_buffer_list_get (buflist, 0);
+  }
+
   if (GST_BUFFER_DTS (buffer) == GST_CLOCK_TIME_NONE &&
       GST_BUFFER_PTS (buffer) == GST_CLOCK_TIME_NONE &&
       gst_base_src_get_do_timestamp (GST_BASE_SRC_CAST (appsrc))) {
@@ -1706,13 +1828,36 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
         now = 0;
       gst_object_unref (clock);
 
-      if (!steal_ref)
-        buffer = gst_buffer_copy (buffer);
-      else
-        buffer = gst_buffer_make_writable (buffer);
+      if (buflist == NULL) {
+        if (!steal_ref)
+          buffer = gst_buffer_copy (buffer);
+        else
+          buffer = gst_buffer_make_writable (buffer);
+
+        GST_BUFFER_PTS (buffer) = now;
+        GST_BUFFER_DTS (buffer) = now;
+      } else {
+        guint i, len;
 
-      GST_BUFFER_PTS (buffer) = now;
-      GST_BUFFER_DTS (buffer) = now;
+        if (!steal_ref)
+          buflist = gst_buffer_list_copy (buflist);
+        else
+          buflist = gst_buffer_list_make_writable (buflist);
+
+        /* one clock read for the whole list; stamp every buffer that was
+         * provided without timestamps */
+        len = gst_buffer_list_length (buflist);
+        for (i = 0; i < len; i++) {
+          buffer = gst_buffer_list_get (buflist, i);
+          if (GST_BUFFER_DTS (buffer) != GST_CLOCK_TIME_NONE ||
+              GST_BUFFER_PTS (buffer) != GST_CLOCK_TIME_NONE)
+            continue;
+
+          buffer = gst_buffer_list_get_writable (buflist, i);
+          GST_BUFFER_PTS (buffer) = now;
+          GST_BUFFER_DTS (buffer) = now;
+        }
+      }
       steal_ref = TRUE;
     } else {
       GST_WARNING_OBJECT (appsrc,
@@ -1737,11 +1882,14 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
           "queue filled (%" G_GUINT64_FORMAT " >= %" G_GUINT64_FORMAT ")",
           priv->queued_bytes, priv->max_bytes);
 
-      if (first) {
+      if (first && !priv->enough_data_emitted) {
         gboolean emit;
 
         emit = priv->emit_signals;
-        /* only signal on the first push */
+        /* only signal once per crossing of the high watermark; the flag is
+         * re-armed in create() when the queue drains below min-percent or
+         * runs empty */
+        priv->enough_data_emitted = TRUE;
         g_mutex_unlock (&priv->mutex);
 
         if (priv->callbacks.enough_data)
@@ -1770,11 +1918,21 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
       break;
   }
 
-  GST_DEBUG_OBJECT (appsrc, "queueing buffer %p", buffer);
-  if (!steal_ref)
-    gst_buffer_ref (buffer);
-  g_queue_push_tail (priv->queue, buffer);
-  priv->queued_bytes += gst_buffer_get_size (buffer);
+  if (buflist != NULL) {
+    GST_DEBUG_OBJECT (appsrc, "queueing buffer list %p", buflist);
+    if (!steal_ref)
+      gst_buffer_list_ref (buflist);
+    g_queue_push_tail (priv->queue, buflist);
+    priv->queued_bytes += gst_buffer_list_calculate_size (buflist);
+    priv->queued_buffers++;
+  } else {
+    GST_DEBUG_OBJECT (appsrc, "queueing buffer %p", buffer);
+    if (!steal_ref)
+      gst_buffer_ref (buffer);
+    g_queue_push_tail (priv->queue, buffer);
+    priv->queued_bytes += gst_buffer_get_size (buffer);
+    priv->queued_buffers++;
+  }
   g_cond_broadcast (&priv->cond);
   g_mutex_unlock (&priv->mutex);
 
@@ -1784,21 +1942,47 @@ gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
 flushing:
   {
     GST_DEBUG_OBJECT (appsrc, "refuse buffer %p, we are flushing", buffer);
-    if (steal_ref)
-      gst_buffer_unref (buffer);
+    if (steal_ref) {
+      if (buflist)
+        gst_buffer_list_unref (buflist);
+      else
+        gst_buffer_unref (buffer);
+    }
     g_mutex_unlock (&priv->mutex);
     return GST_FLOW_FLUSHING;
   }
 eos:
   {
     GST_DEBUG_OBJECT (appsrc, "refuse buffer %p, we are EOS", buffer);
-    if (steal_ref)
-      gst_buffer_unref (buffer);
+    if (steal_ref) {
+      if (buflist)
+        gst_buffer_list_unref (buflist);
+      else
+        gst_buffer_unref (buffer);
+    }
     g_mutex_unlock (&priv->mutex);
     return GST_FLOW_EOS;
   }
 }
 
+static GstFlowReturn
+gst_app_src_push_buffer_full (GstAppSrc * appsrc, GstBuffer * buffer,
+    gboolean steal_ref)
+{
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), GST_FLOW_ERROR);
+
+  return gst_app_src_push_internal (appsrc, buffer, NULL, steal_ref);
+}
+
+static GstFlowReturn
+gst_app_src_push_buffer_list_full (GstAppSrc * appsrc,
+    GstBufferList * buffer_list, gboolean steal_ref)
+{
+  g_return_val_if_fail (GST_IS_BUFFER_LIST (buffer_list), GST_FLOW_ERROR);
+
+  return gst_app_src_push_internal (appsrc, NULL, buffer_list, steal_ref);
+}
+
 static GstFlowReturn
 gst_app_src_push_sample_internal (GstAppSrc * appsrc, GstSample * sample)
 {
@@ -1844,6 +2028,38 @@ gst_app_src_push_buffer (GstAppSrc * appsrc, GstBuffer * buffer)
   return gst_app_src_push_buffer_full (appsrc, buffer, TRUE);
 }
 
+/**
+ * gst_app_src_push_buffer_list:
+ * @appsrc: a #GstAppSrc
+ * @buffer_list: (transfer full): a #GstBufferList to push
+ *
+ * Adds a buffer list to the queue of buffers and buffer lists that the
+ * appsrc element will push to its source pad.  This function takes ownership
+ * of @buffer_list.
+ *
+ * Compared to pushing the buffers one by one with gst_app_src_push_buffer(),
+ * this queues the whole list with a single lock round-trip and the buffers
+ * will be pushed downstream as a list as well, which is considerably cheaper
+ * when feeding many small buffers such as network packets.
+ *
+ * When the do-timestamp property is TRUE, all buffers in the list that were
+ * provided without timestamps are stamped from a single clock read.
+ *
+ * When the block property is TRUE, this function can block until free
+ * space becomes available in the queue.
+ *
+ * Returns: #GST_FLOW_OK when the buffer list was successfuly queued.
+ * #GST_FLOW_FLUSHING when @appsrc is not PAUSED or PLAYING.
+ * #GST_FLOW_EOS when EOS occured.
+ *
+ * Since: 1.14
+ */
+GstFlowReturn
+gst_app_src_push_buffer_list (GstAppSrc * appsrc, GstBufferList * buffer_list)
+{
+  return gst_app_src_push_buffer_list_full (appsrc, buffer_list, TRUE);
+}
+
 /**
  * gst_app_src_push_sample:
  * @appsrc: a #GstAppSrc
@@ -1879,6 +2095,15 @@ gst_app_src_push_buffer_action (GstAppSrc * appsrc, GstBuffer * buffer)
   return gst_app_src_push_buffer_full (appsrc, buffer, FALSE);
 }
 
+/* push a buffer list without stealing the ref of the buffer list. This is
+ * used for the action signal. */
+static GstFlowReturn
+gst_app_src_push_buffer_list_action (GstAppSrc * appsrc,
+    GstBufferList * buffer_list)
+{
+  return gst_app_src_push_buffer_list_full (appsrc, buffer_list, FALSE);
+}
+
 /* push a sample without stealing the ref. This is used for the
  * action signal. */
 static GstFlowReturn
@@ -76,6 +76,13 @@ struct _GstAudioChannelMixer
    * this is matrix * (2^10) as integers */
   gint **matrix_int;
 
+  /* sparse form of the matrix: for each output channel the list of input
+   * channels with a non-zero coefficient. Only used when a good part of
+   * the matrix is zeros, as is typical for up/downmix matrices. */
+  gboolean sparse;
+  gint *sparse_n;
+  gint **sparse_idx;
+
   MixerFunc func;
 
   gpointer tmp;
@@ -103,6 +110,13 @@ gst_audio_channel_mixer_free (GstAudioChannelMixer * mix)
   g_free (mix->matrix_int);
   mix->matrix_int = NULL;
 
+  for (i = 0; i < mix->out_channels; i++)
+    g_free (mix->sparse_idx[i]);
+  g_free (mix->sparse_idx);
+  mix->sparse_idx = NULL;
+  g_free (mix->sparse_n);
+  mix->sparse_n = NULL;
+
   g_free (mix->tmp);
   mix->tmp = NULL;
 
@@ -664,6 +678,36 @@ gst_audio_channel_mixer_setup_matrix_int (GstAudioChannelMixer * mix)
   }
 }
 
+/* Compile the sparse form of the matrix. Typical up/downmix matrices are
+ * mostly zeros, walking only the non-zero coefficients per output channel
+ * saves most of the inner loop work. Only call after mix->matrix and
+ * mix->matrix_int are fully set up. */
+static void
+gst_audio_channel_mixer_setup_sparse (GstAudioChannelMixer * mix)
+{
+  gint i, j, n_zero = 0;
+
+  mix->sparse_n = g_new0 (gint, mix->out_channels);
+  mix->sparse_idx = g_new0 (gint *, mix->out_channels);
+
+  for (j = 0; j < mix->out_channels; j++) {
+    mix->sparse_idx[j] = g_new (gint, mix->in_channels);
+    for (i = 0; i < mix->in_channels; i++) {
+      if (mix->matrix[i][j] != 0.0 || mix->matrix_int[i][j] != 0)
+        mix->sparse_idx[j][mix->sparse_n[j]++] = i;
+      else
+        n_zero++;
+    }
+  }
+
+  /* only worth the extra indirection when we skip at least half of the
+   * coefficients */
+  mix->sparse = (2 * n_zero >= mix->in_channels * mix->out_channels);
+
+  GST_DEBUG ("%d of %d coefficients are zero, %susing sparse mixing",
+      n_zero, mix->in_channels * mix->out_channels, mix->sparse ? "" : "not ");
+}
+
 static void
 gst_audio_channel_mixer_setup_matrix (GstAudioChannelMixer * mix)
 {
@@ -684,6 +728,8 @@ gst_audio_channel_mixer_setup_matrix (GstAudioChannelMixer * mix)
 
   gst_audio_channel_mixer_setup_matrix_int (mix);
 
+  gst_audio_channel_mixer_setup_sparse (mix);
+
 #ifndef GST_DISABLE_GST_DEBUG
   /* debug */
   {
@@ -806,6 +852,113 @@ gst_audio_channel_mixer_mix_double (GstAudioChannelMixer * mix,
   }
 }
 
+/* Sparse variants of the above, walking only the non-zero coefficients
+ * of each output channel */
+
+static void
+gst_audio_channel_mixer_mix_int16_sparse (GstAudioChannelMixer * mix,
+    const gint16 * in_data, gint16 * out_data, gint samples)
+{
+  gint in, out, n, k;
+  gint32 res;
+  gint inchannels, outchannels;
+
+  inchannels = mix->in_channels;
+  outchannels = mix->out_channels;
+
+  for (n = 0; n < samples; n++) {
+    for (out = 0; out < outchannels; out++) {
+      /* convert */
+      res = 0;
+      for (k = 0; k < mix->sparse_n[out]; k++) {
+        in = mix->sparse_idx[out][k];
+        res += in_data[n * inchannels + in] * mix->matrix_int[in][out];
+      }
+
+      /* remove factor from int matrix */
+      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+      out_data[n * outchannels + out] = CLAMP (res, G_MININT16, G_MAXINT16);
+    }
+  }
+}
+
+static void
+gst_audio_channel_mixer_mix_int32_sparse (GstAudioChannelMixer * mix,
+    const gint32 * in_data, gint32 * out_data, gint samples)
+{
+  gint in, out, n, k;
+  gint64 res;
+  gint inchannels, outchannels;
+
+  inchannels = mix->in_channels;
+  outchannels = mix->out_channels;
+
+  for (n = 0; n < samples; n++) {
+    for (out = 0; out < outchannels; out++) {
+      /* convert */
+      res = 0;
+      for (k = 0; k < mix->sparse_n[out]; k++) {
+        in = mix->sparse_idx[out][k];
+        res += in_data[n * inchannels + in] * (gint64) mix->matrix_int[in][out];
+      }
+
+      /* remove factor from int matrix */
+      res = (res + (1 << (PRECISION_INT - 1))) >> PRECISION_INT;
+      out_data[n * outchannels + out] = CLAMP (res, G_MININT32, G_MAXINT32);
+    }
+  }
+}
+
+static void
+gst_audio_channel_mixer_mix_float_sparse (GstAudioChannelMixer * mix,
+    const gfloat * in_data, gfloat * out_data, gint samples)
+{
+  gint in, out, n, k;
+  gfloat res;
+  gint inchannels, outchannels;
+
+  inchannels = mix->in_channels;
+  outchannels = mix->out_channels;
+
+  for (n = 0; n < samples; n++) {
+    for (out = 0; out < outchannels; out++) {
+      /* convert */
+      res = 0.0;
+      for (k = 0; k < mix->sparse_n[out]; k++) {
+        in = mix->sparse_idx[out][k];
+        res += in_data[n * inchannels + in] * mix->matrix[in][out];
+      }
+
+      out_data[n * outchannels + out] = res;
+    }
+  }
+}
+
+static void
+gst_audio_channel_mixer_mix_double_sparse (GstAudioChannelMixer * mix,
+    const gdouble * in_data, gdouble * out_data, gint samples)
+{
+  gint in, out, n, k;
+  gdouble res;
+  gint inchannels, outchannels;
+
+  inchannels = mix->in_channels;
+  outchannels = mix->out_channels;
+
+  for (n = 0; n < samples; n++) {
+    for (out = 0; out < outchannels; out++) {
+      /* convert */
+      res = 0.0;
+      for (k = 0; k < mix->sparse_n[out]; k++) {
+        in = mix->sparse_idx[out][k];
+        res += in_data[n * inchannels + in] * mix->matrix[in][out];
+      }
+
+      out_data[n * outchannels + out] = res;
+    }
+  }
+}
+
 /**
  * gst_audio_channel_mixer_new: (skip):
  * @flags: #GstAudioChannelMixerFlags
@@ -851,16 +1004,24 @@ gst_audio_channel_mixer_new (GstAudioChannelMixerFlags flags,
 
   switch (mix->format) {
     case GST_AUDIO_FORMAT_S16:
-      mix->func = (MixerFunc) gst_audio_channel_mixer_mix_int16;
+      mix->func = mix->sparse ?
+          (MixerFunc) gst_audio_channel_mixer_mix_int16_sparse :
+          (MixerFunc) gst_audio_channel_mixer_mix_int16;
       break;
     case GST_AUDIO_FORMAT_S32:
-      mix->func = (MixerFunc) gst_audio_channel_mixer_mix_int32;
+      mix->func = mix->sparse ?
+          (MixerFunc) gst_audio_channel_mixer_mix_int32_sparse :
+          (MixerFunc) gst_audio_channel_mixer_mix_int32;
       break;
     case GST_AUDIO_FORMAT_F32:
-      mix->func = (MixerFunc) gst_audio_channel_mixer_mix_float;
+      mix->func = mix->sparse ?
+          (MixerFunc) gst_audio_channel_mixer_mix_float_sparse :
+          (MixerFunc) gst_audio_channel_mixer_mix_float;
       break;
     case GST_AUDIO_FORMAT_F64:
-      mix->func = (MixerFunc) gst_audio_channel_mixer_mix_double;
+      mix->func = mix->sparse ?
+          (MixerFunc) gst_audio_channel_mixer_mix_double_sparse :
+          (MixerFunc) gst_audio_channel_mixer_mix_double;
       break;
     default:
       g_assert_not_reached ();
@@ -182,6 +182,103 @@ check_valid_channel_positions (const GstAudioChannelPosition * position,
   return TRUE;
 }
 
+/* apply @reorder_map to the @n frames in @ptr, with typed loops for the
+ * common sample sizes; the generic case moves samples byte-wise and is
+ * considerably slower since the compiler cannot vectorize it */
+static void
+audio_reorder_frames (guint8 * ptr, gint n, gint bps, gint channels,
+    const gint * reorder_map)
+{
+  guint8 tmp[64 * 8];
+  gint bpf = bps * channels;
+  gint i, j;
+
+  switch (bps) {
+    case 2:
+      for (i = 0; i < n; i++) {
+        memcpy (tmp, ptr, bpf);
+        for (j = 0; j < channels; j++)
+          ((guint16 *) ptr)[reorder_map[j]] = ((guint16 *) tmp)[j];
+        ptr += bpf;
+      }
+      break;
+    case 4:
+      for (i = 0; i < n; i++) {
+        memcpy (tmp, ptr, bpf);
+        for (j = 0; j < channels; j++)
+          ((guint32 *) ptr)[reorder_map[j]] = ((guint32 *) tmp)[j];
+        ptr += bpf;
+      }
+      break;
+    case 8:
+      for (i = 0; i < n; i++) {
+        memcpy (tmp, ptr, bpf);
+        for (j = 0; j < channels; j++)
+          ((guint64 *) ptr)[reorder_map[j]] = ((guint64 *) tmp)[j];
+        ptr += bpf;
+      }
+      break;
+    default:
+      for (i = 0; i < n; i++) {
+        memcpy (tmp, ptr, bpf);
+        for (j = 0; j < channels; j++)
+          memcpy (ptr + reorder_map[j] * bps, tmp + j * bps, bps);
+        ptr += bpf;
+      }
+      break;
+  }
+}
+
+/**
+ * gst_audio_reorder_channels_with_reorder_map:
+ * @data: (array length=size) (element-type guint8): The pointer to
+ *   the memory.
+ * @size: The size of the memory.
+ * @format: The %GstAudioFormat of the buffer.
+ * @channels: The number of channels.
+ * @reorder_map: (array): The channel reorder map.
+ *
+ * Reorders @data with a reorder map obtained earlier with
+ * gst_audio_get_channel_reorder_map(), assigning channel i of the input
+ * to channel reorder_map[i] of the output. Unlike
+ * gst_audio_reorder_channels() nothing is recomputed per call, so use
+ * this function when the same reordering is applied to every buffer of
+ * a stream.
+ *
+ * Returns: %TRUE if the reordering was possible.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_audio_reorder_channels_with_reorder_map (gpointer data, gsize size,
+    GstAudioFormat format, gint channels, const gint * reorder_map)
+{
+  const GstAudioFormatInfo *info;
+  gint i, bps;
+
+  info = gst_audio_format_get_info (format);
+
+  g_return_val_if_fail (data != NULL, FALSE);
+  g_return_val_if_fail (reorder_map != NULL, FALSE);
+  g_return_val_if_fail (info != NULL && info->width > 0, FALSE);
+  g_return_val_if_fail (channels > 0, FALSE);
+  g_return_val_if_fail (channels <= 64, FALSE);
+  g_return_val_if_fail (size % ((info->width * channels) / 8) == 0, FALSE);
+
+  for (i = 0; i < channels; i++)
+    g_return_val_if_fail (reorder_map[i] >= 0
+        && reorder_map[i] < channels, FALSE);
+
+  if (size == 0)
+    return TRUE;
+
+  bps = info->width / 8;
+  audio_reorder_frames (data, size / (bps * channels), bps, channels,
+      reorder_map);
+
+  return TRUE;
+}
+
 /**
  * gst_audio_reorder_channels:
  * @data: (array length=size) (element-type guint8): The pointer to
@@ -204,11 +301,8 @@ gst_audio_reorder_channels (gpointer data, gsize size, GstAudioFormat format,
     const GstAudioChannelPosition * to)
 {
   const GstAudioFormatInfo *info;
-  gint i, j, n;
   gint reorder_map[64] = { 0, };
-  guint8 *ptr;
-  gint bpf, bps;
-  guint8 tmp[64 * 8];
+  gint bps;
 
   info = gst_audio_format_get_info (format);
 
@@ -232,18 +326,8 @@ gst_audio_reorder_channels (gpointer data, gsize size, GstAudioFormat format,
     return FALSE;
 
   bps = info->width / 8;
-  bpf = bps * channels;
-  ptr = data;
-
-  n = size / bpf;
-  for (i = 0; i < n; i++) {
-
-    memcpy (tmp, ptr, bpf);
-    for (j = 0; j < channels; j++)
-      memcpy (ptr + reorder_map[j] * bps, tmp + j * bps, bps);
-
-    ptr += bpf;
-  }
+  audio_reorder_frames (data, size / (bps * channels), bps, channels,
+      reorder_map);
 
   return TRUE;
 }
@@ -145,6 +145,12 @@ gboolean       gst_audio_reorder_channels        (gpointer data, gsize size,
                                                   const GstAudioChannelPosition * from,
                                                   const GstAudioChannelPosition * to);
 
+GST_EXPORT
+gboolean       gst_audio_reorder_channels_with_reorder_map (gpointer data, gsize size,
+                                                  GstAudioFormat format,
+                                                  gint channels,
+                                                  const gint * reorder_map);
+
 GST_EXPORT
 gboolean       gst_audio_channel_positions_to_valid_order (GstAudioChannelPosition *position,
                                                            gint channels);
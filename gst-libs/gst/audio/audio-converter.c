@@ -68,6 +68,183 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
+typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
+
+typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
+typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
+
+struct _GstParallelizedTaskThread
+{
+  GstParallelizedTaskRunner *runner;
+  guint idx;
+  GThread *thread;
+};
+
+struct _GstParallelizedTaskRunner
+{
+  guint n_threads;
+
+  GstParallelizedTaskThread *threads;
+
+  GstParallelizedTaskFunc func;
+  gpointer *task_data;
+
+  GMutex lock;
+  GCond cond_todo, cond_done;
+  gint n_todo, n_done;
+  gboolean quit;
+};
+
+static gpointer
+gst_parallelized_task_thread_func (gpointer data)
+{
+  GstParallelizedTaskThread *self = data;
+
+  g_mutex_lock (&self->runner->lock);
+  self->runner->n_done++;
+  if (self->runner->n_done == self->runner->n_threads - 1)
+    g_cond_signal (&self->runner->cond_done);
+
+  do {
+    gint idx;
+
+    while (self->runner->n_todo == -1 && !self->runner->quit)
+      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
+
+    if (self->runner->quit)
+      break;
+
+    idx = self->runner->n_todo--;
+    g_assert (self->runner->n_todo >= -1);
+    g_mutex_unlock (&self->runner->lock);
+
+    g_assert (self->runner->func != NULL);
+
+    self->runner->func (self->runner->task_data[idx]);
+
+    g_mutex_lock (&self->runner->lock);
+    self->runner->n_done++;
+    if (self->runner->n_done == self->runner->n_threads - 1)
+      g_cond_signal (&self->runner->cond_done);
+  } while (TRUE);
+
+  g_mutex_unlock (&self->runner->lock);
+
+  return NULL;
+}
+
+static void
+gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
+{
+  guint i;
+
+  g_mutex_lock (&self->lock);
+  self->quit = TRUE;
+  g_cond_broadcast (&self->cond_todo);
+  g_mutex_unlock (&self->lock);
+
+  for (i = 1; i < self->n_threads; i++) {
+    if (!self->threads[i].thread)
+      continue;
+
+    g_thread_join (self->threads[i].thread);
+  }
+
+  g_mutex_clear (&self->lock);
+  g_cond_clear (&self->cond_todo);
+  g_cond_clear (&self->cond_done);
+  g_free (self->threads);
+  g_free (self);
+}
+
+static GstParallelizedTaskRunner *
+gst_parallelized_task_runner_new (guint n_threads)
+{
+  GstParallelizedTaskRunner *self;
+  guint i;
+  GError *err = NULL;
+
+  if (n_threads == 0)
+    n_threads = g_get_num_processors ();
+
+  self = g_new0 (GstParallelizedTaskRunner, 1);
+  self->n_threads = n_threads;
+  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
+
+  self->quit = FALSE;
+  self->n_todo = -1;
+  self->n_done = 0;
+  g_mutex_init (&self->lock);
+  g_cond_init (&self->cond_todo);
+  g_cond_init (&self->cond_done);
+
+  /* Set when scheduling a job */
+  self->func = NULL;
+  self->task_data = NULL;
+
+  for (i = 0; i < n_threads; i++) {
+    self->threads[i].runner = self;
+    self->threads[i].idx = i;
+
+    /* First thread is the one calling run() */
+    if (i > 0) {
+      self->threads[i].thread =
+          g_thread_try_new ("audioconvert", gst_parallelized_task_thread_func,
+          &self->threads[i], &err);
+      if (!self->threads[i].thread)
+        goto error;
+    }
+  }
+
+  g_mutex_lock (&self->lock);
+  while (self->n_done < self->n_threads - 1)
+    g_cond_wait (&self->cond_done, &self->lock);
+  self->n_done = 0;
+  g_mutex_unlock (&self->lock);
+
+  return self;
+
+error:
+  {
+    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
+    g_clear_error (&err);
+
+    gst_parallelized_task_runner_free (self);
+    return NULL;
+  }
+}
+
+static void
+gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
+    GstParallelizedTaskFunc func, gpointer * task_data)
+{
+  guint n_threads = self->n_threads;
+
+  self->func = func;
+  self->task_data = task_data;
+
+  if (n_threads > 1) {
+    g_mutex_lock (&self->lock);
+    self->n_todo = self->n_threads - 2;
+    self->n_done = 0;
+    g_cond_broadcast (&self->cond_todo);
+    g_mutex_unlock (&self->lock);
+  }
+
+  self->func (self->task_data[self->n_threads - 1]);
+
+  if (n_threads > 1) {
+    g_mutex_lock (&self->lock);
+    while (self->n_done < self->n_threads - 1)
+      g_cond_wait (&self->cond_done, &self->lock);
+    self->n_done = 0;
+    g_mutex_unlock (&self->lock);
+  }
+
+  self->func = NULL;
+  self->task_data = NULL;
+}
+
 typedef struct _AudioChain AudioChain;
 
 typedef void (*AudioConvertFunc) (gpointer dst, const gpointer src, gint count);
@@ -77,6 +254,8 @@ typedef gboolean (*AudioConvertSamplesFunc) (GstAudioConverter * convert,
 typedef void (*AudioConvertEndianFunc) (gpointer dst, const gpointer src,
     gint count);
 
+typedef struct _MixTaskData MixTaskData;
+
 /*                           int/int    int/float  float/int float/float
  *
  *  unpack                     S32          S32         F64       F64
@@ -122,6 +301,11 @@ struct _GstAudioConverter
   gboolean mix_passthrough;
   GstAudioChannelMixer *mix;
 
+  /* optional worker pool that splits the mix over sample ranges */
+  GstParallelizedTaskRunner *mix_runner;
+  MixTaskData *mix_tasks;
+  gpointer *mix_tasks_p;
+
   /* resample */
   GstAudioResampler *resampler;
 
@@ -130,6 +314,10 @@ struct _GstAudioConverter
 
   /* quant */
   GstAudioQuantize *quant;
+  GstAudioDitherMethod quant_dither;
+  GstAudioNoiseShapingMethod quant_ns;
+  guint quantizer;
+  gboolean quant_allow_dither;
 
   /* pack */
   gboolean out_default;
@@ -242,7 +430,6 @@ audio_chain_get_samples (AudioChain * chain, gsize * avail)
   return res;
 }
 
-/*
 static guint
 get_opt_uint (GstAudioConverter * convert, const gchar * opt, guint def)
 {
@@ -251,7 +438,6 @@ get_opt_uint (GstAudioConverter * convert, const gchar * opt, guint def)
     res = def;
   return res;
 }
-*/
 
 static gint
 get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
@@ -267,6 +453,7 @@ get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_DITHER_METHOD GST_AUDIO_DITHER_NONE
 #define DEFAULT_OPT_NOISE_SHAPING_METHOD GST_AUDIO_NOISE_SHAPING_NONE
 #define DEFAULT_OPT_QUANTIZATION 1
+#define DEFAULT_OPT_THREADS 1
 
 #define GET_OPT_RESAMPLER_METHOD(c) get_opt_enum(c, \
     GST_AUDIO_CONVERTER_OPT_RESAMPLER_METHOD, GST_TYPE_AUDIO_RESAMPLER_METHOD, \
@@ -279,6 +466,8 @@ get_opt_enum (GstAudioConverter * convert, const gchar * opt, GType type,
     DEFAULT_OPT_NOISE_SHAPING_METHOD)
 #define GET_OPT_QUANTIZATION(c) get_opt_uint(c, \
     GST_AUDIO_CONVERTER_OPT_QUANTIZATION, DEFAULT_OPT_QUANTIZATION)
+#define GET_OPT_THREADS(c) get_opt_uint(c, \
+    GST_AUDIO_CONVERTER_OPT_THREADS, DEFAULT_OPT_THREADS)
 
 static gboolean
 copy_config (GQuark field_id, const GValue * value, gpointer user_data)
@@ -338,6 +527,26 @@ gst_audio_converter_update_config (GstAudioConverter * convert,
   if (config) {
     gst_structure_foreach (config, copy_config, convert);
     gst_structure_free (config);
+
+    /* swap in a new quantizer when the dither or noise shaping method
+     * changed, the rest of the chain is unaffected */
+    if (convert->quant && convert->quant_allow_dither) {
+      GstAudioDitherMethod dither = GET_OPT_DITHER_METHOD (convert);
+      GstAudioNoiseShapingMethod ns = GET_OPT_NOISE_SHAPING_METHOD (convert);
+
+      if (ns > GST_AUDIO_NOISE_SHAPING_ERROR_FEEDBACK && out_rate < 32000)
+        ns = GST_AUDIO_NOISE_SHAPING_ERROR_FEEDBACK;
+
+      if (dither != convert->quant_dither || ns != convert->quant_ns) {
+        GST_INFO ("switching to dither %d and noise shaping %d", dither, ns);
+        gst_audio_quantize_free (convert->quant);
+        convert->quant_dither = dither;
+        convert->quant_ns = ns;
+        convert->quant =
+            gst_audio_quantize_new (dither, ns, 0, GST_AUDIO_FORMAT_S32,
+            convert->out.channels, convert->quantizer);
+      }
+    }
   }
 
   return TRUE;
@@ -481,6 +690,28 @@ do_convert_in (AudioChain * chain, gpointer user_data)
   return TRUE;
 }
 
+/* mixing has no state between sample frames, so the frame range can be
+ * split over the worker pool; don't bother below this many frames per
+ * thread */
+#define MIX_FRAMES_PER_THREAD 256
+
+struct _MixTaskData
+{
+  GstAudioConverter *convert;
+  gpointer in[1];
+  gpointer out[1];
+  gsize num_samples;
+};
+
+static void
+do_mix_task (gpointer user_data)
+{
+  MixTaskData *td = user_data;
+
+  gst_audio_channel_mixer_samples (td->convert->mix, td->in, td->out,
+      td->num_samples);
+}
+
 static gboolean
 do_mix (AudioChain * chain, gpointer user_data)
 {
@@ -492,7 +723,29 @@ do_mix (AudioChain * chain, gpointer user_data)
   out = (chain->allow_ip ? in : audio_chain_alloc_samples (chain, num_samples));
   GST_LOG ("mix %p, %p, %" G_GSIZE_FORMAT, in, out, num_samples);
 
-  gst_audio_channel_mixer_samples (convert->mix, in, out, num_samples);
+  if (convert->mix_runner != NULL &&
+      num_samples >=
+      MIX_FRAMES_PER_THREAD * convert->mix_runner->n_threads) {
+    guint i, n_threads = convert->mix_runner->n_threads;
+    gint in_bpf = chain->prev->stride, out_bpf = chain->stride;
+    gsize chunk = num_samples / n_threads;
+    gsize pos = 0;
+
+    for (i = 0; i < n_threads; i++) {
+      MixTaskData *td = &convert->mix_tasks[i];
+
+      td->convert = convert;
+      td->in[0] = (guint8 *) in[0] + pos * in_bpf;
+      td->out[0] = (guint8 *) out[0] + pos * out_bpf;
+      td->num_samples = (i == n_threads - 1) ? num_samples - pos : chunk;
+      convert->mix_tasks_p[i] = td;
+      pos += td->num_samples;
+    }
+    gst_parallelized_task_runner_run (convert->mix_runner, do_mix_task,
+        convert->mix_tasks_p);
+  } else {
+    gst_audio_channel_mixer_samples (convert->mix, in, out, num_samples);
+  }
 
   audio_chain_set_samples (chain, out, num_samples);
 
@@ -638,6 +891,10 @@ chain_mix (GstAudioConverter * convert, AudioChain * prev)
   flags |=
       GST_AUDIO_INFO_IS_UNPOSITIONED (out) ?
       GST_AUDIO_CHANNEL_MIXER_FLAGS_UNPOSITIONED_OUT : 0;
+  if (convert->current_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED) {
+    flags |= GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_IN;
+    flags |= GST_AUDIO_CHANNEL_MIXER_FLAGS_NON_INTERLEAVED_OUT;
+  }
 
   convert->current_channels = out->channels;
 
@@ -651,6 +908,20 @@ chain_mix (GstAudioConverter * convert, AudioChain * prev)
       in->channels, out->channels);
 
   if (!convert->mix_passthrough) {
+    guint n_threads = GET_OPT_THREADS (convert);
+
+    /* the mix functions only read the (shared) matrix, concurrent calls
+     * over disjoint sample ranges are safe; the range split below only
+     * handles the single interleaved block though */
+    if (n_threads != 1
+        && convert->current_layout == GST_AUDIO_LAYOUT_INTERLEAVED)
+      convert->mix_runner = gst_parallelized_task_runner_new (n_threads);
+    if (convert->mix_runner != NULL) {
+      convert->mix_tasks =
+          g_new (MixTaskData, convert->mix_runner->n_threads);
+      convert->mix_tasks_p = g_new (gpointer, convert->mix_runner->n_threads);
+    }
+
     prev = audio_chain_new (prev, convert);
     prev->allow_ip = FALSE;
     prev->pass_alloc = FALSE;
@@ -744,7 +1015,9 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
    * as DA converters only can do a SNR up to 20 bits in reality.
    * Also don't dither or apply noise shaping if target depth is larger than
    * source depth. */
-  if (out_depth > 20 || (in_int && out_depth >= in_depth)) {
+  convert->quant_allow_dither =
+      !(out_depth > 20 || (in_int && out_depth >= in_depth));
+  if (!convert->quant_allow_dither) {
     dither = GST_AUDIO_DITHER_NONE;
     ns = GST_AUDIO_NOISE_SHAPING_NONE;
     GST_INFO ("using no dither and noise shaping");
@@ -759,10 +1032,18 @@ chain_quantize (GstAudioConverter * convert, AudioChain * prev)
    * the rounding correct */
   if (out_int && out_depth < 32
       && convert->current_format == GST_AUDIO_FORMAT_S32) {
+    GstAudioQuantizeFlags qflags = 0;
+
+    if (convert->current_layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED)
+      qflags |= GST_AUDIO_QUANTIZE_FLAG_NON_INTERLEAVED;
+
     GST_INFO ("quantize to %d bits, dither %d, ns %d", out_depth, dither, ns);
+    convert->quant_dither = dither;
+    convert->quant_ns = ns;
+    convert->quantizer = 1U << (32 - out_depth);
     convert->quant =
-        gst_audio_quantize_new (dither, ns, 0, convert->current_format,
-        out->channels, 1U << (32 - out_depth));
+        gst_audio_quantize_new (dither, ns, qflags, convert->current_format,
+        out->channels, convert->quantizer);
 
     prev = audio_chain_new (prev, convert);
     prev->allow_ip = TRUE;
@@ -1066,6 +1347,10 @@ converter_resample (GstAudioConverter * convert,
  * Create a new #GstAudioConverter that is able to convert between @in and @out
  * audio formats.
  *
+ * @in_info and @out_info must have the same layout; both interleaved and
+ * non-interleaved (planar) layouts are supported, but conversion between
+ * the two is not.
+ *
  * @config contains extra configuration options, see #GST_VIDEO_CONVERTER_OPT_*
  * parameters for details about the options and values.
  *
@@ -1080,7 +1365,6 @@ gst_audio_converter_new (GstAudioConverterFlags flags, GstAudioInfo * in_info,
 
   g_return_val_if_fail (in_info != NULL, FALSE);
   g_return_val_if_fail (out_info != NULL, FALSE);
-  g_return_val_if_fail (in_info->layout == GST_AUDIO_LAYOUT_INTERLEAVED, FALSE);
   g_return_val_if_fail (in_info->layout == out_info->layout, FALSE);
 
   if ((GST_AUDIO_INFO_CHANNELS (in_info) != GST_AUDIO_INFO_CHANNELS (out_info))
@@ -1201,6 +1485,10 @@ gst_audio_converter_free (GstAudioConverter * convert)
     gst_audio_quantize_free (convert->quant);
   if (convert->mix)
     gst_audio_channel_mixer_free (convert->mix);
+  if (convert->mix_runner)
+    gst_parallelized_task_runner_free (convert->mix_runner);
+  g_free (convert->mix_tasks);
+  g_free (convert->mix_tasks_p);
   if (convert->resampler)
     gst_audio_resampler_free (convert->resampler);
   gst_audio_info_init (&convert->in);
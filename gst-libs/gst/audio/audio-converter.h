@@ -64,6 +64,16 @@ typedef struct _GstAudioConverter GstAudioConverter;
  */
 #define GST_AUDIO_CONVERTER_OPT_QUANTIZATION   "GstAudioConverter.quantization"
 
+/**
+ * GST_AUDIO_CONVERTER_OPT_THREADS:
+ *
+ * #G_TYPE_UINT, maximum number of threads to use. Default 1, 0 for the number
+ * of cores.
+ *
+ * Since: 1.14
+ */
+#define GST_AUDIO_CONVERTER_OPT_THREADS   "GstAudioConverter.threads"
+
 
 /**
  * GstAudioConverterFlags:
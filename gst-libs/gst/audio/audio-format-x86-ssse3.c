@@ -0,0 +1,152 @@
+/* GStreamer
+ * Copyright (C) <2018> GStreamer contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <string.h>
+
+#include "audio-format-x86-ssse3.h"
+
+#if defined (HAVE_TMMINTRIN_H) && defined(__SSSE3__)
+#include <tmmintrin.h>
+
+/* Unpacking expands each packed 3-byte sample into the top three bytes
+ * of a 32 bit sample, i.e. produces (value << 8) with the sign bit in
+ * bit 31, exactly like the scalar loops in audio-format.c. One pshufb
+ * converts four samples at a time.
+ *
+ * A vector load for 4 samples reads 16 input bytes but only consumes
+ * 12, so the loops below leave at least 6 samples (18 bytes) for the
+ * scalar tail; that way the last vector load can never read past the
+ * end of the input. */
+
+void
+audio_format_unpack_s24le_ssse3 (gpointer dest, const gpointer data,
+    gint length)
+{
+  gint32 *d = dest;
+  const guint8 *s = data;
+  const __m128i mask = _mm_set_epi8 (11, 10, 9, -1, 8, 7, 6, -1,
+      5, 4, 3, -1, 2, 1, 0, -1);
+
+  while (length >= 6) {
+    __m128i in = _mm_loadu_si128 ((const __m128i *) s);
+    _mm_storeu_si128 ((__m128i *) d, _mm_shuffle_epi8 (in, mask));
+    s += 12;
+    d += 4;
+    length -= 4;
+  }
+  while (length > 0) {
+    *d++ = ((gint32) (s[0] | (s[1] << 8) | (s[2] << 16))) << 8;
+    s += 3;
+    length--;
+  }
+}
+
+void
+audio_format_unpack_s24be_ssse3 (gpointer dest, const gpointer data,
+    gint length)
+{
+  gint32 *d = dest;
+  const guint8 *s = data;
+  const __m128i mask = _mm_set_epi8 (9, 10, 11, -1, 6, 7, 8, -1,
+      3, 4, 5, -1, 0, 1, 2, -1);
+
+  while (length >= 6) {
+    __m128i in = _mm_loadu_si128 ((const __m128i *) s);
+    _mm_storeu_si128 ((__m128i *) d, _mm_shuffle_epi8 (in, mask));
+    s += 12;
+    d += 4;
+    length -= 4;
+  }
+  while (length > 0) {
+    *d++ = ((gint32) (s[2] | (s[1] << 8) | (s[0] << 16))) << 8;
+    s += 3;
+    length--;
+  }
+}
+
+/* Packing drops the low byte of each 32 bit sample and writes the
+ * remaining three bytes back to back; four samples read exactly 16
+ * bytes and write 12, so no special tail handling is needed for the
+ * stores. */
+
+void
+audio_format_pack_s24le_ssse3 (gpointer data, const gpointer src, gint length)
+{
+  const gint32 *s = src;
+  guint8 *d = data;
+  const __m128i mask = _mm_set_epi8 (-1, -1, -1, -1, 15, 14, 13,
+      11, 10, 9, 7, 6, 5, 3, 2, 1);
+
+  while (length >= 4) {
+    __m128i out = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) s),
+        mask);
+    guint32 tail = _mm_cvtsi128_si32 (_mm_srli_si128 (out, 8));
+
+    _mm_storel_epi64 ((__m128i *) d, out);
+    memcpy (d + 8, &tail, 4);
+    s += 4;
+    d += 12;
+    length -= 4;
+  }
+  while (length > 0) {
+    gint32 tmp = *s++ >> 8;
+
+    d[0] = tmp & 0xff;
+    d[1] = (tmp >> 8) & 0xff;
+    d[2] = (tmp >> 16) & 0xff;
+    d += 3;
+    length--;
+  }
+}
+
+void
+audio_format_pack_s24be_ssse3 (gpointer data, const gpointer src, gint length)
+{
+  const gint32 *s = src;
+  guint8 *d = data;
+  const __m128i mask = _mm_set_epi8 (-1, -1, -1, -1, 13, 14, 15,
+      9, 10, 11, 5, 6, 7, 1, 2, 3);
+
+  while (length >= 4) {
+    __m128i out = _mm_shuffle_epi8 (_mm_loadu_si128 ((const __m128i *) s),
+        mask);
+    guint32 tail = _mm_cvtsi128_si32 (_mm_srli_si128 (out, 8));
+
+    _mm_storel_epi64 ((__m128i *) d, out);
+    memcpy (d + 8, &tail, 4);
+    s += 4;
+    d += 12;
+    length -= 4;
+  }
+  while (length > 0) {
+    gint32 tmp = *s++ >> 8;
+
+    d[2] = tmp & 0xff;
+    d[1] = (tmp >> 8) & 0xff;
+    d[0] = (tmp >> 16) & 0xff;
+    d += 3;
+    length--;
+  }
+}
+
+#endif /* defined (HAVE_TMMINTRIN_H) && defined(__SSSE3__) */
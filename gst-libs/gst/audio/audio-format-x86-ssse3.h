@@ -0,0 +1,34 @@
+/* GStreamer
+ * Copyright (C) <2018> GStreamer contributors
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef AUDIO_FORMAT_X86_SSSE3_H
+#define AUDIO_FORMAT_X86_SSSE3_H
+
+#include <glib.h>
+
+void audio_format_unpack_s24le_ssse3 (gpointer dest, const gpointer data,
+    gint length);
+void audio_format_unpack_s24be_ssse3 (gpointer dest, const gpointer data,
+    gint length);
+void audio_format_pack_s24le_ssse3 (gpointer data, const gpointer src,
+    gint length);
+void audio_format_pack_s24be_ssse3 (gpointer data, const gpointer src,
+    gint length);
+
+#endif /* AUDIO_FORMAT_X86_SSSE3_H */
@@ -109,6 +109,27 @@
 # define audio_orc_pack_f64be audio_orc_pack_f64
 #endif
 
+/* SSSE3 kernels for the packed 24 bit formats, which Orc cannot cover
+ * because of the 3-byte stride */
+#if defined (HAVE_TMMINTRIN_H) && defined (HAVE_SSSE3) && HAVE_SSSE3 && \
+    (defined (__i386__) || defined (__x86_64__))
+#include "audio-format-x86-ssse3.h"
+#define PACK_S24_SIMD 1
+
+static inline gboolean
+have_ssse3 (void)
+{
+  static gsize checked = 0;
+  static gboolean supported = FALSE;
+
+  if (g_once_init_enter (&checked)) {
+    supported = __builtin_cpu_supports ("ssse3");
+    g_once_init_leave (&checked, 1);
+  }
+  return supported;
+}
+#endif
+
 #define MAKE_ORC_PACK_UNPACK(fmt,fmt_t)                         \
 static void unpack_ ##fmt (const GstAudioFormatInfo *info,      \
     GstAudioPackFlags flags, gpointer dest,                     \
@@ -184,11 +205,64 @@ static void pack_ ##name (const GstAudioFormatInfo *info,               \
   }                                                                     \
 }
 #define PACK_S24LE GST_AUDIO_FORMAT_S32, unpack_s24le, pack_s24le
-    MAKE_PACK_UNPACK (s24le, 3, 0, 8, READ24_FROM_LE, WRITE24_TO_LE)
+    MAKE_PACK_UNPACK (s24le_c, 3, 0, 8, READ24_FROM_LE, WRITE24_TO_LE)
+
+static void
+unpack_s24le (const GstAudioFormatInfo * info, GstAudioPackFlags flags,
+    gpointer dest, const gpointer data, gint length)
+{
+#ifdef PACK_S24_SIMD
+  if (have_ssse3 ()) {
+    audio_format_unpack_s24le_ssse3 (dest, data, length);
+    return;
+  }
+#endif
+  unpack_s24le_c (info, flags, dest, data, length);
+}
+
+static void
+pack_s24le (const GstAudioFormatInfo * info, GstAudioPackFlags flags,
+    const gpointer src, gpointer data, gint length)
+{
+#ifdef PACK_S24_SIMD
+  if (have_ssse3 ()) {
+    audio_format_pack_s24le_ssse3 (data, src, length);
+    return;
+  }
+#endif
+  pack_s24le_c (info, flags, src, data, length);
+}
+
 #define PACK_U24LE GST_AUDIO_FORMAT_S32, unpack_u24le, pack_u24le
     MAKE_PACK_UNPACK (u24le, 3, SIGNED, 8, READ24_FROM_LE, WRITE24_TO_LE)
 #define PACK_S24BE GST_AUDIO_FORMAT_S32, unpack_s24be, pack_s24be
-    MAKE_PACK_UNPACK (s24be, 3, 0, 8, READ24_FROM_BE, WRITE24_TO_BE)
+    MAKE_PACK_UNPACK (s24be_c, 3, 0, 8, READ24_FROM_BE, WRITE24_TO_BE)
+
+static void
+unpack_s24be (const GstAudioFormatInfo * info, GstAudioPackFlags flags,
+    gpointer dest, const gpointer data, gint length)
+{
+#ifdef PACK_S24_SIMD
+  if (have_ssse3 ()) {
+    audio_format_unpack_s24be_ssse3 (dest, data, length);
+    return;
+  }
+#endif
+  unpack_s24be_c (info, flags, dest, data, length);
+}
+
+static void
+pack_s24be (const GstAudioFormatInfo * info, GstAudioPackFlags flags,
+    const gpointer src, gpointer data, gint length)
+{
+#ifdef PACK_S24_SIMD
+  if (have_ssse3 ()) {
+    audio_format_pack_s24be_ssse3 (data, src, length);
+    return;
+  }
+#endif
+  pack_s24be_c (info, flags, src, data, length);
+}
 #define PACK_U24BE GST_AUDIO_FORMAT_S32, unpack_u24be, pack_u24be
     MAKE_PACK_UNPACK (u24be, 3, SIGNED, 8, READ24_FROM_BE, WRITE24_TO_BE)
 #define PACK_S20LE GST_AUDIO_FORMAT_S32, unpack_s20le, pack_s20le
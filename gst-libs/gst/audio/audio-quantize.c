@@ -51,6 +51,8 @@ struct _GstAudioQuantize
 
   /* last random number generated per channel for hifreq TPDF dither */
   gpointer last_random;
+  /* parallel random generator states for the dither buffer fill */
+  guint32 random_state[4];
   /* contains the past quantization errors, error[channels][count] */
   guint error_size;
   gpointer error_buf;
@@ -111,14 +113,20 @@ gst_fast_random_int32 (void)
 #define RANDOM_INT_DITHER(dither)                                       \
   (- dither + (gst_fast_random_int32 () & ((dither << 1) - 1)))
 
+/* same but from a previously drawn random number */
+#define RANDOM_INT_DITHER_FROM(r, dither)                               \
+  (- dither + ((gint32) (r) & ((dither << 1) - 1)))
+
+#define LCG_STEP(state)  ((state) = (state) * 1103515245 + 12345)
+
 static void
 setup_dither_buf (GstAudioQuantize * quant, gint samples)
 {
   gboolean need_init = FALSE;
   gint stride = quant->stride;
-  gint i, len = samples * stride;
+  gint i, j, len = samples * stride;
   guint shift = quant->shift;
-  guint32 bias;
+  guint32 bias, *state = quant->random_state;
   gint32 dither, *d;
 
   if (quant->dither_size < len) {
@@ -130,6 +138,9 @@ setup_dither_buf (GstAudioQuantize * quant, gint samples)
   bias = quant->bias;
   d = quant->dither_buf;
 
+  /* The RPDF and TPDF fills below run 4 independent generators so that
+   * the compiler can vectorize across the lanes, the serial generator
+   * would make every value depend on the previous one. */
   switch (quant->dither) {
     case GST_AUDIO_DITHER_NONE:
       if (need_init) {
@@ -140,14 +151,29 @@ setup_dither_buf (GstAudioQuantize * quant, gint samples)
 
     case GST_AUDIO_DITHER_RPDF:
       dither = 1 << (shift);
-      for (i = 0; i < len; i++)
-        d[i] = bias + RANDOM_INT_DITHER (dither);
+      for (i = 0; i + 4 <= len; i += 4) {
+        for (j = 0; j < 4; j++)
+          d[i + j] = bias + RANDOM_INT_DITHER_FROM (LCG_STEP (state[j]),
+              dither);
+      }
+      for (; i < len; i++)
+        d[i] = bias + RANDOM_INT_DITHER_FROM (LCG_STEP (state[0]), dither);
       break;
 
     case GST_AUDIO_DITHER_TPDF:
       dither = 1 << (shift - 1);
-      for (i = 0; i < len; i++)
-        d[i] = bias + RANDOM_INT_DITHER (dither) + RANDOM_INT_DITHER (dither);
+      for (i = 0; i + 4 <= len; i += 4) {
+        for (j = 0; j < 4; j++) {
+          guint32 r1 = LCG_STEP (state[j]);
+          guint32 r2 = LCG_STEP (state[j]);
+
+          d[i + j] = bias + RANDOM_INT_DITHER_FROM (r1, dither) +
+              RANDOM_INT_DITHER_FROM (r2, dither);
+        }
+      }
+      for (; i < len; i++)
+        d[i] = bias + RANDOM_INT_DITHER_FROM (LCG_STEP (state[0]), dither) +
+            RANDOM_INT_DITHER_FROM (LCG_STEP (state[0]), dither);
       break;
 
     case GST_AUDIO_DITHER_TPDF_HF:
@@ -229,73 +255,79 @@ gst_audio_quantize_quantize_int_dither_feedback (GstAudioQuantize * quant,
 #define SREDUCE 2
 #define SROUND (1<<(SREDUCE-1))
 
-static void
-gst_audio_quantize_quantize_int_dither_noise_shape (GstAudioQuantize * quant,
-    const gpointer src, gpointer dst, gint samples)
-{
-  guint32 mask;
-  gint i, j, k, len, stride, nc;
-  const gint32 *s = src;
-  gint32 *c, *dith, *d = dst, v, o, *e, err;
-
-  nc = quant->n_coeffs;
-
-  setup_dither_buf (quant, samples);
-  setup_error_buf (quant, samples, nc);
-
-  stride = quant->stride;
-  len = samples * stride;
-  dith = quant->dither_buf;
-  e = quant->error_buf;
-  c = quant->coeffs;
-  mask = ~quant->mask;
-
-  for (i = 0; i < len; i++) {
-    v = s[i];
-    /* combine and remove error */
-    err = 0;
-    for (j = 0, k = i; j < nc; j++, k += stride)
-      err -= e[k] * c[j];
-    err = (err + SROUND) >> (SREDUCE);
-    ADDSS (v, err);
-    o = v;
-    /* add dither */
-    err = dith[i];
-    ADDSS (v, err);
-    /* quantize */
-    v &= mask;
-    /* store new error with reduced precision */
-    e[k] = (v - o + RROUND) >> REDUCE;
-    /* store result */
-    d[i] = v;
-  }
-  memmove (e, &e[len], sizeof (gint32) * stride * nc);
+/* Instantiated per filter order so that the compiler can fully unroll
+ * (and vectorize) the error convolution */
+#define MAKE_NOISE_SHAPE_FUNC(nc)                                       \
+static void                                                             \
+gst_audio_quantize_quantize_int_dither_noise_shape_##nc                 \
+    (GstAudioQuantize * quant, const gpointer src, gpointer dst,        \
+    gint samples)                                                       \
+{                                                                       \
+  guint32 mask;                                                         \
+  gint i, j, k, len, stride;                                            \
+  const gint32 *s = src;                                                \
+  gint32 *c, *dith, *d = dst, v, o, *e, err;                            \
+                                                                        \
+  setup_dither_buf (quant, samples);                                    \
+  setup_error_buf (quant, samples, (nc));                               \
+                                                                        \
+  stride = quant->stride;                                               \
+  len = samples * stride;                                               \
+  dith = quant->dither_buf;                                             \
+  e = quant->error_buf;                                                 \
+  c = quant->coeffs;                                                    \
+  mask = ~quant->mask;                                                  \
+                                                                        \
+  for (i = 0; i < len; i++) {                                           \
+    v = s[i];                                                           \
+    /* combine and remove error */                                      \
+    err = 0;                                                            \
+    for (j = 0, k = i; j < (nc); j++, k += stride)                      \
+      err -= e[k] * c[j];                                               \
+    err = (err + SROUND) >> (SREDUCE);                                  \
+    ADDSS (v, err);                                                     \
+    o = v;                                                              \
+    /* add dither */                                                    \
+    err = dith[i];                                                      \
+    ADDSS (v, err);                                                     \
+    /* quantize */                                                      \
+    v &= mask;                                                          \
+    /* store new error with reduced precision */                        \
+    e[k] = (v - o + RROUND) >> REDUCE;                                  \
+    /* store result */                                                  \
+    d[i] = v;                                                           \
+  }                                                                     \
+  memmove (e, &e[len], sizeof (gint32) * stride * (nc));                \
 }
 
+MAKE_NOISE_SHAPE_FUNC (2);
+MAKE_NOISE_SHAPE_FUNC (5);
+MAKE_NOISE_SHAPE_FUNC (8);
+
 #define MAKE_QUANTIZE_FUNC_NAME(name)                                   \
 gst_audio_quantize_quantize_##name
 
 static const QuantizeFunc quantize_funcs[] = {
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_none_none),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_feedback),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_2),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_5),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_8),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_none),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_feedback),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_2),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_5),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_8),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_none),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_feedback),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_2),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_5),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_8),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_none),
   (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_feedback),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
-  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_2),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_5),
+  (QuantizeFunc) MAKE_QUANTIZE_FUNC_NAME (int_dither_noise_shape_8),
 };
 
 /* Same as error feedback but also add 1/2 of the previous error value.
@@ -366,6 +398,12 @@ gst_audio_quantize_setup_noise_shaping (GstAudioQuantize * quant)
 static void
 gst_audio_quantize_setup_dither (GstAudioQuantize * quant)
 {
+  gint i;
+
+  /* seed the parallel generator lanes from the serial generator */
+  for (i = 0; i < 4; i++)
+    quant->random_state[i] = gst_fast_random_uint32 ();
+
   switch (quant->dither) {
     case GST_AUDIO_DITHER_TPDF_HF:
       quant->last_random = g_new0 (gint32, quant->stride);
@@ -72,6 +72,9 @@ struct _GstAudioResampler
   /* for cubic */
   gdouble b, c;
 
+  /* in_rate/out_rate ratio the filter was last built for */
+  gdouble filter_ratio;
+
   /* temp taps */
   gpointer tmp_taps;
 
@@ -0,0 +1,653 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "audio-resampler-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && \
+    defined (__AVX2__) && defined (__FMA__)
+
+#include <immintrin.h>
+
+/* The taps memory is only guaranteed to be 16-byte aligned, so all
+ * 256-bit loads are unaligned ones. The tap tables are zero-padded by
+ * TAPS_OVERREAD elements, but the sample history buffers are only sized
+ * for n_taps rounded up to a multiple of 8, so the gint16 kernels must
+ * not load a full 256-bit group past that boundary; they handle the
+ * trailing group of 8 with 128-bit loads instead. */
+
+static inline void
+inner_product_gint16_full_1_avx2 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256i sum = _mm256_setzero_si256 ();
+  __m128i t;
+
+  for (; i + 16 <= len; i += 16) {
+    sum =
+        _mm256_add_epi32 (sum,
+        _mm256_madd_epi16 (_mm256_loadu_si256 ((__m256i *) (a + i)),
+            _mm256_loadu_si256 ((__m256i *) (b + i))));
+  }
+  t = _mm_add_epi32 (_mm256_castsi256_si128 (sum),
+      _mm256_extracti128_si256 (sum, 1));
+  if (i < len)
+    t = _mm_add_epi32 (t,
+        _mm_madd_epi16 (_mm_loadu_si128 ((__m128i *) (a + i)),
+            _mm_loadu_si128 ((__m128i *) (b + i))));
+  t = _mm_add_epi32 (t, _mm_shuffle_epi32 (t, _MM_SHUFFLE (2, 3, 2, 3)));
+  t = _mm_add_epi32 (t, _mm_shuffle_epi32 (t, _MM_SHUFFLE (1, 1, 1, 1)));
+
+  t = _mm_add_epi32 (t, _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  t = _mm_srai_epi32 (t, PRECISION_S16);
+  t = _mm_packs_epi32 (t, t);
+  *o = _mm_extract_epi16 (t, 0);
+}
+
+static inline void
+inner_product_gint16_linear_1_avx2 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256i sum[2], t;
+  __m128i s[2];
+  __m128i f = _mm_set_epi64x (0, *((gint64 *) icoeff));
+  const gint16 *c[2] = { (gint16 *) ((gint8 *) b + 0 * bstride),
+    (gint16 *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_si256 ();
+  f = _mm_unpacklo_epi16 (f, _mm_setzero_si128 ());
+
+  for (; i + 16 <= len; i += 16) {
+    t = _mm256_loadu_si256 ((__m256i *) (a + i));
+    sum[0] =
+        _mm256_add_epi32 (sum[0], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[0] + i))));
+    sum[1] =
+        _mm256_add_epi32 (sum[1], _mm256_madd_epi16 (t,
+            _mm256_loadu_si256 ((__m256i *) (c[1] + i))));
+  }
+  s[0] = _mm_add_epi32 (_mm256_castsi256_si128 (sum[0]),
+      _mm256_extracti128_si256 (sum[0], 1));
+  s[1] = _mm_add_epi32 (_mm256_castsi256_si128 (sum[1]),
+      _mm256_extracti128_si256 (sum[1], 1));
+  if (i < len) {
+    __m128i ta = _mm_loadu_si128 ((__m128i *) (a + i));
+    s[0] = _mm_add_epi32 (s[0], _mm_madd_epi16 (ta,
+            _mm_loadu_si128 ((__m128i *) (c[0] + i))));
+    s[1] = _mm_add_epi32 (s[1], _mm_madd_epi16 (ta,
+            _mm_loadu_si128 ((__m128i *) (c[1] + i))));
+  }
+
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[1] = _mm_srai_epi32 (s[1], PRECISION_S16);
+
+  s[0] =
+      _mm_madd_epi16 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] =
+      _mm_madd_epi16 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[0] = _mm_add_epi32 (s[0], s[1]);
+
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (2, 3, 2,
+              3)));
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (1, 1, 1,
+              1)));
+
+  s[0] = _mm_add_epi32 (s[0], _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_packs_epi32 (s[0], s[0]);
+  *o = _mm_extract_epi16 (s[0], 0);
+}
+
+static inline void
+inner_product_gint16_cubic_1_avx2 (gint16 * o, const gint16 * a,
+    const gint16 * b, gint len, const gint16 * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256i sum[4], ta;
+  __m128i s[4], t[4];
+  __m128i f = _mm_set_epi64x (0, *((gint64 *) icoeff));
+  const gint16 *c[4] = { (gint16 *) ((gint8 *) b + 0 * bstride),
+    (gint16 *) ((gint8 *) b + 1 * bstride),
+    (gint16 *) ((gint8 *) b + 2 * bstride),
+    (gint16 *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_si256 ();
+  f = _mm_unpacklo_epi16 (f, _mm_setzero_si128 ());
+
+  for (; i + 16 <= len; i += 16) {
+    ta = _mm256_loadu_si256 ((__m256i *) (a + i));
+    sum[0] =
+        _mm256_add_epi32 (sum[0], _mm256_madd_epi16 (ta,
+            _mm256_loadu_si256 ((__m256i *) (c[0] + i))));
+    sum[1] =
+        _mm256_add_epi32 (sum[1], _mm256_madd_epi16 (ta,
+            _mm256_loadu_si256 ((__m256i *) (c[1] + i))));
+    sum[2] =
+        _mm256_add_epi32 (sum[2], _mm256_madd_epi16 (ta,
+            _mm256_loadu_si256 ((__m256i *) (c[2] + i))));
+    sum[3] =
+        _mm256_add_epi32 (sum[3], _mm256_madd_epi16 (ta,
+            _mm256_loadu_si256 ((__m256i *) (c[3] + i))));
+  }
+  s[0] = _mm_add_epi32 (_mm256_castsi256_si128 (sum[0]),
+      _mm256_extracti128_si256 (sum[0], 1));
+  s[1] = _mm_add_epi32 (_mm256_castsi256_si128 (sum[1]),
+      _mm256_extracti128_si256 (sum[1], 1));
+  s[2] = _mm_add_epi32 (_mm256_castsi256_si128 (sum[2]),
+      _mm256_extracti128_si256 (sum[2], 1));
+  s[3] = _mm_add_epi32 (_mm256_castsi256_si128 (sum[3]),
+      _mm256_extracti128_si256 (sum[3], 1));
+  if (i < len) {
+    __m128i tl = _mm_loadu_si128 ((__m128i *) (a + i));
+    s[0] = _mm_add_epi32 (s[0], _mm_madd_epi16 (tl,
+            _mm_loadu_si128 ((__m128i *) (c[0] + i))));
+    s[1] = _mm_add_epi32 (s[1], _mm_madd_epi16 (tl,
+            _mm_loadu_si128 ((__m128i *) (c[1] + i))));
+    s[2] = _mm_add_epi32 (s[2], _mm_madd_epi16 (tl,
+            _mm_loadu_si128 ((__m128i *) (c[2] + i))));
+    s[3] = _mm_add_epi32 (s[3], _mm_madd_epi16 (tl,
+            _mm_loadu_si128 ((__m128i *) (c[3] + i))));
+  }
+
+  t[0] = _mm_unpacklo_epi32 (s[0], s[1]);
+  t[1] = _mm_unpacklo_epi32 (s[2], s[3]);
+  t[2] = _mm_unpackhi_epi32 (s[0], s[1]);
+  t[3] = _mm_unpackhi_epi32 (s[2], s[3]);
+
+  s[0] =
+      _mm_add_epi32 (_mm_unpacklo_epi64 (t[0], t[1]), _mm_unpackhi_epi64 (t[0],
+          t[1]));
+  s[2] =
+      _mm_add_epi32 (_mm_unpacklo_epi64 (t[2], t[3]), _mm_unpackhi_epi64 (t[2],
+          t[3]));
+  s[0] = _mm_add_epi32 (s[0], s[2]);
+
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_madd_epi16 (s[0], f);
+
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (2, 3, 2,
+              3)));
+  s[0] = _mm_add_epi32 (s[0], _mm_shuffle_epi32 (s[0], _MM_SHUFFLE (1, 1, 1,
+              1)));
+
+  s[0] = _mm_add_epi32 (s[0], _mm_set1_epi32 (1 << (PRECISION_S16 - 1)));
+  s[0] = _mm_srai_epi32 (s[0], PRECISION_S16);
+  s[0] = _mm_packs_epi32 (s[0], s[0]);
+  *o = _mm_extract_epi16 (s[0], 0);
+}
+
+static inline void
+inner_product_gint32_full_1_avx2 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256i sum, ta, tb;
+  __m128i s;
+  gint64 res;
+
+  sum = _mm256_setzero_si256 ();
+
+  for (; i < len; i += 8) {
+    ta = _mm256_loadu_si256 ((__m256i *) (a + i));
+    tb = _mm256_loadu_si256 ((__m256i *) (b + i));
+
+    sum =
+        _mm256_add_epi64 (sum,
+        _mm256_mul_epi32 (_mm256_unpacklo_epi32 (ta, ta),
+            _mm256_unpacklo_epi32 (tb, tb)));
+    sum =
+        _mm256_add_epi64 (sum,
+        _mm256_mul_epi32 (_mm256_unpackhi_epi32 (ta, ta),
+            _mm256_unpackhi_epi32 (tb, tb)));
+  }
+  s = _mm_add_epi64 (_mm256_castsi256_si128 (sum),
+      _mm256_extracti128_si256 (sum, 1));
+  s = _mm_add_epi64 (s, _mm_unpackhi_epi64 (s, s));
+  res = _mm_cvtsi128_si64 (s);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gint32_linear_1_avx2 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint i = 0;
+  gint64 res;
+  __m256i sum[2], ta, tb;
+  __m128i s[2];
+  __m128i f = _mm_loadu_si128 ((__m128i *) icoeff);
+  const gint32 *c[2] = { (gint32 *) ((gint8 *) b + 0 * bstride),
+    (gint32 *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_si256 ();
+
+  for (; i < len; i += 8) {
+    ta = _mm256_loadu_si256 ((__m256i *) (a + i));
+
+    tb = _mm256_loadu_si256 ((__m256i *) (c[0] + i));
+    sum[0] =
+        _mm256_add_epi64 (sum[0],
+        _mm256_mul_epi32 (_mm256_unpacklo_epi32 (ta, ta),
+            _mm256_unpacklo_epi32 (tb, tb)));
+    sum[0] =
+        _mm256_add_epi64 (sum[0],
+        _mm256_mul_epi32 (_mm256_unpackhi_epi32 (ta, ta),
+            _mm256_unpackhi_epi32 (tb, tb)));
+
+    tb = _mm256_loadu_si256 ((__m256i *) (c[1] + i));
+    sum[1] =
+        _mm256_add_epi64 (sum[1],
+        _mm256_mul_epi32 (_mm256_unpacklo_epi32 (ta, ta),
+            _mm256_unpacklo_epi32 (tb, tb)));
+    sum[1] =
+        _mm256_add_epi64 (sum[1],
+        _mm256_mul_epi32 (_mm256_unpackhi_epi32 (ta, ta),
+            _mm256_unpackhi_epi32 (tb, tb)));
+  }
+  s[0] = _mm_add_epi64 (_mm256_castsi256_si128 (sum[0]),
+      _mm256_extracti128_si256 (sum[0], 1));
+  s[1] = _mm_add_epi64 (_mm256_castsi256_si128 (sum[1]),
+      _mm256_extracti128_si256 (sum[1], 1));
+
+  s[0] = _mm_srli_epi64 (s[0], PRECISION_S32);
+  s[1] = _mm_srli_epi64 (s[1], PRECISION_S32);
+  s[0] =
+      _mm_mul_epi32 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] =
+      _mm_mul_epi32 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[0] = _mm_add_epi64 (s[0], s[1]);
+  s[0] = _mm_add_epi64 (s[0], _mm_unpackhi_epi64 (s[0], s[0]));
+  res = _mm_cvtsi128_si64 (s[0]);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gint32_cubic_1_avx2 (gint32 * o, const gint32 * a,
+    const gint32 * b, gint len, const gint32 * icoeff, gint bstride)
+{
+  gint i = 0;
+  gint64 res;
+  __m256i sum[4], ta, tb;
+  __m128i s[4];
+  __m128i f = _mm_loadu_si128 ((__m128i *) icoeff);
+  const gint32 *c[4] = { (gint32 *) ((gint8 *) b + 0 * bstride),
+    (gint32 *) ((gint8 *) b + 1 * bstride),
+    (gint32 *) ((gint8 *) b + 2 * bstride),
+    (gint32 *) ((gint8 *) b + 3 * bstride)
+  };
+  gint j;
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_si256 ();
+
+  for (; i < len; i += 8) {
+    ta = _mm256_loadu_si256 ((__m256i *) (a + i));
+
+    for (j = 0; j < 4; j++) {
+      tb = _mm256_loadu_si256 ((__m256i *) (c[j] + i));
+      sum[j] =
+          _mm256_add_epi64 (sum[j],
+          _mm256_mul_epi32 (_mm256_unpacklo_epi32 (ta, ta),
+              _mm256_unpacklo_epi32 (tb, tb)));
+      sum[j] =
+          _mm256_add_epi64 (sum[j],
+          _mm256_mul_epi32 (_mm256_unpackhi_epi32 (ta, ta),
+              _mm256_unpackhi_epi32 (tb, tb)));
+    }
+  }
+  for (j = 0; j < 4; j++) {
+    s[j] = _mm_add_epi64 (_mm256_castsi256_si128 (sum[j]),
+        _mm256_extracti128_si256 (sum[j], 1));
+    s[j] = _mm_srli_epi64 (s[j], PRECISION_S32);
+  }
+  s[0] =
+      _mm_mul_epi32 (s[0], _mm_shuffle_epi32 (f, _MM_SHUFFLE (0, 0, 0, 0)));
+  s[1] =
+      _mm_mul_epi32 (s[1], _mm_shuffle_epi32 (f, _MM_SHUFFLE (1, 1, 1, 1)));
+  s[2] =
+      _mm_mul_epi32 (s[2], _mm_shuffle_epi32 (f, _MM_SHUFFLE (2, 2, 2, 2)));
+  s[3] =
+      _mm_mul_epi32 (s[3], _mm_shuffle_epi32 (f, _MM_SHUFFLE (3, 3, 3, 3)));
+  s[0] = _mm_add_epi64 (s[0], s[1]);
+  s[2] = _mm_add_epi64 (s[2], s[3]);
+  s[0] = _mm_add_epi64 (s[0], s[2]);
+  s[0] = _mm_add_epi64 (s[0], _mm_unpackhi_epi64 (s[0], s[0]));
+  res = _mm_cvtsi128_si64 (s[0]);
+
+  res = (res + (1 << (PRECISION_S32 - 1))) >> PRECISION_S32;
+  *o = CLAMP (res, G_MININT32, G_MAXINT32);
+}
+
+static inline void
+inner_product_gfloat_full_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256 sum = _mm256_setzero_ps ();
+  __m128 s;
+
+  for (; i < len; i += 8) {
+    sum =
+        _mm256_fmadd_ps (_mm256_loadu_ps (a + i), _mm256_loadu_ps (b + i),
+        sum);
+  }
+  s = _mm_add_ps (_mm256_castps256_ps128 (sum),
+      _mm256_extractf128_ps (sum, 1));
+  s = _mm_add_ps (s, _mm_movehl_ps (s, s));
+  s = _mm_add_ss (s, _mm_shuffle_ps (s, s, 0x55));
+  _mm_store_ss (o, s);
+}
+
+static inline void
+inner_product_gfloat_linear_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256 sum[2], t;
+  __m128 s[2];
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_ps ();
+
+  for (; i < len; i += 8) {
+    t = _mm256_loadu_ps (a + i);
+    sum[0] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[1] + i), sum[1]);
+  }
+  s[0] = _mm_add_ps (_mm256_castps256_ps128 (sum[0]),
+      _mm256_extractf128_ps (sum[0], 1));
+  s[1] = _mm_add_ps (_mm256_castps256_ps128 (sum[1]),
+      _mm256_extractf128_ps (sum[1], 1));
+
+  s[0] = _mm_mul_ps (_mm_sub_ps (s[0], s[1]), _mm_load1_ps (icoeff));
+  s[0] = _mm_add_ps (s[0], s[1]);
+  s[0] = _mm_add_ps (s[0], _mm_movehl_ps (s[0], s[0]));
+  s[0] = _mm_add_ss (s[0], _mm_shuffle_ps (s[0], s[0], 0x55));
+  _mm_store_ss (o, s[0]);
+}
+
+static inline void
+inner_product_gfloat_cubic_1_avx2 (gfloat * o, const gfloat * a,
+    const gfloat * b, gint len, const gfloat * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256 sum[4], t;
+  __m128 s[4], f = _mm_loadu_ps (icoeff);
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) b + 0 * bstride),
+    (gfloat *) ((gint8 *) b + 1 * bstride),
+    (gfloat *) ((gint8 *) b + 2 * bstride),
+    (gfloat *) ((gint8 *) b + 3 * bstride)
+  };
+
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_ps ();
+
+  for (; i < len; i += 8) {
+    t = _mm256_loadu_ps (a + i);
+    sum[0] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[1] + i), sum[1]);
+    sum[2] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[2] + i), sum[2]);
+    sum[3] = _mm256_fmadd_ps (t, _mm256_loadu_ps (c[3] + i), sum[3]);
+  }
+  s[0] = _mm_add_ps (_mm256_castps256_ps128 (sum[0]),
+      _mm256_extractf128_ps (sum[0], 1));
+  s[1] = _mm_add_ps (_mm256_castps256_ps128 (sum[1]),
+      _mm256_extractf128_ps (sum[1], 1));
+  s[2] = _mm_add_ps (_mm256_castps256_ps128 (sum[2]),
+      _mm256_extractf128_ps (sum[2], 1));
+  s[3] = _mm_add_ps (_mm256_castps256_ps128 (sum[3]),
+      _mm256_extractf128_ps (sum[3], 1));
+
+  s[0] = _mm_mul_ps (s[0], _mm_shuffle_ps (f, f, 0x00));
+  s[1] = _mm_mul_ps (s[1], _mm_shuffle_ps (f, f, 0x55));
+  s[2] = _mm_mul_ps (s[2], _mm_shuffle_ps (f, f, 0xaa));
+  s[3] = _mm_mul_ps (s[3], _mm_shuffle_ps (f, f, 0xff));
+  s[0] = _mm_add_ps (s[0], s[1]);
+  s[2] = _mm_add_ps (s[2], s[3]);
+  s[0] = _mm_add_ps (s[0], s[2]);
+  s[0] = _mm_add_ps (s[0], _mm_movehl_ps (s[0], s[0]));
+  s[0] = _mm_add_ss (s[0], _mm_shuffle_ps (s[0], s[0], 0x55));
+  _mm_store_ss (o, s[0]);
+}
+
+static inline void
+inner_product_gdouble_full_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256d sum = _mm256_setzero_pd ();
+  __m128d s;
+
+  for (; i < len; i += 8) {
+    sum =
+        _mm256_fmadd_pd (_mm256_loadu_pd (a + i + 0),
+        _mm256_loadu_pd (b + i + 0), sum);
+    sum =
+        _mm256_fmadd_pd (_mm256_loadu_pd (a + i + 4),
+        _mm256_loadu_pd (b + i + 4), sum);
+  }
+  s = _mm_add_pd (_mm256_castpd256_pd128 (sum),
+      _mm256_extractf128_pd (sum, 1));
+  s = _mm_add_sd (s, _mm_unpackhi_pd (s, s));
+  _mm_store_sd (o, s);
+}
+
+static inline void
+inner_product_gdouble_linear_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i = 0;
+  __m256d sum[2], t;
+  __m128d s[2];
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride)
+  };
+
+  sum[0] = sum[1] = _mm256_setzero_pd ();
+
+  for (; i < len; i += 4) {
+    t = _mm256_loadu_pd (a + i);
+    sum[0] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[1] + i), sum[1]);
+  }
+  s[0] = _mm_add_pd (_mm256_castpd256_pd128 (sum[0]),
+      _mm256_extractf128_pd (sum[0], 1));
+  s[1] = _mm_add_pd (_mm256_castpd256_pd128 (sum[1]),
+      _mm256_extractf128_pd (sum[1], 1));
+
+  s[0] = _mm_mul_pd (_mm_sub_pd (s[0], s[1]), _mm_load1_pd (icoeff));
+  s[0] = _mm_add_pd (s[0], s[1]);
+  s[0] = _mm_add_sd (s[0], _mm_unpackhi_pd (s[0], s[0]));
+  _mm_store_sd (o, s[0]);
+}
+
+static inline void
+inner_product_gdouble_cubic_1_avx2 (gdouble * o, const gdouble * a,
+    const gdouble * b, gint len, const gdouble * icoeff, gint bstride)
+{
+  gint i;
+  __m256d sum[4], t;
+  __m128d s[4], f[2];
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) b + 0 * bstride),
+    (gdouble *) ((gint8 *) b + 1 * bstride),
+    (gdouble *) ((gint8 *) b + 2 * bstride),
+    (gdouble *) ((gint8 *) b + 3 * bstride)
+  };
+
+  f[0] = _mm_loadu_pd (icoeff + 0);
+  f[1] = _mm_loadu_pd (icoeff + 2);
+  sum[0] = sum[1] = sum[2] = sum[3] = _mm256_setzero_pd ();
+
+  for (i = 0; i < len; i += 4) {
+    t = _mm256_loadu_pd (a + i);
+    sum[0] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[0] + i), sum[0]);
+    sum[1] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[1] + i), sum[1]);
+    sum[2] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[2] + i), sum[2]);
+    sum[3] = _mm256_fmadd_pd (t, _mm256_loadu_pd (c[3] + i), sum[3]);
+  }
+  s[0] = _mm_add_pd (_mm256_castpd256_pd128 (sum[0]),
+      _mm256_extractf128_pd (sum[0], 1));
+  s[1] = _mm_add_pd (_mm256_castpd256_pd128 (sum[1]),
+      _mm256_extractf128_pd (sum[1], 1));
+  s[2] = _mm_add_pd (_mm256_castpd256_pd128 (sum[2]),
+      _mm256_extractf128_pd (sum[2], 1));
+  s[3] = _mm_add_pd (_mm256_castpd256_pd128 (sum[3]),
+      _mm256_extractf128_pd (sum[3], 1));
+
+  s[0] =
+      _mm_mul_pd (s[0], _mm_shuffle_pd (f[0], f[0], _MM_SHUFFLE2 (0, 0)));
+  s[1] =
+      _mm_mul_pd (s[1], _mm_shuffle_pd (f[0], f[0], _MM_SHUFFLE2 (1, 1)));
+  s[2] =
+      _mm_mul_pd (s[2], _mm_shuffle_pd (f[1], f[1], _MM_SHUFFLE2 (0, 0)));
+  s[3] =
+      _mm_mul_pd (s[3], _mm_shuffle_pd (f[1], f[1], _MM_SHUFFLE2 (1, 1)));
+  s[0] = _mm_add_pd (s[0], s[1]);
+  s[2] = _mm_add_pd (s[2], s[3]);
+  s[0] = _mm_add_pd (s[0], s[2]);
+  s[0] = _mm_add_sd (s[0], _mm_unpackhi_pd (s[0], s[0]));
+  _mm_store_sd (o, s[0]);
+}
+
+MAKE_RESAMPLE_FUNC (gint16, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint16, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint16, cubic, 1, avx2);
+
+MAKE_RESAMPLE_FUNC (gint32, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint32, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gint32, cubic, 1, avx2);
+
+MAKE_RESAMPLE_FUNC (gfloat, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gfloat, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gfloat, cubic, 1, avx2);
+
+MAKE_RESAMPLE_FUNC (gdouble, full, 1, avx2);
+MAKE_RESAMPLE_FUNC (gdouble, linear, 1, avx2);
+MAKE_RESAMPLE_FUNC (gdouble, cubic, 1, avx2);
+
+void
+interpolate_gfloat_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m256 f[2], t1;
+  const gfloat *c[2] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm256_broadcast_ss (ic + 0);
+  f[1] = _mm256_broadcast_ss (ic + 1);
+
+  for (i = 0; i < len; i += 8) {
+    t1 = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i), f[0]);
+    t1 = _mm256_fmadd_ps (_mm256_loadu_ps (c[1] + i), f[1], t1);
+    _mm256_storeu_ps (o + i, t1);
+  }
+}
+
+void
+interpolate_gfloat_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gfloat *o = op, *a = ap, *ic = icp;
+  __m256 f[4], t1, t2;
+  const gfloat *c[4] = { (gfloat *) ((gint8 *) a + 0 * astride),
+    (gfloat *) ((gint8 *) a + 1 * astride),
+    (gfloat *) ((gint8 *) a + 2 * astride),
+    (gfloat *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_broadcast_ss (ic + 0);
+  f[1] = _mm256_broadcast_ss (ic + 1);
+  f[2] = _mm256_broadcast_ss (ic + 2);
+  f[3] = _mm256_broadcast_ss (ic + 3);
+
+  for (i = 0; i < len; i += 8) {
+    t1 = _mm256_mul_ps (_mm256_loadu_ps (c[0] + i), f[0]);
+    t1 = _mm256_fmadd_ps (_mm256_loadu_ps (c[1] + i), f[1], t1);
+    t2 = _mm256_mul_ps (_mm256_loadu_ps (c[2] + i), f[2]);
+    t2 = _mm256_fmadd_ps (_mm256_loadu_ps (c[3] + i), f[3], t2);
+    _mm256_storeu_ps (o + i, _mm256_add_ps (t1, t2));
+  }
+}
+
+void
+interpolate_gdouble_linear_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m256d f[2], t1;
+  const gdouble *c[2] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride)
+  };
+
+  f[0] = _mm256_broadcast_sd (ic + 0);
+  f[1] = _mm256_broadcast_sd (ic + 1);
+
+  for (i = 0; i < len; i += 4) {
+    t1 = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i), f[0]);
+    t1 = _mm256_fmadd_pd (_mm256_loadu_pd (c[1] + i), f[1], t1);
+    _mm256_storeu_pd (o + i, t1);
+  }
+}
+
+void
+interpolate_gdouble_cubic_avx2 (gpointer op, const gpointer ap,
+    gint len, const gpointer icp, gint astride)
+{
+  gint i;
+  gdouble *o = op, *a = ap, *ic = icp;
+  __m256d f[4], t1, t2;
+  const gdouble *c[4] = { (gdouble *) ((gint8 *) a + 0 * astride),
+    (gdouble *) ((gint8 *) a + 1 * astride),
+    (gdouble *) ((gint8 *) a + 2 * astride),
+    (gdouble *) ((gint8 *) a + 3 * astride)
+  };
+
+  f[0] = _mm256_broadcast_sd (ic + 0);
+  f[1] = _mm256_broadcast_sd (ic + 1);
+  f[2] = _mm256_broadcast_sd (ic + 2);
+  f[3] = _mm256_broadcast_sd (ic + 3);
+
+  for (i = 0; i < len; i += 4) {
+    t1 = _mm256_mul_pd (_mm256_loadu_pd (c[0] + i), f[0]);
+    t1 = _mm256_fmadd_pd (_mm256_loadu_pd (c[1] + i), f[1], t1);
+    t2 = _mm256_mul_pd (_mm256_loadu_pd (c[2] + i), f[2]);
+    t2 = _mm256_fmadd_pd (_mm256_loadu_pd (c[3] + i), f[3], t2);
+    _mm256_storeu_pd (o + i, _mm256_add_pd (t1, t2));
+  }
+}
+
+#endif
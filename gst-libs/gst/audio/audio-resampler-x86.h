@@ -21,6 +21,7 @@
 #include "audio-resampler-x86-sse.h"
 #include "audio-resampler-x86-sse2.h"
 #include "audio-resampler-x86-sse41.h"
+#include "audio-resampler-x86-avx2.h"
 
 static void
 audio_resampler_check_x86 (const gchar *option)
@@ -69,3 +70,42 @@ audio_resampler_check_x86 (const gchar *option)
 #endif
   }
 }
+
+/* Probed directly with __builtin_cpu_supports() because the orc target
+ * flags do not cover AVX2. */
+static void
+audio_resampler_check_avx2 (void)
+{
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && \
+    defined (HAVE_AVX2) && HAVE_AVX2 && \
+    defined (HAVE_FMA) && HAVE_FMA
+  if (__builtin_cpu_supports ("avx2") && __builtin_cpu_supports ("fma")) {
+    GST_DEBUG ("enable AVX2 optimisations");
+    resample_gint16_full_1 = resample_gint16_full_1_avx2;
+    resample_gint16_linear_1 = resample_gint16_linear_1_avx2;
+    resample_gint16_cubic_1 = resample_gint16_cubic_1_avx2;
+
+    resample_gint32_full_1 = resample_gint32_full_1_avx2;
+    resample_gint32_linear_1 = resample_gint32_linear_1_avx2;
+    resample_gint32_cubic_1 = resample_gint32_cubic_1_avx2;
+
+    resample_gfloat_full_1 = resample_gfloat_full_1_avx2;
+    resample_gfloat_linear_1 = resample_gfloat_linear_1_avx2;
+    resample_gfloat_cubic_1 = resample_gfloat_cubic_1_avx2;
+
+    resample_gdouble_full_1 = resample_gdouble_full_1_avx2;
+    resample_gdouble_linear_1 = resample_gdouble_linear_1_avx2;
+    resample_gdouble_cubic_1 = resample_gdouble_cubic_1_avx2;
+
+    interpolate_gfloat_linear = interpolate_gfloat_linear_avx2;
+    interpolate_gfloat_cubic = interpolate_gfloat_cubic_avx2;
+    interpolate_gdouble_linear = interpolate_gdouble_linear_avx2;
+    interpolate_gdouble_cubic = interpolate_gdouble_cubic_avx2;
+  } else {
+    GST_DEBUG ("AVX2 not supported by the CPU");
+  }
+#else
+  GST_DEBUG ("AVX2 optimisations not enabled");
+#endif
+}
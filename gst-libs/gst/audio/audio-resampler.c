@@ -106,6 +106,10 @@ static const BlackmanQualityMap blackman_qualities[] = {
 #define DEFAULT_OPT_FILTER_OVERSAMPLE 8
 #define DEFAULT_OPT_MAX_PHASE_ERROR 0.1
 
+/* relative rate-ratio drift an interpolated filter can absorb before the
+ * prototype needs to be rebuilt for the new cutoff */
+#define FILTER_REBUILD_MAX_DRIFT 0.001
+
 static gdouble
 get_opt_double (GstStructure * options, const gchar * name, gdouble def)
 {
@@ -874,6 +878,9 @@ audio_resampler_init (void)
         }
       }
     }
+#ifdef CHECK_X86
+    audio_resampler_check_avx2 ();
+#endif
 #endif
     g_once_init_leave (&init_gonce, 1);
   }
@@ -1085,6 +1092,8 @@ resampler_calculate_taps (GstAudioResampler * resampler)
   in_rate = resampler->in_rate;
   out_rate = resampler->out_rate;
 
+  resampler->filter_ratio = (gdouble) in_rate / out_rate;
+
   if (out_rate < in_rate && scale) {
     resampler->cutoff = resampler->cutoff * out_rate / in_rate;
     resampler->n_taps =
@@ -1142,8 +1151,11 @@ resampler_calculate_taps (GstAudioResampler * resampler)
       resampler->filter_mode = GST_AUDIO_RESAMPLER_FILTER_MODE_FULL;
       GST_DEBUG ("automatically selected full filter, %d <= %d", out_rate,
           oversample);
-    } else if (bps * n_taps * out_rate < resampler->filter_threshold) {
-      /* switch to full filter when memory is below threshold */
+    } else if (bps * n_taps * out_rate < resampler->filter_threshold &&
+        !(resampler->flags & GST_AUDIO_RESAMPLER_FLAG_VARIABLE_RATE)) {
+      /* switch to full filter when memory is below threshold; not for
+       * variable rates because every rate change invalidates the full
+       * table while the interpolated filter survives it */
       resampler->filter_mode = GST_AUDIO_RESAMPLER_FILTER_MODE_FULL;
       GST_DEBUG ("automatically selected full filter, memory %d <= %d",
           bps * n_taps * out_rate, resampler->filter_threshold);
@@ -1541,7 +1553,20 @@ gst_audio_resampler_update (GstAudioResampler * resampler,
   resampler->samp_inc = in_rate / out_rate;
   resampler->samp_frac = in_rate % out_rate;
 
-  if (options) {
+  if (options && resampler->filter_interpolation !=
+      GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_NONE &&
+      resampler->filter_ratio > 0.0 && resampler->options != NULL &&
+      gst_structure_is_equal (options, resampler->options) &&
+      fabs ((gdouble) in_rate / out_rate - resampler->filter_ratio) <=
+      resampler->filter_ratio * FILTER_REBUILD_MAX_DRIFT) {
+    /* Same options and the rate ratio only drifted by an inaudible
+     * amount relative to the cutoff the prototype filter was built for;
+     * the interpolated filter derives the phase taps on the fly, so
+     * ppm-level skew corrections don't need a table rebuild */
+    GST_DEBUG ("ratio drift %f below %f, keeping filter",
+        (gdouble) in_rate / out_rate - resampler->filter_ratio,
+        resampler->filter_ratio * FILTER_REBUILD_MAX_DRIFT);
+  } else if (options) {
     GST_INFO ("have new options, reconfigure filter");
 
     if (resampler->options)
@@ -1584,7 +1609,10 @@ gst_audio_resampler_update (GstAudioResampler * resampler,
 
       resampler->samples_avail += diff;
     }
-  } else if (resampler->filter_mode == GST_AUDIO_RESAMPLER_FILTER_MODE_FULL) {
+  } else if (resampler->filter_mode == GST_AUDIO_RESAMPLER_FILTER_MODE_FULL &&
+      resampler->n_phases != resampler->out_rate) {
+    /* the cached taps only depend on the phase, when the reduced output
+     * rate is unchanged they are still valid */
     GST_DEBUG ("setting up filter cache");
     resampler->n_phases = resampler->out_rate;
     alloc_cache_mem (resampler, resampler->bps, resampler->n_taps,
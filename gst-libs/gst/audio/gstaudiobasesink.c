@@ -50,6 +50,8 @@ struct _GstAudioBaseSinkPrivate
   GstAudioBaseSinkSlaveMethod slave_method;
   /* running average of clock skew */
   GstClockTimeDiff avg_skew;
+  /* buffers rendered since the last skew measurement */
+  gint skew_count;
   /* the number of samples we aligned last time */
   gint64 last_align;
 
@@ -75,6 +77,14 @@ struct _GstAudioBaseSinkPrivate
   GstAudioBaseSinkCustomSlavingCallback custom_slaving_callback;
   gpointer custom_slaving_cb_data;
   GDestroyNotify custom_slaving_cb_notify;
+
+  /* minimum number of nanoseconds between two real device delay
+   * queries, 0 = query the device on every clock query */
+  GstClockTime delay_query_interval;
+  /* clock time and monotonic time of the last real device query,
+   * protected with OBJECT_LOCK */
+  GstClockTime last_device_time;
+  GstClockTime last_device_mono;
 };
 
 /* BaseAudioSink signals and args */
@@ -105,6 +115,15 @@ enum
  * fix itself, or is a permanent offset */
 #define DEFAULT_DISCONT_WAIT        (1 * GST_SECOND)
 
+/* by default query the device delay on every clock query */
+#define DEFAULT_DELAY_QUERY_INTERVAL 0
+
+/* measure the clock skew once every this many buffers. Sampling both
+ * clocks is relatively expensive and the correction only acts on a
+ * long-running average anyway, so with small buffers this amortizes the
+ * measurement without affecting the correction. */
+#define SKEW_MEASURE_INTERVAL 8
+
 enum
 {
   PROP_0,
@@ -117,6 +136,8 @@ enum
   PROP_ALIGNMENT_THRESHOLD,
   PROP_DRIFT_TOLERANCE,
   PROP_DISCONT_WAIT,
+  PROP_DELAY_QUERY_INTERVAL,
+  PROP_AVG_SKEW,
 
   PROP_LAST
 };
@@ -249,6 +270,42 @@ gst_audio_base_sink_class_init (GstAudioBaseSinkClass * klass)
           G_MAXUINT64 - 1, DEFAULT_DISCONT_WAIT,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioBaseSink:delay-query-interval:
+   *
+   * The minimum amount of time in nanoseconds between two queries of the
+   * device delay. Between two real queries the clock time is interpolated
+   * from the system monotonic clock, which makes clock queries cheap when
+   * many elements use the audio clock. 0 (the default) queries the device
+   * on every clock query.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_DELAY_QUERY_INTERVAL,
+      g_param_spec_uint64 ("delay-query-interval", "Delay Query Interval",
+          "Minimum time in nanoseconds between two device delay queries, "
+          "0 = query on every clock query", 0,
+          G_MAXUINT64 - 1, DEFAULT_DELAY_QUERY_INTERVAL,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioBaseSink:avg-skew:
+   *
+   * The running average of the skew between the pipeline clock and the
+   * audio device clock in nanoseconds, as measured by the skew slaving
+   * algorithm. -1 when no measurement has been made (yet), for example
+   * with another slave-method or when the sink provides the pipeline
+   * clock itself. Useful as drift telemetry when synchronizing several
+   * sinks against a common (network) clock.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_AVG_SKEW,
+      g_param_spec_int64 ("avg-skew", "Average Skew",
+          "Average clock skew against the device clock in nanoseconds, "
+          "-1 = unknown", G_MININT64, G_MAXINT64, -1,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_audio_base_sink_change_state);
   gstelement_class->provide_clock =
@@ -291,6 +348,8 @@ gst_audio_base_sink_init (GstAudioBaseSink * audiobasesink)
   audiobasesink->priv->custom_slaving_callback = NULL;
   audiobasesink->priv->custom_slaving_cb_data = NULL;
   audiobasesink->priv->custom_slaving_cb_notify = NULL;
+  audiobasesink->priv->delay_query_interval = DEFAULT_DELAY_QUERY_INTERVAL;
+  audiobasesink->priv->last_device_time = GST_CLOCK_TIME_NONE;
 
   audiobasesink->provided_clock = gst_audio_clock_new ("GstAudioSinkClock",
       (GstAudioClockGetTimeFunc) gst_audio_base_sink_get_time, audiobasesink,
@@ -516,6 +575,8 @@ gst_audio_base_sink_get_time (GstClock * clock, GstAudioBaseSink * sink)
   guint64 raw, samples;
   guint delay;
   GstClockTime result;
+  GstClockTime mono_time = GST_CLOCK_TIME_NONE;
+  GstClockTime interval;
   GstAudioRingBuffer *ringbuffer;
   gint rate;
 
@@ -525,6 +586,28 @@ gst_audio_base_sink_get_time (GstClock * clock, GstAudioBaseSink * sink)
   if ((rate = ringbuffer->spec.info.rate) == 0)
     return GST_CLOCK_TIME_NONE;
 
+  interval = sink->priv->delay_query_interval;
+  if (interval > 0 && g_atomic_int_get (&ringbuffer->state) ==
+      GST_AUDIO_RING_BUFFER_STATE_STARTED) {
+    mono_time = g_get_monotonic_time () * GST_USECOND;
+
+    GST_OBJECT_LOCK (sink);
+    if (GST_CLOCK_TIME_IS_VALID (sink->priv->last_device_time) &&
+        mono_time - sink->priv->last_device_mono < interval) {
+      /* a started device consumes samples at the nominal rate, interpolate
+       * with the system clock between two real device queries */
+      result = sink->priv->last_device_time +
+          (mono_time - sink->priv->last_device_mono);
+      GST_OBJECT_UNLOCK (sink);
+
+      GST_DEBUG_OBJECT (sink, "interpolated time %" GST_TIME_FORMAT,
+          GST_TIME_ARGS (result));
+
+      return result;
+    }
+    GST_OBJECT_UNLOCK (sink);
+  }
+
   /* our processed samples are always increasing */
   raw = samples = gst_audio_ring_buffer_samples_done (ringbuffer);
 
@@ -539,6 +622,15 @@ gst_audio_base_sink_get_time (GstClock * clock, GstAudioBaseSink * sink)
 
   result = gst_util_uint64_scale_int (samples, GST_SECOND, rate);
 
+  if (GST_CLOCK_TIME_IS_VALID (mono_time)) {
+    /* drift is corrected here; the next interpolation starts again from a
+     * real device position */
+    GST_OBJECT_LOCK (sink);
+    sink->priv->last_device_time = result;
+    sink->priv->last_device_mono = mono_time;
+    GST_OBJECT_UNLOCK (sink);
+  }
+
   GST_DEBUG_OBJECT (sink,
       "processed samples: raw %" G_GUINT64_FORMAT ", delay %u, real %"
       G_GUINT64_FORMAT ", time %" GST_TIME_FORMAT,
@@ -822,6 +914,54 @@ gst_audio_base_sink_get_discont_wait (GstAudioBaseSink * sink)
   return result;
 }
 
+/**
+ * gst_audio_base_sink_set_delay_query_interval:
+ * @sink: a #GstAudioBaseSink
+ * @interval: the new delay query interval in nanoseconds
+ *
+ * Controls how often the device delay is really queried when the clock
+ * provided by @sink is sampled. Between two real queries the clock time
+ * is interpolated from the system monotonic clock. 0 queries the device
+ * on every clock query.
+ *
+ * Since: 1.14
+ */
+void
+gst_audio_base_sink_set_delay_query_interval (GstAudioBaseSink * sink,
+    GstClockTime interval)
+{
+  g_return_if_fail (GST_IS_AUDIO_BASE_SINK (sink));
+
+  GST_OBJECT_LOCK (sink);
+  sink->priv->delay_query_interval = interval;
+  sink->priv->last_device_time = GST_CLOCK_TIME_NONE;
+  GST_OBJECT_UNLOCK (sink);
+}
+
+/**
+ * gst_audio_base_sink_get_delay_query_interval:
+ * @sink: a #GstAudioBaseSink
+ *
+ * Get the current delay query interval, in nanoseconds, used by @sink.
+ *
+ * Returns: The current delay query interval used by @sink.
+ *
+ * Since: 1.14
+ */
+GstClockTime
+gst_audio_base_sink_get_delay_query_interval (GstAudioBaseSink * sink)
+{
+  GstClockTime result;
+
+  g_return_val_if_fail (GST_IS_AUDIO_BASE_SINK (sink), GST_CLOCK_TIME_NONE);
+
+  GST_OBJECT_LOCK (sink);
+  result = sink->priv->delay_query_interval;
+  GST_OBJECT_UNLOCK (sink);
+
+  return result;
+}
+
 static void
 gst_audio_base_sink_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
@@ -856,6 +996,10 @@ gst_audio_base_sink_set_property (GObject * object, guint prop_id,
     case PROP_DISCONT_WAIT:
       gst_audio_base_sink_set_discont_wait (sink, g_value_get_uint64 (value));
       break;
+    case PROP_DELAY_QUERY_INTERVAL:
+      gst_audio_base_sink_set_delay_query_interval (sink,
+          g_value_get_uint64 (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -896,6 +1040,15 @@ gst_audio_base_sink_get_property (GObject * object, guint prop_id,
     case PROP_DISCONT_WAIT:
       g_value_set_uint64 (value, gst_audio_base_sink_get_discont_wait (sink));
       break;
+    case PROP_DELAY_QUERY_INTERVAL:
+      g_value_set_uint64 (value,
+          gst_audio_base_sink_get_delay_query_interval (sink));
+      break;
+    case PROP_AVG_SKEW:
+      GST_OBJECT_LOCK (sink);
+      g_value_set_int64 (value, sink->priv->avg_skew);
+      GST_OBJECT_UNLOCK (sink);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1042,6 +1195,7 @@ gst_audio_base_sink_reset_sync (GstAudioBaseSink * sink)
   sink->priv->eos_time = -1;
   sink->priv->discont_time = -1;
   sink->priv->avg_skew = -1;
+  sink->priv->skew_count = 0;
   sink->priv->last_align = 0;
 }
 
@@ -1418,6 +1572,14 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
   gst_clock_get_calibration (sink->provided_clock, &cinternal, &cexternal,
       &crate_num, &crate_denom);
 
+  /* measuring the skew is expensive, skip it most of the time and only
+   * convert with the current calibration */
+  if (sink->priv->avg_skew != -1 &&
+      ++sink->priv->skew_count < SKEW_MEASURE_INTERVAL)
+    goto convert;
+
+  sink->priv->skew_count = 0;
+
   /* sample clocks and figure out clock skew */
   etime = gst_clock_get_time (GST_ELEMENT_CLOCK (sink));
   itime = gst_audio_clock_get_time (GST_AUDIO_CLOCK (sink->provided_clock));
@@ -1514,6 +1676,7 @@ gst_audio_base_sink_skew_slaving (GstAudioBaseSink * sink,
         crate_num, crate_denom);
   }
 
+convert:
   /* convert, ignoring speed */
   render_start = clock_convert_external (render_start, cinternal, cexternal,
       crate_num, crate_denom);
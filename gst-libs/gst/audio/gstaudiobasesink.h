@@ -260,6 +260,13 @@ GST_EXPORT
 GstClockTime
            gst_audio_base_sink_get_discont_wait        (GstAudioBaseSink * sink);
 
+GST_EXPORT
+void       gst_audio_base_sink_set_delay_query_interval (GstAudioBaseSink * sink,
+                                                        GstClockTime interval);
+GST_EXPORT
+GstClockTime
+           gst_audio_base_sink_get_delay_query_interval (GstAudioBaseSink * sink);
+
 GST_EXPORT
 void
 gst_audio_base_sink_set_custom_slaving_callback        (GstAudioBaseSink * sink,
@@ -261,6 +261,10 @@ struct _GstAudioDecoderPrivate
   /* pending serialized sink events, will be sent from finish_frame() */
   GList *pending_events;
 
+  /* when non-NULL, output buffers are collected here instead of being
+   * pushed, so that finish_frames() can push them as one list */
+  GstBufferList *batch_list;
+
   /* flags */
   gboolean use_default_pad_acceptcaps;
 };
@@ -955,7 +959,10 @@ gst_audio_decoder_push_forward (GstAudioDecoder * dec, GstBuffer * buf)
       GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buf)),
       GST_TIME_ARGS (GST_BUFFER_DURATION (buf)));
 
-  ret = gst_pad_push (dec->srcpad, buf);
+  if (priv->batch_list)
+    gst_buffer_list_add (priv->batch_list, buf);
+  else
+    ret = gst_pad_push (dec->srcpad, buf);
 
 exit:
   return ret;
@@ -1176,28 +1183,10 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
   return TRUE;
 }
 
-/**
- * gst_audio_decoder_finish_frame:
- * @dec: a #GstAudioDecoder
- * @buf: decoded data
- * @frames: number of decoded frames represented by decoded data
- *
- * Collects decoded data and pushes it downstream.
- *
- * @buf may be NULL in which case the indicated number of frames
- * are discarded and considered to have produced no output
- * (e.g. lead-in or setup frames).
- * Otherwise, source pad caps must be set when it is called with valid
- * data in @buf.
- *
- * Note that a frame received in gst_audio_decoder_handle_frame() may be
- * invalidated by a call to this function.
- *
- * Returns: a #GstFlowReturn that should be escalated to caller (of caller)
- */
-GstFlowReturn
-gst_audio_decoder_finish_frame (GstAudioDecoder * dec, GstBuffer * buf,
-    gint frames)
+/* must be called with the stream lock */
+static GstFlowReturn
+gst_audio_decoder_finish_frame_unlocked (GstAudioDecoder * dec,
+    GstBuffer * buf, gint frames)
 {
   GstAudioDecoderPrivate *priv;
   GstAudioDecoderContext *ctx;
@@ -1227,8 +1216,6 @@ gst_audio_decoder_finish_frame (GstAudioDecoder * dec, GstBuffer * buf,
       " samples for %d frames", buf ? size : -1,
       buf ? size / ctx->info.bpf : -1, frames);
 
-  GST_AUDIO_DECODER_STREAM_LOCK (dec);
-
   if (buf) {
     ret = check_pending_reconfigure (dec);
     if (ret == GST_FLOW_FLUSHING || ret == GST_FLOW_NOT_NEGOTIATED)
@@ -1381,8 +1368,6 @@ exit:
   g_queue_foreach (&inbufs, (GFunc) gst_buffer_unref, NULL);
   g_queue_clear (&inbufs);
 
-  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
-
   return ret;
 
   /* ERRORS */
@@ -1397,6 +1382,103 @@ wrong_buffer:
   }
 }
 
+/**
+ * gst_audio_decoder_finish_frame:
+ * @dec: a #GstAudioDecoder
+ * @buf: decoded data
+ * @frames: number of decoded frames represented by decoded data
+ *
+ * Collects decoded data and pushes it downstream.
+ *
+ * @buf may be NULL in which case the indicated number of frames
+ * are discarded and considered to have produced no output
+ * (e.g. lead-in or setup frames).
+ * Otherwise, source pad caps must be set when it is called with valid
+ * data in @buf.
+ *
+ * Note that a frame received in gst_audio_decoder_handle_frame() may be
+ * invalidated by a call to this function.
+ *
+ * Returns: a #GstFlowReturn that should be escalated to caller (of caller)
+ */
+GstFlowReturn
+gst_audio_decoder_finish_frame (GstAudioDecoder * dec, GstBuffer * buf,
+    gint frames)
+{
+  GstFlowReturn ret;
+
+  GST_AUDIO_DECODER_STREAM_LOCK (dec);
+  ret = gst_audio_decoder_finish_frame_unlocked (dec, buf, frames);
+  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+
+  return ret;
+}
+
+/**
+ * gst_audio_decoder_finish_frames:
+ * @dec: a #GstAudioDecoder
+ * @buffers: (transfer full): decoded data
+ *
+ * Collects a list of decoded buffers and pushes them downstream in one
+ * go, each buffer accounting for one decoded input frame as with a
+ * gst_audio_decoder_finish_frame() call with @frames of 1.
+ *
+ * The stream lock is taken and pending events and reconfiguration are
+ * handled only once for the whole batch, and in forward playback the
+ * resulting buffers are pushed downstream as a single #GstBufferList.
+ *
+ * Returns: a #GstFlowReturn that should be escalated to caller (of caller)
+ *
+ * Since: 1.14
+ */
+GstFlowReturn
+gst_audio_decoder_finish_frames (GstAudioDecoder * dec,
+    GstBufferList * buffers)
+{
+  GstAudioDecoderPrivate *priv;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBufferList *batch;
+  guint i, len;
+
+  g_return_val_if_fail (buffers != NULL, GST_FLOW_ERROR);
+
+  priv = dec->priv;
+  len = gst_buffer_list_length (buffers);
+
+  GST_LOG_OBJECT (dec, "accepting list of %u buffers", len);
+
+  GST_AUDIO_DECODER_STREAM_LOCK (dec);
+
+  /* collect the output in a list in forward playback, reverse playback
+   * queues the buffers anyway. Output aggregation takes care of batching
+   * itself when enabled. */
+  if (dec->output_segment.rate > 0.0 && !priv->batch_list)
+    priv->batch_list = gst_buffer_list_new_sized (len);
+
+  for (i = 0; i < len; i++) {
+    ret = gst_audio_decoder_finish_frame_unlocked (dec,
+        gst_buffer_ref (gst_buffer_list_get (buffers, i)), 1);
+    if (ret != GST_FLOW_OK)
+      break;
+  }
+
+  batch = priv->batch_list;
+  priv->batch_list = NULL;
+
+  if (batch) {
+    if (ret == GST_FLOW_OK && gst_buffer_list_length (batch) > 0)
+      ret = gst_pad_push_list (dec->srcpad, batch);
+    else
+      gst_buffer_list_unref (batch);
+  }
+
+  GST_AUDIO_DECODER_STREAM_UNLOCK (dec);
+
+  gst_buffer_list_unref (buffers);
+
+  return ret;
+}
+
 static GstFlowReturn
 gst_audio_decoder_handle_frame (GstAudioDecoder * dec,
     GstAudioDecoderClass * klass, GstBuffer * buffer)
@@ -333,6 +333,10 @@ GST_EXPORT
 GstFlowReturn     gst_audio_decoder_finish_frame (GstAudioDecoder * dec,
                                                   GstBuffer * buf, gint frames);
 
+GST_EXPORT
+GstFlowReturn     gst_audio_decoder_finish_frames (GstAudioDecoder * dec,
+                                                   GstBufferList * buffers);
+
 GST_EXPORT
 GstBuffer *       gst_audio_decoder_allocate_output_buffer (GstAudioDecoder * dec,
                                                             gsize              size);
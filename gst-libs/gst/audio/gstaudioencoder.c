@@ -243,6 +243,10 @@ struct _GstAudioEncoderPrivate
 
   /* pending serialized sink events, will be sent from finish_frame() */
   GList *pending_events;
+
+  /* collects output buffers while finish_frames() is batching them,
+   * NULL otherwise */
+  GstBufferList *batch_list;
 };
 
 
@@ -988,8 +992,14 @@ gst_audio_encoder_finish_frame (GstAudioEncoder * enc, GstBuffer * buf,
         GST_TIME_ARGS (GST_BUFFER_TIMESTAMP (buf)),
         GST_TIME_ARGS (GST_BUFFER_DURATION (buf)));
 
-    ret = gst_pad_push (enc->srcpad, buf);
-    GST_LOG_OBJECT (enc, "buffer pushed: %s", gst_flow_get_name (ret));
+    if (priv->batch_list) {
+      /* batching mode; collected buffers are pushed
+       * as a list from finish_frames() */
+      gst_buffer_list_add (priv->batch_list, buf);
+    } else {
+      ret = gst_pad_push (enc->srcpad, buf);
+      GST_LOG_OBJECT (enc, "buffer pushed: %s", gst_flow_get_name (ret));
+    }
   } else {
     /* merely advance samples, most work for that already done above */
     priv->samples += samples;
@@ -1026,6 +1036,69 @@ overflow:
   }
 }
 
+/**
+ * gst_audio_encoder_finish_frames:
+ * @enc: a #GstAudioEncoder
+ * @buffers: (transfer full): a #GstBufferList of encoded data
+ * @samples: number of samples (per channel) represented by each buffer
+ *
+ * Collects a batch of encoded data and pushes it downstream as a single
+ * buffer list.  Each buffer in @buffers is processed as by
+ * gst_audio_encoder_finish_frame(), but downstream only sees one push,
+ * which reduces per-buffer overhead for subclasses (e.g. hardware
+ * accelerated ones) that produce several encoded frames at a time.
+ * Source pad caps must be set when this is called.
+ *
+ * Returns: a #GstFlowReturn that should be escalated to caller (of caller)
+ *
+ * Since: 1.14
+ */
+GstFlowReturn
+gst_audio_encoder_finish_frames (GstAudioEncoder * enc, GstBufferList * buffers,
+    gint samples)
+{
+  GstAudioEncoderPrivate *priv;
+  GstFlowReturn ret = GST_FLOW_OK;
+  GstBufferList *batch;
+  guint i, len;
+
+  g_return_val_if_fail (GST_IS_AUDIO_ENCODER (enc), GST_FLOW_ERROR);
+  g_return_val_if_fail (buffers != NULL, GST_FLOW_ERROR);
+
+  priv = enc->priv;
+
+  GST_AUDIO_ENCODER_STREAM_LOCK (enc);
+
+  len = gst_buffer_list_length (buffers);
+  GST_LOG_OBJECT (enc, "accepting list of %u encoded buffers", len);
+
+  if (!priv->batch_list)
+    priv->batch_list = gst_buffer_list_new_sized (len);
+
+  for (i = 0; i < len; i++) {
+    ret = gst_audio_encoder_finish_frame (enc,
+        gst_buffer_ref (gst_buffer_list_get (buffers, i)), samples);
+    if (ret != GST_FLOW_OK)
+      break;
+  }
+
+  batch = priv->batch_list;
+  priv->batch_list = NULL;
+
+  if (ret == GST_FLOW_OK && gst_buffer_list_length (batch) > 0) {
+    ret = gst_pad_push_list (enc->srcpad, batch);
+    GST_LOG_OBJECT (enc, "buffer list pushed: %s", gst_flow_get_name (ret));
+  } else {
+    gst_buffer_list_unref (batch);
+  }
+
+  GST_AUDIO_ENCODER_STREAM_UNLOCK (enc);
+
+  gst_buffer_list_unref (buffers);
+
+  return ret;
+}
+
  /* adapter tracking idea:
   * - start of adapter corresponds with what has already been encoded
   * (i.e. really returned by encoder subclass)
@@ -1175,6 +1248,38 @@ gst_audio_encoder_set_base_gp (GstAudioEncoder * enc)
   }
 }
 
+/* check whether @size bytes match exactly what push_buffers would carve
+ * out of an otherwise empty adapter, i.e. whether the subclass can be fed
+ * an incoming buffer of that size as a single frame without going through
+ * the adapter */
+static gboolean
+gst_audio_encoder_frame_aligned (GstAudioEncoder * enc, gsize size)
+{
+  GstAudioEncoderContext *ctx = &enc->priv->ctx;
+  gint av = size, need;
+
+  if (!av)
+    return FALSE;
+
+  need = ctx->frame_samples_min > 0 ?
+      ctx->frame_samples_min * ctx->info.bpf : av;
+  if (need > av)
+    return FALSE;
+
+  if (ctx->frame_samples_max > 0)
+    need = MIN (av, ctx->frame_samples_max * ctx->info.bpf);
+
+  if (ctx->frame_samples_min == ctx->frame_samples_max &&
+      ctx->frame_samples_min > 0 && need) {
+    if (ctx->frame_max > 1)
+      need = need * MIN ((av / need), ctx->frame_max);
+    else if (ctx->frame_max == 0)
+      need = need * (av / need);
+  }
+
+  return need == av;
+}
+
 static GstFlowReturn
 gst_audio_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
 {
@@ -1331,11 +1436,40 @@ gst_audio_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buffer)
     }
   }
 
-  gst_adapter_push (enc->priv->adapter, buffer);
   /* new stuff, so we can push subclass again */
   enc->priv->drained = FALSE;
 
-  ret = gst_audio_encoder_push_buffers (enc, FALSE);
+  if (gst_adapter_available (priv->adapter) == 0 &&
+      GST_AUDIO_ENCODER_GET_CLASS (enc)->handle_frame != NULL &&
+      gst_audio_encoder_frame_aligned (enc, size)) {
+    GstAudioEncoderClass *klass = GST_AUDIO_ENCODER_GET_CLASS (enc);
+
+    /* fast path; incoming buffer matches the subclass frame size exactly,
+     * so hand it over as-is rather than bouncing its data through
+     * gst_adapter_map().  That keeps upstream memory (possibly not
+     * plain system memory) intact for the subclass to map or pass on,
+     * and avoids a copy when the subclass retains the buffer.
+     * The adapter still tracks the buffer so timestamps and metadata
+     * are handled by finish_frame() as usual */
+    GST_LOG_OBJECT (enc, "providing subclass with %" G_GSIZE_FORMAT
+        " bytes directly", size);
+
+    gst_buffer_ref (buffer);
+    gst_adapter_push (priv->adapter, buffer);
+
+    priv->got_data = FALSE;
+    priv->offset += size;
+    GST_OBJECT_LOCK (enc);
+    priv->samples_in += size / ctx->info.bpf;
+    GST_OBJECT_UNLOCK (enc);
+
+    ret = klass->handle_frame (enc, buffer);
+    gst_buffer_unref (buffer);
+  } else {
+    gst_adapter_push (enc->priv->adapter, buffer);
+
+    ret = gst_audio_encoder_push_buffers (enc, FALSE);
+  }
 
 done:
   GST_LOG_OBJECT (enc, "chain leaving");
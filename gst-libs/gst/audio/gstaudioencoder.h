@@ -255,6 +255,11 @@ GstFlowReturn   gst_audio_encoder_finish_frame (GstAudioEncoder * enc,
                                                 GstBuffer       * buffer,
                                                 gint              samples);
 
+GST_EXPORT
+GstFlowReturn   gst_audio_encoder_finish_frames (GstAudioEncoder * enc,
+                                                 GstBufferList   * buffers,
+                                                 gint              samples);
+
 GST_EXPORT
 GstCaps *       gst_audio_encoder_proxy_getcaps (GstAudioEncoder * enc,
                                                  GstCaps         * caps,
@@ -35,6 +35,7 @@
  */
 
 #include <string.h>
+#include <math.h>
 
 #include <gst/audio/audio.h>
 #include "gstaudioringbuffer.h"
@@ -105,6 +106,7 @@ gst_audio_ring_buffer_finalize (GObject * object)
 
   g_cond_clear (&ringbuffer->cond);
   g_free (ringbuffer->empty_seg);
+  g_free (ringbuffer->metering);
 
   if (ringbuffer->cb_data_notify != NULL)
     ringbuffer->cb_data_notify (ringbuffer->cb_data);
@@ -1399,25 +1401,150 @@ no_start:
 
 
 
+/* dispatch on the sample size once per sample so the common widths use
+ * plain loads and stores instead of a memcpy per channel */
 #define REORDER_SAMPLE(d, s, l)                 \
 G_STMT_START {                                  \
   gint i;                                       \
-  for (i = 0; i < channels; i++) {              \
-    memcpy (d + reorder_map[i] * bps, s + i * bps, bps); \
+  switch (bps) {                                \
+    case 2:                                     \
+      for (i = 0; i < channels; i++)            \
+        ((guint16 *) (gpointer) (d))[reorder_map[i]] = \
+            ((const guint16 *) (gpointer) (s))[i]; \
+      break;                                    \
+    case 4:                                     \
+      for (i = 0; i < channels; i++)            \
+        ((guint32 *) (gpointer) (d))[reorder_map[i]] = \
+            ((const guint32 *) (gpointer) (s))[i]; \
+      break;                                    \
+    case 8:                                     \
+      for (i = 0; i < channels; i++)            \
+        ((guint64 *) (gpointer) (d))[reorder_map[i]] = \
+            ((const guint64 *) (gpointer) (s))[i]; \
+      break;                                    \
+    default:                                    \
+      for (i = 0; i < channels; i++) {          \
+        memcpy (d + reorder_map[i] * bps, s + i * bps, bps); \
+      }                                         \
+      break;                                    \
   }                                             \
 } G_STMT_END
 
-#define REORDER_SAMPLES(d, s, len)              \
+#define REORDER_SAMPLES_TYPE(type, d, s, len)   \
 G_STMT_START {                                  \
-  gint i, len_ = len / bpf;                     \
-  guint8 *d_ = d, *s_ = s;                      \
+  gint i, j, len_ = len / bpf;                  \
+  type *d_ = (type *) (gpointer) (d);           \
+  const type *s_ = (const type *) (gpointer) (s); \
   for (i = 0; i < len_; i++) {                  \
-    REORDER_SAMPLE(d_, s_, bpf);                \
-    d_ += bpf;                                  \
-    s_ += bpf;                                  \
+    for (j = 0; j < channels; j++)              \
+      d_[reorder_map[j]] = s_[j];               \
+    d_ += channels;                             \
+    s_ += channels;                             \
+  }                                             \
+} G_STMT_END
+
+#define REORDER_SAMPLES(d, s, len)              \
+G_STMT_START {                                  \
+  switch (bps) {                                \
+    case 2:                                     \
+      REORDER_SAMPLES_TYPE (guint16, d, s, len); \
+      break;                                    \
+    case 4:                                     \
+      REORDER_SAMPLES_TYPE (guint32, d, s, len); \
+      break;                                    \
+    case 8:                                     \
+      REORDER_SAMPLES_TYPE (guint64, d, s, len); \
+      break;                                    \
+    default: {                                  \
+      gint i, len_ = len / bpf;                 \
+      guint8 *d_ = d, *s_ = s;                  \
+      for (i = 0; i < len_; i++) {              \
+        REORDER_SAMPLE(d_, s_, bpf);            \
+        d_ += bpf;                              \
+        s_ += bpf;                              \
+      }                                         \
+      break;                                    \
+    }                                           \
   }                                             \
 } G_STMT_END
 
+/* Optional level metering, running in the commit path while the samples
+ * are hot in the cache. The last computed levels are published in
+ * per-channel slots as Q31 fixed point so that a monitoring thread can
+ * poll them with plain atomic reads, without ever blocking the writer. */
+#define MAX_METER_CHANNELS 64
+
+typedef struct
+{
+  gint enabled;                 /* ATOMIC */
+  gint channels;                /* ATOMIC, number of valid slots */
+  gint peak[MAX_METER_CHANNELS];        /* ATOMIC, Q31 */
+  gint rms[MAX_METER_CHANNELS]; /* ATOMIC, Q31 */
+} GstAudioRingBufferMetering;
+
+#define METER_SAMPLES(type,scale)                       \
+G_STMT_START {                                          \
+  const type *s = (const type *) data;                  \
+  gint c, n;                                            \
+  for (n = 0; n < samples; n++) {                       \
+    for (c = 0; c < mchannels; c++) {                   \
+      gdouble v = ABS ((gdouble) s[c]) * (1.0 / (scale)); \
+      if (v > peak[c])                                  \
+        peak[c] = v;                                    \
+      sumsq[c] += v * v;                                \
+    }                                                   \
+    s += channels;                                      \
+  }                                                     \
+} G_STMT_END
+
+static void
+default_meter (GstAudioRingBuffer * buf, const guint8 * data, gint samples)
+{
+  GstAudioRingBufferMetering *meter;
+  gdouble peak[MAX_METER_CHANNELS] = { 0, };
+  gdouble sumsq[MAX_METER_CHANNELS] = { 0, };
+  gint channels, mchannels, c;
+
+  meter = g_atomic_pointer_get (&buf->metering);
+  if (meter == NULL || !g_atomic_int_get (&meter->enabled))
+    return;
+
+  if (samples <= 0 || buf->spec.type != GST_AUDIO_RING_BUFFER_FORMAT_TYPE_RAW)
+    return;
+
+  channels = buf->spec.info.channels;
+  mchannels = MIN (channels, MAX_METER_CHANNELS);
+
+  switch (GST_AUDIO_INFO_FORMAT (&buf->spec.info)) {
+    case GST_AUDIO_FORMAT_S8:
+      METER_SAMPLES (gint8, 128.0);
+      break;
+    case GST_AUDIO_FORMAT_S16:
+      METER_SAMPLES (gint16, 32768.0);
+      break;
+    case GST_AUDIO_FORMAT_S32:
+      METER_SAMPLES (gint32, 2147483648.0);
+      break;
+    case GST_AUDIO_FORMAT_F32:
+      METER_SAMPLES (gfloat, 1.0);
+      break;
+    case GST_AUDIO_FORMAT_F64:
+      METER_SAMPLES (gdouble, 1.0);
+      break;
+    default:
+      /* packed or non-native formats are not metered */
+      return;
+  }
+
+  for (c = 0; c < mchannels; c++) {
+    g_atomic_int_set (&meter->peak[c],
+        (gint) (MIN (peak[c], 1.0) * G_MAXINT32));
+    g_atomic_int_set (&meter->rms[c],
+        (gint) (MIN (sqrt (sumsq[c] / samples), 1.0) * G_MAXINT32));
+  }
+  g_atomic_int_set (&meter->channels, mchannels);
+}
+
 #define FWD_SAMPLES(s,se,d,de,F)         	\
 G_STMT_START {					\
   /* no rate conversion */			\
@@ -1521,6 +1648,9 @@ default_commit (GstAudioRingBuffer * buf, guint64 * sample,
   g_return_val_if_fail (buf->memory != NULL, -1);
   g_return_val_if_fail (data != NULL, -1);
 
+  if (G_UNLIKELY (buf->metering != NULL))
+    default_meter (buf, data, in_samples);
+
   need_reorder = buf->need_reorder;
 
   channels = buf->spec.info.channels;
@@ -1817,16 +1947,10 @@ gst_audio_ring_buffer_read (GstAudioRingBuffer * buf, guint64 sample,
 
     if (need_reorder) {
       guint8 *ptr = dest + (readseg * segsize) + (sampleoff * bpf);
-      gint i, j;
       gint *reorder_map = buf->channel_reorder_map;
 
       /* Reorder from device order to GStreamer order */
-      for (i = 0; i < sampleslen; i++) {
-        for (j = 0; j < channels; j++) {
-          memcpy (data + reorder_map[j] * bps, ptr + j * bps, bps);
-        }
-        ptr += bpf;
-      }
+      REORDER_SAMPLES (data, ptr, sampleslen * bpf);
     } else {
       memcpy (data, dest + (readseg * segsize) + (sampleoff * bpf),
           (sampleslen * bpf));
@@ -1991,6 +2115,87 @@ gst_audio_ring_buffer_may_start (GstAudioRingBuffer * buf, gboolean allowed)
   g_atomic_int_set (&buf->may_start, allowed);
 }
 
+/**
+ * gst_audio_ring_buffer_set_metering:
+ * @buf: the #GstAudioRingBuffer
+ * @enabled: the new metering state
+ *
+ * Enable or disable level metering on @buf. When enabled, the default
+ * commit function computes the peak and RMS level of every channel of
+ * each buffer it writes into the ringbuffer, while the samples are
+ * still hot in the cache from the copy. The last computed levels can be
+ * polled at any time with gst_audio_ring_buffer_get_channel_levels().
+ *
+ * Levels are only computed for raw ringbuffers in a native-endian
+ * format; for other formats, and for subclasses that override the
+ * commit vmethod, the levels are simply never updated.
+ *
+ * Since: 1.14
+ */
+void
+gst_audio_ring_buffer_set_metering (GstAudioRingBuffer * buf, gboolean enabled)
+{
+  GstAudioRingBufferMetering *meter;
+
+  g_return_if_fail (GST_IS_AUDIO_RING_BUFFER (buf));
+
+  GST_DEBUG_OBJECT (buf, "metering: %d", enabled);
+
+  meter = g_atomic_pointer_get (&buf->metering);
+  if (meter == NULL) {
+    if (!enabled)
+      return;
+    meter = g_new0 (GstAudioRingBufferMetering, 1);
+    if (!g_atomic_pointer_compare_and_exchange (&buf->metering, NULL, meter)) {
+      /* lost the race against another enabler */
+      g_free (meter);
+      meter = g_atomic_pointer_get (&buf->metering);
+    }
+  }
+  if (enabled)
+    g_atomic_int_set (&meter->channels, 0);
+  g_atomic_int_set (&meter->enabled, enabled);
+}
+
+/**
+ * gst_audio_ring_buffer_get_channel_levels:
+ * @buf: the #GstAudioRingBuffer
+ * @channel: the channel to query
+ * @peak: (out) (allow-none): the peak level of @channel
+ * @rms: (out) (allow-none): the RMS level of @channel
+ *
+ * Get the levels of @channel over the most recently committed buffer,
+ * as linear values between 0.0 and 1.0. This only returns meaningful
+ * values after metering was enabled with
+ * gst_audio_ring_buffer_set_metering() and samples were committed; it
+ * can be called from any thread without blocking the writer.
+ *
+ * Returns: %TRUE when levels were available for @channel.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_audio_ring_buffer_get_channel_levels (GstAudioRingBuffer * buf,
+    guint channel, gdouble * peak, gdouble * rms)
+{
+  GstAudioRingBufferMetering *meter;
+
+  g_return_val_if_fail (GST_IS_AUDIO_RING_BUFFER (buf), FALSE);
+
+  meter = g_atomic_pointer_get (&buf->metering);
+  if (meter == NULL || !g_atomic_int_get (&meter->enabled))
+    return FALSE;
+  if (channel >= (guint) g_atomic_int_get (&meter->channels))
+    return FALSE;
+
+  if (peak)
+    *peak = g_atomic_int_get (&meter->peak[channel]) / (gdouble) G_MAXINT32;
+  if (rms)
+    *rms = g_atomic_int_get (&meter->rms[channel]) / (gdouble) G_MAXINT32;
+
+  return TRUE;
+}
+
 /* GST_AUDIO_CHANNEL_POSITION_NONE is used for position-less
  * mutually exclusive channels. In this case we should not attempt
  * to do any reordering.
@@ -213,8 +213,11 @@ struct _GstAudioRingBuffer {
 
   GDestroyNotify              cb_data_notify;
 
+  /* level metering state, created on demand. ABI added 1.14 */
+  gpointer                    metering;
+
   /*< private >*/
-  gpointer _gst_reserved[GST_PADDING - 1];
+  gpointer _gst_reserved[GST_PADDING - 2];
 };
 
 /**
@@ -402,6 +405,14 @@ void            gst_audio_ring_buffer_advance         (GstAudioRingBuffer *buf,
 GST_EXPORT
 void            gst_audio_ring_buffer_may_start       (GstAudioRingBuffer *buf, gboolean allowed);
 
+/* level metering */
+GST_EXPORT
+void            gst_audio_ring_buffer_set_metering    (GstAudioRingBuffer *buf, gboolean enabled);
+
+GST_EXPORT
+gboolean        gst_audio_ring_buffer_get_channel_levels (GstAudioRingBuffer *buf, guint channel,
+                                                       gdouble *peak, gdouble *rms);
+
 #ifdef G_DEFINE_AUTOPTR_CLEANUP_FUNC
 G_DEFINE_AUTOPTR_CLEANUP_FUNC(GstAudioRingBuffer, gst_object_unref)
 #endif
@@ -67,6 +67,8 @@ struct _GstFFTF32
   void *cfg;
   gboolean inverse;
   gint len;
+  GstFFTWindow win_type;        /* window the cached coefficients were built for */
+  gfloat *win_coeffs;           /* lazily built window coefficients, or NULL */
 };
 
 /**
@@ -170,6 +172,7 @@ gst_fft_f32_inverse_fft (GstFFTF32 * self, const GstFFTF32Complex * freqdata,
 void
 gst_fft_f32_free (GstFFTF32 * self)
 {
+  g_free (self->win_coeffs);
   g_free (self);
 }
 
@@ -181,40 +184,60 @@ gst_fft_f32_free (GstFFTF32 * self)
  *
  * This calls the window function @window on the @timedata sample buffer.
  *
+ * The window coefficients are computed once on the first call for a given
+ * @window and then cached in @self, so applying the window to every buffer
+ * costs one multiplication per sample.
+ *
  */
 void
 gst_fft_f32_window (GstFFTF32 * self, gfloat * timedata, GstFFTWindow window)
 {
   gint i, len;
+  const gfloat *coeffs;
 
   g_return_if_fail (self);
   g_return_if_fail (timedata);
 
   len = self->len;
 
-  switch (window) {
-    case GST_FFT_WINDOW_RECTANGULAR:
-      /* do nothing */
-      break;
-    case GST_FFT_WINDOW_HAMMING:
-      for (i = 0; i < len; i++)
-        timedata[i] *= (0.53836 - 0.46164 * cos (2.0 * G_PI * i / len));
-      break;
-    case GST_FFT_WINDOW_HANN:
-      for (i = 0; i < len; i++)
-        timedata[i] *= (0.5 - 0.5 * cos (2.0 * G_PI * i / len));
-      break;
-    case GST_FFT_WINDOW_BARTLETT:
-      for (i = 0; i < len; i++)
-        timedata[i] *= (1.0 - fabs ((2.0 * i - len) / len));
-      break;
-    case GST_FFT_WINDOW_BLACKMAN:
-      for (i = 0; i < len; i++)
-        timedata[i] *= (0.42 - 0.5 * cos ((2.0 * i) / len) +
-            0.08 * cos ((4.0 * i) / len));
-      break;
-    default:
-      g_assert_not_reached ();
-      break;
+  if (window == GST_FFT_WINDOW_RECTANGULAR)
+    return;
+
+  /* The window coefficients only depend on @len and @window, so build them
+   * once and cache them in the instance. Spectrum-style elements call this
+   * for every frame and only pay a single multiplication per sample then,
+   * instead of evaluating cos() for every sample on every call. */
+  if (self->win_coeffs == NULL || self->win_type != window) {
+    if (self->win_coeffs == NULL)
+      self->win_coeffs = g_new (gfloat, len);
+
+    switch (window) {
+      case GST_FFT_WINDOW_HAMMING:
+        for (i = 0; i < len; i++)
+          self->win_coeffs[i] =
+              (0.53836 - 0.46164 * cos (2.0 * G_PI * i / len));
+        break;
+      case GST_FFT_WINDOW_HANN:
+        for (i = 0; i < len; i++)
+          self->win_coeffs[i] = (0.5 - 0.5 * cos (2.0 * G_PI * i / len));
+        break;
+      case GST_FFT_WINDOW_BARTLETT:
+        for (i = 0; i < len; i++)
+          self->win_coeffs[i] = (1.0 - fabs ((2.0 * i - len) / len));
+        break;
+      case GST_FFT_WINDOW_BLACKMAN:
+        for (i = 0; i < len; i++)
+          self->win_coeffs[i] = (0.42 - 0.5 * cos ((2.0 * i) / len) +
+              0.08 * cos ((4.0 * i) / len));
+        break;
+      default:
+        g_assert_not_reached ();
+        break;
+    }
+    self->win_type = window;
   }
+
+  coeffs = self->win_coeffs;
+  for (i = 0; i < len; i++)
+    timedata[i] *= coeffs[i];
 }
@@ -20,21 +20,6 @@ THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
  fixed or floating point complex numbers.  It also delares the kf_ internal functions.
  */
 
-static kiss_fft_s16_cpx *scratchbuf = NULL;
-static size_t nscratchbuf = 0;
-static kiss_fft_s16_cpx *tmpbuf = NULL;
-static size_t ntmpbuf = 0;
-
-#define CHECKBUF(buf,nbuf,n) \
-    do { \
-        if ( nbuf < (size_t)(n) ) {\
-            free(buf); \
-            buf = (kiss_fft_s16_cpx*)KISS_FFT_S16_MALLOC(sizeof(kiss_fft_s16_cpx)*(n)); \
-            nbuf = (size_t)(n); \
-        } \
-   }while(0)
-
-
 static void
 kf_bfly2 (kiss_fft_s16_cpx * Fout,
     const size_t fstride, const kiss_fft_s16_cfg st, int m)
@@ -228,8 +213,12 @@ kf_bfly_generic (kiss_fft_s16_cpx * Fout,
   kiss_fft_s16_cpx *twiddles = st->twiddles;
   kiss_fft_s16_cpx t;
   int Norig = st->nfft;
+  kiss_fft_s16_cpx *scratchbuf;
 
-  CHECKBUF (scratchbuf, nscratchbuf, p);
+  /* use a per-call scratch buffer so that transforms on different
+   * cfgs can safely run concurrently in different threads */
+  scratchbuf =
+      (kiss_fft_s16_cpx *) KISS_FFT_S16_MALLOC (sizeof (kiss_fft_s16_cpx) * p);
 
   for (u = 0; u < m; ++u) {
     k = u;
@@ -254,6 +243,8 @@ kf_bfly_generic (kiss_fft_s16_cpx * Fout,
       k += m;
     }
   }
+
+  g_free (scratchbuf);
 }
 
 static void
@@ -424,9 +415,12 @@ kiss_fft_s16_stride (kiss_fft_s16_cfg st, const kiss_fft_s16_cpx * fin,
     kiss_fft_s16_cpx * fout, int in_stride)
 {
   if (fin == fout) {
-    CHECKBUF (tmpbuf, ntmpbuf, st->nfft);
+    kiss_fft_s16_cpx *tmpbuf = (kiss_fft_s16_cpx *)
+        KISS_FFT_S16_MALLOC (sizeof (kiss_fft_s16_cpx) * st->nfft);
+
     kf_work (tmpbuf, fin, 1, in_stride, st->factors, st);
     memcpy (fout, tmpbuf, sizeof (kiss_fft_s16_cpx) * st->nfft);
+    g_free (tmpbuf);
   } else {
     kf_work (fout, fin, 1, in_stride, st->factors, st);
   }
@@ -440,18 +434,12 @@ kiss_fft_s16 (kiss_fft_s16_cfg cfg, const kiss_fft_s16_cpx * fin,
 }
 
 
-/* not really necessary to call, but if someone is doing in-place ffts, they may want to free the 
-   buffers from CHECKBUF
+/* there is no longer any global state to release; kept for source
+   compatibility with the original kiss_fft API
  */
 void
 kiss_fft_s16_cleanup (void)
 {
-  free (scratchbuf);
-  scratchbuf = NULL;
-  nscratchbuf = 0;
-  free (tmpbuf);
-  tmpbuf = NULL;
-  ntmpbuf = 0;
 }
 
 int
@@ -707,6 +707,52 @@ gst_codec_utils_h264_caps_set_level_and_profile (GstCaps * caps,
   return (level != NULL && profile != NULL);
 }
 
+/**
+ * gst_codec_utils_h264_get_profile_flags_level:
+ * @codec_data: H264 AVCC extradata
+ * @len: length of @codec_data
+ * @profile: (out) (allow-none): return location for the profile_idc, or %NULL
+ * @flags: (out) (allow-none): return location for the constraint set flags,
+ *     or %NULL
+ * @level: (out) (allow-none): return location for the level_idc, or %NULL
+ *
+ * Parses the profile indication, constraint set flags and level indication
+ * from the AVCC extradata in one pass, as typically found in the codec_data
+ * field of video/x-h264 caps (in AVC stream format). The extradata is
+ * expected to have the format defined in ISO/IEC 14496-15.
+ *
+ * Returns: %TRUE if the data could be parsed, %FALSE otherwise.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_codec_utils_h264_get_profile_flags_level (const guint8 * codec_data,
+    guint len, guint8 * profile, guint8 * flags, guint8 * level)
+{
+  g_return_val_if_fail (codec_data != NULL, FALSE);
+
+  if (len < 4) {
+    GST_WARNING ("AVC codec data is too small (%u < 4)", len);
+    return FALSE;
+  }
+
+  GST_MEMDUMP ("AVC codec data", codec_data, len);
+
+  if (codec_data[0] != 1) {
+    GST_WARNING ("Unexpected AVC codec data version %u", codec_data[0]);
+    return FALSE;
+  }
+
+  if (profile)
+    *profile = codec_data[1];
+  if (flags)
+    *flags = codec_data[2];
+  if (level)
+    *level = codec_data[3];
+
+  return TRUE;
+}
+
 /**
  * gst_codec_utils_h265_get_profile:
  * @profile_tier_level: Pointer to the profile_tier_level
@@ -850,6 +850,33 @@ format_info_get_desc (const FormatInfo * info, const GstCaps * caps)
   return NULL;
 }
 
+/* media type -> index of the first matching entry in formats[] (plus one,
+ * so that a failed lookup yields 0). Built once on first use, so lookups
+ * don't have to strcmp their way through the whole table every time.
+ * Records sharing a media type (the systemstream variants) must be
+ * adjacent in the table for this to find them all. */
+static GHashTable *format_info_index;   /* no lock needed, insert-once */
+
+static void
+ensure_format_info_index (void)
+{
+  static gsize once = 0;
+
+  if (g_once_init_enter (&once)) {
+    GHashTable *index;
+    guint i;
+
+    index = g_hash_table_new (g_str_hash, g_str_equal);
+    /* walk backwards so the entry stored for a type is the first one */
+    for (i = G_N_ELEMENTS (formats); i > 0; --i) {
+      g_hash_table_insert (index, (gpointer) formats[i - 1].type,
+          GUINT_TO_POINTER (i));
+    }
+    format_info_index = index;
+    g_once_init_leave (&once, 1);
+  }
+}
+
 /* returns format info structure, will return NULL for dynamic media types! */
 static const FormatInfo *
 find_format_info (const GstCaps * caps)
@@ -858,20 +885,25 @@ find_format_info (const GstCaps * caps)
   const gchar *media_type;
   guint i;
 
+  ensure_format_info_index ();
+
   s = gst_caps_get_structure (caps, 0);
   media_type = gst_structure_get_name (s);
 
-  for (i = 0; i < G_N_ELEMENTS (formats); ++i) {
-    if (strcmp (media_type, formats[i].type) == 0) {
-      gboolean is_sys = FALSE;
+  i = GPOINTER_TO_UINT (g_hash_table_lookup (format_info_index, media_type));
+  if (i == 0)
+    return NULL;
 
-      if ((formats[i].flags & FLAG_SYSTEMSTREAM) == 0)
-        return &formats[i];
+  for (--i; i < G_N_ELEMENTS (formats)
+      && strcmp (media_type, formats[i].type) == 0; ++i) {
+    gboolean is_sys = FALSE;
 
-      /* this record should only be matched if the systemstream field is set */
-      if (gst_structure_get_boolean (s, "systemstream", &is_sys) && is_sys)
-        return &formats[i];
-    }
+    if ((formats[i].flags & FLAG_SYSTEMSTREAM) == 0)
+      return &formats[i];
+
+    /* this record should only be matched if the systemstream field is set */
+    if (gst_structure_get_boolean (s, "systemstream", &is_sys) && is_sys)
+      return &formats[i];
   }
 
   return NULL;
@@ -615,8 +615,11 @@ gst_audio_visualizer_set_property (GObject * object, guint prop_id,
 
   switch (prop_id) {
     case PROP_SHADER:
+      /* the chain function snapshots the shader under the config lock */
+      g_mutex_lock (&scope->priv->config_lock);
       scope->priv->shader_type = g_value_get_enum (value);
       gst_audio_visualizer_change_shader (scope);
+      g_mutex_unlock (&scope->priv->config_lock);
       break;
     case PROP_SHADE_AMOUNT:
       scope->priv->shade_amount = g_value_get_uint (value);
@@ -1082,6 +1085,7 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
   while (avail >= sbpf) {
     GstBuffer *outbuf;
     GstVideoFrame outframe;
+    GstAudioVisualizerShaderFunc shader;
 
     /* get timestamp of the current adapter content */
     ts = gst_adapter_prev_pts (scope->priv->adapter, &dist);
@@ -1132,6 +1136,11 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
 
     g_mutex_unlock (&scope->priv->config_lock);
     ret = default_prepare_output_buffer (scope, &outbuf);
+
+    /* sync controlled properties */
+    if (GST_CLOCK_TIME_IS_VALID (ts))
+      gst_object_sync_values (GST_OBJECT (scope), ts);
+
     g_mutex_lock (&scope->priv->config_lock);
     /* recheck as the value could have changed */
     sbpf = scope->req_spf * bpf;
@@ -1140,10 +1149,6 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
     if (ret != GST_FLOW_OK)
       break;
 
-    /* sync controlled properties */
-    if (GST_CLOCK_TIME_IS_VALID (ts))
-      gst_object_sync_values (GST_OBJECT (scope), ts);
-
     GST_BUFFER_PTS (outbuf) = ts;
     GST_BUFFER_DURATION (outbuf) = scope->priv->frame_duration;
 
@@ -1151,9 +1156,16 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
     if (!(adata = (gpointer) gst_adapter_map (scope->priv->adapter, sbpf)))
       break;
 
+    /* take a consistent snapshot of the shader for this frame, then render
+     * without the config lock held so that property changes don't have to
+     * wait for a whole frame to be drawn. The adapter data, tempframe and
+     * the video info are only ever touched from this streaming thread. */
+    shader = scope->priv->shader;
+    g_mutex_unlock (&scope->priv->config_lock);
+
     gst_video_frame_map (&outframe, &scope->vinfo, outbuf, GST_MAP_READWRITE);
 
-    if (scope->priv->shader) {
+    if (shader) {
       gst_video_frame_copy (&outframe, &scope->priv->tempframe);
     } else {
       /* gst_video_frame_clear() or is output frame already cleared */
@@ -1177,15 +1189,13 @@ gst_audio_visualizer_chain (GstPad * pad, GstObject * parent,
       } else {
         /* run various post processing (shading and geometric transformation) */
         /* FIXME: SHADER assumes 32bpp */
-        if (scope->priv->shader &&
-            GST_VIDEO_INFO_COMP_PSTRIDE (&scope->vinfo, 0) == 4) {
-          scope->priv->shader (scope, &outframe, &scope->priv->tempframe);
+        if (shader && GST_VIDEO_INFO_COMP_PSTRIDE (&scope->vinfo, 0) == 4) {
+          shader (scope, &outframe, &scope->priv->tempframe);
         }
       }
     }
     gst_video_frame_unmap (&outframe);
 
-    g_mutex_unlock (&scope->priv->config_lock);
     ret = gst_pad_push (scope->priv->srcpad, outbuf);
     outbuf = NULL;
     g_mutex_lock (&scope->priv->config_lock);
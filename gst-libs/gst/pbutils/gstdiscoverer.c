@@ -114,8 +114,20 @@ struct _GstDiscovererPrivate
   GstElement *uridecodebin;
   GstBus *bus;
 
+  /* TRUE if discovery should stop at the parser level without decoding */
+  gboolean parse_only;
+  /* the default caps of uridecodebin, to restore when parse-only is unset */
+  GstCaps *default_caps;
+
   GType decodebin_type;
 
+  /* Parallel discovery (only used in async mode when n-parallel > 1).
+   * URIs stay queued in pending_uris and are handed out to internal
+   * worker discoverers as they become idle. */
+  guint n_parallel;
+  GPtrArray *workers;
+  GList *idle_workers;
+
   /* Custom main context variables */
   GMainContext *ctx;
   guint sourceid;
@@ -163,18 +175,44 @@ enum
 };
 
 #define DEFAULT_PROP_TIMEOUT 15 * GST_SECOND
+#define DEFAULT_PROP_N_PARALLEL 1
+#define DEFAULT_PROP_PARSE_ONLY FALSE
 
 enum
 {
   PROP_0,
-  PROP_TIMEOUT
+  PROP_TIMEOUT,
+  PROP_N_PARALLEL,
+  PROP_PARSE_ONLY
 };
 
+/* Caps on which decoding stops in parse-only mode: the raw formats
+ * uridecodebin stops on by default, plus the output of the common parsers,
+ * so streams are still demuxed and parsed but no decoder is ever plugged
+ * and no decoded data needs to preroll. */
+static GstStaticCaps parse_only_caps =
+GST_STATIC_CAPS ("video/x-raw(ANY); audio/x-raw(ANY); text/x-raw(ANY); "
+    "subpicture/x-dvd; subpicture/x-pgs; "
+    "video/x-h264, parsed=(boolean)true; "
+    "video/x-h265, parsed=(boolean)true; "
+    "video/mpeg, mpegversion=(int){ 1, 2, 4 }, parsed=(boolean)true; "
+    "video/x-vp8; video/x-vp9; video/x-theora; "
+    "audio/mpeg, mpegversion=(int)1, parsed=(boolean)true; "
+    "audio/mpeg, mpegversion=(int){ 2, 4 }, framed=(boolean)true; "
+    "audio/x-ac3, framed=(boolean)true; "
+    "audio/x-eac3, framed=(boolean)true; "
+    "audio/x-dts, framed=(boolean)true; "
+    "audio/x-flac, framed=(boolean)true; "
+    "audio/x-vorbis; audio/x-opus");
+
 static guint gst_discoverer_signals[LAST_SIGNAL] = { 0 };
 
 static void gst_discoverer_set_timeout (GstDiscoverer * dc,
     GstClockTime timeout);
+static void gst_discoverer_set_parse_only (GstDiscoverer * dc,
+    gboolean parse_only);
 static gboolean async_timeout_cb (GstDiscoverer * dc);
+static void discoverer_dispatch_pending (GstDiscoverer * dc);
 
 static void discoverer_bus_cb (GstBus * bus, GstMessage * msg,
     GstDiscoverer * dc);
@@ -220,6 +258,50 @@ gst_discoverer_class_init (GstDiscovererClass * klass)
           GST_SECOND, 3600 * GST_SECOND, DEFAULT_PROP_TIMEOUT,
           G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDiscoverer:n-parallel:
+   *
+   * The number of discovery pipelines to use in asynchronous mode.
+   *
+   * With the default of 1 the pending URIs are discovered one at a time on
+   * a single internal pipeline, as before. With a higher value the pending
+   * URIs are distributed over that many internal pipelines, so prerolling
+   * of several files can overlap and discovery of large collections scales
+   * with the number of available CPU cores.
+   *
+   * Changing this property has no effect while gst_discoverer_start() is
+   * in effect, and it is ignored in synchronous mode.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_N_PARALLEL,
+      g_param_spec_uint ("n-parallel", "n-parallel",
+          "Number of parallel discovery pipelines in async mode",
+          1, 64, DEFAULT_PROP_N_PARALLEL,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstDiscoverer:parse-only:
+   *
+   * Whether discovery should stop at the parser level instead of plugging
+   * decoders and prerolling decoded data.
+   *
+   * When enabled, the output of the common parsers is considered final, so
+   * a discovery only demuxes the container and parses the stream headers:
+   * codec caps, duration, resolution, sample rate and most tags are still
+   * reported, but information that requires decoded data (such as the bit
+   * depth of decoded audio) is not, and typically far less of the file
+   * needs to be read. This is useful for quickly scanning large
+   * collections where container/codec level information is sufficient.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_PARSE_ONLY,
+      g_param_spec_boolean ("parse-only", "parse-only",
+          "Stop discovery at the parser level without decoding",
+          DEFAULT_PROP_PARSE_ONLY,
+          G_PARAM_READWRITE | G_PARAM_CONSTRUCT | G_PARAM_STATIC_STRINGS));
+
   /* signals */
   /**
    * GstDiscoverer::finished:
@@ -306,6 +388,7 @@ gst_discoverer_init (GstDiscoverer * dc)
       GstDiscovererPrivate);
 
   dc->priv->timeout = DEFAULT_PROP_TIMEOUT;
+  dc->priv->n_parallel = DEFAULT_PROP_N_PARALLEL;
   dc->priv->async = FALSE;
   dc->priv->async_done = FALSE;
 
@@ -325,6 +408,9 @@ gst_discoverer_init (GstDiscoverer * dc)
   GST_LOG_OBJECT (dc, "Adding uridecodebin to pipeline");
   gst_bin_add (dc->priv->pipeline, dc->priv->uridecodebin);
 
+  /* keep the default caps around so parse-only can be unset again */
+  g_object_get (dc->priv->uridecodebin, "caps", &dc->priv->default_caps, NULL);
+
   dc->priv->pad_added_id =
       g_signal_connect_object (dc->priv->uridecodebin, "pad-added",
       G_CALLBACK (uridecodebin_pad_added_cb), dc, 0);
@@ -408,11 +494,23 @@ gst_discoverer_dispose (GObject * obj)
 
   gst_discoverer_stop (dc);
 
+  if (dc->priv->workers) {
+    g_ptr_array_unref (dc->priv->workers);
+    dc->priv->workers = NULL;
+    g_list_free (dc->priv->idle_workers);
+    dc->priv->idle_workers = NULL;
+  }
+
   if (dc->priv->seeking_query) {
     gst_query_unref (dc->priv->seeking_query);
     dc->priv->seeking_query = NULL;
   }
 
+  if (dc->priv->default_caps) {
+    gst_caps_unref (dc->priv->default_caps);
+    dc->priv->default_caps = NULL;
+  }
+
   G_OBJECT_CLASS (gst_discoverer_parent_class)->dispose (obj);
 }
 
@@ -436,6 +534,14 @@ gst_discoverer_set_property (GObject * object, guint prop_id,
     case PROP_TIMEOUT:
       gst_discoverer_set_timeout (dc, g_value_get_uint64 (value));
       break;
+    case PROP_N_PARALLEL:
+      DISCO_LOCK (dc);
+      dc->priv->n_parallel = g_value_get_uint (value);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_PARSE_ONLY:
+      gst_discoverer_set_parse_only (dc, g_value_get_boolean (value));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -454,6 +560,16 @@ gst_discoverer_get_property (GObject * object, guint prop_id,
       g_value_set_uint64 (value, dc->priv->timeout);
       DISCO_UNLOCK (dc);
       break;
+    case PROP_N_PARALLEL:
+      DISCO_LOCK (dc);
+      g_value_set_uint (value, dc->priv->n_parallel);
+      DISCO_UNLOCK (dc);
+      break;
+    case PROP_PARSE_ONLY:
+      DISCO_LOCK (dc);
+      g_value_set_boolean (value, dc->priv->parse_only);
+      DISCO_UNLOCK (dc);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -468,6 +584,40 @@ gst_discoverer_set_timeout (GstDiscoverer * dc, GstClockTime timeout)
   /* FIXME : update current pending timeout if we're running */
   DISCO_LOCK (dc);
   dc->priv->timeout = timeout;
+  if (dc->priv->workers) {
+    guint i;
+
+    for (i = 0; i < dc->priv->workers->len; i++)
+      g_object_set (g_ptr_array_index (dc->priv->workers, i), "timeout",
+          timeout, NULL);
+  }
+  DISCO_UNLOCK (dc);
+}
+
+static void
+gst_discoverer_set_parse_only (GstDiscoverer * dc, gboolean parse_only)
+{
+  GST_DEBUG_OBJECT (dc, "parse-only : %d", parse_only);
+
+  DISCO_LOCK (dc);
+  dc->priv->parse_only = parse_only;
+  if (dc->priv->uridecodebin) {
+    GstCaps *caps;
+
+    if (parse_only)
+      caps = gst_static_caps_get (&parse_only_caps);
+    else
+      caps = gst_caps_ref (dc->priv->default_caps);
+    g_object_set (dc->priv->uridecodebin, "caps", caps, NULL);
+    gst_caps_unref (caps);
+  }
+  if (dc->priv->workers) {
+    guint i;
+
+    for (i = 0; i < dc->priv->workers->len; i++)
+      g_object_set (g_ptr_array_index (dc->priv->workers, i), "parse-only",
+          parse_only, NULL);
+  }
   DISCO_UNLOCK (dc);
 }
 
@@ -1742,6 +1892,98 @@ beach:
   return res;
 }
 
+/* Parallel discovery.
+ *
+ * When n-parallel > 1 the discoverer does not run its own pipeline in
+ * async mode. Instead it creates that many internal worker discoverers
+ * (each with the default n-parallel of 1), keeps the URI queue for
+ * itself and hands a URI to each worker as the worker becomes idle.
+ * The discovered and source-setup signals of the workers are forwarded
+ * on the parent discoverer. */
+
+static void
+worker_discovered_cb (GstDiscoverer * worker, GstDiscovererInfo * info,
+    GError * err, GstDiscoverer * dc)
+{
+  g_signal_emit (dc, gst_discoverer_signals[SIGNAL_DISCOVERED], 0, info, err);
+}
+
+static void
+worker_source_setup_cb (GstDiscoverer * worker, GstElement * source,
+    GstDiscoverer * dc)
+{
+  g_signal_emit (dc, gst_discoverer_signals[SIGNAL_SOURCE_SETUP], 0, source);
+}
+
+static void
+worker_finished_cb (GstDiscoverer * worker, GstDiscoverer * dc)
+{
+  gboolean finished;
+
+  DISCO_LOCK (dc);
+  dc->priv->idle_workers = g_list_append (dc->priv->idle_workers, worker);
+  finished = dc->priv->running && dc->priv->pending_uris == NULL &&
+      g_list_length (dc->priv->idle_workers) == dc->priv->workers->len;
+  DISCO_UNLOCK (dc);
+
+  if (finished) {
+    GST_DEBUG_OBJECT (dc, "All workers idle and no pending URIs, done");
+    g_signal_emit (dc, gst_discoverer_signals[SIGNAL_FINISHED], 0);
+  } else
+    discoverer_dispatch_pending (dc);
+}
+
+/* Hands pending URIs to idle workers. The lock is released around each
+ * dispatch since setting up a worker can emit source-setup synchronously,
+ * and the forwarded signal handlers may call back into the discoverer. */
+static void
+discoverer_dispatch_pending (GstDiscoverer * dc)
+{
+  DISCO_LOCK (dc);
+  while (dc->priv->idle_workers != NULL && dc->priv->pending_uris != NULL) {
+    GstDiscoverer *worker = (GstDiscoverer *) dc->priv->idle_workers->data;
+    gchar *uri = (gchar *) dc->priv->pending_uris->data;
+
+    dc->priv->idle_workers =
+        g_list_delete_link (dc->priv->idle_workers, dc->priv->idle_workers);
+    dc->priv->pending_uris =
+        g_list_delete_link (dc->priv->pending_uris, dc->priv->pending_uris);
+    DISCO_UNLOCK (dc);
+
+    GST_DEBUG_OBJECT (dc, "Dispatching %s to worker %p", uri, worker);
+    gst_discoverer_discover_uri_async (worker, uri);
+    g_free (uri);
+
+    DISCO_LOCK (dc);
+  }
+  DISCO_UNLOCK (dc);
+}
+
+static void
+discoverer_create_workers (GstDiscoverer * dc)
+{
+  guint i;
+
+  GST_DEBUG_OBJECT (dc, "Creating %u workers", dc->priv->n_parallel);
+
+  dc->priv->workers = g_ptr_array_new_with_free_func (g_object_unref);
+  for (i = 0; i < dc->priv->n_parallel; i++) {
+    GstDiscoverer *worker = gst_discoverer_new (dc->priv->timeout, NULL);
+
+    if (G_UNLIKELY (worker == NULL))
+      continue;
+    g_object_set (worker, "parse-only", dc->priv->parse_only, NULL);
+    g_signal_connect_object (worker, "discovered",
+        G_CALLBACK (worker_discovered_cb), dc, 0);
+    g_signal_connect_object (worker, "source-setup",
+        G_CALLBACK (worker_source_setup_cb), dc, 0);
+    g_signal_connect_object (worker, "finished",
+        G_CALLBACK (worker_finished_cb), dc, 0);
+    g_ptr_array_add (dc->priv->workers, worker);
+    dc->priv->idle_workers = g_list_append (dc->priv->idle_workers, worker);
+  }
+}
+
 /* Serializing code */
 
 static GVariant *
@@ -2079,6 +2321,23 @@ gst_discoverer_start (GstDiscoverer * discoverer)
   discoverer->priv->async = TRUE;
   discoverer->priv->running = TRUE;
 
+  if (discoverer->priv->n_parallel > 1) {
+    guint i;
+
+    if (discoverer->priv->workers == NULL)
+      discoverer_create_workers (discoverer);
+
+    for (i = 0; i < discoverer->priv->workers->len; i++)
+      gst_discoverer_start ((GstDiscoverer *)
+          g_ptr_array_index (discoverer->priv->workers, i));
+
+    g_signal_emit (discoverer, gst_discoverer_signals[SIGNAL_STARTING], 0);
+    discoverer_dispatch_pending (discoverer);
+    GST_DEBUG_OBJECT (discoverer, "Started with %u workers",
+        discoverer->priv->workers->len);
+    return;
+  }
+
   ctx = g_main_context_get_thread_default ();
 
   /* Connect to bus signals */
@@ -2130,6 +2389,21 @@ gst_discoverer_stop (GstDiscoverer * discoverer)
   discoverer->priv->running = FALSE;
   DISCO_UNLOCK (discoverer);
 
+  if (discoverer->priv->workers) {
+    guint i;
+
+    for (i = 0; i < discoverer->priv->workers->len; i++)
+      gst_discoverer_stop ((GstDiscoverer *)
+          g_ptr_array_index (discoverer->priv->workers, i));
+
+    /* drop the pool so the next start() creates one matching whatever
+     * n-parallel is by then */
+    g_list_free (discoverer->priv->idle_workers);
+    discoverer->priv->idle_workers = NULL;
+    g_ptr_array_unref (discoverer->priv->workers);
+    discoverer->priv->workers = NULL;
+  }
+
   /* Remove timeout handler */
   if (discoverer->priv->timeoutid) {
     g_source_remove (discoverer->priv->timeoutid);
@@ -2181,6 +2455,11 @@ gst_discoverer_discover_uri_async (GstDiscoverer * discoverer,
   can_run = (discoverer->priv->pending_uris == NULL);
   discoverer->priv->pending_uris =
       g_list_append (discoverer->priv->pending_uris, g_strdup (uri));
+  if (discoverer->priv->async && discoverer->priv->workers != NULL) {
+    DISCO_UNLOCK (discoverer);
+    discoverer_dispatch_pending (discoverer);
+    return TRUE;
+  }
   DISCO_UNLOCK (discoverer);
 
   if (can_run)
@@ -2294,6 +2573,17 @@ gst_discoverer_new (GstClockTime timeout, GError ** err)
  * Note that any #GstToc (s) that might have been discovered will not be serialized
  * for now.
  *
+ * For caching large media libraries, note that the serialized form of a
+ * #GVariant is usable directly from memory-mapped storage: store the
+ * returned variants in an array ("av") variant, write its serialized data
+ * to disk with g_variant_get_data(), and load it later with
+ * g_mapped_file_new(), g_mapped_file_get_bytes() and
+ * g_variant_new_from_bytes(). Indexing the array with
+ * g_variant_get_child_value() only touches the pages holding the
+ * requested entry, so the cost of opening such a cache is independent of
+ * the library size; pass each entry to
+ * gst_discoverer_info_from_variant() to materialize it on demand.
+ *
  * Returns: (transfer full): A newly-allocated #GVariant representing @info.
  *
  * Since: 1.6
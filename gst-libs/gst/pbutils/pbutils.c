@@ -50,6 +50,17 @@
  * Before using any of its functions, applications and plugins must call
  * gst_pb_utils_init() to initialise the library.
  *
+ * ## Measuring pipeline latency
+ *
+ * This library deliberately does not provide pipeline instrumentation
+ * API. Per-element latency, throughput and scheduling measurements are
+ * the job of the tracer subsystem in GStreamer core, which hooks pads
+ * process-wide without touching the elements: run a pipeline with e.g.
+ * GST_TRACERS="latency;stats" GST_DEBUG="GST_TRACER:7" and post-process
+ * the structured tracer log, or load a custom #GstTracer for live
+ * export to an external monitoring system. Hand-rolled pad probes are
+ * only worth the trouble for one-off experiments on single pads.
+ *
  */
 
 #ifdef HAVE_CONFIG_H
@@ -1850,6 +1850,13 @@ gst_riff_create_iavs_caps (guint32 codec_fcc,
 
 /*
  * Functions below are for template caps. All is variable.
+ *
+ * The caps built here are identical on every call, so we build them once
+ * and hand out refs to the shared result. Callers that want to modify them
+ * have to go through gst_caps_make_writable() anyway, which will copy as
+ * long as we keep our ref. Note that this does not apply to the
+ * per-stream gst_riff_create_*_caps() above: those return caps with a
+ * refcount of 1 that callers fill in further, so they must stay fresh.
  */
 
 GstCaps *
@@ -1939,17 +1946,23 @@ gst_riff_create_video_template_caps (void)
     GST_MAKE_FOURCC ('r', '2', '1', '0'),
     /* FILL ME */
   };
-  guint i;
-  GstCaps *caps, *one;
-
-  caps = gst_caps_new_empty ();
-  for (i = 0; i < G_N_ELEMENTS (tags); i++) {
-    one = gst_riff_create_video_caps (tags[i], NULL, NULL, NULL, NULL, NULL);
-    if (one)
-      gst_caps_append (caps, one);
+  static GstCaps *templ_caps = NULL;
+
+  if (g_once_init_enter (&templ_caps)) {
+    GstCaps *caps, *one;
+    guint i;
+
+    caps = gst_caps_new_empty ();
+    for (i = 0; i < G_N_ELEMENTS (tags); i++) {
+      one = gst_riff_create_video_caps (tags[i], NULL, NULL, NULL, NULL, NULL);
+      if (one)
+        gst_caps_append (caps, one);
+    }
+    GST_MINI_OBJECT_FLAG_SET (caps, GST_MINI_OBJECT_FLAG_MAY_BE_LEAKED);
+    g_once_init_leave (&templ_caps, caps);
   }
 
-  return caps;
+  return gst_caps_ref (templ_caps);
 }
 
 GstCaps *
@@ -1984,21 +1997,27 @@ gst_riff_create_audio_template_caps (void)
     GST_RIFF_WAVE_FORMAT_SIREN,
     /* FILL ME */
   };
-  guint i;
-  GstCaps *caps, *one;
-
-  caps = gst_caps_new_empty ();
-  for (i = 0; i < G_N_ELEMENTS (tags); i++) {
-    one =
-        gst_riff_create_audio_caps (tags[i], NULL, NULL, NULL, NULL, NULL,
-        NULL);
-    if (one)
-      gst_caps_append (caps, one);
+  static GstCaps *templ_caps = NULL;
+
+  if (g_once_init_enter (&templ_caps)) {
+    GstCaps *caps, *one;
+    guint i;
+
+    caps = gst_caps_new_empty ();
+    for (i = 0; i < G_N_ELEMENTS (tags); i++) {
+      one =
+          gst_riff_create_audio_caps (tags[i], NULL, NULL, NULL, NULL, NULL,
+          NULL);
+      if (one)
+        gst_caps_append (caps, one);
+    }
+    one = gst_caps_new_empty_simple ("application/x-ogg-avi");
+    gst_caps_append (caps, one);
+    GST_MINI_OBJECT_FLAG_SET (caps, GST_MINI_OBJECT_FLAG_MAY_BE_LEAKED);
+    g_once_init_leave (&templ_caps, caps);
   }
-  one = gst_caps_new_empty_simple ("application/x-ogg-avi");
-  gst_caps_append (caps, one);
 
-  return caps;
+  return gst_caps_ref (templ_caps);
 }
 
 GstCaps *
@@ -2008,15 +2027,21 @@ gst_riff_create_iavs_template_caps (void)
     GST_MAKE_FOURCC ('D', 'V', 'S', 'D')
         /* FILL ME */
   };
-  guint i;
-  GstCaps *caps, *one;
-
-  caps = gst_caps_new_empty ();
-  for (i = 0; i < G_N_ELEMENTS (tags); i++) {
-    one = gst_riff_create_iavs_caps (tags[i], NULL, NULL, NULL, NULL, NULL);
-    if (one)
-      gst_caps_append (caps, one);
+  static GstCaps *templ_caps = NULL;
+
+  if (g_once_init_enter (&templ_caps)) {
+    GstCaps *caps, *one;
+    guint i;
+
+    caps = gst_caps_new_empty ();
+    for (i = 0; i < G_N_ELEMENTS (tags); i++) {
+      one = gst_riff_create_iavs_caps (tags[i], NULL, NULL, NULL, NULL, NULL);
+      if (one)
+        gst_caps_append (caps, one);
+    }
+    GST_MINI_OBJECT_FLAG_SET (caps, GST_MINI_OBJECT_FLAG_MAY_BE_LEAKED);
+    g_once_init_leave (&templ_caps, caps);
   }
 
-  return caps;
+  return gst_caps_ref (templ_caps);
 }
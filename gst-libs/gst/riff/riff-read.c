@@ -203,6 +203,123 @@ bogus_size:
   }
 }
 
+/**
+ * gst_riff_parse_chunk_index:
+ * @element: caller element (used for debugging).
+ * @buf: input buffer.
+ * @offset: offset in the buffer to start scanning from.
+ *
+ * Scans all chunks in @buf from @offset in a single pass, reading only the
+ * chunk headers, and collects their location and fourcc. The returned array
+ * is sorted by chunk offset, so callers that seek repeatedly can look up
+ * chunks with gst_riff_chunk_index_find() instead of re-walking the chunk
+ * list from the start with gst_riff_parse_chunk().
+ *
+ * Returns: (transfer full) (nullable): a #GArray of #GstRiffChunkInfo, or
+ *     %NULL if no chunk could be found at @offset. Free with g_array_unref()
+ *     when no longer needed.
+ *
+ * Since: 1.14
+ */
+GArray *
+gst_riff_parse_chunk_index (GstElement * element, GstBuffer * buf,
+    guint offset)
+{
+  GArray *index;
+  GstMapInfo info;
+
+  g_return_val_if_fail (element != NULL, NULL);
+  g_return_val_if_fail (buf != NULL, NULL);
+
+  if (!gst_buffer_map (buf, &info, GST_MAP_READ)) {
+    GST_ERROR_OBJECT (element, "Failed to map buffer for reading");
+    return NULL;
+  }
+
+  index = g_array_new (FALSE, FALSE, sizeof (GstRiffChunkInfo));
+
+  while (offset + 8 <= info.size) {
+    GstRiffChunkInfo chunk;
+    guint size;
+
+    chunk.fourcc = GST_READ_UINT32_LE (info.data + offset);
+    size = GST_READ_UINT32_LE (info.data + offset + 4);
+
+    /* be paranoid: size may be nonsensical value here, such as (guint) -1 */
+    if (G_UNLIKELY (size > G_MAXINT)) {
+      GST_ERROR_OBJECT (element, "Broken file: bogus chunk size %u at "
+          "offset %u, stopping index scan", size, offset);
+      break;
+    }
+
+    /* truncated last chunk, clip to the available data like
+     * gst_riff_parse_chunk() does */
+    if (info.size < size + 8 + offset)
+      size = info.size - 8 - offset;
+
+    chunk.offset = offset;
+    chunk.size = size;
+    g_array_append_val (index, chunk);
+
+    GST_LOG_OBJECT (element, "chunk %" GST_FOURCC_FORMAT " at offset %u, "
+        "size %u", GST_FOURCC_ARGS (chunk.fourcc), chunk.offset, chunk.size);
+
+    offset += 8 + GST_ROUND_UP_2 (size);
+  }
+
+  gst_buffer_unmap (buf, &info);
+
+  GST_DEBUG_OBJECT (element, "indexed %u chunks", index->len);
+
+  if (index->len == 0) {
+    g_array_unref (index);
+    return NULL;
+  }
+
+  return index;
+}
+
+/**
+ * gst_riff_chunk_index_find:
+ * @index: chunk index from gst_riff_parse_chunk_index()
+ * @offset: offset in the scanned buffer to look up
+ * @info: (out): filled with the located chunk
+ *
+ * Binary-searches @index for the chunk that contains @offset, i.e. whose
+ * chunk header or data spans it.
+ *
+ * Returns: %TRUE if a chunk containing @offset was found.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_riff_chunk_index_find (GArray * index, guint offset,
+    GstRiffChunkInfo * info)
+{
+  gint lo, hi, mid;
+
+  g_return_val_if_fail (index != NULL, FALSE);
+  g_return_val_if_fail (info != NULL, FALSE);
+
+  lo = 0;
+  hi = index->len - 1;
+  while (lo <= hi) {
+    GstRiffChunkInfo *chunk;
+
+    mid = (lo + hi) / 2;
+    chunk = &g_array_index (index, GstRiffChunkInfo, mid);
+    if (offset < chunk->offset) {
+      hi = mid - 1;
+    } else if (offset >= chunk->offset + 8 + GST_ROUND_UP_2 (chunk->size)) {
+      lo = mid + 1;
+    } else {
+      *info = *chunk;
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
 /**
  * gst_riff_parse_file_header:
  * @element: caller element (used for debugging/error).
@@ -54,6 +54,32 @@ gboolean gst_riff_parse_chunk       (GstElement * element,
                                      guint32    * fourcc,
                                      GstBuffer ** chunk_data);
 
+/**
+ * GstRiffChunkInfo:
+ * @fourcc: fourcc of the chunk
+ * @offset: offset of the chunk header in the scanned buffer
+ * @size: size of the chunk data, as stated in the chunk header
+ *
+ * Location of a single chunk found by gst_riff_parse_chunk_index().
+ *
+ * Since: 1.14
+ */
+typedef struct {
+  guint32 fourcc;
+  guint   offset;
+  guint   size;
+} GstRiffChunkInfo;
+
+GST_EXPORT
+GArray * gst_riff_parse_chunk_index (GstElement * element,
+                                     GstBuffer  * buf,
+                                     guint        offset);
+
+GST_EXPORT
+gboolean gst_riff_chunk_index_find  (GArray           * index,
+                                     guint              offset,
+                                     GstRiffChunkInfo * info);
+
 GST_EXPORT
 gboolean gst_riff_parse_file_header (GstElement * element,
                                      GstBuffer  * buf,
@@ -488,20 +488,10 @@ end:
   }
 }
 
-/**
- * gst_rtcp_buffer_add_packet:
- * @rtcp: a valid RTCP buffer
- * @type: the #GstRTCPType of the new packet
- * @packet: pointer to new packet
- *
- * Add a new packet of @type to @rtcp. @packet will point to the newly created
- * packet.
- *
- * Returns: %TRUE if the packet could be created. This function returns %FALSE
- * if the max mtu is exceeded for the buffer.
- */
-gboolean
-gst_rtcp_buffer_add_packet (GstRTCPBuffer * rtcp, GstRTCPType type,
+/* writes a new packet header of @type at packet->offset, which must be
+ * the first free offset in the buffer */
+static gboolean
+gst_rtcp_buffer_add_packet_at (GstRTCPBuffer * rtcp, GstRTCPType type,
     GstRTCPPacket * packet)
 {
   guint len;
@@ -509,16 +499,6 @@ gst_rtcp_buffer_add_packet (GstRTCPBuffer * rtcp, GstRTCPType type,
   guint8 *data;
   gboolean result;
 
-  g_return_val_if_fail (rtcp != NULL, FALSE);
-  g_return_val_if_fail (GST_IS_BUFFER (rtcp->buffer), FALSE);
-  g_return_val_if_fail (type != GST_RTCP_TYPE_INVALID, FALSE);
-  g_return_val_if_fail (packet != NULL, FALSE);
-  g_return_val_if_fail (rtcp->map.flags & GST_MAP_WRITE, FALSE);
-
-  /* find free space */
-  if (gst_rtcp_buffer_get_first_packet (rtcp, packet))
-    while (gst_rtcp_packet_move_to_next (packet));
-
   maxsize = rtcp->map.maxsize;
 
   /* packet->offset is now pointing to the next free offset in the buffer to
@@ -581,6 +561,74 @@ no_space:
   }
 }
 
+/**
+ * gst_rtcp_buffer_add_packet:
+ * @rtcp: a valid RTCP buffer
+ * @type: the #GstRTCPType of the new packet
+ * @packet: pointer to new packet
+ *
+ * Add a new packet of @type to @rtcp. @packet will point to the newly created
+ * packet.
+ *
+ * Returns: %TRUE if the packet could be created. This function returns %FALSE
+ * if the max mtu is exceeded for the buffer.
+ */
+gboolean
+gst_rtcp_buffer_add_packet (GstRTCPBuffer * rtcp, GstRTCPType type,
+    GstRTCPPacket * packet)
+{
+  g_return_val_if_fail (rtcp != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (rtcp->buffer), FALSE);
+  g_return_val_if_fail (type != GST_RTCP_TYPE_INVALID, FALSE);
+  g_return_val_if_fail (packet != NULL, FALSE);
+  g_return_val_if_fail (rtcp->map.flags & GST_MAP_WRITE, FALSE);
+
+  /* find free space */
+  if (gst_rtcp_buffer_get_first_packet (rtcp, packet))
+    while (gst_rtcp_packet_move_to_next (packet));
+
+  return gst_rtcp_buffer_add_packet_at (rtcp, type, packet);
+}
+
+/**
+ * gst_rtcp_buffer_append_packet:
+ * @rtcp: a valid RTCP buffer
+ * @type: the #GstRTCPType of the new packet
+ * @packet: pointer to the last packet of @rtcp
+ *
+ * Add a new packet of @type to @rtcp, like gst_rtcp_buffer_add_packet(),
+ * but continue from @packet, which must point to a valid packet of @rtcp,
+ * typically the one added last.  @packet will point to the newly created
+ * packet.
+ *
+ * Whereas gst_rtcp_buffer_add_packet() walks all packet headers from the
+ * start of the buffer to find free space, this function only skips the
+ * packets from @packet onwards, so building a large compound packet stays
+ * linear in the number of packets.
+ *
+ * Returns: %TRUE if the packet could be created. This function returns %FALSE
+ * if the max mtu is exceeded for the buffer.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_rtcp_buffer_append_packet (GstRTCPBuffer * rtcp, GstRTCPType type,
+    GstRTCPPacket * packet)
+{
+  g_return_val_if_fail (rtcp != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (rtcp->buffer), FALSE);
+  g_return_val_if_fail (type != GST_RTCP_TYPE_INVALID, FALSE);
+  g_return_val_if_fail (packet != NULL, FALSE);
+  g_return_val_if_fail (packet->rtcp == rtcp, FALSE);
+  g_return_val_if_fail (packet->type != GST_RTCP_TYPE_INVALID, FALSE);
+  g_return_val_if_fail (rtcp->map.flags & GST_MAP_WRITE, FALSE);
+
+  /* find free space from the current position */
+  while (gst_rtcp_packet_move_to_next (packet));
+
+  return gst_rtcp_buffer_add_packet_at (rtcp, type, packet);
+}
+
 /**
  * gst_rtcp_packet_remove:
  * @packet: a #GstRTCPPacket
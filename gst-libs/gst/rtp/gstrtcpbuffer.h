@@ -265,6 +265,10 @@ GST_EXPORT
 gboolean        gst_rtcp_buffer_add_packet        (GstRTCPBuffer *rtcp, GstRTCPType type,
                                                    GstRTCPPacket *packet);
 
+GST_EXPORT
+gboolean        gst_rtcp_buffer_append_packet     (GstRTCPBuffer *rtcp, GstRTCPType type,
+                                                   GstRTCPPacket *packet);
+
 GST_EXPORT
 gboolean        gst_rtcp_packet_remove            (GstRTCPPacket *packet);
 
@@ -26,7 +26,10 @@
  * Provides a base class for RTP depayloaders
  */
 
+#include <string.h>
+
 #include "gstrtpbasedepayload.h"
+#include "gstrtpmeta.h"
 
 GST_DEBUG_CATEGORY_STATIC (rtpbasedepayload_debug);
 #define GST_CAT_DEFAULT (rtpbasedepayload_debug)
@@ -34,6 +37,12 @@ GST_DEBUG_CATEGORY_STATIC (rtpbasedepayload_debug);
 #define GST_RTP_BASE_DEPAYLOAD_GET_PRIVATE(obj)  \
    (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_RTP_BASE_DEPAYLOAD, GstRTPBaseDepayloadPrivate))
 
+/* maximum number of packets the optional reorder stage can hold back */
+#define GST_RTP_BASE_DEPAYLOAD_MAX_REORDER 64
+
+/* maximum number of SSRCs the per-SSRC seqnum tracking can follow */
+#define GST_RTP_BASE_DEPAYLOAD_MAX_SSRC_STATES 64
+
 struct _GstRTPBaseDepayloadPrivate
 {
   GstClockTime npt_start;
@@ -56,6 +65,26 @@ struct _GstRTPBaseDepayloadPrivate
 
   GstCaps *last_caps;
   GstEvent *segment_event;
+
+  /* optional reorder stage; a fixed-size seqnum-indexed ring without
+   * timers, packets are only released when the missing ones arrive or
+   * when the window overflows */
+  guint reorder_window;
+  guint reorder_count;
+  gboolean reorder_flushing;
+  GstBuffer *reorder_pkts[GST_RTP_BASE_DEPAYLOAD_MAX_REORDER];
+  guint16 reorder_seqs[GST_RTP_BASE_DEPAYLOAD_MAX_REORDER];
+
+  /* per-SSRC seqnum tracking for bundled streams, only used when
+   * max-ssrc-states > 0 */
+  guint max_ssrc_states;
+  guint64 ssrc_tick;
+  struct
+  {
+    guint32 ssrc;
+    guint32 next_seqnum;
+    guint64 used;
+  } ssrc_states[GST_RTP_BASE_DEPAYLOAD_MAX_SSRC_STATES];
 };
 
 /* Filter signals and args */
@@ -69,9 +98,14 @@ enum
 {
   PROP_0,
   PROP_STATS,
+  PROP_REORDER_WINDOW,
+  PROP_MAX_SSRC_STATES,
   PROP_LAST
 };
 
+#define DEFAULT_REORDER_WINDOW 0
+#define DEFAULT_MAX_SSRC_STATES 0
+
 static void gst_rtp_base_depayload_finalize (GObject * object);
 static void gst_rtp_base_depayload_set_property (GObject * object,
     guint prop_id, const GValue * value, GParamSpec * pspec);
@@ -90,6 +124,9 @@ static GstStateChangeReturn gst_rtp_base_depayload_change_state (GstElement *
 
 static gboolean gst_rtp_base_depayload_packet_lost (GstRTPBaseDepayload *
     filter, GstEvent * event);
+static GstFlowReturn gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload *
+    filter, GstRTPBaseDepayloadClass * bclass, GstBuffer * in);
+static void gst_rtp_base_depayload_reorder_clear (GstRTPBaseDepayload * filter);
 static gboolean gst_rtp_base_depayload_handle_event (GstRTPBaseDepayload *
     filter, GstEvent * event);
 
@@ -167,6 +204,49 @@ gst_rtp_base_depayload_class_init (GstRTPBaseDepayloadClass * klass)
       g_param_spec_boxed ("stats", "Statistics", "Various statistics",
           GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstRTPBaseDepayload:reorder-window:
+   *
+   * Hold back at most this many out-of-order packets and release them in
+   * sequence order once the missing packets arrive or the window overflows.
+   *
+   * This is a lightweight alternative to a jitterbuffer for links with
+   * very little jitter: there are no timers, so a packet that never
+   * arrives stalls the held back packets until the window fills up.
+   * Leave this at 0 (disabled) when a jitterbuffer is upstream.
+   *
+   * Since: 1.14
+   **/
+  g_object_class_install_property (G_OBJECT_CLASS (klass), PROP_REORDER_WINDOW,
+      g_param_spec_uint ("reorder-window", "Reorder Window",
+          "Maximum number of out-of-order packets to hold back and reorder "
+          "(0 = disabled)", 0, GST_RTP_BASE_DEPAYLOAD_MAX_REORDER,
+          DEFAULT_REORDER_WINDOW, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstRTPBaseDepayload:max-ssrc-states:
+   *
+   * Track packet seqnums separately for up to this many SSRCs instead of
+   * treating every SSRC change as a sender restart. This avoids spurious
+   * DISCONT marking when multiple bundled streams of the same format are
+   * fed through one depayloader. When more SSRCs than this are active the
+   * least recently seen one is forgotten.
+   *
+   * The reorder-window is bypassed while this is active since held back
+   * packets of different SSRCs cannot be ordered against each other.
+   * Leave this at 0 (disabled) to get the classic single-stream
+   * behaviour.
+   *
+   * Since: 1.14
+   **/
+  g_object_class_install_property (G_OBJECT_CLASS (klass),
+      PROP_MAX_SSRC_STATES, g_param_spec_uint ("max-ssrc-states",
+          "Max SSRC states",
+          "Maximum number of SSRCs to track seqnum state for "
+          "(0 = treat SSRC changes as sender restarts)", 0,
+          GST_RTP_BASE_DEPAYLOAD_MAX_SSRC_STATES, DEFAULT_MAX_SSRC_STATES,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state = gst_rtp_base_depayload_change_state;
 
   klass->packet_lost = gst_rtp_base_depayload_packet_lost;
@@ -214,6 +294,8 @@ gst_rtp_base_depayload_init (GstRTPBaseDepayload * filter,
   priv->dts = -1;
   priv->pts = -1;
   priv->duration = -1;
+  priv->reorder_window = DEFAULT_REORDER_WINDOW;
+  priv->max_ssrc_states = DEFAULT_MAX_SSRC_STATES;
 
   gst_segment_init (&filter->segment, GST_FORMAT_UNDEFINED);
 }
@@ -221,6 +303,8 @@ gst_rtp_base_depayload_init (GstRTPBaseDepayload * filter,
 static void
 gst_rtp_base_depayload_finalize (GObject * object)
 {
+  gst_rtp_base_depayload_reorder_clear (GST_RTP_BASE_DEPAYLOAD (object));
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
@@ -309,6 +393,169 @@ caps_not_changed:
   }
 }
 
+/* forget all tracked SSRCs */
+static void
+gst_rtp_base_depayload_ssrc_states_clear (GstRTPBaseDepayload * filter)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+
+  memset (priv->ssrc_states, 0, sizeof (priv->ssrc_states));
+  priv->ssrc_tick = 0;
+}
+
+/* find or create the seqnum tracking slot for @ssrc and return a pointer
+ * to its next expected seqnum. The table is a small linear-scan array;
+ * bundled sessions only carry a handful of SSRCs so anything fancier is
+ * not worth it. When the table is full the least recently seen entry is
+ * recycled. */
+static guint32 *
+gst_rtp_base_depayload_ssrc_state (GstRTPBaseDepayload * filter, guint32 ssrc)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  guint i, max, lru = 0;
+
+  max = MIN (priv->max_ssrc_states, GST_RTP_BASE_DEPAYLOAD_MAX_SSRC_STATES);
+
+  priv->ssrc_tick++;
+  for (i = 0; i < max; i++) {
+    if (priv->ssrc_states[i].used != 0 && priv->ssrc_states[i].ssrc == ssrc) {
+      priv->ssrc_states[i].used = priv->ssrc_tick;
+      return &priv->ssrc_states[i].next_seqnum;
+    }
+    if (priv->ssrc_states[i].used < priv->ssrc_states[lru].used)
+      lru = i;
+  }
+  GST_LOG_OBJECT (filter, "new ssrc %u, taking state slot %u", ssrc, lru);
+  priv->ssrc_states[lru].ssrc = ssrc;
+  priv->ssrc_states[lru].used = priv->ssrc_tick;
+  priv->ssrc_states[lru].next_seqnum = -1;
+
+  return &priv->ssrc_states[lru].next_seqnum;
+}
+
+/* drop everything the reorder stage holds, without processing */
+static void
+gst_rtp_base_depayload_reorder_clear (GstRTPBaseDepayload * filter)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  guint i;
+
+  for (i = 0; i < GST_RTP_BASE_DEPAYLOAD_MAX_REORDER; i++)
+    gst_buffer_replace (&priv->reorder_pkts[i], NULL);
+  priv->reorder_count = 0;
+}
+
+/* process everything the reorder stage holds, in sequence number order,
+ * accepting the gaps of the packets that never arrived */
+static void
+gst_rtp_base_depayload_reorder_flush (GstRTPBaseDepayload * filter,
+    GstRTPBaseDepayloadClass * bclass)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  guint32 base;
+  guint i;
+
+  if (priv->reorder_count == 0)
+    return;
+
+  GST_DEBUG_OBJECT (filter, "flushing %u held back packets",
+      priv->reorder_count);
+
+  base = priv->next_seqnum;
+  priv->reorder_flushing = TRUE;
+  for (i = 1; i <= GST_RTP_BASE_DEPAYLOAD_MAX_REORDER; i++) {
+    guint idx = ((guint16) (base + i)) % GST_RTP_BASE_DEPAYLOAD_MAX_REORDER;
+    GstBuffer *buf = priv->reorder_pkts[idx];
+
+    if (priv->reorder_count == 0)
+      break;
+    if (buf == NULL)
+      continue;
+
+    priv->reorder_pkts[idx] = NULL;
+    priv->reorder_count--;
+    /* delivered best-effort, the missing packets are handled as a
+     * regular discont */
+    gst_rtp_base_depayload_handle_buffer (filter, bclass, buf);
+  }
+  priv->reorder_flushing = FALSE;
+}
+
+/* hold back a future packet until the missing ones arrive; @gap is
+ * negative and tells how far @seqnum is ahead of the expected seqnum.
+ * Returns TRUE when ownership of @in was taken, in which case @rtp was
+ * unmapped. */
+static gboolean
+gst_rtp_base_depayload_reorder_stash (GstRTPBaseDepayload * filter,
+    GstRTPBaseDepayloadClass * bclass, GstBuffer * in, GstRTPBuffer * rtp,
+    guint16 seqnum, gint gap)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  guint idx;
+
+  if (priv->reorder_window == 0 || priv->reorder_flushing)
+    return FALSE;
+
+  if ((guint) (-gap) > priv->reorder_window) {
+    /* too far ahead; release what we hold and handle this packet as a
+     * regular discont */
+    gst_rtp_base_depayload_reorder_flush (filter, bclass);
+    return FALSE;
+  }
+
+  idx = seqnum % GST_RTP_BASE_DEPAYLOAD_MAX_REORDER;
+  gst_rtp_buffer_unmap (rtp);
+
+  if (priv->reorder_pkts[idx] != NULL) {
+    if (priv->reorder_seqs[idx] == seqnum) {
+      /* duplicate of a packet we already hold */
+      GST_LOG_OBJECT (filter, "dropping duplicate of held back packet %u",
+          seqnum);
+      gst_buffer_unref (in);
+      return TRUE;
+    }
+    /* stale entry, can only happen when the window was reconfigured
+     * mid-stream */
+    gst_buffer_unref (priv->reorder_pkts[idx]);
+    priv->reorder_count--;
+  }
+
+  GST_LOG_OBJECT (filter, "holding back packet %u, expected %u", seqnum,
+      priv->next_seqnum);
+
+  priv->reorder_pkts[idx] = in;
+  priv->reorder_seqs[idx] = seqnum;
+  priv->reorder_count++;
+
+  return TRUE;
+}
+
+/* release consecutive held back packets now that the expected seqnum
+ * advanced */
+static GstFlowReturn
+gst_rtp_base_depayload_reorder_drain (GstRTPBaseDepayload * filter,
+    GstRTPBaseDepayloadClass * bclass)
+{
+  GstRTPBaseDepayloadPrivate *priv = filter->priv;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  while (ret == GST_FLOW_OK && priv->reorder_count > 0) {
+    guint idx = priv->next_seqnum % GST_RTP_BASE_DEPAYLOAD_MAX_REORDER;
+    GstBuffer *buf = priv->reorder_pkts[idx];
+
+    if (buf == NULL || priv->reorder_seqs[idx] != priv->next_seqnum)
+      break;
+
+    GST_LOG_OBJECT (filter, "releasing held back packet %u",
+        priv->reorder_seqs[idx]);
+
+    priv->reorder_pkts[idx] = NULL;
+    priv->reorder_count--;
+    ret = gst_rtp_base_depayload_handle_buffer (filter, bclass, buf);
+  }
+  return ret;
+}
+
 /* takes ownership of the input buffer */
 static GstFlowReturn
 gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
@@ -323,6 +570,7 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
   guint32 ssrc;
   guint16 seqnum;
   guint32 rtptime;
+  guint32 *next_seqnum;
   gboolean discont, buf_discont;
   gint gap;
   GstRTPBuffer rtp = { NULL };
@@ -358,25 +606,39 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
       GST_TIME_FORMAT ", dts %" GST_TIME_FORMAT, buf_discont, seqnum, rtptime,
       GST_TIME_ARGS (priv->pts), GST_TIME_ARGS (priv->dts));
 
+  /* with per-SSRC tracking enabled an SSRC change is not a restart, each
+   * SSRC is checked against its own expected seqnum */
+  if (priv->max_ssrc_states > 0)
+    next_seqnum = gst_rtp_base_depayload_ssrc_state (filter, ssrc);
+  else
+    next_seqnum = &priv->next_seqnum;
+
   /* Check seqnum. This is a very simple check that makes sure that the seqnums
    * are strictly increasing, dropping anything that is out of the ordinary. We
    * can only do this when the next_seqnum is known. */
-  if (G_LIKELY (priv->next_seqnum != -1)) {
-    if (ssrc != priv->last_ssrc) {
+  if (G_LIKELY (*next_seqnum != -1)) {
+    if (ssrc != priv->last_ssrc && priv->max_ssrc_states == 0) {
       GST_LOG_OBJECT (filter,
           "New ssrc %u (current ssrc %u), sender restarted",
           ssrc, priv->last_ssrc);
       discont = TRUE;
     } else {
-      gap = gst_rtp_buffer_compare_seqnum (seqnum, priv->next_seqnum);
+      gap = gst_rtp_buffer_compare_seqnum (seqnum, *next_seqnum);
 
       /* if we have no gap, all is fine */
       if (G_UNLIKELY (gap != 0)) {
         GST_LOG_OBJECT (filter, "got packet %u, expected %u, gap %d", seqnum,
-            priv->next_seqnum, gap);
+            *next_seqnum, gap);
         if (gap < 0) {
-          /* seqnum > next_seqnum, we are missing some packets, this is always a
-           * DISCONT. */
+          /* seqnum > next_seqnum, we are missing some packets; maybe the
+           * reorder stage wants to wait for them. The reorder ring mixes
+           * seqnums of all SSRCs, so it is bypassed when per-SSRC
+           * tracking is enabled. */
+          if (priv->max_ssrc_states == 0 &&
+              gst_rtp_base_depayload_reorder_stash (filter, bclass, in, &rtp,
+                  seqnum, gap))
+            return GST_FLOW_OK;
+          /* this is always a DISCONT. */
           GST_LOG_OBJECT (filter, "%d missing packets", gap);
           discont = TRUE;
         } else {
@@ -394,7 +656,7 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
       }
     }
   }
-  priv->next_seqnum = (seqnum + 1) & 0xffff;
+  *next_seqnum = (seqnum + 1) & 0xffff;
   priv->last_ssrc = ssrc;
 
   if (G_UNLIKELY (discont)) {
@@ -418,6 +680,11 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
     }
   }
 
+  /* attach the parsed header fields so that the subclass and downstream
+   * elements can inspect them without mapping the packet again */
+  if (gst_buffer_is_writable (in) && gst_buffer_get_rtp_meta (in) == NULL)
+    gst_buffer_add_rtp_meta (in, &rtp);
+
   /* prepare segment event if needed */
   if (filter->need_newsegment) {
     priv->segment_event = create_segment_event (filter, rtptime,
@@ -442,6 +709,11 @@ gst_rtp_base_depayload_handle_buffer (GstRTPBaseDepayload * filter,
 
   gst_buffer_unref (in);
 
+  /* the expected seqnum advanced, followup packets may already be waiting
+   * in the reorder stage */
+  if (G_UNLIKELY (priv->reorder_count > 0) && ret == GST_FLOW_OK)
+    ret = gst_rtp_base_depayload_reorder_drain (filter, bclass);
+
   return ret;
 
   /* ERRORS */
@@ -561,6 +833,13 @@ gst_rtp_base_depayload_handle_event (GstRTPBaseDepayload * filter,
       filter->need_newsegment = TRUE;
       filter->priv->next_seqnum = -1;
       gst_event_replace (&filter->priv->segment_event, NULL);
+      gst_rtp_base_depayload_reorder_clear (filter);
+      gst_rtp_base_depayload_ssrc_states_clear (filter);
+      break;
+    case GST_EVENT_EOS:
+      /* release whatever the reorder stage still holds before EOS */
+      gst_rtp_base_depayload_reorder_flush (filter,
+          GST_RTP_BASE_DEPAYLOAD_GET_CLASS (filter));
       break;
     case GST_EVENT_CAPS:
     {
@@ -871,6 +1150,7 @@ gst_rtp_base_depayload_change_state (GstElement * element,
       priv->next_seqnum = -1;
       priv->negotiated = FALSE;
       priv->discont = FALSE;
+      gst_rtp_base_depayload_ssrc_states_clear (filter);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_PLAYING:
       break;
@@ -886,6 +1166,7 @@ gst_rtp_base_depayload_change_state (GstElement * element,
     case GST_STATE_CHANGE_PAUSED_TO_READY:
       gst_caps_replace (&priv->last_caps, NULL);
       gst_event_replace (&priv->segment_event, NULL);
+      gst_rtp_base_depayload_reorder_clear (filter);
       break;
     case GST_STATE_CHANGE_READY_TO_NULL:
       break;
@@ -932,7 +1213,17 @@ static void
 gst_rtp_base_depayload_set_property (GObject * object, guint prop_id,
     const GValue * value, GParamSpec * pspec)
 {
+  GstRTPBaseDepayload *depayload;
+
+  depayload = GST_RTP_BASE_DEPAYLOAD (object);
+
   switch (prop_id) {
+    case PROP_REORDER_WINDOW:
+      depayload->priv->reorder_window = g_value_get_uint (value);
+      break;
+    case PROP_MAX_SSRC_STATES:
+      depayload->priv->max_ssrc_states = g_value_get_uint (value);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -952,6 +1243,12 @@ gst_rtp_base_depayload_get_property (GObject * object, guint prop_id,
       g_value_take_boxed (value,
           gst_rtp_base_depayload_create_stats (depayload));
       break;
+    case PROP_REORDER_WINDOW:
+      g_value_set_uint (value, depayload->priv->reorder_window);
+      break;
+    case PROP_MAX_SSRC_STATES:
+      g_value_set_uint (value, depayload->priv->max_ssrc_states);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -31,6 +31,7 @@
  */
 
 #include "gstrtpbuffer.h"
+#include "gstrtpmeta.h"
 
 #include <stdlib.h>
 #include <string.h>
@@ -145,6 +146,48 @@ gst_rtp_buffer_allocate_data (GstBuffer * buffer, guint payload_len,
   }
 }
 
+/**
+ * gst_rtp_buffer_attach_payload:
+ * @buffer: a #GstBuffer holding an RTP packet
+ * @mem: (transfer full): a #GstMemory holding payload data
+ *
+ * Append @mem to the RTP packet in @buffer as payload, before the padding
+ * block when the padding bit is set. Together with a packet created with a
+ * payload length of 0 this composes an RTP packet without copying the
+ * media data: share the memory of the source buffer, for example with
+ * gst_buffer_get_memory(), and attach it with this function.
+ * gst_rtp_buffer_map() handles such multi-memory packets and will map the
+ * payload blocks separately from the header.
+ *
+ * @buffer must be writable and must already contain an RTP header, for
+ * example from gst_rtp_buffer_new_allocate().
+ *
+ * Since: 1.14
+ */
+void
+gst_rtp_buffer_attach_payload (GstBuffer * buffer, GstMemory * mem)
+{
+  GstMapInfo map;
+  guint idx;
+
+  g_return_if_fail (GST_IS_BUFFER (buffer));
+  g_return_if_fail (gst_buffer_is_writable (buffer));
+  g_return_if_fail (mem != NULL);
+
+  idx = gst_buffer_n_memory (buffer);
+  g_return_if_fail (idx > 0);
+
+  /* the padding block, when present, must stay the last memory */
+  if (gst_buffer_map_range (buffer, 0, 1, &map, GST_MAP_READ)) {
+    if (map.size >= GST_RTP_HEADER_LEN && GST_RTP_HEADER_PADDING (map.data)
+        && idx > 1)
+      idx--;
+    gst_buffer_unmap (buffer, &map);
+  }
+
+  gst_buffer_insert_memory (buffer, idx, mem);
+}
+
 /**
  * gst_rtp_buffer_new_take_data:
  * @data: (array length=len) (transfer full) (element-type guint8):
@@ -211,6 +254,106 @@ gst_rtp_buffer_new_allocate (guint payload_len, guint8 pad_len,
   return result;
 }
 
+/* shared by all header memories carved out of one allocation */
+typedef struct
+{
+  volatile gint refcount;
+} GstRTPHeaderArena;
+
+static void
+gst_rtp_header_arena_unref (gpointer data)
+{
+  GstRTPHeaderArena *arena = data;
+
+  if (g_atomic_int_dec_and_test (&arena->refcount))
+    g_free (arena);
+}
+
+/**
+ * gst_rtp_buffer_new_allocate_list:
+ * @n_packets: the number of packets to allocate
+ * @payload_len: the length of the payload of each packet
+ * @pad_len: the amount of padding of each packet
+ * @csrc_count: the number of CSRC entries of each packet
+ *
+ * Allocate a list of @n_packets new #GstBuffers, each one able to hold an
+ * RTP packet with @csrc_count CSRCs, a payload length of @payload_len and
+ * padding of @pad_len, like gst_rtp_buffer_new_allocate() would.
+ *
+ * The RTP headers of all packets are carved out of a single allocation,
+ * which makes this considerably cheaper than allocating the packets one by
+ * one when producing large bursts of packets, e.g. for a sink that sends a
+ * whole buffer list in one system call.
+ *
+ * Returns: (transfer full): A newly allocated #GstBufferList with @n_packets
+ * buffers that can each hold an RTP packet with given parameters.
+ *
+ * Since: 1.14
+ */
+GstBufferList *
+gst_rtp_buffer_new_allocate_list (guint n_packets, guint payload_len,
+    guint8 pad_len, guint8 csrc_count)
+{
+  GstBufferList *list;
+  GstRTPHeaderArena *arena;
+  guint8 *base;
+  gsize hlen;
+  guint i;
+
+  g_return_val_if_fail (csrc_count <= 15, NULL);
+
+  list = gst_buffer_list_new_sized (n_packets);
+  if (n_packets == 0)
+    return list;
+
+  hlen = GST_RTP_HEADER_LEN + csrc_count * sizeof (guint32);
+
+  arena = g_malloc (sizeof (GstRTPHeaderArena) + n_packets * hlen);
+  arena->refcount = n_packets;
+  base = (guint8 *) (arena + 1);
+
+  /* fill in defaults in the first header, the others are copies */
+  memset (base, 0, hlen);
+  GST_RTP_HEADER_VERSION (base) = GST_RTP_VERSION;
+  if (pad_len)
+    GST_RTP_HEADER_PADDING (base) = TRUE;
+  GST_RTP_HEADER_CSRC_COUNT (base) = csrc_count;
+
+  for (i = 0; i < n_packets; i++) {
+    GstBuffer *buffer;
+    GstMemory *mem;
+    guint8 *header = base + i * hlen;
+
+    if (i > 0)
+      memcpy (header, base, hlen);
+
+    buffer = gst_buffer_new ();
+    mem = gst_memory_new_wrapped (0, header, hlen, 0, hlen, arena,
+        gst_rtp_header_arena_unref);
+    gst_buffer_append_memory (buffer, mem);
+
+    if (payload_len) {
+      mem = gst_allocator_alloc (NULL, payload_len, NULL);
+      gst_buffer_append_memory (buffer, mem);
+    }
+    if (pad_len) {
+      GstMapInfo map;
+
+      mem = gst_allocator_alloc (NULL, pad_len, NULL);
+
+      gst_memory_map (mem, &map, GST_MAP_WRITE);
+      map.data[pad_len - 1] = pad_len;
+      gst_memory_unmap (mem, &map);
+
+      gst_buffer_append_memory (buffer, mem);
+    }
+
+    gst_buffer_list_add (list, buffer);
+  }
+
+  return list;
+}
+
 /**
  * gst_rtp_buffer_new_allocate_len:
  * @packet_len: the total length of the packet
@@ -436,6 +579,15 @@ gst_rtp_buffer_map (GstBuffer * buffer, GstMapFlags flags, GstRTPBuffer * rtp)
     rtp->size[2] = 0;
   }
 
+  if ((flags & GST_MAP_WRITE) && gst_buffer_is_writable (buffer)) {
+    GstMeta *meta = gst_buffer_get_meta (buffer, GST_RTP_META_API_TYPE);
+
+    /* header fields may be rewritten through this mapping, which would
+     * leave an attached parsed-header meta stale; drop it */
+    if (meta != NULL)
+      gst_buffer_remove_meta (buffer, meta);
+  }
+
   /* rtp->state = 0; *//* unused */
 
   return TRUE;
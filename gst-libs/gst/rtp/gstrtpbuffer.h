@@ -68,6 +68,9 @@ GST_EXPORT
 void            gst_rtp_buffer_allocate_data         (GstBuffer *buffer, guint payload_len,
                                                       guint8 pad_len, guint8 csrc_count);
 
+GST_EXPORT
+void            gst_rtp_buffer_attach_payload        (GstBuffer *buffer, GstMemory *mem);
+
 GST_EXPORT
 GstBuffer*      gst_rtp_buffer_new_take_data         (gpointer data, gsize len);
 
@@ -80,6 +83,10 @@ GstBuffer*      gst_rtp_buffer_new_allocate          (guint payload_len, guint8
 GST_EXPORT
 GstBuffer*      gst_rtp_buffer_new_allocate_len      (guint packet_len, guint8 pad_len, guint8 csrc_count);
 
+GST_EXPORT
+GstBufferList*  gst_rtp_buffer_new_allocate_list     (guint n_packets, guint payload_len,
+                                                      guint8 pad_len, guint8 csrc_count);
+
 GST_EXPORT
 guint           gst_rtp_buffer_calc_header_len       (guint8 csrc_count);
 
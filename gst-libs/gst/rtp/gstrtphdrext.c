@@ -132,3 +132,103 @@ gst_rtp_hdrext_get_ntp_56 (gpointer data, guint size, guint64 * ntptime)
   }
   return TRUE;
 }
+
+/**
+ * gst_rtp_hdrext_parse_fields:
+ * @rtp: a mapped RTP packet
+ * @appbits: (out) (allow-none): the application specific bits for
+ *    two-byte form headers, 0 for the one-byte form
+ * @fields: (out caller-allocates) (array length=max_fields): an array to
+ *    fill with the extension elements
+ * @max_fields: the size of @fields
+ *
+ * Extracts all RFC 5285 header extension elements of @rtp, in both the
+ * one-byte and the two-byte form, into @fields in a single pass over the
+ * extension block. This is cheaper than calling
+ * gst_rtp_buffer_get_extension_onebyte_header() per negotiated
+ * identifier since each of those calls rescans the block; the caller can
+ * index the returned array by its negotiated identifiers directly.
+ *
+ * The data pointers in @fields reference the packet and stay valid only
+ * as long as @rtp is mapped.
+ *
+ * Returns: the number of entries filled in @fields
+ *
+ * Since: 1.14
+ */
+guint
+gst_rtp_hdrext_parse_fields (GstRTPBuffer * rtp, guint8 * appbits,
+    GstRTPHdrextField * fields, guint max_fields)
+{
+  guint16 bits;
+  guint8 *pdata;
+  guint wordlen, bytelen;
+  gboolean onebyte;
+  gulong offset = 0;
+  guint count = 0;
+
+  g_return_val_if_fail (rtp != NULL, 0);
+  g_return_val_if_fail (fields != NULL, 0);
+
+  if (appbits)
+    *appbits = 0;
+
+  if (!gst_rtp_buffer_get_extension_data (rtp, &bits, (gpointer) & pdata,
+          &wordlen))
+    return 0;
+
+  if (bits == 0xBEDE) {
+    onebyte = TRUE;
+  } else if (bits >> 4 == 0x100) {
+    onebyte = FALSE;
+    if (appbits)
+      *appbits = bits;
+  } else {
+    return 0;
+  }
+
+  bytelen = wordlen * 4;
+
+  while (count < max_fields) {
+    guint8 read_id, read_len;
+
+    if (offset + (onebyte ? 1 : 2) >= bytelen)
+      break;
+
+    if (onebyte) {
+      read_id = GST_READ_UINT8 (pdata + offset) >> 4;
+      read_len = (GST_READ_UINT8 (pdata + offset) & 0x0F) + 1;
+      offset += 1;
+
+      /* ID 0 means its padding, skip */
+      if (read_id == 0)
+        continue;
+
+      /* ID 15 is special and means we should stop parsing */
+      if (read_id == 15)
+        break;
+    } else {
+      read_id = GST_READ_UINT8 (pdata + offset);
+      offset += 1;
+
+      if (read_id == 0)
+        continue;
+
+      read_len = GST_READ_UINT8 (pdata + offset);
+      offset += 1;
+    }
+
+    /* Ignore extension headers where the size does not fit */
+    if (offset + read_len > bytelen)
+      break;
+
+    fields[count].id = read_id;
+    fields[count].size = read_len;
+    fields[count].data = pdata + offset;
+    count++;
+
+    offset += read_len;
+  }
+
+  return count;
+}
@@ -50,6 +50,39 @@ gboolean       gst_rtp_hdrext_set_ntp_56  (gpointer data, guint size, guint64 nt
 GST_EXPORT
 gboolean       gst_rtp_hdrext_get_ntp_56  (gpointer data, guint size, guint64 *ntptime);
 
+/**
+ * GST_RTP_HDREXT_MAX_FIELDS:
+ *
+ * Maximum number of header extension elements that
+ * gst_rtp_hdrext_parse_fields() extracts from one packet.
+ *
+ * Since: 1.14
+ */
+#define GST_RTP_HDREXT_MAX_FIELDS 16
+
+/**
+ * GstRTPHdrextField:
+ * @id: the extension element identifier, 1-14 for one-byte headers and
+ *    1-255 for two-byte headers
+ * @size: the number of bytes in @data
+ * @data: the extension element data, valid as long as the packet is
+ *    mapped
+ *
+ * One RFC 5285 header extension element as extracted by
+ * gst_rtp_hdrext_parse_fields().
+ *
+ * Since: 1.14
+ */
+typedef struct {
+  guint8   id;
+  guint8   size;
+  gpointer data;
+} GstRTPHdrextField;
+
+GST_EXPORT
+guint          gst_rtp_hdrext_parse_fields (GstRTPBuffer *rtp, guint8 *appbits,
+                                            GstRTPHdrextField *fields, guint max_fields);
+
 G_END_DECLS
 
 #endif /* __GST_RTPHDREXT_H__ */
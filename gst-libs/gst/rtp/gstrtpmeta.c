@@ -0,0 +1,144 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * gstrtpmeta.c: RTP buffer metadata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/**
+ * SECTION:gstrtpmeta
+ * @title: GstRTPMeta
+ * @short_description: RTP buffer metadata
+ * @see_also: #GstRTPBuffer, #GstRTPBaseDepayload
+ *
+ * The #GstRTPMeta carries the header fields of a validated RTP packet so
+ * that elements downstream of the one that parsed the packet can inspect
+ * them without mapping the buffer memory again.
+ */
+
+#include "gstrtpmeta.h"
+
+GType
+gst_rtp_meta_api_get_type (void)
+{
+  static volatile GType type = 0;
+  static const gchar *tags[] = { NULL };
+
+  if (g_once_init_enter (&type)) {
+    GType _type = gst_meta_api_type_register ("GstRTPMetaAPI", tags);
+    g_once_init_leave (&type, _type);
+  }
+  return type;
+}
+
+static gboolean
+gst_rtp_meta_transform (GstBuffer * dest, GstMeta * meta,
+    GstBuffer * buffer, GQuark type, gpointer data)
+{
+  GstRTPMeta *dmeta, *smeta;
+
+  smeta = (GstRTPMeta *) meta;
+
+  if (GST_META_TRANSFORM_IS_COPY (type)) {
+    GstMetaTransformCopy *copy = data;
+
+    /* only copy along when the whole packet is copied; the offsets are
+     * meaningless in a partial copy */
+    if (copy->region)
+      return TRUE;
+
+    dmeta = (GstRTPMeta *) gst_buffer_add_meta (dest, GST_RTP_META_INFO, NULL);
+    if (!dmeta)
+      return FALSE;
+
+    dmeta->payload_type = smeta->payload_type;
+    dmeta->seq = smeta->seq;
+    dmeta->timestamp = smeta->timestamp;
+    dmeta->ssrc = smeta->ssrc;
+    dmeta->header_len = smeta->header_len;
+    dmeta->payload_len = smeta->payload_len;
+  }
+  return TRUE;
+}
+
+static gboolean
+gst_rtp_meta_init (GstMeta * meta, gpointer params, GstBuffer * buffer)
+{
+  GstRTPMeta *rmeta = (GstRTPMeta *) meta;
+
+  rmeta->payload_type = 0;
+  rmeta->seq = 0;
+  rmeta->timestamp = 0;
+  rmeta->ssrc = 0;
+  rmeta->header_len = 0;
+  rmeta->payload_len = 0;
+
+  return TRUE;
+}
+
+const GstMetaInfo *
+gst_rtp_meta_get_info (void)
+{
+  static const GstMetaInfo *info = NULL;
+
+  if (g_once_init_enter ((GstMetaInfo **) & info)) {
+    const GstMetaInfo *meta =
+        gst_meta_register (GST_RTP_META_API_TYPE,
+        "GstRTPMeta",
+        sizeof (GstRTPMeta),
+        gst_rtp_meta_init,
+        NULL,
+        gst_rtp_meta_transform);
+    g_once_init_leave ((GstMetaInfo **) & info, (GstMetaInfo *) meta);
+  }
+  return info;
+}
+
+/**
+ * gst_buffer_add_rtp_meta:
+ * @buffer: a writable #GstBuffer
+ * @rtp: a #GstRTPBuffer mapped on @buffer
+ *
+ * Attaches a #GstRTPMeta to @buffer, filled in with the header fields of
+ * the packet mapped in @rtp.
+ *
+ * Returns: (transfer none): the #GstRTPMeta on @buffer.
+ *
+ * Since: 1.14
+ */
+GstRTPMeta *
+gst_buffer_add_rtp_meta (GstBuffer * buffer, GstRTPBuffer * rtp)
+{
+  GstRTPMeta *meta;
+
+  g_return_val_if_fail (GST_IS_BUFFER (buffer), NULL);
+  g_return_val_if_fail (rtp != NULL, NULL);
+  g_return_val_if_fail (rtp->buffer == buffer, NULL);
+
+  meta = (GstRTPMeta *) gst_buffer_add_meta (buffer, GST_RTP_META_INFO, NULL);
+  if (!meta)
+    return NULL;
+
+  meta->payload_type = gst_rtp_buffer_get_payload_type (rtp);
+  meta->seq = gst_rtp_buffer_get_seq (rtp);
+  meta->timestamp = gst_rtp_buffer_get_timestamp (rtp);
+  meta->ssrc = gst_rtp_buffer_get_ssrc (rtp);
+  meta->header_len = gst_rtp_buffer_get_header_len (rtp);
+  meta->payload_len = gst_rtp_buffer_get_payload_len (rtp);
+
+  return meta;
+}
@@ -0,0 +1,78 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * gstrtpmeta.h: RTP buffer metadata
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef __GST_RTPMETA_H__
+#define __GST_RTPMETA_H__
+
+#include <gst/gst.h>
+#include <gst/rtp/gstrtpbuffer.h>
+
+G_BEGIN_DECLS
+
+#define GST_RTP_META_API_TYPE  (gst_rtp_meta_api_get_type())
+#define GST_RTP_META_INFO  (gst_rtp_meta_get_info())
+typedef struct _GstRTPMeta GstRTPMeta;
+
+/**
+ * GstRTPMeta:
+ * @meta: parent #GstMeta
+ * @payload_type: the RTP payload type
+ * @seq: the RTP sequence number
+ * @timestamp: the RTP timestamp
+ * @ssrc: the SSRC
+ * @header_len: number of bytes of RTP header, including CSRC entries and
+ *    header extension; this is also the offset of the payload in the buffer
+ * @payload_len: number of bytes of payload, excluding padding
+ *
+ * Buffer metadata describing the already parsed header fields of a valid
+ * RTP packet. It is typically attached by #GstRTPBaseDepayload after the
+ * packet was mapped and validated, so that the header fields and payload
+ * position can be retrieved later with plain offset arithmetic, without
+ * mapping the buffer memory again.
+ *
+ * Since: 1.14
+ */
+struct _GstRTPMeta
+{
+  GstMeta meta;
+
+  guint8 payload_type;
+  guint16 seq;
+  guint32 timestamp;
+  guint32 ssrc;
+  guint header_len;
+  guint payload_len;
+};
+
+GST_EXPORT
+GType gst_rtp_meta_api_get_type (void);
+
+GST_EXPORT
+const GstMetaInfo *gst_rtp_meta_get_info (void);
+
+#define gst_buffer_get_rtp_meta(b) \
+    ((GstRTPMeta *)gst_buffer_get_meta((b),GST_RTP_META_API_TYPE))
+GST_EXPORT
+GstRTPMeta * gst_buffer_add_rtp_meta (GstBuffer * buffer, GstRTPBuffer * rtp);
+
+G_END_DECLS
+
+#endif /* __GST_RTPMETA_H__ */
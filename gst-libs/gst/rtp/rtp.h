@@ -24,6 +24,7 @@
 
 #include <gst/rtp/gstrtpdefs.h>
 #include <gst/rtp/gstrtpbuffer.h>
+#include <gst/rtp/gstrtpmeta.h>
 #include <gst/rtp/gstrtcpbuffer.h>
 #include <gst/rtp/gstrtppayloads.h>
 #include <gst/rtp/gstrtphdrext.h>
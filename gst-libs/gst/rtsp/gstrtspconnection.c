@@ -104,6 +104,9 @@ typedef enum
 
 #define TUNNELID_LEN   24
 
+/* size of the chunks we read into the read buffer */
+#define READ_BUFFER_SIZE 4096
+
 struct _GstRTSPConnection
 {
   /*< private > */
@@ -142,6 +145,12 @@ struct _GstRTSPConnection
   gchar *initial_buffer;
   gsize initial_buffer_offset;
 
+  /* read buffer, filled in chunks so that parsing the byte oriented parts
+   * of the protocol does not cost a system call per byte */
+  guint8 *read_buffer;
+  guint read_buffer_size;
+  guint read_buffer_offset;
+
   gboolean remember_session_id; /* remember the session id or not */
 
   /* Session state */
@@ -1179,16 +1188,52 @@ fill_raw_bytes (GstRTSPConnection * conn, guint8 * buffer, guint size,
       conn->initial_buffer_offset += out;
   }
 
+  /* drain data left over from the last chunked read */
+  if (size > (guint) out
+      && conn->read_buffer_offset < conn->read_buffer_size) {
+    guint left = conn->read_buffer_size - conn->read_buffer_offset;
+    guint n = MIN (left, size - (guint) out);
+
+    memcpy (&buffer[out], &conn->read_buffer[conn->read_buffer_offset], n);
+    conn->read_buffer_offset += n;
+    out += n;
+  }
+
   if (G_LIKELY (size > (guint) out)) {
     gssize r;
     gsize count = size - out;
-    if (block)
-      r = g_input_stream_read (conn->input_stream, (gchar *) & buffer[out],
-          count, conn->may_cancel ? conn->cancellable : NULL, err);
-    else
-      r = g_pollable_input_stream_read_nonblocking (G_POLLABLE_INPUT_STREAM
-          (conn->input_stream), (gchar *) & buffer[out], count,
-          conn->may_cancel ? conn->cancellable : NULL, err);
+
+    if (count < READ_BUFFER_SIZE) {
+      /* small read, pull in a whole chunk and hand out the part that was
+       * asked for, the remainder is drained by the next calls */
+      if (conn->read_buffer == NULL)
+        conn->read_buffer = g_malloc (READ_BUFFER_SIZE);
+
+      if (block)
+        r = g_input_stream_read (conn->input_stream,
+            (gchar *) conn->read_buffer, READ_BUFFER_SIZE,
+            conn->may_cancel ? conn->cancellable : NULL, err);
+      else
+        r = g_pollable_input_stream_read_nonblocking (G_POLLABLE_INPUT_STREAM
+            (conn->input_stream), (gchar *) conn->read_buffer,
+            READ_BUFFER_SIZE, conn->may_cancel ? conn->cancellable : NULL,
+            err);
+
+      if (r > 0) {
+        conn->read_buffer_size = r;
+        conn->read_buffer_offset = MIN ((gsize) r, count);
+        memcpy (&buffer[out], conn->read_buffer, conn->read_buffer_offset);
+        r = conn->read_buffer_offset;
+      }
+    } else {
+      if (block)
+        r = g_input_stream_read (conn->input_stream, (gchar *) & buffer[out],
+            count, conn->may_cancel ? conn->cancellable : NULL, err);
+      else
+        r = g_pollable_input_stream_read_nonblocking (G_POLLABLE_INPUT_STREAM
+            (conn->input_stream), (gchar *) & buffer[out], count,
+            conn->may_cancel ? conn->cancellable : NULL, err);
+    }
 
     if (G_UNLIKELY (r < 0)) {
       if (out == 0) {
@@ -1445,7 +1490,8 @@ gst_rtsp_connection_write (GstRTSPConnection * conn, const guint8 * data,
 }
 
 static GString *
-message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
+message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message,
+    gboolean include_body)
 {
   GString *str = NULL;
 
@@ -1453,11 +1499,16 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
 
   switch (message->type) {
     case GST_RTSP_MESSAGE_REQUEST:
-      /* create request string, add CSeq */
-      g_string_append_printf (str, "%s %s RTSP/1.0\r\n"
-          "CSeq: %d\r\n",
+      /* create request string */
+      g_string_append_printf (str, "%s %s RTSP/1.0\r\n",
           gst_rtsp_method_as_text (message->type_data.request.method),
-          message->type_data.request.uri, conn->cseq++);
+          message->type_data.request.uri);
+      /* add the CSeq as a real header on @message instead of only in the
+       * serialized form, so that a caller that pipelines several requests
+       * can read it back and correlate the responses by their CSeq */
+      gst_rtsp_message_remove_header (message, GST_RTSP_HDR_CSEQ, -1);
+      gst_rtsp_message_take_header (message, GST_RTSP_HDR_CSEQ,
+          g_strdup_printf ("%d", conn->cseq++));
       /* add session id if we have one */
       if (conn->session_id[0] != '\0') {
         gst_rtsp_message_remove_header (message, GST_RTSP_HDR_SESSION, -1);
@@ -1499,9 +1550,10 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
 
       /* create string with header and data */
       str = g_string_append_len (str, (gchar *) data_header, 4);
-      str =
-          g_string_append_len (str, (gchar *) message->body,
-          message->body_size);
+      if (include_body)
+        str =
+            g_string_append_len (str, (gchar *) message->body,
+            message->body_size);
       break;
     }
     default:
@@ -1533,9 +1585,10 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
       g_free (len);
       /* header ends here */
       g_string_append (str, "\r\n");
-      str =
-          g_string_append_len (str, (gchar *) message->body,
-          message->body_size);
+      if (include_body)
+        str =
+            g_string_append_len (str, (gchar *) message->body,
+            message->body_size);
     } else {
       /* just end headers */
       g_string_append (str, "\r\n");
@@ -1555,6 +1608,11 @@ message_to_string (GstRTSPConnection * conn, GstRTSPMessage * message)
  * the specified @timeout. @timeout can be #NULL, in which case this function
  * might block forever.
  *
+ * Several requests can be sent back to back without waiting for their
+ * responses; the CSeq header that was assigned to a request can be read
+ * back from @message after this call to correlate the pipelined
+ * responses.
+ *
  * This function can be cancelled with gst_rtsp_connection_flush().
  *
  * Returns: #GST_RTSP_OK on success.
@@ -1565,29 +1623,51 @@ gst_rtsp_connection_send (GstRTSPConnection * conn, GstRTSPMessage * message,
 {
   GString *string = NULL;
   GstRTSPResult res;
-  gchar *str;
-  gsize len;
 
   g_return_val_if_fail (conn != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
-
-  if (G_UNLIKELY (!(string = message_to_string (conn, message))))
-    goto no_message;
+  g_return_val_if_fail (conn->output_stream != NULL, GST_RTSP_EINVAL);
 
   if (conn->tunneled) {
+    gchar *str;
+    gsize len;
+
+    /* the tunnel base64-encodes the complete message, we have to flatten
+     * the body into the string first */
+    if (G_UNLIKELY (!(string = message_to_string (conn, message, TRUE))))
+      goto no_message;
+
     str = g_base64_encode ((const guchar *) string->str, string->len);
     g_string_free (string, TRUE);
     len = strlen (str);
-  } else {
-    str = string->str;
-    len = string->len;
-    g_string_free (string, FALSE);
-  }
 
-  /* write request */
-  res = gst_rtsp_connection_write (conn, (guint8 *) str, len, timeout);
+    res = gst_rtsp_connection_write (conn, (guint8 *) str, len, timeout);
+    g_free (str);
+  } else {
+    GstClockTime to;
+    guint offset;
+
+    /* serialize the headers only and write the body, when there is one,
+     * straight from @message so the payload is never copied */
+    if (G_UNLIKELY (!(string = message_to_string (conn, message, FALSE))))
+      goto no_message;
+
+    to = timeout ? GST_TIMEVAL_TO_TIME (*timeout) : 0;
+
+    g_socket_set_timeout (conn->write_socket,
+        (to + GST_SECOND - 1) / GST_SECOND);
+    offset = 0;
+    res = write_bytes (conn->output_stream, (guint8 *) string->str, &offset,
+        string->len, TRUE, conn->cancellable);
+    if (res == GST_RTSP_OK && message->body_size > 0) {
+      offset = 0;
+      res = write_bytes (conn->output_stream, message->body, &offset,
+          message->body_size, TRUE, conn->cancellable);
+    }
+    g_socket_set_timeout (conn->write_socket, 0);
 
-  g_free (str);
+    g_string_free (string, TRUE);
+  }
 
   return res;
 
@@ -2330,6 +2410,11 @@ gst_rtsp_connection_close (GstRTSPConnection * conn)
   conn->initial_buffer = NULL;
   conn->initial_buffer_offset = 0;
 
+  g_free (conn->read_buffer);
+  conn->read_buffer = NULL;
+  conn->read_buffer_size = 0;
+  conn->read_buffer_offset = 0;
+
   conn->write_socket = NULL;
   conn->read_socket = NULL;
   conn->tunneled = FALSE;
@@ -2413,6 +2498,13 @@ gst_rtsp_connection_poll (GstRTSPConnection * conn, GstRTSPEvent events,
   g_return_val_if_fail (conn->read_socket != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (conn->write_socket != NULL, GST_RTSP_EINVAL);
 
+  /* data left in the read buffer can be read right away */
+  if ((events & GST_RTSP_EV_READ) &&
+      conn->read_buffer_offset < conn->read_buffer_size) {
+    *revents = GST_RTSP_EV_READ;
+    return GST_RTSP_OK;
+  }
+
   ctx = g_main_context_new ();
 
   /* configure timeout if any */
@@ -3029,6 +3121,15 @@ gst_rtsp_connection_do_tunnel (GstRTSPConnection * conn,
     conn->initial_buffer = conn2->initial_buffer;
     conn2->initial_buffer = NULL;
     conn->initial_buffer_offset = conn2->initial_buffer_offset;
+
+    /* the read buffer moves along with the input stream */
+    g_free (conn->read_buffer);
+    conn->read_buffer = conn2->read_buffer;
+    conn->read_buffer_size = conn2->read_buffer_size;
+    conn->read_buffer_offset = conn2->read_buffer_offset;
+    conn2->read_buffer = NULL;
+    conn2->read_buffer_size = 0;
+    conn2->read_buffer_offset = 0;
   }
 
   /* we need base64 decoding for the readfd */
@@ -3085,6 +3186,9 @@ typedef struct
 {
   guint8 *data;
   guint size;
+  /* body segment, written right after data without being copied into it */
+  guint8 *body_data;
+  guint body_size;
   guint id;
 } GstRTSPRec;
 
@@ -3112,6 +3216,8 @@ struct _GstRTSPWatch
   guint8 *write_data;
   guint write_off;
   guint write_size;
+  guint8 *write_body_data;
+  guint write_body_size;
   guint write_id;
   gsize max_bytes;
   guint max_messages;
@@ -3135,6 +3241,10 @@ gst_rtsp_source_prepare (GSource * source, gint * timeout)
   if (watch->conn->initial_buffer != NULL)
     return TRUE;
 
+  /* data left in the read buffer may hold a complete message */
+  if (watch->conn->read_buffer_offset < watch->conn->read_buffer_size)
+    return TRUE;
+
   *timeout = (watch->conn->timeout * 1000);
 
   return FALSE;
@@ -3356,7 +3466,8 @@ gst_rtsp_source_dispatch (GSource * source, GSourceFunc callback G_GNUC_UNUSED,
   GstRTSPWatch *watch = (GstRTSPWatch *) source;
   GstRTSPConnection *conn = watch->conn;
 
-  if (conn->initial_buffer != NULL) {
+  if (conn->initial_buffer != NULL ||
+      conn->read_buffer_offset < conn->read_buffer_size) {
     gst_rtsp_source_dispatch_read (G_POLLABLE_INPUT_STREAM (conn->input_stream),
         watch);
   }
@@ -3408,11 +3519,13 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
         break;
       }
 
-      watch->messages_bytes -= rec->size;
+      watch->messages_bytes -= rec->size + rec->body_size;
 
       watch->write_off = 0;
       watch->write_data = rec->data;
       watch->write_size = rec->size;
+      watch->write_body_data = rec->body_data;
+      watch->write_body_size = rec->body_size;
       watch->write_id = rec->id;
 
       g_slice_free (GstRTSPRec, rec);
@@ -3421,6 +3534,19 @@ gst_rtsp_source_dispatch_write (GPollableOutputStream * stream,
     res = write_bytes (conn->output_stream, watch->write_data,
         &watch->write_off, watch->write_size, FALSE, conn->cancellable);
 
+    if (res == GST_RTSP_OK && watch->write_body_data != NULL) {
+      /* the first segment is done, continue with the message body */
+      g_free (watch->write_data);
+      watch->write_data = watch->write_body_data;
+      watch->write_size = watch->write_body_size;
+      watch->write_off = 0;
+      watch->write_body_data = NULL;
+      watch->write_body_size = 0;
+
+      res = write_bytes (conn->output_stream, watch->write_data,
+          &watch->write_off, watch->write_size, FALSE, conn->cancellable);
+    }
+
     if (!IS_BACKLOG_FULL (watch))
       g_cond_signal (&watch->queue_not_full);
     g_mutex_unlock (&watch->mutex);
@@ -3466,6 +3592,7 @@ gst_rtsp_rec_free (gpointer data)
   GstRTSPRec *rec = data;
 
   g_free (rec->data);
+  g_free (rec->body_data);
   g_slice_free (GstRTSPRec, rec);
 }
 
@@ -3486,6 +3613,7 @@ gst_rtsp_source_finalize (GSource * source)
   watch->messages_bytes = 0;
 
   g_free (watch->write_data);
+  g_free (watch->write_body_data);
   g_cond_clear (&watch->queue_not_full);
 
   if (watch->readsrc)
@@ -3701,42 +3829,19 @@ gst_rtsp_watch_get_send_backlog (GstRTSPWatch * watch,
   g_mutex_unlock (&watch->mutex);
 }
 
-/**
- * gst_rtsp_watch_write_data:
- * @watch: a #GstRTSPWatch
- * @data: (array length=size) (transfer full): the data to queue
- * @size: the size of @data
- * @id: (out) (allow-none): location for a message ID or %NULL
- *
- * Write @data using the connection of the @watch. If it cannot be sent
- * immediately, it will be queued for transmission in @watch. The contents of
- * @message will then be serialized and transmitted when the connection of the
- * @watch becomes writable. In case the @message is queued, the ID returned in
- * @id will be non-zero and used as the ID argument in the message_sent
- * callback.
- *
- * This function will take ownership of @data and g_free() it after use.
- *
- * If the amount of queued data exceeds the limits set with
- * gst_rtsp_watch_set_send_backlog(), this function will return
- * #GST_RTSP_ENOMEM.
- *
- * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
- * are reached. #GST_RTSP_EINTR when @watch was flushing.
- */
-GstRTSPResult
-gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
-    guint size, guint * id)
+/* write @data and @body_data using the connection of @watch, queueing
+ * whatever cannot be sent immediately. Both segments are written back to
+ * back on the wire so the body never has to be flattened behind the
+ * serialized headers. Takes ownership of @data and @body_data. */
+static GstRTSPResult
+gst_rtsp_watch_write_segments (GstRTSPWatch * watch, const guint8 * data,
+    guint size, const guint8 * body_data, guint body_size, guint * id)
 {
   GstRTSPResult res;
   GstRTSPRec *rec;
-  guint off = 0;
+  guint off = 0, body_off = 0;
   GMainContext *context = NULL;
 
-  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
-  g_return_val_if_fail (size != 0, GST_RTSP_EINVAL);
-
   g_mutex_lock (&watch->mutex);
   if (watch->flushing)
     goto flushing;
@@ -3746,10 +3851,15 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
     res =
         write_bytes (watch->conn->output_stream, data, &off, size,
         FALSE, watch->conn->cancellable);
+    if (res == GST_RTSP_OK && body_size > 0)
+      res =
+          write_bytes (watch->conn->output_stream, body_data, &body_off,
+          body_size, FALSE, watch->conn->cancellable);
     if (res != GST_RTSP_EINTR) {
       if (id != NULL)
         *id = 0;
       g_free ((gpointer) data);
+      g_free ((gpointer) body_data);
       goto done;
     }
   }
@@ -3758,15 +3868,32 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
   if (IS_BACKLOG_FULL (watch))
     goto too_much_backlog;
 
-  /* make a record with the data and id for sending async */
+  /* make a record with the remaining segments and id for sending async */
   rec = g_slice_new (GstRTSPRec);
-  if (off == 0) {
-    rec->data = (guint8 *) data;
-    rec->size = size;
-  } else {
-    rec->data = g_memdup (data + off, size - off);
-    rec->size = size - off;
+  if (off >= size) {
+    /* the first segment was written completely, only the body is left */
     g_free ((gpointer) data);
+    if (body_off == 0) {
+      rec->data = (guint8 *) body_data;
+      rec->size = body_size;
+    } else {
+      rec->data = g_memdup (body_data + body_off, body_size - body_off);
+      rec->size = body_size - body_off;
+      g_free ((gpointer) body_data);
+    }
+    rec->body_data = NULL;
+    rec->body_size = 0;
+  } else {
+    if (off == 0) {
+      rec->data = (guint8 *) data;
+      rec->size = size;
+    } else {
+      rec->data = g_memdup (data + off, size - off);
+      rec->size = size - off;
+      g_free ((gpointer) data);
+    }
+    rec->body_data = (guint8 *) body_data;
+    rec->body_size = body_size;
   }
 
   do {
@@ -3776,7 +3903,7 @@ gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
 
   /* add the record to a queue. */
   g_queue_push_head (watch->messages, rec);
-  watch->messages_bytes += rec->size;
+  watch->messages_bytes += rec->size + rec->body_size;
 
   /* make sure the main context will now also check for writability on the
    * socket */
@@ -3816,6 +3943,7 @@ flushing:
     GST_DEBUG ("we are flushing");
     g_mutex_unlock (&watch->mutex);
     g_free ((gpointer) data);
+    g_free ((gpointer) body_data);
     return GST_RTSP_EINTR;
   }
 too_much_backlog:
@@ -3825,10 +3953,45 @@ too_much_backlog:
         watch->messages_bytes, watch->max_messages, watch->messages->length);
     g_mutex_unlock (&watch->mutex);
     g_free ((gpointer) data);
+    g_free ((gpointer) body_data);
     return GST_RTSP_ENOMEM;
   }
 }
 
+/**
+ * gst_rtsp_watch_write_data:
+ * @watch: a #GstRTSPWatch
+ * @data: (array length=size) (transfer full): the data to queue
+ * @size: the size of @data
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Write @data using the connection of the @watch. If it cannot be sent
+ * immediately, it will be queued for transmission in @watch. The contents of
+ * @message will then be serialized and transmitted when the connection of the
+ * @watch becomes writable. In case the @message is queued, the ID returned in
+ * @id will be non-zero and used as the ID argument in the message_sent
+ * callback.
+ *
+ * This function will take ownership of @data and g_free() it after use.
+ *
+ * If the amount of queued data exceeds the limits set with
+ * gst_rtsp_watch_set_send_backlog(), this function will return
+ * #GST_RTSP_ENOMEM.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ */
+GstRTSPResult
+gst_rtsp_watch_write_data (GstRTSPWatch * watch, const guint8 * data,
+    guint size, guint * id)
+{
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (data != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (size != 0, GST_RTSP_EINVAL);
+
+  return gst_rtsp_watch_write_segments (watch, data, size, NULL, 0, id);
+}
+
 /**
  * gst_rtsp_watch_send_message:
  * @watch: a #GstRTSPWatch
@@ -3855,12 +4018,62 @@ gst_rtsp_watch_send_message (GstRTSPWatch * watch, GstRTSPMessage * message,
   g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
 
   /* make a record with the message as a string and id */
-  str = message_to_string (watch->conn, message);
+  str = message_to_string (watch->conn, message, TRUE);
   size = str->len;
   return gst_rtsp_watch_write_data (watch,
       (guint8 *) g_string_free (str, FALSE), size, id);
 }
 
+/**
+ * gst_rtsp_watch_send_message_take:
+ * @watch: a #GstRTSPWatch
+ * @message: (transfer full): a #GstRTSPMessage
+ * @id: (out) (allow-none): location for a message ID or %NULL
+ *
+ * Send @message using the connection of the @watch, like
+ * gst_rtsp_watch_send_message(), but take ownership of @message. The message
+ * body is moved into the backlog queue instead of being copied behind the
+ * serialized headers, which avoids a copy of the payload of every queued
+ * data message. @message is unset when this function returns and should not
+ * be used anymore.
+ *
+ * If the amount of queued data exceeds the limits set with
+ * gst_rtsp_watch_set_send_backlog(), this function will return
+ * #GST_RTSP_ENOMEM.
+ *
+ * Returns: #GST_RTSP_OK on success. #GST_RTSP_ENOMEM when the backlog limits
+ * are reached. #GST_RTSP_EINTR when @watch was flushing.
+ *
+ * Since: 1.14
+ */
+GstRTSPResult
+gst_rtsp_watch_send_message_take (GstRTSPWatch * watch,
+    GstRTSPMessage * message, guint * id)
+{
+  GString *str;
+  guint size;
+  guint8 *body_data = NULL;
+  guint body_size = 0;
+
+  g_return_val_if_fail (watch != NULL, GST_RTSP_EINVAL);
+  g_return_val_if_fail (message != NULL, GST_RTSP_EINVAL);
+
+  /* serialize the headers and steal the body so that it is queued without
+   * being copied */
+  str = message_to_string (watch->conn, message, FALSE);
+  gst_rtsp_message_steal_body (message, &body_data, &body_size);
+  gst_rtsp_message_unset (message);
+
+  if (body_size == 0) {
+    g_free (body_data);
+    body_data = NULL;
+  }
+
+  size = str->len;
+  return gst_rtsp_watch_write_segments (watch,
+      (guint8 *) g_string_free (str, FALSE), size, body_data, body_size, id);
+}
+
 /**
  * gst_rtsp_watch_wait_backlog:
  * @watch: a #GstRTSPWatch
@@ -3953,3 +4166,121 @@ gst_rtsp_watch_set_flushing (GstRTSPWatch * watch, gboolean flushing)
   }
   g_mutex_unlock (&watch->mutex);
 }
+
+struct _GstRTSPWatchGroup
+{
+  GMainContext *context;
+  GMainLoop *loop;
+  GThread *thread;
+};
+
+static gpointer
+gst_rtsp_watch_group_thread (gpointer data)
+{
+  GstRTSPWatchGroup *group = data;
+
+  g_main_context_push_thread_default (group->context);
+  g_main_loop_run (group->loop);
+  g_main_context_pop_thread_default (group->context);
+
+  return NULL;
+}
+
+/**
+ * gst_rtsp_watch_group_new:
+ *
+ * Create a new watch group. A watch group services the #GstRTSPWatch
+ * objects attached to it with gst_rtsp_watch_group_attach() from its own
+ * #GMainContext, iterated in a dedicated thread.
+ *
+ * A single #GMainContext slows down when it has to service thousands of
+ * sources. By creating a couple of groups and spreading the watches of
+ * the connections over them, each context only has to deal with its own
+ * share of the watches and the dispatching happens concurrently.
+ *
+ * Returns: a new #GstRTSPWatchGroup. Free with gst_rtsp_watch_group_free()
+ *     after usage.
+ *
+ * Since: 1.14
+ */
+GstRTSPWatchGroup *
+gst_rtsp_watch_group_new (void)
+{
+  GstRTSPWatchGroup *group;
+
+  group = g_new0 (GstRTSPWatchGroup, 1);
+  group->context = g_main_context_new ();
+  group->loop = g_main_loop_new (group->context, FALSE);
+  group->thread = g_thread_new ("rtsp-watch-group",
+      gst_rtsp_watch_group_thread, group);
+
+  return group;
+}
+
+/**
+ * gst_rtsp_watch_group_get_context:
+ * @group: a #GstRTSPWatchGroup
+ *
+ * Get the #GMainContext that dispatches the watches of @group. This can
+ * be used to attach additional sources, like timeouts for checking the
+ * session liveness of the connections serviced by @group.
+ *
+ * Returns: (transfer none): the #GMainContext of @group. The context
+ *     remains valid for the lifetime of @group.
+ *
+ * Since: 1.14
+ */
+GMainContext *
+gst_rtsp_watch_group_get_context (GstRTSPWatchGroup * group)
+{
+  g_return_val_if_fail (group != NULL, NULL);
+
+  return group->context;
+}
+
+/**
+ * gst_rtsp_watch_group_attach:
+ * @group: a #GstRTSPWatchGroup
+ * @watch: a #GstRTSPWatch
+ *
+ * Attach @watch to the context of @group so that it will be dispatched
+ * from the thread of @group. This is equivalent to calling
+ * gst_rtsp_watch_attach() with the context of @group.
+ *
+ * Note that the watch callbacks will be called from the thread of @group.
+ *
+ * Returns: the ID (greater than 0) of @watch within the context of @group.
+ *
+ * Since: 1.14
+ */
+guint
+gst_rtsp_watch_group_attach (GstRTSPWatchGroup * group, GstRTSPWatch * watch)
+{
+  g_return_val_if_fail (group != NULL, 0);
+  g_return_val_if_fail (watch != NULL, 0);
+
+  return gst_rtsp_watch_attach (watch, group->context);
+}
+
+/**
+ * gst_rtsp_watch_group_free:
+ * @group: a #GstRTSPWatchGroup
+ *
+ * Stop the dispatcher thread of @group and free @group. Watches that are
+ * still attached are destroyed together with the context; pending
+ * messages in their backlog queues will not be sent.
+ *
+ * Since: 1.14
+ */
+void
+gst_rtsp_watch_group_free (GstRTSPWatchGroup * group)
+{
+  g_return_if_fail (group != NULL);
+
+  g_main_loop_quit (group->loop);
+  g_thread_join (group->thread);
+
+  g_main_loop_unref (group->loop);
+  g_main_context_unref (group->context);
+  g_free (group);
+}
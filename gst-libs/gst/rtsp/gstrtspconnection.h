@@ -226,6 +226,16 @@ gboolean           gst_rtsp_connection_get_remember_session_id (GstRTSPConnectio
  */
 typedef struct _GstRTSPWatch GstRTSPWatch;
 
+/**
+ * GstRTSPWatchGroup:
+ *
+ * Opaque group of #GstRTSPWatch objects that are serviced from one
+ * dedicated dispatcher thread.
+ *
+ * Since: 1.14
+ */
+typedef struct _GstRTSPWatchGroup GstRTSPWatchGroup;
+
 /**
  * GstRTSPWatchFuncs:
  * @message_received: callback when a message was received
@@ -303,6 +313,11 @@ GstRTSPResult      gst_rtsp_watch_send_message       (GstRTSPWatch *watch,
                                                       GstRTSPMessage *message,
                                                       guint *id);
 
+GST_EXPORT
+GstRTSPResult      gst_rtsp_watch_send_message_take  (GstRTSPWatch *watch,
+                                                      GstRTSPMessage *message,
+                                                      guint *id);
+
 GST_EXPORT
 GstRTSPResult      gst_rtsp_watch_wait_backlog       (GstRTSPWatch * watch,
                                                       GTimeVal *timeout);
@@ -310,6 +325,20 @@ GstRTSPResult      gst_rtsp_watch_wait_backlog       (GstRTSPWatch * watch,
 GST_EXPORT
 void               gst_rtsp_watch_set_flushing       (GstRTSPWatch * watch,
                                                       gboolean flushing);
+
+GST_EXPORT
+GstRTSPWatchGroup * gst_rtsp_watch_group_new          (void);
+
+GST_EXPORT
+GMainContext *      gst_rtsp_watch_group_get_context  (GstRTSPWatchGroup *group);
+
+GST_EXPORT
+guint               gst_rtsp_watch_group_attach       (GstRTSPWatchGroup *group,
+                                                       GstRTSPWatch *watch);
+
+GST_EXPORT
+void                gst_rtsp_watch_group_free         (GstRTSPWatchGroup *group);
+
 G_END_DECLS
 
 #endif /* __GST_RTSP_CONNECTION_H__ */
@@ -97,6 +97,33 @@ gst_rtsp_message_new (GstRTSPMessage ** msg)
   return gst_rtsp_message_init (newmsg);
 }
 
+/* Detach the headers array of @msg so it survives the following unset,
+ * freeing the values but keeping the allocated array for reuse.
+ * Re-initializing the same message over and over to build the next one
+ * is the common pattern in servers, and recycling the array saves a
+ * free/alloc pair plus the growth reallocs for every message. Returns a
+ * fresh array when @msg does not have one yet. */
+static GArray *
+gst_rtsp_message_recycle_hdr_fields (GstRTSPMessage * msg)
+{
+  GArray *hdr_fields = msg->hdr_fields;
+  guint i;
+
+  if (hdr_fields == NULL)
+    return g_array_sized_new (FALSE, FALSE, sizeof (RTSPKeyValue), 8);
+
+  for (i = 0; i < hdr_fields->len; i++) {
+    RTSPKeyValue *keyval = &g_array_index (hdr_fields, RTSPKeyValue, i);
+
+    g_free (keyval->value);
+    g_free (keyval->custom_key);
+  }
+  g_array_set_size (hdr_fields, 0);
+  msg->hdr_fields = NULL;
+
+  return hdr_fields;
+}
+
 /**
  * gst_rtsp_message_init:
  * @msg: a #GstRTSPMessage
@@ -109,12 +136,15 @@ gst_rtsp_message_new (GstRTSPMessage ** msg)
 GstRTSPResult
 gst_rtsp_message_init (GstRTSPMessage * msg)
 {
+  GArray *hdr_fields;
+
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
 
+  hdr_fields = gst_rtsp_message_recycle_hdr_fields (msg);
   gst_rtsp_message_unset (msg);
 
   msg->type = GST_RTSP_MESSAGE_INVALID;
-  msg->hdr_fields = g_array_new (FALSE, FALSE, sizeof (RTSPKeyValue));
+  msg->hdr_fields = hdr_fields;
 
   return GST_RTSP_OK;
 }
@@ -177,16 +207,19 @@ GstRTSPResult
 gst_rtsp_message_init_request (GstRTSPMessage * msg, GstRTSPMethod method,
     const gchar * uri)
 {
+  GArray *hdr_fields;
+
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
   g_return_val_if_fail (uri != NULL, GST_RTSP_EINVAL);
 
+  hdr_fields = gst_rtsp_message_recycle_hdr_fields (msg);
   gst_rtsp_message_unset (msg);
 
   msg->type = GST_RTSP_MESSAGE_REQUEST;
   msg->type_data.request.method = method;
   msg->type_data.request.uri = g_strdup (uri);
   msg->type_data.request.version = GST_RTSP_VERSION_1_0;
-  msg->hdr_fields = g_array_new (FALSE, FALSE, sizeof (RTSPKeyValue));
+  msg->hdr_fields = hdr_fields;
 
   return GST_RTSP_OK;
 }
@@ -276,8 +309,11 @@ GstRTSPResult
 gst_rtsp_message_init_response (GstRTSPMessage * msg, GstRTSPStatusCode code,
     const gchar * reason, const GstRTSPMessage * request)
 {
+  GArray *hdr_fields;
+
   g_return_val_if_fail (msg != NULL, GST_RTSP_EINVAL);
 
+  hdr_fields = gst_rtsp_message_recycle_hdr_fields (msg);
   gst_rtsp_message_unset (msg);
 
   if (reason == NULL)
@@ -287,7 +323,7 @@ gst_rtsp_message_init_response (GstRTSPMessage * msg, GstRTSPStatusCode code,
   msg->type_data.response.code = code;
   msg->type_data.response.reason = g_strdup (reason);
   msg->type_data.response.version = GST_RTSP_VERSION_1_0;
-  msg->hdr_fields = g_array_new (FALSE, FALSE, sizeof (RTSPKeyValue));
+  msg->hdr_fields = hdr_fields;
 
   if (request) {
     if (request->type == GST_RTSP_MESSAGE_HTTP_REQUEST) {
@@ -1415,6 +1415,59 @@ gst_mikey_message_add_rand_len (GstMIKEYMessage * msg, guint8 len)
   return gst_mikey_message_add_payload (msg, &p->pt);
 }
 
+/* conservative estimate of the serialized size of @payloads, so the byte
+ * array can be allocated in one go */
+static guint
+payloads_estimate_size (GArray * payloads)
+{
+  guint i, size = 0;
+
+  for (i = 0; i < payloads->len; i++) {
+    GstMIKEYPayload *payload = g_array_index (payloads, GstMIKEYPayload *, i);
+
+    /* headers, algorithm bytes, MAC, ... */
+    size += 32;
+
+    switch (payload->type) {
+      case GST_MIKEY_PT_KEMAC:
+        size +=
+            payloads_estimate_size (((GstMIKEYPayloadKEMAC *)
+                payload)->subpayloads);
+        break;
+      case GST_MIKEY_PT_PKE:
+        size += ((GstMIKEYPayloadPKE *) payload)->data_len;
+        break;
+      case GST_MIKEY_PT_SP:
+      {
+        GstMIKEYPayloadSP *p = (GstMIKEYPayloadSP *) payload;
+        guint j;
+
+        for (j = 0; j < p->params->len; j++)
+          size += 2 + g_array_index (p->params, GstMIKEYPayloadSPParam,
+              j).len;
+        break;
+      }
+      case GST_MIKEY_PT_RAND:
+        size += ((GstMIKEYPayloadRAND *) payload)->len;
+        break;
+      case GST_MIKEY_PT_KEY_DATA:
+      {
+        GstMIKEYPayloadKeyData *p = (GstMIKEYPayloadKeyData *) payload;
+
+        size += p->key_len + p->salt_len;
+        if (p->kv_type == GST_MIKEY_KV_SPI)
+          size += 1 + p->kv_len[0];
+        else if (p->kv_type == GST_MIKEY_KV_INTERVAL)
+          size += 2 + p->kv_len[0] + p->kv_len[1];
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return size;
+}
+
 #define ENSURE_SIZE(n)                          \
 G_STMT_START {                                  \
   guint offset = data - arr->data;              \
@@ -1676,7 +1729,12 @@ gst_mikey_message_to_bytes (GstMIKEYMessage * msg, GstMIKEYEncryptInfo * info,
   guint8 *data;
   GstMIKEYPayload *next_payload;
   guint i, n_cs;
-  arr = g_byte_array_new ();
+
+  n_cs = msg->map_info->len;
+  /* reserve enough space up front so the payload serializers don't have to
+   * grow the array while they append */
+  arr = g_byte_array_sized_new (10 + 9 * n_cs +
+      payloads_estimate_size (msg->payloads));
   data = arr->data;
 
   if (msg->payloads->len == 0)
@@ -1684,7 +1742,6 @@ gst_mikey_message_to_bytes (GstMIKEYMessage * msg, GstMIKEYEncryptInfo * info,
   else
     next_payload = g_array_index (msg->payloads, GstMIKEYPayload *, 0);
 
-  n_cs = msg->map_info->len;
   /*                      1                   2                   3
    *  0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1 2 3 4 5 6 7 8 9 0 1
    * +-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+-+
@@ -458,6 +458,9 @@ gst_sdp_address_is_multicast (const gchar * nettype, const gchar * addrtype,
   return ret;
 }
 
+static void gst_sdp_media_as_text_append (const GstSDPMedia * media,
+    GString * lines);
+
 /**
  * gst_sdp_message_as_text:
  * @msg: a #GstSDPMessage
@@ -471,11 +474,18 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
 {
   /* change all vars so they match rfc? */
   GString *lines;
-  guint i;
+  guint size, i;
 
   g_return_val_if_fail (msg != NULL, NULL);
 
-  lines = g_string_new ("");
+  /* rough estimate of the output size, the bulk of a big description is
+   * made of attribute lines; this avoids most of the reallocations while
+   * appending */
+  size = 1024 + gst_sdp_message_attributes_len (msg) * 32;
+  for (i = 0; i < gst_sdp_message_medias_len (msg); i++)
+    size += 256 + gst_sdp_message_get_media (msg, i)->attributes->len * 32;
+
+  lines = g_string_sized_new (size);
 
   if (msg->version)
     g_string_append_printf (lines, "v=%s\r\n", msg->version);
@@ -516,7 +526,7 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
       if (msg->connection.addr_number > 1)
         g_string_append_printf (lines, "/%u", msg->connection.addr_number);
     }
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "\r\n");
   }
 
   for (i = 0; i < gst_sdp_message_bandwidths_len (msg); i++) {
@@ -527,7 +537,7 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
   }
 
   if (gst_sdp_message_times_len (msg) == 0) {
-    g_string_append_printf (lines, "t=0 0\r\n");
+    g_string_append (lines, "t=0 0\r\n");
   } else {
     for (i = 0; i < gst_sdp_message_times_len (msg); i++) {
       const GstSDPTime *times = gst_sdp_message_get_time (msg, i);
@@ -542,7 +552,7 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
         for (j = 1; j < times->repeat->len; j++)
           g_string_append_printf (lines, " %s",
               g_array_index (times->repeat, gchar *, j));
-        g_string_append_printf (lines, "\r\n");
+        g_string_append (lines, "\r\n");
       }
     }
   }
@@ -555,14 +565,14 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
       zone = gst_sdp_message_get_zone (msg, i);
       g_string_append_printf (lines, " %s %s", zone->time, zone->typed_time);
     }
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "\r\n");
   }
 
   if (msg->key.type) {
     g_string_append_printf (lines, "k=%s", msg->key.type);
     if (msg->key.data)
       g_string_append_printf (lines, ":%s", msg->key.data);
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "\r\n");
   }
 
   for (i = 0; i < gst_sdp_message_attributes_len (msg); i++) {
@@ -572,17 +582,16 @@ gst_sdp_message_as_text (const GstSDPMessage * msg)
       g_string_append_printf (lines, "a=%s", attr->key);
       if (attr->value)
         g_string_append_printf (lines, ":%s", attr->value);
-      g_string_append_printf (lines, "\r\n");
+      g_string_append (lines, "\r\n");
     }
   }
 
+  /* append the media sections right into our own string instead of
+   * serializing them into a temporary copy first */
   for (i = 0; i < gst_sdp_message_medias_len (msg); i++) {
     const GstSDPMedia *media = gst_sdp_message_get_media (msg, i);
-    gchar *sdp_media_str;
 
-    sdp_media_str = gst_sdp_media_as_text (media);
-    g_string_append_printf (lines, "%s", sdp_media_str);
-    g_free (sdp_media_str);
+    gst_sdp_media_as_text_append (media, lines);
   }
 
   return g_string_free (lines, FALSE);
@@ -1646,6 +1655,43 @@ gst_sdp_message_get_attribute_val (const GstSDPMessage * msg, const gchar * key)
   return gst_sdp_message_get_attribute_val_n (msg, key, 0);
 }
 
+/**
+ * gst_sdp_message_find_attribute:
+ * @msg: a #GstSDPMessage
+ * @start: the index to start the search from
+ * @key: the key
+ *
+ * Find the next attribute with key @key in @msg, starting the search at
+ * index @start. Use the result + 1 as new @start to find the following
+ * attribute with the same key, which makes collecting all values for a
+ * key linear in the number of attributes, unlike repeated calls to
+ * gst_sdp_message_get_attribute_val_n() that restart the scan for every
+ * @nth.
+ *
+ * Returns: the index of the attribute or -1 when no attribute with @key was
+ * found at or after @start.
+ *
+ * Since: 1.14
+ */
+gint
+gst_sdp_message_find_attribute (const GstSDPMessage * msg, guint start,
+    const gchar * key)
+{
+  guint i;
+
+  g_return_val_if_fail (msg != NULL, -1);
+  g_return_val_if_fail (key != NULL, -1);
+
+  for (i = start; i < msg->attributes->len; i++) {
+    GstSDPAttribute *attr;
+
+    attr = &g_array_index (msg->attributes, GstSDPAttribute, i);
+    if (!strcmp (attr->key, key))
+      return i;
+  }
+  return -1;
+}
+
 #define DUP_ATTRIBUTE(v, val) memcpy (v, val, sizeof (GstSDPAttribute))
 #define FREE_ATTRIBUTE(v) gst_sdp_attribute_clear(v)
 
@@ -1936,24 +1982,11 @@ gst_sdp_media_copy (const GstSDPMedia * media, GstSDPMedia ** copy)
   return GST_SDP_OK;
 }
 
-/**
- * gst_sdp_media_as_text:
- * @media: a #GstSDPMedia
- *
- * Convert the contents of @media to a text string.
- *
- * Returns: A dynamically allocated string representing the media.
- */
-gchar *
-gst_sdp_media_as_text (const GstSDPMedia * media)
+static void
+gst_sdp_media_as_text_append (const GstSDPMedia * media, GString * lines)
 {
-  GString *lines;
   guint i;
 
-  g_return_val_if_fail (media != NULL, NULL);
-
-  lines = g_string_new ("");
-
   if (media->media)
     g_string_append_printf (lines, "m=%s", media->media);
 
@@ -1966,7 +1999,7 @@ gst_sdp_media_as_text (const GstSDPMedia * media)
 
   for (i = 0; i < gst_sdp_media_formats_len (media); i++)
     g_string_append_printf (lines, " %s", gst_sdp_media_get_format (media, i));
-  g_string_append_printf (lines, "\r\n");
+  g_string_append (lines, "\r\n");
 
   if (media->information)
     g_string_append_printf (lines, "i=%s", media->information);
@@ -1985,7 +2018,7 @@ gst_sdp_media_as_text (const GstSDPMedia * media)
         if (conn->addr_number > 1)
           g_string_append_printf (lines, "/%u", conn->addr_number);
       }
-      g_string_append_printf (lines, "\r\n");
+      g_string_append (lines, "\r\n");
     }
   }
 
@@ -2000,7 +2033,7 @@ gst_sdp_media_as_text (const GstSDPMedia * media)
     g_string_append_printf (lines, "k=%s", media->key.type);
     if (media->key.data)
       g_string_append_printf (lines, ":%s", media->key.data);
-    g_string_append_printf (lines, "\r\n");
+    g_string_append (lines, "\r\n");
   }
 
   for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
@@ -2010,9 +2043,28 @@ gst_sdp_media_as_text (const GstSDPMedia * media)
       g_string_append_printf (lines, "a=%s", attr->key);
       if (attr->value && attr->value[0] != '\0')
         g_string_append_printf (lines, ":%s", attr->value);
-      g_string_append_printf (lines, "\r\n");
+      g_string_append (lines, "\r\n");
     }
   }
+}
+
+/**
+ * gst_sdp_media_as_text:
+ * @media: a #GstSDPMedia
+ *
+ * Convert the contents of @media to a text string.
+ *
+ * Returns: A dynamically allocated string representing the media.
+ */
+gchar *
+gst_sdp_media_as_text (const GstSDPMedia * media)
+{
+  GString *lines;
+
+  g_return_val_if_fail (media != NULL, NULL);
+
+  lines = g_string_new ("");
+  gst_sdp_media_as_text_append (media, lines);
 
   return g_string_free (lines, FALSE);
 }
@@ -2823,6 +2875,43 @@ gst_sdp_media_get_attribute_val (const GstSDPMedia * media, const gchar * key)
   return gst_sdp_media_get_attribute_val_n (media, key, 0);
 }
 
+/**
+ * gst_sdp_media_find_attribute:
+ * @media: a #GstSDPMedia
+ * @start: the index to start the search from
+ * @key: a key
+ *
+ * Find the next attribute with key @key in @media, starting the search at
+ * index @start. Use the result + 1 as new @start to find the following
+ * attribute with the same key, which makes collecting all values for a
+ * key linear in the number of attributes, unlike repeated calls to
+ * gst_sdp_media_get_attribute_val_n() that restart the scan for every
+ * @nth.
+ *
+ * Returns: the index of the attribute or -1 when no attribute with @key was
+ * found at or after @start.
+ *
+ * Since: 1.14
+ */
+gint
+gst_sdp_media_find_attribute (const GstSDPMedia * media, guint start,
+    const gchar * key)
+{
+  guint i;
+
+  g_return_val_if_fail (media != NULL, -1);
+  g_return_val_if_fail (key != NULL, -1);
+
+  for (i = start; i < media->attributes->len; i++) {
+    GstSDPAttribute *attr;
+
+    attr = &g_array_index (media->attributes, GstSDPAttribute, i);
+    if (!strcmp (attr->key, key))
+      return i;
+  }
+  return -1;
+}
+
 /**
  * gst_sdp_media_insert_attribute:
  * @media: a #GstSDPMedia
@@ -3518,6 +3607,46 @@ gst_sdp_media_add_rtcp_fb_attributes_from_media (const GstSDPMedia * media,
   return GST_SDP_OK;
 }
 
+/* Cache of caps parsed from media descriptions. Applications that
+ * re-negotiate many identical streams, like an NVR connecting to racks
+ * of equal cameras, parse the exact same m=/a= lines over and over; the
+ * cache turns the repeat conversions into one caps copy. The cached
+ * caps are never handed out directly so the caller always owns writable
+ * caps, as before. Bounded by flushing everything when it grows too
+ * large, which never happens with a homogeneous set of senders. */
+#define SDP_MEDIA_CAPS_CACHE_MAX 256
+
+static GMutex media_caps_cache_lock;
+static GHashTable *media_caps_cache;
+
+/* build the cache key from all the attributes that influence the result
+ * of gst_sdp_media_get_caps_from_media() */
+static gchar *
+gst_sdp_media_caps_cache_key (const GstSDPMedia * media, gint pt)
+{
+  GString *key;
+  guint i;
+
+  key = g_string_new (media->media);
+  g_string_append_printf (key, ":%d", pt);
+
+  for (i = 0; i < gst_sdp_media_attributes_len (media); i++) {
+    const GstSDPAttribute *attr =
+        &g_array_index (media->attributes, GstSDPAttribute, i);
+
+    if (strcmp (attr->key, "rtpmap") == 0 || strcmp (attr->key, "fmtp") == 0
+        || strcmp (attr->key, "framesize") == 0
+        || strcmp (attr->key, "rtcp-fb") == 0) {
+      g_string_append_c (key, '\n');
+      g_string_append (key, attr->key);
+      g_string_append_c (key, ':');
+      if (attr->value)
+        g_string_append (key, attr->value);
+    }
+  }
+  return g_string_free (key, FALSE);
+}
+
 /**
  * gst_sdp_media_get_caps_from_media:
  * @media: a #GstSDPMedia
@@ -3549,9 +3678,24 @@ gst_sdp_media_get_caps_from_media (const GstSDPMedia * media, gint pt)
   GstStructure *s;
   gint payload = 0;
   gboolean ret;
+  gchar *cache_key;
+  GstCaps *cached;
 
   g_return_val_if_fail (media != NULL, NULL);
 
+  cache_key = gst_sdp_media_caps_cache_key (media, pt);
+
+  g_mutex_lock (&media_caps_cache_lock);
+  if (media_caps_cache != NULL &&
+      (cached = g_hash_table_lookup (media_caps_cache, cache_key))) {
+    caps = gst_caps_copy (cached);
+    g_mutex_unlock (&media_caps_cache_lock);
+    GST_DEBUG ("cache hit for %s", cache_key);
+    g_free (cache_key);
+    return caps;
+  }
+  g_mutex_unlock (&media_caps_cache_lock);
+
   /* get and parse rtpmap */
   rtpmap = gst_sdp_get_attribute_for_pt (media, "rtpmap", pt);
 
@@ -3694,6 +3838,19 @@ gst_sdp_media_get_caps_from_media (const GstSDPMedia * media, gint pt)
   gst_sdp_media_add_rtcp_fb_attributes_from_media (media, pt, caps);
 
 out:
+  if (caps != NULL) {
+    g_mutex_lock (&media_caps_cache_lock);
+    if (media_caps_cache == NULL)
+      media_caps_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+          g_free, (GDestroyNotify) gst_caps_unref);
+    else if (g_hash_table_size (media_caps_cache) >= SDP_MEDIA_CAPS_CACHE_MAX)
+      g_hash_table_remove_all (media_caps_cache);
+    /* store a private copy, the caller may modify its caps */
+    g_hash_table_insert (media_caps_cache, cache_key, gst_caps_copy (caps));
+    cache_key = NULL;
+    g_mutex_unlock (&media_caps_cache_lock);
+  }
+  g_free (cache_key);
   g_free (framesize);
   g_free (fmtp);
   g_free (name);
@@ -543,6 +543,10 @@ GST_EXPORT
 const gchar*            gst_sdp_message_get_attribute_val_n (const GstSDPMessage *msg,
                                                              const gchar *key, guint nth);
 
+GST_EXPORT
+gint                    gst_sdp_message_find_attribute      (const GstSDPMessage *msg,
+                                                             guint start, const gchar *key);
+
 GST_EXPORT
 GstSDPResult            gst_sdp_message_insert_attribute    (GstSDPMessage *msg, gint idx,
                                                              GstSDPAttribute *attr);
@@ -716,6 +720,10 @@ GST_EXPORT
 const gchar*            gst_sdp_media_get_attribute_val_n   (const GstSDPMedia *media, const gchar *key,
                                                              guint nth);
 
+GST_EXPORT
+gint                    gst_sdp_media_find_attribute        (const GstSDPMedia *media, guint start,
+                                                             const gchar *key);
+
 GST_EXPORT
 GstSDPResult            gst_sdp_media_insert_attribute      (GstSDPMedia *media, gint idx,
                                                              GstSDPAttribute *attr);
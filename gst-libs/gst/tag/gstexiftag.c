@@ -527,13 +527,20 @@ gst_exif_reader_reset (GstExifReader * reader, gboolean return_taglist)
 
 /* GstExifWriter functions */
 
+/*
+ * Initializes the writer with storage preallocated for @n_tags tag entries,
+ * so serializing doesn't need to reallocate for every tag. The directory
+ * size is exact (each entry is 12 bytes, plus entry count and next-IFD
+ * offset), the data area size is only an estimate and may still grow.
+ */
 static void
-gst_exif_writer_init (GstExifWriter * writer, gint byte_order)
+gst_exif_writer_init (GstExifWriter * writer, gint byte_order, guint n_tags)
 {
   ensure_exif_tags ();
 
-  gst_byte_writer_init (&writer->tagwriter);
-  gst_byte_writer_init (&writer->datawriter);
+  gst_byte_writer_init_with_size (&writer->tagwriter,
+      2 + n_tags * EXIF_TAG_ENTRY_SIZE + 4, FALSE);
+  gst_byte_writer_init_with_size (&writer->datawriter, n_tags * 16, FALSE);
 
   writer->byte_order = byte_order;
   writer->tags_total = 0;
@@ -557,6 +564,55 @@ gst_exif_writer_reset_and_get_buffer (GstExifWriter * writer)
   return gst_buffer_append (header, data);
 }
 
+/* indexes for the static tag maps, mapping exif tag id to map index;
+ * inserted once, so no locking needed for lookups */
+static GHashTable *tag_map_index_ifd0;
+static GHashTable *tag_map_index_exif;
+static GHashTable *tag_map_index_gps;
+
+/* map indexes are stored 1-based, negated for complementary tags, so that
+ * a failed lookup (0) can be told apart and complementary matches can be
+ * skipped when not wanted */
+static GHashTable *
+exif_tag_map_index_new (const GstExifTagMatch * tag_map)
+{
+  GHashTable *index;
+  gint i;
+
+  index = g_hash_table_new (g_direct_hash, g_direct_equal);
+  for (i = 0; tag_map[i].exif_tag != 0; i++) {
+    g_hash_table_insert (index, GUINT_TO_POINTER ((guint) tag_map[i].exif_tag),
+        GINT_TO_POINTER (i + 1));
+    if (tag_map[i].complementary_tag != 0) {
+      g_hash_table_insert (index,
+          GUINT_TO_POINTER ((guint) tag_map[i].complementary_tag),
+          GINT_TO_POINTER (-(i + 1)));
+    }
+  }
+  return index;
+}
+
+static GHashTable *
+exif_tag_map_get_index (const GstExifTagMatch * tag_map)
+{
+  static gsize init_gonce = 0;
+
+  if (g_once_init_enter (&init_gonce)) {
+    tag_map_index_ifd0 = exif_tag_map_index_new (tag_map_ifd0);
+    tag_map_index_exif = exif_tag_map_index_new (tag_map_exif);
+    tag_map_index_gps = exif_tag_map_index_new (tag_map_gps);
+    g_once_init_leave (&init_gonce, 1);
+  }
+
+  if (tag_map == tag_map_ifd0)
+    return tag_map_index_ifd0;
+  if (tag_map == tag_map_exif)
+    return tag_map_index_exif;
+  if (tag_map == tag_map_gps)
+    return tag_map_index_gps;
+  return NULL;
+}
+
 /*
  * Given the exif tag with the passed id, returns the map index of the tag
  * corresponding to it. If use_complementary is true, then the complementary
@@ -568,8 +624,20 @@ static gint
 exif_tag_map_find_reverse (guint16 exif_tag, const GstExifTagMatch * tag_map,
     gboolean use_complementary)
 {
+  GHashTable *index;
   gint i;
 
+  index = exif_tag_map_get_index (tag_map);
+  if (G_LIKELY (index != NULL)) {
+    i = GPOINTER_TO_INT (g_hash_table_lookup (index,
+            GUINT_TO_POINTER ((guint) exif_tag)));
+    if (i > 0)
+      return i - 1;
+    if (i < 0 && use_complementary)
+      return -i - 1;
+    return -1;
+  }
+
   for (i = 0; tag_map[i].exif_tag != 0; i++) {
     if (exif_tag == tag_map[i].exif_tag || (use_complementary &&
             exif_tag == tag_map[i].complementary_tag)) {
@@ -603,6 +671,37 @@ gst_tag_list_has_ifd_tags (const GstTagList * taglist,
   return FALSE;
 }
 
+/*
+ * Estimates the number of tag entries that serializing @taglist with
+ * @tag_map will produce, so the writer storage can be sized up front.
+ * Tags with a complementary tag write two entries (e.g. a GPS coordinate
+ * and its reference direction).
+ */
+static guint
+gst_tag_list_count_ifd_tags (const GstTagList * taglist,
+    const GstExifTagMatch * tag_map)
+{
+  guint count = 0;
+  gint i;
+
+  for (i = 0; tag_map[i].exif_tag != 0; i++) {
+    if (tag_map[i].gst_tag == NULL) {
+      if ((tag_map[i].exif_tag == EXIF_GPS_IFD_TAG &&
+              gst_tag_list_has_ifd_tags (taglist, tag_map_gps)) ||
+          (tag_map[i].exif_tag == EXIF_IFD_TAG &&
+              gst_tag_list_has_ifd_tags (taglist, tag_map_exif)) ||
+          tag_map[i].exif_tag == EXIF_VERSION_TAG ||
+          tag_map[i].exif_tag == EXIF_FLASHPIX_VERSION_TAG)
+        count++;
+      continue;
+    }
+
+    if (gst_tag_list_get_value_index (taglist, tag_map[i].gst_tag, 0))
+      count += (tag_map[i].complementary_tag != 0) ? 2 : 1;
+  }
+  return count;
+}
+
 /*
  * Writes the tag entry.
  *
@@ -1576,7 +1675,8 @@ write_exif_ifd (const GstTagList * taglist, guint byte_order,
     return NULL;
   }
 
-  gst_exif_writer_init (&writer, byte_order);
+  gst_exif_writer_init (&writer, byte_order,
+      gst_tag_list_count_ifd_tags (taglist, tag_map));
 
   /* write tag number as 0 */
   handled &= gst_byte_writer_put_uint16_le (&writer.tagwriter, 0);
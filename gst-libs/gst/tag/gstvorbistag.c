@@ -41,6 +41,38 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "tag-base64-x86-avx2.h"
+#endif
+
+/* in-place base64 decode of @len characters, like
+ * g_base64_decode_inplace() but with a vectorized fast path for the
+ * potentially megabytes-sized picture payloads */
+static gsize
+decode_base64_inplace (gchar * data, gsize len)
+{
+#ifdef CHECK_X86
+  static gsize once = 0;
+  static gboolean use_avx2 = FALSE;
+
+  if (g_once_init_enter (&once)) {
+    use_avx2 = tag_base64_avx2_available ();
+    g_once_init_leave (&once, 1);
+  }
+  if (use_avx2)
+    return tag_base64_decode_avx2 ((guint8 *) data, len);
+#endif
+  {
+    gsize out_len = 0;
+
+    if (len > 0)
+      g_base64_decode_inplace (data, &out_len);
+    return out_len;
+  }
+}
+
 /*
  * see http://xiph.org/ogg/vorbis/doc/v-comment.html
  */
@@ -307,7 +339,7 @@ gst_vorbis_tag_add_coverart (GstTagList * tags, gchar * img_data_base64,
   /* img_data_base64 points to a temporary copy of the base64 encoded data, so
    * it's safe to do inpace decoding here
    */
-  g_base64_decode_inplace (img_data_base64, &img_len);
+  img_len = decode_base64_inplace (img_data_base64, base64_len);
   if (img_len == 0)
     goto decode_failed;
 
@@ -358,7 +390,7 @@ gst_vorbis_tag_add_metadata_block_picture (GstTagList * tags,
   /* img_data_base64 points to a temporary copy of the base64 encoded data, so
    * it's safe to do inpace decoding here
    */
-  g_base64_decode_inplace (value, &decoded_len);
+  decoded_len = decode_base64_inplace (value, value_len);
   if (decoded_len == 0)
     goto decode_failed;
 
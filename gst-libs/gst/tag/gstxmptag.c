@@ -223,6 +223,14 @@ gst_xmp_schema_new ()
  */
 static GHashTable *__xmp_schemas;
 
+/*
+ * Maps xmp tag names (e.g. "dc:title") to their XmpTag, across all schemas.
+ * Filled while the schemas are registered, and insert-once after that, so
+ * lookups need no locking. Children of struct tags are not in here, they
+ * are only looked up in the context of their parent tag.
+ */
+static GHashTable *__xmp_tag_map_reverse;
+
 static GstXmpSchema *
 _gst_xmp_get_schema (const gchar * name)
 {
@@ -267,6 +275,21 @@ _gst_xmp_schema_add_mapping (GstXmpSchema * schema, XmpTag * tag)
     return;
   }
   gst_xmp_schema_insert (schema, GUINT_TO_POINTER (key), tag);
+
+  /* index the xmp tag name(s) for reverse lookups; compound tags have no
+   * name of their own, they are represented by their children */
+  if (tag->tag_name) {
+    g_hash_table_insert (__xmp_tag_map_reverse, (gpointer) tag->tag_name, tag);
+  } else {
+    GSList *walk;
+
+    for (walk = tag->children; walk; walk = g_slist_next (walk)) {
+      XmpTag *child = walk->data;
+
+      g_hash_table_insert (__xmp_tag_map_reverse, (gpointer) child->tag_name,
+          child);
+    }
+  }
 }
 
 static XmpTag *
@@ -351,60 +374,18 @@ _xmp_tag_get_mapping (const gchar * gst_tag, XmpSerializationData * serdata)
 }
 #endif
 
-/* finds the gst tag that maps to this xmp tag in this schema */
-static const gchar *
-_gst_xmp_schema_get_mapping_reverse (GstXmpSchema * schema,
-    const gchar * xmp_tag, XmpTag ** _xmp_tag)
-{
-  GHashTableIter iter;
-  gpointer key, value;
-  const gchar *ret = NULL;
-
-  /* Iterate over the hashtable */
-  g_hash_table_iter_init (&iter, schema);
-  while (!ret && g_hash_table_iter_next (&iter, &key, &value)) {
-    XmpTag *xmpinfo = (XmpTag *) value;
-
-    if (xmpinfo->tag_name) {
-      if (strcmp (xmpinfo->tag_name, xmp_tag) == 0) {
-        *_xmp_tag = xmpinfo;
-        ret = g_quark_to_string (GPOINTER_TO_UINT (key));
-        goto out;
-      }
-    } else if (xmpinfo->children) {
-      GSList *iter;
-      for (iter = xmpinfo->children; iter; iter = g_slist_next (iter)) {
-        XmpTag *child = iter->data;
-        if (strcmp (child->tag_name, xmp_tag) == 0) {
-          *_xmp_tag = child;
-          ret = g_quark_to_string (GPOINTER_TO_UINT (key));
-          goto out;
-        }
-      }
-    } else {
-      g_assert_not_reached ();
-    }
-  }
-
-out:
-  return ret;
-}
-
 /* finds the gst tag that maps to this xmp tag (searches on all schemas) */
 static const gchar *
 _gst_xmp_tag_get_mapping_reverse (const gchar * xmp_tag, XmpTag ** _xmp_tag)
 {
-  GHashTableIter iter;
-  gpointer key, value;
-  const gchar *ret = NULL;
+  XmpTag *xmpinfo;
 
-  /* Iterate over the hashtable */
-  g_hash_table_iter_init (&iter, __xmp_schemas);
-  while (!ret && g_hash_table_iter_next (&iter, &key, &value)) {
-    ret = _gst_xmp_schema_get_mapping_reverse ((GstXmpSchema *) value, xmp_tag,
-        _xmp_tag);
-  }
-  return ret;
+  xmpinfo = g_hash_table_lookup (__xmp_tag_map_reverse, xmp_tag);
+  if (xmpinfo == NULL)
+    return NULL;
+
+  *_xmp_tag = xmpinfo;
+  return xmpinfo->gst_tag;
 }
 
 /* utility functions/macros */
@@ -941,6 +922,7 @@ _init_xmp_tag_map (gpointer user_data)
   GstXmpSchema *schema;
 
   __xmp_schemas = g_hash_table_new (g_direct_hash, g_direct_equal);
+  __xmp_tag_map_reverse = g_hash_table_new (g_str_hash, g_str_equal);
 
   /* add the maps */
   /* dublic code metadata
@@ -233,6 +233,8 @@ gst_tag_list_from_id3v2_tag (GstBuffer * buffer)
 
   memset (&work, 0, sizeof (ID3TagsWorking));
   work.buffer = buffer;
+  work.map_data = info.data;
+  work.map_size = info.size;
   work.hdr.version = version;
   work.hdr.size = read_size;
   work.hdr.flags = flags;
@@ -301,21 +303,19 @@ id3v2_frame_hdr_size (guint id3v2ver)
   }
 }
 
+/* must be sorted, we binary search it (2.2 and 2.3 frames) */
 static const gchar obsolete_frame_ids[][5] = {
-  {"CRM"}, {"EQU"}, {"LNK"}, {"RVA"}, {"TIM"}, {"TSI"}, /* From 2.2 */
-  {"EQUA"}, {"RVAD"}, {"TIME"}, {"TRDA"}, {"TSIZ"}      /* From 2.3 */
+  {"CRM"}, {"EQU"}, {"EQUA"}, {"LNK"}, {"RVA"}, {"RVAD"},
+  {"TIM"}, {"TIME"}, {"TRDA"}, {"TSI"}, {"TSIZ"}
 };
 
+/* must be sorted by original id, we binary search it
+ * (2.2 frames are the 3-character ids, 2.3 frames the 4-character ones) */
 static const struct ID3v2FrameIDConvert
 {
   const gchar orig[5];
   const gchar new[5];
 } frame_id_conversions[] = {
-  /* 2.3.x frames */
-  {
-  "TORY", "TDOR"}, {
-  "TYER", "TDRC"},
-      /* 2.2.x frames */
   {
   "BUF", "RBUF"}, {
   "CNT", "PCNT"}, {
@@ -348,6 +348,7 @@ static const struct ID3v2FrameIDConvert
   "TOF", "TOFN"}, {
   "TOL", "TOLY"}, {
   "TOR", "TDOR"}, {
+  "TORY", "TDOR"}, {
   "TOT", "TOAL"}, {
   "TP1", "TPE1"}, {
   "TP2", "TPE2"}, {
@@ -365,6 +366,7 @@ static const struct ID3v2FrameIDConvert
   "TXT", "TOLY"}, {
   "TXX", "TXXX"}, {
   "TYE", "TDRC"}, {
+  "TYER", "TDRC"}, {
   "UFI", "UFID"}, {
   "ULT", "USLT"}, {
   "WAF", "WOAF"}, {
@@ -379,17 +381,33 @@ static const struct ID3v2FrameIDConvert
 static gboolean
 convert_fid_to_v240 (gchar * frame_id)
 {
-  gint i;
-
-  for (i = 0; i < G_N_ELEMENTS (obsolete_frame_ids); ++i) {
-    if (strncmp (frame_id, obsolete_frame_ids[i], 5) == 0)
+  gint lo, hi, mid, cmp;
+
+  lo = 0;
+  hi = G_N_ELEMENTS (obsolete_frame_ids) - 1;
+  while (lo <= hi) {
+    mid = (lo + hi) / 2;
+    cmp = strncmp (frame_id, obsolete_frame_ids[mid], 5);
+    if (cmp == 0)
       return TRUE;
+    else if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
   }
 
-  for (i = 0; i < G_N_ELEMENTS (frame_id_conversions); ++i) {
-    if (strncmp (frame_id, frame_id_conversions[i].orig, 5) == 0) {
-      strcpy (frame_id, frame_id_conversions[i].new);
+  lo = 0;
+  hi = G_N_ELEMENTS (frame_id_conversions) - 1;
+  while (lo <= hi) {
+    mid = (lo + hi) / 2;
+    cmp = strncmp (frame_id, frame_id_conversions[mid].orig, 5);
+    if (cmp == 0) {
+      strcpy (frame_id, frame_id_conversions[mid].new);
       return FALSE;
+    } else if (cmp < 0) {
+      hi = mid - 1;
+    } else {
+      lo = mid + 1;
     }
   }
   return FALSE;
@@ -49,10 +49,15 @@ typedef struct {
 
 typedef struct {
   ID3v2Header hdr;
-  
+
   GstBuffer *buffer;
   GstTagList *tags;
 
+  /* Mapped data of buffer, so frame payloads that still point into the
+   * mapped region can be extracted without copying */
+  const guint8 *map_data;
+  gsize map_size;
+
   /* Current frame decoding */
   guint cur_frame_size;
   gchar *frame_id;
@@ -566,6 +566,87 @@ scan_encoded_string (guint8 encoding, gchar * data, gint data_size)
   return 0;
 }
 
+/* Add the picture to the tag list without copying the image data, by
+ * creating a sub-buffer that shares the memory of the mapped tag buffer.
+ * Only possible if the frame payload has not been rewritten for
+ * un-unsynchronisation or decompression, i.e. if it still points into the
+ * mapped tag data. Returns FALSE if the caller should fall back to the
+ * copying code path. */
+static gboolean
+parse_picture_frame_zero_copy (ID3TagsWorking * work, guint8 pic_type)
+{
+  GstTagImageType image_type;
+  GstStructure *image_info = NULL;
+  const gchar *tag_name, *name;
+  GstBuffer *image;
+  GstSample *sample;
+  GstCaps *caps = NULL;
+
+  if (work->map_data == NULL ||
+      work->parse_data < work->map_data ||
+      work->parse_data + work->parse_size > work->map_data + work->map_size)
+    return FALSE;
+
+  image = gst_buffer_copy_region (work->buffer, GST_BUFFER_COPY_MEMORY,
+      work->parse_data - work->map_data, work->parse_size);
+
+  /* Find GStreamer media type, can't trust declared type */
+  caps = gst_type_find_helper_for_buffer (NULL, image, NULL);
+
+  if (caps == NULL)
+    goto no_type;
+
+  GST_DEBUG ("Found GStreamer media type: %" GST_PTR_FORMAT, caps);
+
+  name = gst_structure_get_name (gst_caps_get_structure (caps, 0));
+
+  /* URI lists need a NUL terminator appended and hence a copy, so only
+   * accept actual image data here; anything else takes the copying path */
+  if (!g_str_has_prefix (name, "image/") && !g_str_has_prefix (name, "video/"))
+    goto not_an_image;
+
+  if (pic_type == 0x01 || pic_type == 0x02) {
+    /* file icon for preview. Don't add image-type to the sample info, since
+     * there is only supposed to be one of these, and the type is already
+     * indicated via the special tag */
+    tag_name = GST_TAG_PREVIEW_IMAGE;
+  } else {
+    tag_name = GST_TAG_IMAGE;
+
+    /* Remap the ID3v2 APIC type to our ImageType enum */
+    if (pic_type >= 0x3 && pic_type <= 0x14)
+      image_type = (GstTagImageType) (pic_type - 2);
+    else
+      image_type = GST_TAG_IMAGE_TYPE_UNDEFINED;
+
+    image_info = gst_structure_new ("GstTagImageInfo",
+        "image-type", GST_TYPE_TAG_IMAGE_TYPE, image_type, NULL);
+  }
+
+  sample = gst_sample_new (image, caps, NULL, image_info);
+  gst_buffer_unref (image);
+  gst_caps_unref (caps);
+
+  gst_tag_list_add (work->tags, GST_TAG_MERGE_APPEND, tag_name, sample, NULL);
+  gst_sample_unref (sample);
+
+  return TRUE;
+
+/* ERRORS */
+no_type:
+  {
+    GST_DEBUG ("Could not determine media type of shared image data");
+    /* fall through */
+  }
+not_an_image:
+  {
+    gst_buffer_unref (image);
+    if (caps)
+      gst_caps_unref (caps);
+    return FALSE;
+  }
+}
+
 static gboolean
 parse_picture_frame (ID3TagsWorking * work)
 {
@@ -634,6 +715,13 @@ parse_picture_frame (ID3TagsWorking * work)
   if (work->parse_size <= 0)
     goto not_enough_data;
 
+  /* try sharing the tag buffer's memory first, to avoid copying
+   * potentially megabytes of embedded cover art */
+  if (parse_picture_frame_zero_copy (work, pic_type)) {
+    g_free (mime_str);
+    return TRUE;
+  }
+
   if (!gst_tag_list_add_id3_image (work->tags, (guint8 *) work->parse_data,
           work->parse_size, pic_type)) {
     goto error;
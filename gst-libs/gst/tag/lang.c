@@ -256,6 +256,88 @@ qsort_strcmp_func (const void *p1, const void *p2)
   return strcmp (*(char *const *) p1, *(char *const *) p2);
 }
 
+static int
+qsort_iso_639_2_index_cmp (const void *p1, const void *p2)
+{
+  return strcmp (iso_639_codes[*(const guint16 *) p1].iso_639_2,
+      iso_639_codes[*(const guint16 *) p2].iso_639_2);
+}
+
+/* the generated table is sorted by two-letter code, but the three-letter
+ * codes in it are not in sorted order, so build an index sorted by those
+ * once, to allow binary searching both ways */
+static const guint16 *
+get_iso_639_2_index (void)
+{
+  static gsize once_val = 0;
+
+  if (g_once_init_enter (&once_val)) {
+    guint16 *index;
+    guint i;
+
+    index = g_new (guint16, G_N_ELEMENTS (iso_639_codes));
+    for (i = 0; i < G_N_ELEMENTS (iso_639_codes); ++i)
+      index[i] = i;
+
+    qsort (index, G_N_ELEMENTS (iso_639_codes), sizeof (guint16),
+        qsort_iso_639_2_index_cmp);
+
+    g_once_init_leave (&once_val, (gsize) index);
+  }
+
+  return (const guint16 *) once_val;
+}
+
+/*
+ * Returns the index of an entry in iso_639_codes whose two- or three-letter
+ * code matches @lang_code, or -1 if there is none. For languages with both
+ * a bibliographic and a terminological three-letter code the table contains
+ * two adjacent entries sharing the same name offset, and either of them may
+ * be returned here.
+ */
+static gint
+find_iso_639_code (const gchar * lang_code)
+{
+  const guint16 *index;
+  gint lo, hi, mid, cmp;
+
+  if (lang_code[0] == '\0' || lang_code[1] == '\0')
+    return -1;
+
+  if (lang_code[2] == '\0') {
+    /* two-letter code, the table itself is sorted by those */
+    lo = 0;
+    hi = G_N_ELEMENTS (iso_639_codes) - 1;
+    while (lo <= hi) {
+      mid = (lo + hi) / 2;
+      cmp = strcmp (lang_code, iso_639_codes[mid].iso_639_1);
+      if (cmp == 0)
+        return mid;
+      else if (cmp < 0)
+        hi = mid - 1;
+      else
+        lo = mid + 1;
+    }
+    return -1;
+  }
+
+  index = get_iso_639_2_index ();
+
+  lo = 0;
+  hi = G_N_ELEMENTS (iso_639_codes) - 1;
+  while (lo <= hi) {
+    mid = (lo + hi) / 2;
+    cmp = strcmp (lang_code, iso_639_codes[index[mid]].iso_639_2);
+    if (cmp == 0)
+      return index[mid];
+    else if (cmp < 0)
+      hi = mid - 1;
+    else
+      lo = mid + 1;
+  }
+  return -1;
+}
+
 /**
  * gst_tag_get_language_codes:
  *
@@ -363,16 +445,13 @@ gst_tag_get_language_code_iso_639_1 (const gchar * lang_code)
    * map the language codes from our static table. Theoretically the iso-codes
    * XML file might have had additional codes that are now in the hash table.
    * We keep it simple for now and don't waste memory on additional tables. */
-  for (i = 0; i < G_N_ELEMENTS (iso_639_codes); ++i) {
-    /* we check both codes here, so function can be used in a more versatile
-     * way, to convert a language tag to a two-letter language code and/or
-     * verify an existing code */
-    if (strcmp (lang_code, iso_639_codes[i].iso_639_1) == 0 ||
-        strcmp (lang_code, iso_639_codes[i].iso_639_2) == 0) {
-      c = iso_639_codes[i].iso_639_1;
-      break;
-    }
-  }
+
+  /* we check both codes here, so function can be used in a more versatile
+   * way, to convert a language tag to a two-letter language code and/or
+   * verify an existing code */
+  i = find_iso_639_code (lang_code);
+  if (i != -1)
+    c = iso_639_codes[i].iso_639_1;
 
   GST_LOG ("%s -> %s", lang_code, GST_STR_NULL (c));
 
@@ -390,22 +469,21 @@ gst_tag_get_language_code_iso_639_2X (const gchar * lang_code, guint8 flags)
    * We keep it simple for now and don't waste memory on additional tables.
    * Also, we currently only parse the iso_639.xml file if language names or
    * a list of all codes is requested, and it'd be nice to keep it like that. */
-  for (i = 0; i < G_N_ELEMENTS (iso_639_codes); ++i) {
-    /* we check both codes here, so function can be used in a more versatile
-     * way, to convert a language tag to a three-letter language code and/or
-     * verify an existing code */
-    if (strcmp (lang_code, iso_639_codes[i].iso_639_1) == 0 ||
-        strcmp (lang_code, iso_639_codes[i].iso_639_2) == 0) {
-      if ((iso_639_codes[i].flags & flags) == flags) {
-        return iso_639_codes[i].iso_639_2;
-      } else if (i > 0 && (iso_639_codes[i - 1].flags & flags) == flags &&
-          iso_639_codes[i].name_offset == iso_639_codes[i - 1].name_offset) {
-        return iso_639_codes[i - 1].iso_639_2;
-      } else if ((i + 1) < G_N_ELEMENTS (iso_639_codes) &&
-          (iso_639_codes[i + 1].flags & flags) == flags &&
-          iso_639_codes[i].name_offset == iso_639_codes[i + 1].name_offset) {
-        return iso_639_codes[i + 1].iso_639_2;
-      }
+
+  /* we check both codes here, so function can be used in a more versatile
+   * way, to convert a language tag to a three-letter language code and/or
+   * verify an existing code */
+  i = find_iso_639_code (lang_code);
+  if (i != -1) {
+    if ((iso_639_codes[i].flags & flags) == flags) {
+      return iso_639_codes[i].iso_639_2;
+    } else if (i > 0 && (iso_639_codes[i - 1].flags & flags) == flags &&
+        iso_639_codes[i].name_offset == iso_639_codes[i - 1].name_offset) {
+      return iso_639_codes[i - 1].iso_639_2;
+    } else if ((i + 1) < G_N_ELEMENTS (iso_639_codes) &&
+        (iso_639_codes[i + 1].flags & flags) == flags &&
+        iso_639_codes[i].name_offset == iso_639_codes[i + 1].name_offset) {
+      return iso_639_codes[i + 1].iso_639_2;
     }
   }
   return NULL;
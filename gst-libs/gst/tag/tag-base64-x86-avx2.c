@@ -0,0 +1,137 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "tag-base64-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+/* Decode 32 base64 characters at @src into 24 bytes at @dst, using the
+ * lookup-shuffle technique: classify each character by its nibbles to
+ * validate it, then add a per-class offset to map it to its 6-bit value
+ * and pack the values with two multiply-adds. Returns FALSE without
+ * writing anything when a character is not plain base64 (padding,
+ * whitespace, ...). @dst may lag behind @src in the same buffer; only
+ * 32 bytes are stored of which the first 24 are valid. */
+static inline gboolean
+decode32 (const guint8 * src, guint8 * dst)
+{
+  const __m256i lut_lo = _mm256_setr_epi8 (
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a,
+      0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+      0x11, 0x11, 0x13, 0x1a, 0x1b, 0x1b, 0x1b, 0x1a);
+  const __m256i lut_hi = _mm256_setr_epi8 (
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+      0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+      0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+  const __m256i lut_roll = _mm256_setr_epi8 (
+      0, 16, 19, 4, -65, -65, -71, -71,
+      0, 0, 0, 0, 0, 0, 0, 0,
+      0, 16, 19, 4, -65, -65, -71, -71,
+      0, 0, 0, 0, 0, 0, 0, 0);
+  __m256i v, hi_nib, lo_nib, lo, hi, eq_2f, roll, merged, packed;
+
+  v = _mm256_loadu_si256 ((const __m256i *) src);
+  hi_nib = _mm256_and_si256 (_mm256_srli_epi32 (v, 4),
+      _mm256_set1_epi8 (0x0f));
+  lo_nib = _mm256_and_si256 (v, _mm256_set1_epi8 (0x0f));
+
+  lo = _mm256_shuffle_epi8 (lut_lo, lo_nib);
+  hi = _mm256_shuffle_epi8 (lut_hi, hi_nib);
+
+  if (!_mm256_testz_si256 (lo, hi))
+    return FALSE;
+
+  /* '/' shares its high nibble with '+', shift its roll index down */
+  eq_2f = _mm256_cmpeq_epi8 (v, _mm256_set1_epi8 (0x2f));
+  roll = _mm256_shuffle_epi8 (lut_roll, _mm256_add_epi8 (eq_2f, hi_nib));
+  v = _mm256_add_epi8 (v, roll);
+
+  /* pack the 32 6-bit values into 24 bytes */
+  merged = _mm256_maddubs_epi16 (v, _mm256_set1_epi32 (0x01400140));
+  packed = _mm256_madd_epi16 (merged, _mm256_set1_epi32 (0x00011000));
+  packed = _mm256_shuffle_epi8 (packed, _mm256_setr_epi8 (
+          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+          2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+  packed = _mm256_permutevar8x32_epi32 (packed,
+      _mm256_setr_epi32 (0, 1, 2, 4, 5, 6, 7, 7));
+
+  _mm256_storeu_si256 ((__m256i *) dst, packed);
+  return TRUE;
+}
+
+gsize
+tag_base64_decode_avx2 (guint8 * data, gsize len)
+{
+  gsize in = 0, out = 0;
+  gint state = 0;
+  guint save = 0;
+
+  /* in-place is safe: the output runs at 3/4 of the input position and
+   * the 8 bytes of store slack never reach the next load. Leaving at
+   * least 45 characters for the tail keeps the slack inside the output
+   * buffer and pushes padding into the scalar path below. */
+  while (len - in >= 45) {
+    if (!decode32 (data + in, data + out))
+      break;
+    in += 32;
+    out += 24;
+  }
+
+  /* let GLib deal with the remainder: padding, whitespace and
+   * non-base64 characters */
+  out += g_base64_decode_step ((const gchar *) data + in, len - in,
+      data + out, &state, &save);
+
+  return out;
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stub so that the dispatch code always links; it is never called
+ * because tag_base64_avx2_available() returns FALSE. */
+
+gsize
+tag_base64_decode_avx2 (guint8 * data, gsize len)
+{
+  g_assert_not_reached ();
+  return 0;
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+tag_base64_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
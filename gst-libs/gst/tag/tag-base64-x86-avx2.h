@@ -0,0 +1,35 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef TAG_BASE64_X86_AVX2_H
+#define TAG_BASE64_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the avx2 kernel below was compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean tag_base64_avx2_available (void);
+
+/* Decode @len base64 characters in @data in place and return the decoded
+ * size; same semantics as g_base64_decode_inplace(). Padding, whitespace
+ * and other non-base64 characters are handled by falling back to the
+ * GLib decoder for the remainder of the input. */
+gsize tag_base64_decode_avx2 (guint8 * data, gsize len);
+
+#endif /* TAG_BASE64_X86_AVX2_H */
@@ -277,6 +277,117 @@ link_failed:
   }
 }
 
+/* Keep a few idle conversion pipelines around, keyed on the caps pair.
+ * Pipeline construction and negotiation dwarf the actual conversion for
+ * users that convert many samples with the same caps (thumbnailers), so
+ * a finished pipeline goes back to READY and is parked here instead of
+ * being torn down. Pipelines with baked-in crop parameters are never
+ * cached. */
+#define CONVERT_PIPELINE_CACHE_SIZE 4
+
+typedef struct
+{
+  GstCaps *from_caps;
+  GstCaps *to_caps;
+  GstElement *pipeline;
+  GstElement *src;
+  GstElement *sink;
+  guint64 age;
+} ConvertPipelineCacheEntry;
+
+static GMutex convert_pipeline_cache_lock;
+static GList *convert_pipeline_cache = NULL;
+static guint64 convert_pipeline_cache_age = 0;
+
+static void
+convert_pipeline_cache_entry_free (ConvertPipelineCacheEntry * entry)
+{
+  gst_element_set_state (entry->pipeline, GST_STATE_NULL);
+  gst_object_unref (entry->pipeline);
+  gst_caps_unref (entry->from_caps);
+  gst_caps_unref (entry->to_caps);
+  g_slice_free (ConvertPipelineCacheEntry, entry);
+}
+
+/* Take a matching idle pipeline out of the cache, the caller owns it */
+static GstElement *
+convert_pipeline_cache_acquire (const GstCaps * from_caps,
+    const GstCaps * to_caps, GstElement ** src, GstElement ** sink)
+{
+  GstElement *pipeline = NULL;
+  GList *l;
+
+  g_mutex_lock (&convert_pipeline_cache_lock);
+  for (l = convert_pipeline_cache; l; l = l->next) {
+    ConvertPipelineCacheEntry *entry = l->data;
+
+    if (gst_caps_is_equal (entry->from_caps, from_caps) &&
+        gst_caps_is_equal (entry->to_caps, to_caps)) {
+      pipeline = entry->pipeline;
+      *src = entry->src;
+      *sink = entry->sink;
+      gst_caps_unref (entry->from_caps);
+      gst_caps_unref (entry->to_caps);
+      g_slice_free (ConvertPipelineCacheEntry, entry);
+      convert_pipeline_cache = g_list_delete_link (convert_pipeline_cache, l);
+      GST_DEBUG ("reusing cached conversion pipeline %p", pipeline);
+      break;
+    }
+  }
+  g_mutex_unlock (&convert_pipeline_cache_lock);
+
+  return pipeline;
+}
+
+static void
+convert_pipeline_cache_release (const GstCaps * from_caps,
+    const GstCaps * to_caps, GstElement * pipeline, GstElement * src,
+    GstElement * sink)
+{
+  ConvertPipelineCacheEntry *entry;
+
+  /* back to READY; this flushes appsrc and appsink so the next sample
+   * prerolls from a clean state */
+  if (gst_element_set_state (pipeline, GST_STATE_READY) !=
+      GST_STATE_CHANGE_SUCCESS) {
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+    return;
+  }
+
+  entry = g_slice_new (ConvertPipelineCacheEntry);
+  entry->from_caps = gst_caps_copy (from_caps);
+  entry->to_caps = gst_caps_copy (to_caps);
+  entry->pipeline = pipeline;
+  entry->src = src;
+  entry->sink = sink;
+
+  g_mutex_lock (&convert_pipeline_cache_lock);
+  entry->age = convert_pipeline_cache_age++;
+  convert_pipeline_cache = g_list_prepend (convert_pipeline_cache, entry);
+
+  if (g_list_length (convert_pipeline_cache) > CONVERT_PIPELINE_CACHE_SIZE) {
+    GList *l, *oldest = NULL;
+
+    for (l = convert_pipeline_cache; l; l = l->next) {
+      ConvertPipelineCacheEntry *e = l->data;
+
+      if (oldest == NULL
+          || e->age < ((ConvertPipelineCacheEntry *) oldest->data)->age)
+        oldest = l;
+    }
+    entry = oldest->data;
+    convert_pipeline_cache =
+        g_list_delete_link (convert_pipeline_cache, oldest);
+  } else {
+    entry = NULL;
+  }
+  g_mutex_unlock (&convert_pipeline_cache_lock);
+
+  if (entry)
+    convert_pipeline_cache_entry_free (entry);
+}
+
 /**
  * gst_video_convert_sample:
  * @sample: a #GstSample
@@ -304,7 +415,8 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
   GstBus *bus;
   GstCaps *from_caps, *to_caps_copy = NULL;
   GstFlowReturn ret;
-  GstElement *pipeline, *src, *sink;
+  GstElement *pipeline, *src = NULL, *sink = NULL;
+  gboolean cacheable;
   guint i, n;
 
   g_return_val_if_fail (sample != NULL, NULL);
@@ -327,11 +439,19 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
     gst_caps_append_structure (to_caps_copy, s);
   }
 
-  pipeline =
-      build_convert_frame_pipeline (&src, &sink, from_caps,
-      gst_buffer_get_video_crop_meta (buf), to_caps_copy, &err);
-  if (!pipeline)
-    goto no_pipeline;
+  /* crop parameters are baked into the pipeline, don't cache those */
+  cacheable = gst_buffer_get_video_crop_meta (buf) == NULL;
+
+  pipeline = cacheable ?
+      convert_pipeline_cache_acquire (from_caps, to_caps_copy, &src,
+      &sink) : NULL;
+  if (!pipeline) {
+    pipeline =
+        build_convert_frame_pipeline (&src, &sink, from_caps,
+        gst_buffer_get_video_crop_meta (buf), to_caps_copy, &err);
+    if (!pipeline)
+      goto no_pipeline;
+  }
 
   /* now set the pipeline to the paused state, after we push the buffer into
    * appsrc, this should preroll the converted buffer in appsink */
@@ -391,9 +511,14 @@ gst_video_convert_sample (GstSample * sample, const GstCaps * to_caps,
           "Could not convert video frame: timeout during conversion");
   }
 
-  gst_element_set_state (pipeline, GST_STATE_NULL);
   gst_object_unref (bus);
-  gst_object_unref (pipeline);
+  if (cacheable && result != NULL) {
+    convert_pipeline_cache_release (from_caps, to_caps_copy, pipeline, src,
+        sink);
+  } else {
+    gst_element_set_state (pipeline, GST_STATE_NULL);
+    gst_object_unref (pipeline);
+  }
   gst_caps_unref (to_caps_copy);
 
   return result;
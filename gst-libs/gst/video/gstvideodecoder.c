@@ -288,6 +288,21 @@
 GST_DEBUG_CATEGORY (videodecoder_debug);
 #define GST_CAT_DEFAULT videodecoder_debug
 
+enum
+{
+  PROP_0,
+  PROP_SKIP_LEVEL
+};
+
+/* the skip level is raised after this many consecutive QoS events with a
+ * proportion above the raise threshold and lowered again after more
+ * consecutive events below the lower threshold; the gap between the
+ * thresholds and the larger lower count provide the hysteresis */
+#define SKIP_LEVEL_RAISE_PROPORTION 1.05
+#define SKIP_LEVEL_LOWER_PROPORTION 0.90
+#define SKIP_LEVEL_RAISE_EVENTS 4
+#define SKIP_LEVEL_LOWER_EVENTS 8
+
 #define GST_VIDEO_DECODER_GET_PRIVATE(obj)  \
     (G_TYPE_INSTANCE_GET_PRIVATE ((obj), GST_TYPE_VIDEO_DECODER, \
         GstVideoDecoderPrivate))
@@ -356,6 +371,14 @@ struct _GstVideoDecoderPrivate
   /* collected output - of buffer objects, not frames */
   GList *output_queued;
 
+  /* push output buffers finished during one chain call as a buffer list,
+   * set by the subclass */
+  gboolean use_buffer_lists;
+  /* TRUE while an input buffer is handled in the chain function */
+  gboolean in_chain;
+  /* buffers collected during the current chain call */
+  GstBufferList *output_list;
+
 
   /* base_picture_number is the picture number of the reference picture */
   guint64 base_picture_number;
@@ -370,6 +393,10 @@ struct _GstVideoDecoderPrivate
   guint32 decode_frame_number;
 
   GList *frames;                /* Protected with OBJECT_LOCK */
+  /* index into frames on system_frame_number, for O(1) lookup in
+   * gst_video_decoder_get_frame(). Same protection as frames, entries
+   * are borrowed references */
+  GHashTable *frames_index;
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;     /* OBJECT_LOCK and STREAM_LOCK */
   gboolean output_state_changed;
@@ -379,6 +406,10 @@ struct _GstVideoDecoderPrivate
   GstClockTime earliest_time;   /* OBJECT_LOCK */
   GstClockTime qos_frame_duration;      /* OBJECT_LOCK */
   gboolean discont;
+  /* adaptive frame skipping, derived from QoS feedback */
+  GstVideoDecoderSkipLevel skip_level;  /* OBJECT_LOCK */
+  guint qos_late_events;        /* OBJECT_LOCK */
+  guint qos_early_events;       /* OBJECT_LOCK */
   /* qos messages: frames dropped/processed */
   guint dropped;
   guint processed;
@@ -415,6 +446,8 @@ static void gst_video_decoder_init (GstVideoDecoder * dec,
     GstVideoDecoderClass * klass);
 
 static void gst_video_decoder_finalize (GObject * object);
+static void gst_video_decoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_video_decoder_setcaps (GstVideoDecoder * dec,
     GstCaps * caps);
@@ -444,8 +477,12 @@ static GstVideoCodecFrame *gst_video_decoder_new_frame (GstVideoDecoder *
     decoder);
 static GstFlowReturn gst_video_decoder_clip_and_push_buf (GstVideoDecoder *
     decoder, GstBuffer * buf);
+static GstFlowReturn gst_video_decoder_finish_frame_unlocked (GstVideoDecoder *
+    decoder, GstVideoCodecFrame * frame);
 static GstFlowReturn gst_video_decoder_flush_parse (GstVideoDecoder * dec,
     gboolean at_eos);
+static GstFlowReturn gst_video_decoder_push_output_list (GstVideoDecoder *
+    decoder);
 
 static void gst_video_decoder_clear_queues (GstVideoDecoder * dec);
 
@@ -514,6 +551,22 @@ gst_video_decoder_class_init (GstVideoDecoderClass * klass)
   g_type_class_add_private (klass, sizeof (GstVideoDecoderPrivate));
 
   gobject_class->finalize = gst_video_decoder_finalize;
+  gobject_class->get_property = gst_video_decoder_get_property;
+
+  /**
+   * GstVideoDecoder::skip-level:
+   *
+   * The degradation level currently suggested by the base class, derived
+   * from QoS feedback. See gst_video_decoder_get_skip_level().
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_SKIP_LEVEL,
+      g_param_spec_enum ("skip-level", "Skip Level",
+          "Suggested degradation level derived from QoS feedback",
+          GST_TYPE_VIDEO_DECODER_SKIP_LEVEL,
+          GST_VIDEO_DECODER_SKIP_LEVEL_NONE,
+          G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_video_decoder_change_state);
@@ -538,6 +591,8 @@ gst_video_decoder_init (GstVideoDecoder * decoder, GstVideoDecoderClass * klass)
 
   decoder->priv = GST_VIDEO_DECODER_GET_PRIVATE (decoder);
 
+  decoder->priv->frames_index = g_hash_table_new (NULL, NULL);
+
   pad_template =
       gst_element_class_get_pad_template (GST_ELEMENT_CLASS (klass), "sink");
   g_return_if_fail (pad_template != NULL);
@@ -586,7 +641,7 @@ _new_input_state (GstCaps * caps)
   GstStructure *structure;
   const GValue *codec_data;
 
-  state = g_slice_new0 (GstVideoCodecState);
+  state = __gst_video_codec_state_alloc ();
   state->ref_count = 1;
   gst_video_info_init (&state->info);
   if (G_UNLIKELY (!gst_video_info_from_caps (&state->info, caps)))
@@ -614,7 +669,7 @@ _new_output_state (GstVideoFormat fmt, guint width, guint height,
 {
   GstVideoCodecState *state;
 
-  state = g_slice_new0 (GstVideoCodecState);
+  state = __gst_video_codec_state_alloc ();
   state->ref_count = 1;
   gst_video_info_init (&state->info);
   if (!gst_video_info_set_format (&state->info, fmt, width, height)) {
@@ -770,9 +825,27 @@ gst_video_decoder_finalize (GObject * object)
     decoder->priv->allocator = NULL;
   }
 
+  g_hash_table_unref (decoder->priv->frames_index);
+
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+static void
+gst_video_decoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoDecoder *decoder = GST_VIDEO_DECODER (object);
+
+  switch (prop_id) {
+    case PROP_SKIP_LEVEL:
+      g_value_set_enum (value, gst_video_decoder_get_skip_level (decoder));
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
 /* hard == FLUSH, otherwise discont */
 static GstFlowReturn
 gst_video_decoder_flush (GstVideoDecoder * dec, gboolean hard)
@@ -1539,6 +1612,34 @@ gst_video_decoder_src_event_default (GstVideoDecoder * decoder,
       } else {
         priv->earliest_time = GST_CLOCK_TIME_NONE;
       }
+
+      /* track the proportion trend and move the suggested skip level with
+       * hysteresis; a single late frame never raises it and a single early
+       * one never lowers it again */
+      if (type != GST_QOS_TYPE_THROTTLE) {
+        if (proportion > SKIP_LEVEL_RAISE_PROPORTION && diff > 0) {
+          priv->qos_early_events = 0;
+          if (++priv->qos_late_events >= SKIP_LEVEL_RAISE_EVENTS &&
+              priv->skip_level < GST_VIDEO_DECODER_SKIP_LEVEL_KEY_UNITS) {
+            priv->skip_level++;
+            priv->qos_late_events = 0;
+            GST_DEBUG_OBJECT (decoder, "raising skip level to %d",
+                priv->skip_level);
+          }
+        } else if (proportion < SKIP_LEVEL_LOWER_PROPORTION) {
+          priv->qos_late_events = 0;
+          if (++priv->qos_early_events >= SKIP_LEVEL_LOWER_EVENTS &&
+              priv->skip_level > GST_VIDEO_DECODER_SKIP_LEVEL_NONE) {
+            priv->skip_level--;
+            priv->qos_early_events = 0;
+            GST_DEBUG_OBJECT (decoder, "lowering skip level to %d",
+                priv->skip_level);
+          }
+        } else {
+          priv->qos_late_events = 0;
+          priv->qos_early_events = 0;
+        }
+      }
       GST_OBJECT_UNLOCK (decoder);
 
       GST_DEBUG_OBJECT (decoder,
@@ -1978,6 +2079,11 @@ gst_video_decoder_clear_queues (GstVideoDecoder * dec)
       (GDestroyNotify) gst_mini_object_unref);
   priv->output_queued = NULL;
 
+  if (priv->output_list) {
+    gst_buffer_list_unref (priv->output_list);
+    priv->output_list = NULL;
+  }
+
   g_list_free_full (priv->gather, (GDestroyNotify) gst_mini_object_unref);
   priv->gather = NULL;
   g_list_free_full (priv->decode, (GDestroyNotify) gst_video_codec_frame_unref);
@@ -1989,6 +2095,7 @@ gst_video_decoder_clear_queues (GstVideoDecoder * dec)
   priv->parse_gather = NULL;
   g_list_free_full (priv->frames, (GDestroyNotify) gst_video_codec_frame_unref);
   priv->frames = NULL;
+  g_hash_table_remove_all (priv->frames_index);
 }
 
 static void
@@ -2026,6 +2133,9 @@ gst_video_decoder_reset (GstVideoDecoder * decoder, gboolean full,
     GST_OBJECT_LOCK (decoder);
     priv->earliest_time = GST_CLOCK_TIME_NONE;
     priv->proportion = 0.5;
+    priv->skip_level = GST_VIDEO_DECODER_SKIP_LEVEL_NONE;
+    priv->qos_late_events = 0;
+    priv->qos_early_events = 0;
     GST_OBJECT_UNLOCK (decoder);
   }
 
@@ -2137,6 +2247,13 @@ gst_video_decoder_chain_forward (GstVideoDecoder * decoder,
     if (decoder->input_segment.rate < 0.0) {
       priv->parse_gather =
           g_list_prepend (priv->parse_gather, priv->current_frame);
+    } else if (!was_keyframe
+        && (decoder->input_segment.flags & GST_SEEK_FLAG_TRICKMODE_KEY_UNITS)) {
+      /* Upstream could not (or did not) reduce the stream to key units only;
+       * decoding delta units would only produce frames that are never
+       * displayed, so get rid of them before they reach the subclass */
+      GST_LOG_OBJECT (decoder, "Dropping delta unit in key-units trick mode");
+      gst_video_decoder_release_frame (decoder, priv->current_frame);
     } else {
       ret = gst_video_decoder_decode_frame (decoder, priv->current_frame);
     }
@@ -2451,11 +2568,23 @@ gst_video_decoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
   decoder->priv->had_input_data = TRUE;
 
+  decoder->priv->in_chain = TRUE;
+
   if (decoder->input_segment.rate > 0.0)
     ret = gst_video_decoder_chain_forward (decoder, buf, FALSE);
   else
     ret = gst_video_decoder_chain_reverse (decoder, buf);
 
+  decoder->priv->in_chain = FALSE;
+
+  /* this input buffer is done, push what it produced as one list */
+  if (decoder->priv->output_list) {
+    GstFlowReturn fret = gst_video_decoder_push_output_list (decoder);
+
+    if (ret == GST_FLOW_OK)
+      ret = fret;
+  }
+
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
   return ret;
 
@@ -2563,7 +2692,7 @@ gst_video_decoder_new_frame (GstVideoDecoder * decoder)
   GstVideoDecoderPrivate *priv = decoder->priv;
   GstVideoCodecFrame *frame;
 
-  frame = g_slice_new0 (GstVideoCodecFrame);
+  frame = __gst_video_codec_frame_alloc ();
 
   frame->ref_count = 1;
 
@@ -2816,6 +2945,8 @@ gst_video_decoder_release_frame (GstVideoDecoder * dec,
   GST_VIDEO_DECODER_STREAM_LOCK (dec);
   link = g_list_find (dec->priv->frames, frame);
   if (link) {
+    g_hash_table_remove (dec->priv->frames_index,
+        GUINT_TO_POINTER (frame->system_frame_number));
     gst_video_codec_frame_unref (frame);
     dec->priv->frames = g_list_delete_link (dec->priv->frames, link);
   }
@@ -2946,6 +3077,25 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
   return TRUE;
 }
 
+/* Push the buffers collected during the current chain call downstream as
+ * one buffer list. Must be called with the stream lock, and before anything
+ * serialized (caps, tags, ...) may overtake the collected buffers. */
+static GstFlowReturn
+gst_video_decoder_push_output_list (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderPrivate *priv = decoder->priv;
+  GstBufferList *list;
+
+  if ((list = priv->output_list) == NULL)
+    return GST_FLOW_OK;
+  priv->output_list = NULL;
+
+  GST_LOG_OBJECT (decoder, "pushing %u collected buffers as a list",
+      gst_buffer_list_length (list));
+
+  return gst_pad_push_list (decoder->srcpad, list);
+}
+
 /**
  * gst_video_decoder_finish_frame:
  * @decoder: a #GstVideoDecoder
@@ -2965,6 +3115,61 @@ foreach_metadata (GstBuffer * inbuf, GstMeta ** meta, gpointer user_data)
 GstFlowReturn
 gst_video_decoder_finish_frame (GstVideoDecoder * decoder,
     GstVideoCodecFrame * frame)
+{
+  GstFlowReturn ret;
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+  ret = gst_video_decoder_finish_frame_unlocked (decoder, frame);
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
+  return ret;
+}
+
+/**
+ * gst_video_decoder_finish_frames:
+ * @decoder: a #GstVideoDecoder
+ * @frames: (array length=n_frames) (transfer full): decoded #GstVideoCodecFrame
+ * @n_frames: number of frames in @frames
+ *
+ * Finish @n_frames decoded frames in one go, like calling
+ * gst_video_decoder_finish_frame() on each of them, but with a single
+ * acquisition of the stream lock. Useful for subclasses that retire many
+ * frames at once, e.g. when draining a hardware decoder.
+ *
+ * All frames are finished even when pushing one of them fails; the first
+ * error is returned.
+ *
+ * Returns: a #GstFlowReturn resulting from sending data downstream
+ *
+ * Since: 1.14
+ */
+GstFlowReturn
+gst_video_decoder_finish_frames (GstVideoDecoder * decoder,
+    GstVideoCodecFrame ** frames, guint n_frames)
+{
+  GstFlowReturn ret = GST_FLOW_OK;
+  guint i;
+
+  g_return_val_if_fail (frames != NULL || n_frames == 0, GST_FLOW_ERROR);
+
+  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
+  for (i = 0; i < n_frames; i++) {
+    GstFlowReturn fret;
+
+    /* keep going so that all frames are released, report the first error */
+    fret = gst_video_decoder_finish_frame_unlocked (decoder, frames[i]);
+    if (ret == GST_FLOW_OK)
+      ret = fret;
+  }
+  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
+
+  return ret;
+}
+
+/* Must be called with the stream lock, takes ownership of @frame */
+static GstFlowReturn
+gst_video_decoder_finish_frame_unlocked (GstVideoDecoder * decoder,
+    GstVideoCodecFrame * frame)
 {
   GstFlowReturn ret = GST_FLOW_OK;
   GstVideoDecoderClass *decoder_class = GST_VIDEO_DECODER_GET_CLASS (decoder);
@@ -2974,11 +3179,11 @@ gst_video_decoder_finish_frame (GstVideoDecoder * decoder,
 
   GST_LOG_OBJECT (decoder, "finish frame %p", frame);
 
-  GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-
   needs_reconfigure = gst_pad_check_reconfigure (decoder->srcpad);
   if (G_UNLIKELY (priv->output_state_changed || (priv->output_state
               && needs_reconfigure))) {
+    /* buffers collected so far still have the old caps */
+    gst_video_decoder_push_output_list (decoder);
     if (!gst_video_decoder_negotiate_unlocked (decoder)) {
       gst_pad_mark_reconfigure (decoder->srcpad);
       if (GST_PAD_IS_FLUSHING (decoder->srcpad))
@@ -2995,6 +3200,9 @@ gst_video_decoder_finish_frame (GstVideoDecoder * decoder,
   if (priv->tags_changed) {
     GstEvent *tags_event;
 
+    /* don't let the tags overtake buffers collected before them */
+    gst_video_decoder_push_output_list (decoder);
+
     tags_event = gst_video_decoder_create_merged_tags_event (decoder);
 
     if (tags_event != NULL)
@@ -3063,7 +3271,6 @@ gst_video_decoder_finish_frame (GstVideoDecoder * decoder,
 done:
   if (frame)
     gst_video_decoder_release_frame (decoder, frame);
-  GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
   return ret;
 }
 
@@ -3202,7 +3409,15 @@ gst_video_decoder_clip_and_push_buf (GstVideoDecoder * decoder, GstBuffer * buf)
   }
 #endif
 
-  ret = gst_pad_push (decoder->srcpad, buf);
+  if (priv->use_buffer_lists && priv->in_chain) {
+    /* collected buffers go out as one list when the input buffer that
+     * produced them is done */
+    if (priv->output_list == NULL)
+      priv->output_list = gst_buffer_list_new ();
+    gst_buffer_list_add (priv->output_list, buf);
+  } else {
+    ret = gst_pad_push (decoder->srcpad, buf);
+  }
 
 done:
   return ret;
@@ -3342,6 +3557,12 @@ gst_video_decoder_have_frame (GstVideoDecoder * decoder)
   if (decoder->input_segment.rate < 0.0) {
     priv->parse_gather =
         g_list_prepend (priv->parse_gather, priv->current_frame);
+  } else if (!GST_VIDEO_CODEC_FRAME_IS_SYNC_POINT (priv->current_frame)
+      && (decoder->input_segment.flags & GST_SEEK_FLAG_TRICKMODE_KEY_UNITS)) {
+    /* Delta units are never displayed in key-units trick mode, so don't
+     * bother decoding them at all */
+    GST_LOG_OBJECT (decoder, "Dropping delta unit in key-units trick mode");
+    gst_video_decoder_release_frame (decoder, priv->current_frame);
   } else {
     /* Otherwise, decode the frame, which gives away our ref */
     ret = gst_video_decoder_decode_frame (decoder, priv->current_frame);
@@ -3401,6 +3622,8 @@ gst_video_decoder_decode_frame (GstVideoDecoder * decoder,
 
   gst_video_codec_frame_ref (frame);
   priv->frames = g_list_append (priv->frames, frame);
+  g_hash_table_insert (priv->frames_index,
+      GUINT_TO_POINTER (frame->system_frame_number), frame);
 
   if (g_list_length (priv->frames) > 10) {
     GST_DEBUG_OBJECT (decoder, "decoder frame list getting long: %d frames,"
@@ -3541,20 +3764,15 @@ gst_video_decoder_get_oldest_frame (GstVideoDecoder * decoder)
 GstVideoCodecFrame *
 gst_video_decoder_get_frame (GstVideoDecoder * decoder, int frame_number)
 {
-  GList *g;
-  GstVideoCodecFrame *frame = NULL;
+  GstVideoCodecFrame *frame;
 
   GST_DEBUG_OBJECT (decoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_DECODER_STREAM_LOCK (decoder);
-  for (g = decoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
-    }
-  }
+  frame = g_hash_table_lookup (decoder->priv->frames_index,
+      GUINT_TO_POINTER ((guint) frame_number));
+  if (frame)
+    frame = gst_video_codec_frame_ref (frame);
   GST_VIDEO_DECODER_STREAM_UNLOCK (decoder);
 
   return frame;
@@ -4115,6 +4333,41 @@ gst_video_decoder_get_qos_proportion (GstVideoDecoder * decoder)
   return proportion;
 }
 
+/**
+ * gst_video_decoder_get_skip_level:
+ * @decoder: a #GstVideoDecoder
+ *
+ * Get the degradation level that the base class currently suggests. The
+ * level is raised when several consecutive QoS events report that
+ * downstream cannot keep up and lowered again, with hysteresis, when the
+ * situation has recovered.
+ *
+ * Subclasses that can cheaply identify frame types should check this in
+ * their handle_frame implementation and release frames they choose not to
+ * decode with gst_video_decoder_drop_frame(). Acting on the suggestion is
+ * entirely optional; subclasses that ignore it keep the existing
+ * behaviour, where only gst_video_decoder_get_max_decode_time() reports
+ * lateness per frame.
+ *
+ * Returns: the currently suggested #GstVideoDecoderSkipLevel.
+ *
+ * Since: 1.14
+ */
+GstVideoDecoderSkipLevel
+gst_video_decoder_get_skip_level (GstVideoDecoder * decoder)
+{
+  GstVideoDecoderSkipLevel skip_level;
+
+  g_return_val_if_fail (GST_IS_VIDEO_DECODER (decoder),
+      GST_VIDEO_DECODER_SKIP_LEVEL_NONE);
+
+  GST_OBJECT_LOCK (decoder);
+  skip_level = decoder->priv->skip_level;
+  GST_OBJECT_UNLOCK (decoder);
+
+  return skip_level;
+}
+
 GstFlowReturn
 _gst_video_decoder_error (GstVideoDecoder * dec, gint weight,
     GQuark domain, gint code, gchar * txt, gchar * dbg, const gchar * file,
@@ -4246,6 +4499,46 @@ gst_video_decoder_get_packetized (GstVideoDecoder * decoder)
   return decoder->priv->packetized;
 }
 
+/**
+ * gst_video_decoder_set_use_buffer_lists:
+ * @decoder: a #GstVideoDecoder
+ * @use_lists: whether to push output buffers as buffer lists
+ *
+ * Configures whether output buffers finished while handling a single
+ * input buffer are collected and pushed downstream together as one
+ * #GstBufferList once the input buffer is done, instead of with one pad
+ * push per buffer. This cuts the per-push overhead for subclasses that
+ * produce many small output buffers per input, e.g. slice or tile based
+ * decoders. Caps and tag events still go out before the buffers they
+ * apply to, and buffers finished outside of the chain function are
+ * pushed individually as before.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_decoder_set_use_buffer_lists (GstVideoDecoder * decoder,
+    gboolean use_lists)
+{
+  decoder->priv->use_buffer_lists = use_lists;
+}
+
+/**
+ * gst_video_decoder_get_use_buffer_lists:
+ * @decoder: a #GstVideoDecoder
+ *
+ * Queries whether the base class pushes the output buffers produced by
+ * one input buffer as a single buffer list.
+ *
+ * Returns: TRUE if output buffers are pushed as buffer lists.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_video_decoder_get_use_buffer_lists (GstVideoDecoder * decoder)
+{
+  return decoder->priv->use_buffer_lists;
+}
+
 /**
  * gst_video_decoder_set_estimate_rate:
  * @dec: a #GstVideoDecoder
@@ -111,6 +111,29 @@ G_BEGIN_DECLS
  */
 #define GST_VIDEO_DECODER_STREAM_UNLOCK(decoder) g_rec_mutex_unlock (&GST_VIDEO_DECODER (decoder)->stream_lock)
 
+/**
+ * GstVideoDecoderSkipLevel:
+ * @GST_VIDEO_DECODER_SKIP_LEVEL_NONE: decode all frames
+ * @GST_VIDEO_DECODER_SKIP_LEVEL_B_FRAMES: skip bidirectionally predicted
+ *     frames
+ * @GST_VIDEO_DECODER_SKIP_LEVEL_NON_REF_FRAMES: skip all frames that no
+ *     other frame depends on
+ * @GST_VIDEO_DECODER_SKIP_LEVEL_KEY_UNITS: only decode keyframes
+ *
+ * Degradation levels, in increasing severity, that a decoder can apply
+ * when it cannot keep up with real time. The base class suggests a level
+ * based on QoS feedback, see gst_video_decoder_get_skip_level().
+ *
+ * Since: 1.14
+ */
+typedef enum
+{
+  GST_VIDEO_DECODER_SKIP_LEVEL_NONE,
+  GST_VIDEO_DECODER_SKIP_LEVEL_B_FRAMES,
+  GST_VIDEO_DECODER_SKIP_LEVEL_NON_REF_FRAMES,
+  GST_VIDEO_DECODER_SKIP_LEVEL_KEY_UNITS
+} GstVideoDecoderSkipLevel;
+
 typedef struct _GstVideoDecoder GstVideoDecoder;
 typedef struct _GstVideoDecoderClass GstVideoDecoderClass;
 typedef struct _GstVideoDecoderPrivate GstVideoDecoderPrivate;
@@ -353,6 +376,13 @@ void     gst_video_decoder_set_packetized (GstVideoDecoder * decoder,
 GST_EXPORT
 gboolean gst_video_decoder_get_packetized (GstVideoDecoder * decoder);
 
+GST_EXPORT
+void     gst_video_decoder_set_use_buffer_lists (GstVideoDecoder * decoder,
+					   gboolean use_lists);
+
+GST_EXPORT
+gboolean gst_video_decoder_get_use_buffer_lists (GstVideoDecoder * decoder);
+
 GST_EXPORT
 void     gst_video_decoder_set_estimate_rate (GstVideoDecoder * dec,
 					      gboolean          enabled);
@@ -446,10 +476,18 @@ GstClockTimeDiff gst_video_decoder_get_max_decode_time (GstVideoDecoder *decoder
 GST_EXPORT
 gdouble          gst_video_decoder_get_qos_proportion (GstVideoDecoder * decoder);
 
+GST_EXPORT
+GstVideoDecoderSkipLevel gst_video_decoder_get_skip_level (GstVideoDecoder * decoder);
+
 GST_EXPORT
 GstFlowReturn    gst_video_decoder_finish_frame (GstVideoDecoder *decoder,
 						 GstVideoCodecFrame *frame);
 
+GST_EXPORT
+GstFlowReturn    gst_video_decoder_finish_frames (GstVideoDecoder *decoder,
+						  GstVideoCodecFrame **frames,
+						  guint n_frames);
+
 GST_EXPORT
 GstFlowReturn    gst_video_decoder_drop_frame (GstVideoDecoder *dec,
 					       GstVideoCodecFrame *frame);
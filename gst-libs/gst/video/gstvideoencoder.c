@@ -129,6 +129,10 @@ struct _GstVideoEncoderPrivate
   guint32 system_frame_number;
 
   GList *frames;                /* Protected with OBJECT_LOCK */
+  /* index into frames on system_frame_number, for O(1) lookup in
+   * gst_video_encoder_get_frame(). Same protection as frames, entries
+   * are borrowed references */
+  GHashTable *frames_index;
   GstVideoCodecState *input_state;
   GstVideoCodecState *output_state;
   gboolean output_state_changed;
@@ -138,6 +142,9 @@ struct _GstVideoEncoderPrivate
 
   GstAllocator *allocator;
   GstAllocationParams params;
+  /* caps of the last successful allocation query, used to skip the
+   * query on renegotiation when nothing relevant changed */
+  GstCaps *negotiated_allocation_caps;
 
   /* upstream stream tags (global tags are passed through as-is) */
   GstTagList *upstream_tags;
@@ -152,6 +159,16 @@ struct _GstVideoEncoderPrivate
   /* adjustment needed on pts, dts, segment start and stop to accomodate
    * min_pts */
   GstClockTime time_adjustment;
+
+  /* optional bounded output queue, drained by a srcpad task so a slow
+   * downstream does not stall the encoding thread */
+  guint output_queue_length;    /* property, 0 = push synchronously */
+  GQueue output_queue;          /* buffers and serialized events,
+                                 * protected by output_lock */
+  GMutex output_lock;
+  GCond output_cond;
+  GstFlowReturn output_flow;
+  gboolean output_task_started;
 };
 
 typedef struct _ForcedKeyUnitEvent ForcedKeyUnitEvent;
@@ -183,13 +200,28 @@ forced_key_unit_event_new (GstClockTime running_time, gboolean all_headers,
   return evt;
 }
 
+enum
+{
+  PROP_0,
+  PROP_OUTPUT_QUEUE_LENGTH
+};
+
+#define DEFAULT_OUTPUT_QUEUE_LENGTH 0
+
 static GstElementClass *parent_class = NULL;
 static void gst_video_encoder_class_init (GstVideoEncoderClass * klass);
 static void gst_video_encoder_init (GstVideoEncoder * enc,
     GstVideoEncoderClass * klass);
 
+static void gst_video_encoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_video_encoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 static void gst_video_encoder_finalize (GObject * object);
 
+static void gst_video_encoder_output_queue_clear (GstVideoEncoder * encoder);
+static void gst_video_encoder_output_queue_stop (GstVideoEncoder * encoder);
+
 static gboolean gst_video_encoder_setcaps (GstVideoEncoder * enc,
     GstCaps * caps);
 static GstCaps *gst_video_encoder_sink_getcaps (GstVideoEncoder * encoder,
@@ -281,8 +313,33 @@ gst_video_encoder_class_init (GstVideoEncoderClass * klass)
 
   g_type_class_add_private (klass, sizeof (GstVideoEncoderPrivate));
 
+  gobject_class->set_property = gst_video_encoder_set_property;
+  gobject_class->get_property = gst_video_encoder_get_property;
   gobject_class->finalize = gst_video_encoder_finalize;
 
+  /**
+   * GstVideoEncoder:output-queue-length:
+   *
+   * Queue up to this many encoded frames (and the serialized events
+   * between them) and push them from a separate streaming thread,
+   * instead of pushing directly from the encoding thread. This keeps
+   * jitter of a slow downstream, like a network sink, away from the
+   * encoding thread, which matters for hardware encoders that starve
+   * when they are not fed continuously. When the queue is full the
+   * encoding thread blocks like it would when pushing directly.
+   *
+   * Set this before starting the element; 0 (the default) keeps the
+   * classic synchronous behaviour.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_OUTPUT_QUEUE_LENGTH,
+      g_param_spec_uint ("output-queue-length", "Output queue length",
+          "Number of encoded frames to queue for a separate pushing thread "
+          "(0 = push from the encoding thread)", 0, G_MAXUINT,
+          DEFAULT_OUTPUT_QUEUE_LENGTH,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gstelement_class->change_state =
       GST_DEBUG_FUNCPTR (gst_video_encoder_change_state);
 
@@ -369,6 +426,7 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
       gst_object_unref (priv->allocator);
       priv->allocator = NULL;
     }
+    gst_caps_replace (&priv->negotiated_allocation_caps, NULL);
 
     g_list_foreach (priv->current_frame_events, (GFunc) gst_event_unref, NULL);
     g_list_free (priv->current_frame_events);
@@ -389,6 +447,7 @@ gst_video_encoder_reset (GstVideoEncoder * encoder, gboolean hard)
   g_list_foreach (priv->frames, (GFunc) gst_video_codec_frame_unref, NULL);
   g_list_free (priv->frames);
   priv->frames = NULL;
+  g_hash_table_remove_all (priv->frames_index);
 
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
@@ -421,6 +480,8 @@ gst_video_encoder_init (GstVideoEncoder * encoder, GstVideoEncoderClass * klass)
 
   priv = encoder->priv = GST_VIDEO_ENCODER_GET_PRIVATE (encoder);
 
+  priv->frames_index = g_hash_table_new (NULL, NULL);
+
   pad_template =
       gst_element_class_get_pad_template (GST_ELEMENT_CLASS (klass), "sink");
   g_return_if_fail (pad_template != NULL);
@@ -451,6 +512,12 @@ gst_video_encoder_init (GstVideoEncoder * encoder, GstVideoEncoderClass * klass)
 
   g_rec_mutex_init (&encoder->stream_lock);
 
+  priv->output_queue_length = DEFAULT_OUTPUT_QUEUE_LENGTH;
+  g_queue_init (&priv->output_queue);
+  g_mutex_init (&priv->output_lock);
+  g_cond_init (&priv->output_cond);
+  priv->output_flow = GST_FLOW_OK;
+
   priv->headers = NULL;
   priv->new_headers = FALSE;
 
@@ -491,7 +558,7 @@ _new_output_state (GstCaps * caps, GstVideoCodecState * reference)
 {
   GstVideoCodecState *state;
 
-  state = g_slice_new0 (GstVideoCodecState);
+  state = __gst_video_codec_state_alloc ();
   state->ref_count = 1;
   gst_video_info_init (&state->info);
 
@@ -534,7 +601,7 @@ _new_input_state (GstCaps * caps)
 {
   GstVideoCodecState *state;
 
-  state = g_slice_new0 (GstVideoCodecState);
+  state = __gst_video_codec_state_alloc ();
   state->ref_count = 1;
   gst_video_info_init (&state->info);
   if (G_UNLIKELY (!gst_video_info_from_caps (&state->info, caps)))
@@ -837,14 +904,181 @@ gst_video_encoder_finalize (GObject * object)
   encoder = GST_VIDEO_ENCODER (object);
   g_rec_mutex_clear (&encoder->stream_lock);
 
+  g_queue_foreach (&encoder->priv->output_queue,
+      (GFunc) gst_mini_object_unref, NULL);
+  g_queue_clear (&encoder->priv->output_queue);
+  g_mutex_clear (&encoder->priv->output_lock);
+  g_cond_clear (&encoder->priv->output_cond);
+
   if (encoder->priv->allocator) {
     gst_object_unref (encoder->priv->allocator);
     encoder->priv->allocator = NULL;
   }
+  gst_caps_replace (&encoder->priv->negotiated_allocation_caps, NULL);
+
+  g_hash_table_unref (encoder->priv->frames_index);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
 
+static void
+gst_video_encoder_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstVideoEncoder *encoder = GST_VIDEO_ENCODER (object);
+
+  switch (prop_id) {
+    case PROP_OUTPUT_QUEUE_LENGTH:
+      g_mutex_lock (&encoder->priv->output_lock);
+      encoder->priv->output_queue_length = g_value_get_uint (value);
+      g_mutex_unlock (&encoder->priv->output_lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_video_encoder_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstVideoEncoder *encoder = GST_VIDEO_ENCODER (object);
+
+  switch (prop_id) {
+    case PROP_OUTPUT_QUEUE_LENGTH:
+      g_mutex_lock (&encoder->priv->output_lock);
+      g_value_set_uint (value, encoder->priv->output_queue_length);
+      g_mutex_unlock (&encoder->priv->output_lock);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+/* TRUE when output should go through the queue instead of being pushed
+ * from the calling thread. Once the task ran, everything keeps going
+ * through it until it is stopped so ordering stays intact even when the
+ * property is changed mid-stream. */
+static gboolean
+gst_video_encoder_output_queue_active (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+
+  return priv->output_task_started || priv->output_queue_length > 0;
+}
+
+/* srcpad task function, pushes one queued buffer or event downstream
+ * per iteration */
+static void
+gst_video_encoder_output_loop (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstMiniObject *item;
+  GstFlowReturn ret = GST_FLOW_OK;
+
+  g_mutex_lock (&priv->output_lock);
+  while (g_queue_is_empty (&priv->output_queue)
+      && priv->output_flow == GST_FLOW_OK)
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+
+  if (g_queue_is_empty (&priv->output_queue)) {
+    /* flushing or downstream error, wait in the paused task */
+    g_mutex_unlock (&priv->output_lock);
+    gst_pad_pause_task (encoder->srcpad);
+    return;
+  }
+
+  item = g_queue_pop_head (&priv->output_queue);
+  /* wake up an encoding thread that waits for room in the queue */
+  g_cond_signal (&priv->output_cond);
+  g_mutex_unlock (&priv->output_lock);
+
+  if (GST_IS_EVENT (item))
+    gst_pad_push_event (encoder->srcpad, GST_EVENT_CAST (item));
+  else
+    ret = gst_pad_push (encoder->srcpad, GST_BUFFER_CAST (item));
+
+  if (ret != GST_FLOW_OK) {
+    GST_DEBUG_OBJECT (encoder, "output loop got %s, pausing",
+        gst_flow_get_name (ret));
+    g_mutex_lock (&priv->output_lock);
+    if (priv->output_flow == GST_FLOW_OK)
+      priv->output_flow = ret;
+    g_cond_broadcast (&priv->output_cond);
+    g_mutex_unlock (&priv->output_lock);
+    gst_pad_pause_task (encoder->srcpad);
+  }
+}
+
+/* hand @item (a buffer or a serialized event, transfer full) to the
+ * output task, blocking while the queue is full. Returns the most
+ * recent flow return seen by the pushing task. */
+static GstFlowReturn
+gst_video_encoder_output_queue_push (GstVideoEncoder * encoder,
+    GstMiniObject * item)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+  GstFlowReturn ret;
+
+  g_mutex_lock (&priv->output_lock);
+
+  if (!priv->output_task_started) {
+    priv->output_flow = GST_FLOW_OK;
+    gst_pad_start_task (encoder->srcpad,
+        (GstTaskFunction) gst_video_encoder_output_loop, encoder, NULL);
+    priv->output_task_started = TRUE;
+  }
+
+  /* the MAX keeps at least one slot usable if the property was lowered
+   * to 0 while the task is running */
+  while (priv->output_flow == GST_FLOW_OK
+      && g_queue_get_length (&priv->output_queue) >=
+      MAX (priv->output_queue_length, 1))
+    g_cond_wait (&priv->output_cond, &priv->output_lock);
+
+  ret = priv->output_flow;
+  if (ret == GST_FLOW_OK) {
+    g_queue_push_tail (&priv->output_queue, item);
+    g_cond_signal (&priv->output_cond);
+  } else {
+    gst_mini_object_unref (item);
+  }
+  g_mutex_unlock (&priv->output_lock);
+
+  return ret;
+}
+
+/* drop everything that is still queued and unblock waiters; the task is
+ * left running and pauses itself */
+static void
+gst_video_encoder_output_queue_clear (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+
+  g_mutex_lock (&priv->output_lock);
+  priv->output_flow = GST_FLOW_FLUSHING;
+  g_queue_foreach (&priv->output_queue, (GFunc) gst_mini_object_unref, NULL);
+  g_queue_clear (&priv->output_queue);
+  g_cond_broadcast (&priv->output_cond);
+  g_mutex_unlock (&priv->output_lock);
+}
+
+/* clear the queue and join the output task */
+static void
+gst_video_encoder_output_queue_stop (GstVideoEncoder * encoder)
+{
+  GstVideoEncoderPrivate *priv = encoder->priv;
+
+  gst_video_encoder_output_queue_clear (encoder);
+
+  if (priv->output_task_started) {
+    gst_pad_stop_task (encoder->srcpad);
+    priv->output_task_started = FALSE;
+  }
+}
+
 static gboolean
 gst_video_encoder_push_event (GstVideoEncoder * encoder, GstEvent * event)
 {
@@ -884,6 +1118,15 @@ gst_video_encoder_push_event (GstVideoEncoder * encoder, GstEvent * event)
       break;
   }
 
+  /* serialized events must stay ordered with the queued buffers; flush
+   * events bypass the queue, it is cleared when they are handled */
+  if (gst_video_encoder_output_queue_active (encoder)
+      && GST_EVENT_IS_SERIALIZED (event)
+      && GST_EVENT_TYPE (event) != GST_EVENT_FLUSH_STOP) {
+    return gst_video_encoder_output_queue_push (encoder,
+        GST_MINI_OBJECT_CAST (event)) == GST_FLOW_OK;
+  }
+
   return gst_pad_push_event (encoder->srcpad, event);
 }
 
@@ -1079,7 +1322,16 @@ gst_video_encoder_sink_event_default (GstVideoEncoder * encoder,
       }
       break;
     }
+    case GST_EVENT_FLUSH_START:{
+      /* unblock an encoding thread that waits for room in the output
+       * queue; the output task itself is unblocked by the flush
+       * travelling downstream and is joined on FLUSH_STOP */
+      if (gst_video_encoder_output_queue_active (encoder))
+        gst_video_encoder_output_queue_clear (encoder);
+      break;
+    }
     case GST_EVENT_FLUSH_STOP:{
+      gst_video_encoder_output_queue_stop (encoder);
       GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
       gst_video_encoder_flush (encoder);
       gst_segment_init (&encoder->input_segment, GST_FORMAT_TIME);
@@ -1293,7 +1545,7 @@ gst_video_encoder_new_frame (GstVideoEncoder * encoder, GstBuffer * buf,
   GstVideoEncoderPrivate *priv = encoder->priv;
   GstVideoCodecFrame *frame;
 
-  frame = g_slice_new0 (GstVideoCodecFrame);
+  frame = __gst_video_codec_frame_alloc ();
 
   frame->ref_count = 1;
 
@@ -1428,6 +1680,8 @@ gst_video_encoder_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 
   gst_video_codec_frame_ref (frame);
   priv->frames = g_list_append (priv->frames, frame);
+  g_hash_table_insert (priv->frames_index,
+      GUINT_TO_POINTER (frame->system_frame_number), frame);
 
   /* new data, more finish needed */
   priv->drained = FALSE;
@@ -1487,6 +1741,10 @@ gst_video_encoder_change_state (GstElement * element, GstStateChange transition)
     case GST_STATE_CHANGE_PAUSED_TO_READY:{
       gboolean stopped = TRUE;
 
+      /* wakes the output task out of its queue wait if needed, drops
+       * whatever it had not pushed and joins it */
+      gst_video_encoder_output_queue_stop (encoder);
+
       if (encoder_class->stop)
         stopped = encoder_class->stop (encoder);
 
@@ -1638,16 +1896,36 @@ gst_video_encoder_negotiate_default (GstVideoEncoder * encoder)
   }
 
   prevcaps = gst_pad_get_current_caps (encoder->srcpad);
-  if (!prevcaps || !gst_caps_is_equal (prevcaps, state->caps))
-    ret = gst_pad_set_caps (encoder->srcpad, state->caps);
-  else
+  if (!prevcaps || !gst_caps_is_equal (prevcaps, state->caps)) {
+    if (prevcaps && gst_video_encoder_output_queue_active (encoder)) {
+      /* buffers with the old caps may still sit in the output queue,
+       * the caps event must not overtake them */
+      ret = gst_video_encoder_output_queue_push (encoder,
+          GST_MINI_OBJECT_CAST (gst_event_new_caps (state->caps))) ==
+          GST_FLOW_OK;
+    } else {
+      ret = gst_pad_set_caps (encoder->srcpad, state->caps);
+    }
+  } else {
     ret = TRUE;
+  }
   if (prevcaps)
     gst_caps_unref (prevcaps);
 
   if (!ret)
     goto done;
 
+  /* when the allocation caps did not change and downstream did not ask
+   * for a reconfigure, the previous allocation query result is still
+   * valid and the whole query/decide dance can be skipped */
+  if (encoder->priv->negotiated_allocation_caps &&
+      gst_caps_is_equal (encoder->priv->negotiated_allocation_caps,
+          state->allocation_caps)) {
+    GST_DEBUG_OBJECT (encoder,
+        "allocation caps unchanged, reusing negotiated allocator");
+    goto done;
+  }
+
   query = gst_query_new_allocation (state->allocation_caps, TRUE);
   if (!gst_pad_peer_query (encoder->srcpad, query)) {
     GST_DEBUG_OBJECT (encoder, "didn't get downstream ALLOCATION hints");
@@ -1676,6 +1954,9 @@ gst_video_encoder_negotiate_default (GstVideoEncoder * encoder)
   encoder->priv->allocator = allocator;
   encoder->priv->params = params;
 
+  gst_caps_replace (&encoder->priv->negotiated_allocation_caps,
+      state->allocation_caps);
+
 done:
   if (query)
     gst_query_unref (query);
@@ -1724,7 +2005,8 @@ gst_video_encoder_negotiate (GstVideoEncoder * encoder)
   klass = GST_VIDEO_ENCODER_GET_CLASS (encoder);
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  gst_pad_check_reconfigure (encoder->srcpad);
+  if (gst_pad_check_reconfigure (encoder->srcpad))
+    gst_caps_replace (&encoder->priv->negotiated_allocation_caps, NULL);
   if (klass->negotiate) {
     ret = klass->negotiate (encoder);
     if (!ret)
@@ -1757,6 +2039,8 @@ gst_video_encoder_allocate_output_buffer (GstVideoEncoder * encoder, gsize size)
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
   needs_reconfigure = gst_pad_check_reconfigure (encoder->srcpad);
+  if (needs_reconfigure)
+    gst_caps_replace (&encoder->priv->negotiated_allocation_caps, NULL);
   if (G_UNLIKELY (encoder->priv->output_state_changed
           || (encoder->priv->output_state && needs_reconfigure))) {
     if (!gst_video_encoder_negotiate_unlocked (encoder)) {
@@ -1811,6 +2095,8 @@ gst_video_encoder_allocate_output_frame (GstVideoEncoder *
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
   needs_reconfigure = gst_pad_check_reconfigure (encoder->srcpad);
+  if (needs_reconfigure)
+    gst_caps_replace (&encoder->priv->negotiated_allocation_caps, NULL);
   if (G_UNLIKELY (encoder->priv->output_state_changed
           || (encoder->priv->output_state && needs_reconfigure))) {
     if (!gst_video_encoder_negotiate_unlocked (encoder)) {
@@ -1839,6 +2125,8 @@ gst_video_encoder_release_frame (GstVideoEncoder * enc,
   /* unref once from the list */
   link = g_list_find (enc->priv->frames, frame);
   if (link) {
+    g_hash_table_remove (enc->priv->frames_index,
+        GUINT_TO_POINTER (frame->system_frame_number));
     gst_video_codec_frame_unref (frame);
     enc->priv->frames = g_list_delete_link (enc->priv->frames, link);
   }
@@ -1944,6 +2232,8 @@ gst_video_encoder_finish_frame (GstVideoEncoder * encoder,
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
 
   needs_reconfigure = gst_pad_check_reconfigure (encoder->srcpad);
+  if (needs_reconfigure)
+    gst_caps_replace (&priv->negotiated_allocation_caps, NULL);
   if (G_UNLIKELY (priv->output_state_changed || (priv->output_state
               && needs_reconfigure))) {
     if (!gst_video_encoder_negotiate_unlocked (encoder)) {
@@ -2139,7 +2429,11 @@ gst_video_encoder_finish_frame (GstVideoEncoder * encoder,
         discont = FALSE;
       }
 
-      gst_pad_push (encoder->srcpad, gst_buffer_ref (tmpbuf));
+      if (gst_video_encoder_output_queue_active (encoder))
+        gst_video_encoder_output_queue_push (encoder,
+            GST_MINI_OBJECT_CAST (gst_buffer_ref (tmpbuf)));
+      else
+        gst_pad_push (encoder->srcpad, gst_buffer_ref (tmpbuf));
     }
     priv->new_headers = FALSE;
   }
@@ -2177,8 +2471,13 @@ gst_video_encoder_finish_frame (GstVideoEncoder * encoder,
   gst_video_encoder_release_frame (encoder, frame);
   frame = NULL;
 
-  if (ret == GST_FLOW_OK)
-    ret = gst_pad_push (encoder->srcpad, buffer);
+  if (ret == GST_FLOW_OK) {
+    if (gst_video_encoder_output_queue_active (encoder))
+      ret = gst_video_encoder_output_queue_push (encoder,
+          GST_MINI_OBJECT_CAST (buffer));
+    else
+      ret = gst_pad_push (encoder->srcpad, buffer);
+  }
 
 done:
   /* handed out */
@@ -2350,20 +2649,15 @@ gst_video_encoder_get_oldest_frame (GstVideoEncoder * encoder)
 GstVideoCodecFrame *
 gst_video_encoder_get_frame (GstVideoEncoder * encoder, int frame_number)
 {
-  GList *g;
-  GstVideoCodecFrame *frame = NULL;
+  GstVideoCodecFrame *frame;
 
   GST_DEBUG_OBJECT (encoder, "frame_number : %d", frame_number);
 
   GST_VIDEO_ENCODER_STREAM_LOCK (encoder);
-  for (g = encoder->priv->frames; g; g = g->next) {
-    GstVideoCodecFrame *tmp = g->data;
-
-    if (tmp->system_frame_number == frame_number) {
-      frame = gst_video_codec_frame_ref (tmp);
-      break;
-    }
-  }
+  frame = g_hash_table_lookup (encoder->priv->frames_index,
+      GUINT_TO_POINTER ((guint) frame_number));
+  if (frame)
+    frame = gst_video_codec_frame_ref (frame);
   GST_VIDEO_ENCODER_STREAM_UNLOCK (encoder);
 
   return frame;
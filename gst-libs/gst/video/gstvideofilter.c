@@ -198,6 +198,20 @@ gst_video_filter_get_unit_size (GstBaseTransform * btrans, GstCaps * caps,
   return TRUE;
 }
 
+/* check if @new_info describes the same frames as @old_info, with at
+ * most the framerate being different */
+static gboolean
+video_info_equal_up_to_fps (const GstVideoInfo * old_info,
+    const GstVideoInfo * new_info)
+{
+  GstVideoInfo tmp = *new_info;
+
+  tmp.fps_n = old_info->fps_n;
+  tmp.fps_d = old_info->fps_d;
+
+  return gst_video_info_is_equal (&tmp, old_info);
+}
+
 static gboolean
 gst_video_filter_set_caps (GstBaseTransform * trans, GstCaps * incaps,
     GstCaps * outcaps)
@@ -215,6 +229,21 @@ gst_video_filter_set_caps (GstBaseTransform * trans, GstCaps * incaps,
   if (!gst_video_info_from_caps (&out_info, outcaps))
     goto invalid_caps;
 
+  /* Renegotiation fast path: if nothing but (at most) the framerate
+   * changed, there is no need to let the subclass rebuild its state
+   * (converters, lookup tables, ...), since the frames themselves stay
+   * exactly the same. This matters for pipelines that renegotiate
+   * frequently with effectively unchanged video formats. */
+  if (filter->negotiated
+      && video_info_equal_up_to_fps (&filter->in_info, &in_info)
+      && video_info_equal_up_to_fps (&filter->out_info, &out_info)) {
+    GST_DEBUG_OBJECT (filter,
+        "caps changed framerate only, skipping reconfiguration");
+    filter->in_info = in_info;
+    filter->out_info = out_info;
+    return TRUE;
+  }
+
   fclass = GST_VIDEO_FILTER_GET_CLASS (filter);
   if (fclass->set_info)
     res = fclass->set_info (filter, incaps, &in_info, outcaps, &out_info);
@@ -35,6 +35,18 @@ GST_DEBUG_CATEGORY_STATIC (gst_video_pool_debug);
  * Allows configuration of video-specific requirements such as
  * stride alignments or pixel padding, and can also be configured
  * to automatically add #GstVideoMeta to the buffers.
+ *
+ * ## Memory placement
+ *
+ * The pool allocates from the #GstAllocator configured with
+ * gst_buffer_pool_config_set_allocator(), the default system memory
+ * allocator when none is set. The default allocator does not pre-fault the
+ * allocated pages, so on NUMA machines the operating system's first-touch
+ * policy applies: pages are committed on the node of the thread that first
+ * writes to a buffer, typically the producer. Applications that need a
+ * different placement policy (binding to a node, interleaving, ...) should
+ * configure a custom #GstAllocator that applies the policy at allocation
+ * time; no pool changes are needed for that.
  */
 
 /**
@@ -101,6 +113,11 @@ struct _GstVideoBufferPoolPrivate
   gboolean need_alignment;
   GstAllocator *allocator;
   GstAllocationParams params;
+
+  /* lock-free freelist of recycled buffers, only used when the pool is
+   * unlimited (max_buffers == 0), see video_buffer_pool_release_buffer() */
+  GstAtomicQueue *recycle;
+  gboolean use_recycle;
 };
 
 static void gst_video_buffer_pool_finalize (GObject * object);
@@ -154,6 +171,12 @@ video_buffer_pool_set_config (GstBufferPool * pool, GstStructure * config)
 
   GST_LOG_OBJECT (pool, "%dx%d, caps %" GST_PTR_FORMAT, width, height, caps);
 
+  /* buffers parked in the recycle queue are invisible to the base class, so
+   * a blocking acquire could miss them and wait forever; only use the
+   * lock-free path when an empty base queue makes the base class allocate
+   * a new buffer instead of blocking */
+  priv->use_recycle = (max_buffers == 0);
+
   if (priv->caps)
     gst_caps_unref (priv->caps);
   priv->caps = gst_caps_ref (caps);
@@ -274,6 +297,73 @@ no_memory:
   }
 }
 
+static void
+video_buffer_pool_drain_recycle (GstBufferPool * pool)
+{
+  GstVideoBufferPool *vpool = GST_VIDEO_BUFFER_POOL_CAST (pool);
+  GstVideoBufferPoolPrivate *priv = vpool->priv;
+  GstBuffer *buffer;
+
+  /* hand recycled buffers back to the base class queue so that they are
+   * accounted for again when the pool drains or flushes */
+  while ((buffer = gst_atomic_queue_pop (priv->recycle)))
+    GST_BUFFER_POOL_CLASS (parent_class)->release_buffer (pool, buffer);
+}
+
+static GstFlowReturn
+video_buffer_pool_acquire_buffer (GstBufferPool * pool, GstBuffer ** buffer,
+    GstBufferPoolAcquireParams * params)
+{
+  GstVideoBufferPool *vpool = GST_VIDEO_BUFFER_POOL_CAST (pool);
+  GstVideoBufferPoolPrivate *priv = vpool->priv;
+  GstBuffer *buf;
+
+  /* fast path, avoids the pool lock and the GstPoll write of the base
+   * class queue */
+  if ((buf = gst_atomic_queue_pop (priv->recycle))) {
+    *buffer = buf;
+    return GST_FLOW_OK;
+  }
+
+  return GST_BUFFER_POOL_CLASS (parent_class)->acquire_buffer (pool, buffer,
+      params);
+}
+
+static void
+video_buffer_pool_release_buffer (GstBufferPool * pool, GstBuffer * buffer)
+{
+  GstVideoBufferPool *vpool = GST_VIDEO_BUFFER_POOL_CAST (pool);
+  GstVideoBufferPoolPrivate *priv = vpool->priv;
+
+  /* the buffer was already reset by the base class, park it in the
+   * lock-free freelist. When flushing, buffers must go back to the base
+   * class so that the drain on deactivation sees them */
+  if (priv->use_recycle && !GST_BUFFER_POOL_IS_FLUSHING (pool)) {
+    gst_atomic_queue_push (priv->recycle, buffer);
+    return;
+  }
+
+  GST_BUFFER_POOL_CLASS (parent_class)->release_buffer (pool, buffer);
+}
+
+static void
+video_buffer_pool_flush_start (GstBufferPool * pool)
+{
+  video_buffer_pool_drain_recycle (pool);
+
+  if (GST_BUFFER_POOL_CLASS (parent_class)->flush_start)
+    GST_BUFFER_POOL_CLASS (parent_class)->flush_start (pool);
+}
+
+static gboolean
+video_buffer_pool_stop (GstBufferPool * pool)
+{
+  /* catch buffers that raced into the freelist after flush_start */
+  video_buffer_pool_drain_recycle (pool);
+
+  return GST_BUFFER_POOL_CLASS (parent_class)->stop (pool);
+}
+
 /**
  * gst_video_buffer_pool_new:
  *
@@ -308,6 +398,10 @@ gst_video_buffer_pool_class_init (GstVideoBufferPoolClass * klass)
   gstbufferpool_class->get_options = video_buffer_pool_get_options;
   gstbufferpool_class->set_config = video_buffer_pool_set_config;
   gstbufferpool_class->alloc_buffer = video_buffer_pool_alloc;
+  gstbufferpool_class->acquire_buffer = video_buffer_pool_acquire_buffer;
+  gstbufferpool_class->release_buffer = video_buffer_pool_release_buffer;
+  gstbufferpool_class->flush_start = video_buffer_pool_flush_start;
+  gstbufferpool_class->stop = video_buffer_pool_stop;
 
   GST_DEBUG_CATEGORY_INIT (gst_video_pool_debug, "videopool", 0,
       "videopool object");
@@ -317,6 +411,7 @@ static void
 gst_video_buffer_pool_init (GstVideoBufferPool * pool)
 {
   pool->priv = GST_VIDEO_BUFFER_POOL_GET_PRIVATE (pool);
+  pool->priv->recycle = gst_atomic_queue_new (16);
 }
 
 static void
@@ -333,5 +428,8 @@ gst_video_buffer_pool_finalize (GObject * object)
   if (priv->allocator)
     gst_object_unref (priv->allocator);
 
+  /* the freelist was drained when the pool stopped */
+  gst_atomic_queue_unref (priv->recycle);
+
   G_OBJECT_CLASS (gst_video_buffer_pool_parent_class)->finalize (object);
 }
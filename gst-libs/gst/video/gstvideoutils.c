@@ -25,6 +25,7 @@
 
 #include <gst/video/video.h>
 #include "gstvideoutils.h"
+#include "gstvideoutilsprivate.h"
 
 #include <string.h>
 
@@ -32,9 +33,69 @@ G_DEFINE_BOXED_TYPE (GstVideoCodecFrame, gst_video_codec_frame,
     (GBoxedCopyFunc) gst_video_codec_frame_ref,
     (GBoxedFreeFunc) gst_video_codec_frame_unref);
 
+/* Codec frames and states churn at frame rate in every decoder and encoder,
+ * with allocation and free typically happening on different threads. Keep a
+ * small process-wide freelist of cleared structs so the steady state recycles
+ * them instead of going through the allocator each time. */
+#define CODEC_FREELIST_SIZE 32
+
+static GstAtomicQueue *
+codec_frame_freelist (void)
+{
+  static gsize init = 0;
+  static GstAtomicQueue *queue;
+
+  if (g_once_init_enter (&init)) {
+    queue = gst_atomic_queue_new (CODEC_FREELIST_SIZE);
+    g_once_init_leave (&init, 1);
+  }
+  return queue;
+}
+
+static GstAtomicQueue *
+codec_state_freelist (void)
+{
+  static gsize init = 0;
+  static GstAtomicQueue *queue;
+
+  if (g_once_init_enter (&init)) {
+    queue = gst_atomic_queue_new (CODEC_FREELIST_SIZE);
+    g_once_init_leave (&init, 1);
+  }
+  return queue;
+}
+
+/* Returns a zeroed GstVideoCodecFrame, recycled when possible */
+GstVideoCodecFrame *
+__gst_video_codec_frame_alloc (void)
+{
+  GstVideoCodecFrame *frame;
+
+  frame = gst_atomic_queue_pop (codec_frame_freelist ());
+  if (frame == NULL)
+    frame = g_slice_new0 (GstVideoCodecFrame);
+
+  return frame;
+}
+
+/* Returns a zeroed GstVideoCodecState, recycled when possible */
+GstVideoCodecState *
+__gst_video_codec_state_alloc (void)
+{
+  GstVideoCodecState *state;
+
+  state = gst_atomic_queue_pop (codec_state_freelist ());
+  if (state == NULL)
+    state = g_slice_new0 (GstVideoCodecState);
+
+  return state;
+}
+
 static void
 _gst_video_codec_frame_free (GstVideoCodecFrame * frame)
 {
+  GstAtomicQueue *freelist;
+
   g_return_if_fail (frame != NULL);
 
   GST_DEBUG ("free frame %p", frame);
@@ -53,7 +114,13 @@ _gst_video_codec_frame_free (GstVideoCodecFrame * frame)
   if (frame->user_data_destroy_notify)
     frame->user_data_destroy_notify (frame->user_data);
 
-  g_slice_free (GstVideoCodecFrame, frame);
+  freelist = codec_frame_freelist ();
+  if (gst_atomic_queue_length (freelist) < CODEC_FREELIST_SIZE) {
+    memset (frame, 0, sizeof (GstVideoCodecFrame));
+    gst_atomic_queue_push (freelist, frame);
+  } else {
+    g_slice_free (GstVideoCodecFrame, frame);
+  }
 }
 
 /**
@@ -158,6 +225,8 @@ gst_video_codec_state_ref (GstVideoCodecState * state)
 static void
 _gst_video_codec_state_free (GstVideoCodecState * state)
 {
+  GstAtomicQueue *freelist;
+
   GST_DEBUG ("free state %p", state);
 
   if (state->caps)
@@ -166,7 +235,14 @@ _gst_video_codec_state_free (GstVideoCodecState * state)
     gst_caps_unref (state->allocation_caps);
   if (state->codec_data)
     gst_buffer_unref (state->codec_data);
-  g_slice_free (GstVideoCodecState, state);
+
+  freelist = codec_state_freelist ();
+  if (gst_atomic_queue_length (freelist) < CODEC_FREELIST_SIZE) {
+    memset (state, 0, sizeof (GstVideoCodecState));
+    gst_atomic_queue_push (freelist, state);
+  } else {
+    g_slice_free (GstVideoCodecState, state);
+  }
 }
 
 /**
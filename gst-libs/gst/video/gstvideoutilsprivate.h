@@ -46,6 +46,13 @@ gboolean __gst_video_rawvideo_convert (GstVideoCodecState * state, GstFormat src
                                        gint64 src_value, GstFormat * dest_format,
                                        gint64 * dest_value);
 
+/* Recycling allocators for the per-frame codec structs, see gstvideoutils.c */
+G_GNUC_INTERNAL
+GstVideoCodecFrame *__gst_video_codec_frame_alloc (void);
+
+G_GNUC_INTERNAL
+GstVideoCodecState *__gst_video_codec_state_alloc (void);
+
 G_END_DECLS
 
 #endif
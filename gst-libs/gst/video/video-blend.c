@@ -275,6 +275,44 @@ G_STMT_START { \
   cb = MIN(c, 255); \
 } G_STMT_END
 
+/* rounding division by 255, only valid for x in [0, 65790[. Branch-free and
+ * cheap enough that the compiler can vectorize the blend loops below. */
+#define DIV255(x) (((x) + 128 + (((x) + 128) >> 8)) >> 8)
+
+/* A OVER B for an opaque destination: the blended alpha is always 255 so
+ * the per-pixel alpha divisions of the generic loop disappear. */
+static void
+blend_line_opaque (guint8 * d, const guint8 * s, gint width)
+{
+  gint j;
+
+  for (j = 0; j < width * 4; j += 4) {
+    gint a = s[j];
+
+    d[j + 0] = 255;
+    d[j + 1] = DIV255 (s[j + 1] * a + d[j + 1] * (255 - a));
+    d[j + 2] = DIV255 (s[j + 2] * a + d[j + 2] * (255 - a));
+    d[j + 3] = DIV255 (s[j + 3] * a + d[j + 3] * (255 - a));
+  }
+}
+
+/* Same, for a premultiplied source */
+static void
+blend_line_prea_opaque (guint8 * d, const guint8 * s,
+    gint width)
+{
+  gint j;
+
+  for (j = 0; j < width * 4; j += 4) {
+    gint ia = 255 - s[j];
+
+    d[j + 0] = 255;
+    d[j + 1] = MIN (s[j + 1] + DIV255 (d[j + 1] * ia), 255);
+    d[j + 2] = MIN (s[j + 2] + DIV255 (d[j + 2] * ia), 255);
+    d[j + 3] = MIN (s[j + 3] + DIV255 (d[j + 3] * ia), 255);
+  }
+}
+
 
 /**
  * gst_video_blend:
@@ -294,7 +332,7 @@ gst_video_blend (GstVideoFrame * dest,
   gint i, j, global_alpha_val, src_width, src_height, dest_width, dest_height;
   gint src_xoff = 0, src_yoff = 0;
   guint8 *tmpdestline = NULL, *tmpsrcline = NULL;
-  gboolean src_premultiplied_alpha, dest_premultiplied_alpha;
+  gboolean src_premultiplied_alpha, dest_premultiplied_alpha, dest_has_alpha;
   void (*matrix) (guint8 * tmpline, guint width);
   const GstVideoFormatInfo *sinfo, *dinfo, *dunpackinfo, *sunpackinfo;
 
@@ -331,6 +369,8 @@ gst_video_blend (GstVideoFrame * dest,
   if (!sinfo || !dinfo)
     goto failed;
 
+  dest_has_alpha = GST_VIDEO_FORMAT_INFO_HAS_ALPHA (dinfo);
+
   dunpackinfo = gst_video_format_get_info (dinfo->unpack_format);
   sunpackinfo = gst_video_format_get_info (sinfo->unpack_format);
 
@@ -419,7 +459,14 @@ gst_video_blend (GstVideoFrame * dest,
   } G_STMT_END
 
     if (G_LIKELY (global_alpha == 1.0)) {
-      if (src_premultiplied_alpha && dest_premultiplied_alpha) {
+      if (!dest_has_alpha) {
+        /* the blended alpha is always 255 and thrown away when packing, use
+         * the vectorizable loops */
+        if (src_premultiplied_alpha)
+          blend_line_prea_opaque (tmpdestline, tmpsrcline, src_width);
+        else
+          blend_line_opaque (tmpdestline, tmpsrcline, src_width);
+      } else if (src_premultiplied_alpha && dest_premultiplied_alpha) {
         BLENDLOOP (OVER11, 255);
       } else if (!src_premultiplied_alpha && dest_premultiplied_alpha) {
         BLENDLOOP (OVER01, 255);
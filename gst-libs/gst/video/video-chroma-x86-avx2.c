@@ -0,0 +1,160 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-chroma-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+/* even chroma samples gathered per pass, keeps the scratch on the stack */
+#define CHROMA_TILE 128
+
+/* 2x horizontal upsampling without cositing, in-place on an AYUV line.
+ *
+ * The scalar code writes, for every source pair (a, b) at even pixels
+ * 2k and 2k+2:
+ *
+ *   out(2k+1) = (3*a + b + 2) >> 2
+ *   out(2k+2) = (a + 3*b + 2) >> 2
+ *
+ * The source chroma lives at the even pixels and is overwritten as we
+ * go, so each tile first gathers the original even-position chroma into
+ * a scratch array; the filter is then a pmaddubsw with (3,1)/(1,3)
+ * coefficients over pairs of neighbouring samples.
+ */
+void
+video_chroma_avx2_up_h2_u8 (guint8 * pixels, gint width)
+{
+  guint8 *p = pixels;
+  gint n = (width - 1) / 2;
+  gint k = 0;
+  guint8 cu, cv;
+
+  if (n <= 0)
+    return;
+
+  /* original chroma of pixel 0, the left source of the first pair */
+  cu = p[2];
+  cv = p[3];
+
+  while (k < n) {
+    guint8 tu[CHROMA_TILE + 1], tv[CHROMA_TILE + 1];
+    gint t = MIN (n - k, CHROMA_TILE);
+    gint j;
+    guint8 *d = p + 4 * (2 * k + 1);
+
+    /* gather original even-position chroma; index 0 carries over from
+     * the previous tile because the pixel was already overwritten */
+    tu[0] = cu;
+    tv[0] = cv;
+    for (j = 1; j <= t; j++) {
+      tu[j] = p[8 * (k + j) + 2];
+      tv[j] = p[8 * (k + j) + 3];
+    }
+    cu = tu[t];
+    cv = tv[t];
+
+    for (j = 0; j + 8 <= t; j += 8) {
+      const __m128i c31 = _mm_set1_epi16 (0x0103);
+      const __m128i c13 = _mm_set1_epi16 (0x0301);
+      const __m128i two = _mm_set1_epi16 (2);
+      const __m256i low16 = _mm256_set1_epi32 (0xFFFF);
+      __m128i ua, ub, va, vb, up, vp;
+      __m128i uo, ue, vo, ve, ur, vr, uv0, uv1;
+      __m256i d0, d1;
+
+      ua = _mm_loadl_epi64 ((const __m128i *) (tu + j));
+      ub = _mm_loadl_epi64 ((const __m128i *) (tu + j + 1));
+      va = _mm_loadl_epi64 ((const __m128i *) (tv + j));
+      vb = _mm_loadl_epi64 ((const __m128i *) (tv + j + 1));
+
+      /* pairs (a, b) per output position */
+      up = _mm_unpacklo_epi8 (ua, ub);
+      vp = _mm_unpacklo_epi8 (va, vb);
+
+      /* odd outputs 3a+b, even outputs a+3b, rounded, 8 of each */
+      uo = _mm_srli_epi16 (_mm_add_epi16 (_mm_maddubs_epi16 (up, c31), two), 2);
+      ue = _mm_srli_epi16 (_mm_add_epi16 (_mm_maddubs_epi16 (up, c13), two), 2);
+      vo = _mm_srli_epi16 (_mm_add_epi16 (_mm_maddubs_epi16 (vp, c31), two), 2);
+      ve = _mm_srli_epi16 (_mm_add_epi16 (_mm_maddubs_epi16 (vp, c13), two), 2);
+
+      /* interleave to the output pixel order odd,even,odd,even,... */
+      ur = _mm_unpacklo_epi8 (_mm_packus_epi16 (uo, uo),
+          _mm_packus_epi16 (ue, ue));
+      vr = _mm_unpacklo_epi8 (_mm_packus_epi16 (vo, vo),
+          _mm_packus_epi16 (ve, ve));
+
+      /* (u,v) byte pairs for 16 consecutive output pixels */
+      uv0 = _mm_unpacklo_epi8 (ur, vr);
+      uv1 = _mm_unpackhi_epi8 (ur, vr);
+
+      /* merge into the pixels, keeping the A and Y bytes */
+      d0 = _mm256_loadu_si256 ((const __m256i *) (d + 8 * j));
+      d1 = _mm256_loadu_si256 ((const __m256i *) (d + 8 * j + 32));
+      d0 = _mm256_or_si256 (_mm256_and_si256 (d0, low16),
+          _mm256_slli_epi32 (_mm256_cvtepu16_epi32 (uv0), 16));
+      d1 = _mm256_or_si256 (_mm256_and_si256 (d1, low16),
+          _mm256_slli_epi32 (_mm256_cvtepu16_epi32 (uv1), 16));
+      _mm256_storeu_si256 ((__m256i *) (d + 8 * j), d0);
+      _mm256_storeu_si256 ((__m256i *) (d + 8 * j + 32), d1);
+    }
+    for (; j < t; j++) {
+      guint8 a, b;
+
+      a = tu[j], b = tu[j + 1];
+      d[8 * j + 2] = (3 * a + b + 2) >> 2;
+      d[8 * j + 6] = (a + 3 * b + 2) >> 2;
+      a = tv[j], b = tv[j + 1];
+      d[8 * j + 3] = (3 * a + b + 2) >> 2;
+      d[8 * j + 7] = (a + 3 * b + 2) >> 2;
+    }
+    k += t;
+  }
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stub so that the dispatch code in video-chroma.c always links; it is
+ * never called because video_chroma_avx2_available() returns FALSE. */
+
+void
+video_chroma_avx2_up_h2_u8 (guint8 * pixels, gint width)
+{
+  g_assert_not_reached ();
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+video_chroma_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
@@ -0,0 +1,33 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_CHROMA_X86_AVX2_H
+#define VIDEO_CHROMA_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the kernels below were compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean video_chroma_avx2_available (void);
+
+/* 2x horizontal chroma upsampling without cositing on an AYUV line,
+ * bit-exact with video_chroma_up_h2_u8 */
+void video_chroma_avx2_up_h2_u8 (guint8 * pixels, gint width);
+
+#endif /* VIDEO_CHROMA_X86_AVX2_H */
@@ -27,6 +27,12 @@
 #include "video-orc.h"
 #include "video-format.h"
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "video-chroma-x86-avx2.h"
+#endif
+
 
 /**
  * SECTION:gstvideochroma
@@ -838,6 +844,15 @@ MAKE_DOWNSAMPLE_V4_CS (u8, guint8);
 MAKE_DOWNSAMPLE_VI4_CS (u16, guint16);
 MAKE_DOWNSAMPLE_VI4_CS (u8, guint8);
 
+#ifdef CHECK_X86
+static void
+video_chroma_up_h2_u8_avx2 (GstVideoChromaResample * resample,
+    gpointer pixels, gint width)
+{
+  video_chroma_avx2_up_h2_u8 (pixels, width);
+}
+#endif
+
 typedef struct
 {
   void (*resample) (GstVideoChromaResample * resample, gpointer pixels,
@@ -987,6 +1002,21 @@ gst_video_chroma_resample_new (GstVideoChromaMethod method,
   result->v_factor = v_factor;
   result->h_resample = h_resamplers[h_index].resample;
   result->v_resample = v_resamplers[v_index].resample;
+
+#ifdef CHECK_X86
+  {
+    static gsize simd_once = 0;
+    static gboolean use_avx2 = FALSE;
+
+    if (g_once_init_enter (&simd_once)) {
+      use_avx2 = video_chroma_avx2_available ();
+      GST_DEBUG ("AVX2 chroma resampling %savailable", use_avx2 ? "" : "not ");
+      g_once_init_leave (&simd_once, 1);
+    }
+    if (use_avx2 && result->h_resample == video_chroma_up_h2_u8)
+      result->h_resample = video_chroma_up_h2_u8_avx2;
+  }
+#endif
   result->n_lines = v_resamplers[v_index].n_lines;
   result->offset = v_resamplers[v_index].offset;
 
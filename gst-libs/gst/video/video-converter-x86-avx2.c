@@ -0,0 +1,117 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-converter-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+void
+video_converter_avx2_matrix16 (guint16 * pixels, const gint * im, gint shift,
+    gint width)
+{
+  /* column vectors of the matrix, replicated for two pixels; the first
+   * lane of each is 0 so the alpha component sums to 0 and is blended
+   * back from the source below */
+  const __m256i cr = _mm256_setr_epi32 (0, im[0], im[4], im[8],
+      0, im[0], im[4], im[8]);
+  const __m256i cg = _mm256_setr_epi32 (0, im[1], im[5], im[9],
+      0, im[1], im[5], im[9]);
+  const __m256i cb = _mm256_setr_epi32 (0, im[2], im[6], im[10],
+      0, im[2], im[6], im[10]);
+  const __m256i co = _mm256_setr_epi32 (0, im[3], im[7], im[11],
+      0, im[3], im[7], im[11]);
+  gint i = 0;
+
+  for (; i + 2 <= width; i += 2) {
+    __m128i q, lo, hi, res;
+    __m256i v, r, g, b, sum;
+
+    /* two AYUV/ARGB pixels, widened to 32 bits per component */
+    q = _mm_loadu_si128 ((const __m128i *) (pixels + i * 4));
+    v = _mm256_cvtepu16_epi32 (q);
+
+    r = _mm256_shuffle_epi32 (v, _MM_SHUFFLE (1, 1, 1, 1));
+    g = _mm256_shuffle_epi32 (v, _MM_SHUFFLE (2, 2, 2, 2));
+    b = _mm256_shuffle_epi32 (v, _MM_SHUFFLE (3, 3, 3, 3));
+
+    sum = _mm256_add_epi32 (_mm256_mullo_epi32 (r, cr),
+        _mm256_mullo_epi32 (g, cg));
+    sum = _mm256_add_epi32 (sum, _mm256_mullo_epi32 (b, cb));
+    sum = _mm256_add_epi32 (sum, co);
+    sum = _mm256_srai_epi32 (sum, shift);
+
+    /* pack back to 16 bits with unsigned saturation, clamping to
+     * [0, 65535] like the C version */
+    sum = _mm256_packus_epi32 (sum, sum);
+    lo = _mm256_castsi256_si128 (sum);
+    hi = _mm256_extracti128_si256 (sum, 1);
+    res = _mm_unpacklo_epi64 (lo, hi);
+
+    /* keep the original alpha of both pixels */
+    res = _mm_blend_epi16 (res, q, 0x11);
+    _mm_storeu_si128 ((__m128i *) (pixels + i * 4), res);
+  }
+  for (; i < width; i++) {
+    gint r = pixels[i * 4 + 1];
+    gint g = pixels[i * 4 + 2];
+    gint b = pixels[i * 4 + 3];
+    gint y, u, v;
+
+    y = (im[0] * r + im[1] * g + im[2] * b + im[3]) >> shift;
+    u = (im[4] * r + im[5] * g + im[6] * b + im[7]) >> shift;
+    v = (im[8] * r + im[9] * g + im[10] * b + im[11]) >> shift;
+
+    pixels[i * 4 + 1] = CLAMP (y, 0, 65535);
+    pixels[i * 4 + 2] = CLAMP (u, 0, 65535);
+    pixels[i * 4 + 3] = CLAMP (v, 0, 65535);
+  }
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stub so that the dispatch code in video-converter.c always links; it is
+ * never called because video_converter_avx2_available() returns FALSE. */
+
+void
+video_converter_avx2_matrix16 (guint16 * pixels, const gint * im, gint shift,
+    gint width)
+{
+  g_assert_not_reached ();
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+video_converter_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
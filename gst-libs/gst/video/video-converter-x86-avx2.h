@@ -0,0 +1,35 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_CONVERTER_X86_AVX2_H
+#define VIDEO_CONVERTER_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the avx2 kernels below were compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean video_converter_avx2_available (void);
+
+/* Apply the 4x4 color matrix @im (row-major, @shift bit fixed point) in
+ * place to @width 16-bit AYUV/ARGB pixels, leaving the first component
+ * untouched; equivalent to video_converter_matrix16 */
+void video_converter_avx2_matrix16 (guint16 * pixels, const gint * im,
+    gint shift, gint width);
+
+#endif /* VIDEO_CONVERTER_X86_AVX2_H */
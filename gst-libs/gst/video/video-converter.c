@@ -37,6 +37,15 @@
 
 #include "video-orc.h"
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "video-converter-x86-avx2.h"
+
+/* set up once in gst_video_converter_new() */
+static gboolean video_converter_use_avx2 = FALSE;
+#endif
+
 /**
  * SECTION:videoconverter
  * @title: GstVideoConverter
@@ -118,105 +127,74 @@ ensure_debug_category (void)
 typedef void (*GstParallelizedTaskFunc) (gpointer user_data);
 
 typedef struct _GstParallelizedTaskRunner GstParallelizedTaskRunner;
-typedef struct _GstParallelizedTaskThread GstParallelizedTaskThread;
+typedef struct _GstParallelizedTaskItem GstParallelizedTaskItem;
 
-struct _GstParallelizedTaskThread
+struct _GstParallelizedTaskItem
 {
   GstParallelizedTaskRunner *runner;
   guint idx;
-  GThread *thread;
 };
 
 struct _GstParallelizedTaskRunner
 {
   guint n_threads;
 
-  GstParallelizedTaskThread *threads;
+  GstParallelizedTaskItem *items;
 
   GstParallelizedTaskFunc func;
   gpointer *task_data;
 
   GMutex lock;
-  GCond cond_todo, cond_done;
-  gint n_todo, n_done;
-  gboolean quit;
+  GCond cond_done;
+  gint n_done;
 };
 
-static gpointer
-gst_parallelized_task_thread_func (gpointer data)
-{
-  GstParallelizedTaskThread *self = data;
+/* All runners share one process-wide thread pool so that many converter
+ * instances in one process don't each park their own set of idle
+ * threads. A run() always executes one chunk on the calling thread, so
+ * forward progress does not depend on the pool and queueing behind
+ * another converter's chunks just serializes the work. */
+static void gst_parallelized_task_pool_func (gpointer data,
+    gpointer user_data);
 
-#if 0
-#ifdef HAVE_PTHREAD
-  {
-    pthread_t thread = pthread_self ();
-    cpu_set_t cpuset;
-    int r;
+static GThreadPool *
+gst_parallelized_task_pool_get (void)
+{
+  static GThreadPool *pool = NULL;
+  static gsize once = 0;
 
-    CPU_ZERO (&cpuset);
-    CPU_SET (self->idx, &cpuset);
-    if ((r = pthread_setaffinity_np (thread, sizeof (cpuset), &cpuset)) != 0)
-      GST_ERROR ("Failed to set thread affinity for thread %d: %s", self->idx,
-          g_strerror (r));
+  if (g_once_init_enter (&once)) {
+    pool = g_thread_pool_new (gst_parallelized_task_pool_func, NULL,
+        g_get_num_processors (), FALSE, NULL);
+    g_once_init_leave (&once, 1);
   }
-#endif
-#endif
-
-  g_mutex_lock (&self->runner->lock);
-  self->runner->n_done++;
-  if (self->runner->n_done == self->runner->n_threads - 1)
-    g_cond_signal (&self->runner->cond_done);
-
-  do {
-    gint idx;
-
-    while (self->runner->n_todo == -1 && !self->runner->quit)
-      g_cond_wait (&self->runner->cond_todo, &self->runner->lock);
-
-    if (self->runner->quit)
-      break;
-
-    idx = self->runner->n_todo--;
-    g_assert (self->runner->n_todo >= -1);
-    g_mutex_unlock (&self->runner->lock);
-
-    g_assert (self->runner->func != NULL);
+  return pool;
+}
 
-    self->runner->func (self->runner->task_data[idx]);
+static void
+gst_parallelized_task_pool_func (gpointer data, gpointer user_data)
+{
+  GstParallelizedTaskItem *item = data;
+  GstParallelizedTaskRunner *self = item->runner;
 
-    g_mutex_lock (&self->runner->lock);
-    self->runner->n_done++;
-    if (self->runner->n_done == self->runner->n_threads - 1)
-      g_cond_signal (&self->runner->cond_done);
-  } while (TRUE);
+  g_assert (self->func != NULL);
 
-  g_mutex_unlock (&self->runner->lock);
+  self->func (self->task_data[item->idx]);
 
-  return NULL;
+  g_mutex_lock (&self->lock);
+  self->n_done++;
+  g_cond_signal (&self->cond_done);
+  g_mutex_unlock (&self->lock);
 }
 
 static void
 gst_parallelized_task_runner_free (GstParallelizedTaskRunner * self)
 {
-  guint i;
-
-  g_mutex_lock (&self->lock);
-  self->quit = TRUE;
-  g_cond_broadcast (&self->cond_todo);
-  g_mutex_unlock (&self->lock);
-
-  for (i = 1; i < self->n_threads; i++) {
-    if (!self->threads[i].thread)
-      continue;
-
-    g_thread_join (self->threads[i].thread);
-  }
-
+  /* run() waits for all chunks before returning, so no pool item can
+   * still reference us here */
   g_mutex_clear (&self->lock);
-  g_cond_clear (&self->cond_todo);
   g_cond_clear (&self->cond_done);
-  g_free (self->threads);
+  g_free (self->items);
   g_free (self);
 }
 
@@ -225,20 +203,16 @@ gst_parallelized_task_runner_new (guint n_threads)
 {
   GstParallelizedTaskRunner *self;
   guint i;
-  GError *err = NULL;
 
   if (n_threads == 0)
     n_threads = g_get_num_processors ();
 
   self = g_new0 (GstParallelizedTaskRunner, 1);
   self->n_threads = n_threads;
-  self->threads = g_new0 (GstParallelizedTaskThread, n_threads);
+  self->items = g_new0 (GstParallelizedTaskItem, n_threads);
 
-  self->quit = FALSE;
-  self->n_todo = -1;
   self->n_done = 0;
   g_mutex_init (&self->lock);
-  g_cond_init (&self->cond_todo);
   g_cond_init (&self->cond_done);
 
   /* Set when scheduling a job */
@@ -246,35 +220,11 @@ gst_parallelized_task_runner_new (guint n_threads)
   self->task_data = NULL;
 
   for (i = 0; i < n_threads; i++) {
-    self->threads[i].runner = self;
-    self->threads[i].idx = i;
-
-    /* First thread is the one calling run() */
-    if (i > 0) {
-      self->threads[i].thread =
-          g_thread_try_new ("videoconvert", gst_parallelized_task_thread_func,
-          &self->threads[i], &err);
-      if (!self->threads[i].thread)
-        goto error;
-    }
+    self->items[i].runner = self;
+    self->items[i].idx = i;
   }
 
-  g_mutex_lock (&self->lock);
-  while (self->n_done < self->n_threads - 1)
-    g_cond_wait (&self->cond_done, &self->lock);
-  self->n_done = 0;
-  g_mutex_unlock (&self->lock);
-
   return self;
-
-error:
-  {
-    GST_ERROR ("Failed to start thread %u: %s", i, err->message);
-    g_clear_error (&err);
-
-    gst_parallelized_task_runner_free (self);
-    return NULL;
-  }
 }
 
 static void
@@ -287,11 +237,16 @@ gst_parallelized_task_runner_run (GstParallelizedTaskRunner * self,
   self->task_data = task_data;
 
   if (n_threads > 1) {
+    GThreadPool *pool = gst_parallelized_task_pool_get ();
+    guint i;
+
     g_mutex_lock (&self->lock);
-    self->n_todo = self->n_threads - 2;
     self->n_done = 0;
-    g_cond_broadcast (&self->cond_todo);
     g_mutex_unlock (&self->lock);
+
+    /* the last chunk runs on the calling thread */
+    for (i = 0; i < n_threads - 1; i++)
+      g_thread_pool_push (pool, &self->items[i], NULL);
   }
 
   self->func (self->task_data[self->n_threads - 1]);
@@ -335,7 +290,7 @@ typedef struct _GammaData GammaData;
 
 struct _GammaData
 {
-  gpointer gamma_table;
+  gpointer gamma_table;         /* owned by the process-wide table cache */
   gint width;
   void (*gamma_func) (GammaData * data, gpointer dest, gpointer src);
 };
@@ -411,6 +366,10 @@ struct _GstVideoConverter
   gboolean identity_unpack;
   gint unpack_pstride;
 
+  /* deinterlace */
+  GstLineCache **deinterlace_lines;
+  GstVideoDeinterlaceMethod deinterlace_method;
+
   /* chroma upsample */
   GstLineCache **upsample_lines;
   GstVideoChromaResample **upsample;
@@ -648,6 +607,8 @@ gst_line_cache_alloc_line (GstLineCache * cache, gint idx)
 static void video_converter_generic (GstVideoConverter * convert,
     const GstVideoFrame * src, GstVideoFrame * dest);
 static gboolean video_converter_lookup_fastpath (GstVideoConverter * convert);
+static void video_converter_update_fastpath_offsets (GstVideoConverter *
+    convert);
 static void video_converter_compute_matrix (GstVideoConverter * convert);
 static void video_converter_compute_resample (GstVideoConverter * convert,
     gint idx);
@@ -669,6 +630,8 @@ static gboolean do_convert_to_YUV_lines (GstLineCache * cache, gint idx,
     gint out_line, gint in_line, gpointer user_data);
 static gboolean do_upsample_lines (GstLineCache * cache, gint idx,
     gint out_line, gint in_line, gpointer user_data);
+static gboolean do_deinterlace_lines (GstLineCache * cache, gint idx,
+    gint out_line, gint in_line, gpointer user_data);
 static gboolean do_vscale_lines (GstLineCache * cache, gint idx, gint out_line,
     gint in_line, gpointer user_data);
 static gboolean do_hscale_lines (GstLineCache * cache, gint idx, gint out_line,
@@ -807,6 +770,8 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
 #define DEFAULT_OPT_RESAMPLER_TAPS 0
 #define DEFAULT_OPT_DITHER_METHOD GST_VIDEO_DITHER_BAYER
 #define DEFAULT_OPT_DITHER_QUANTIZATION 1
+/* options none, weave, bob, blend */
+#define DEFAULT_OPT_DEINTERLACE_METHOD GST_VIDEO_DEINTERLACE_METHOD_NONE
 
 #define GET_OPT_FILL_BORDER(c) get_opt_bool(c, \
     GST_VIDEO_CONVERTER_OPT_FILL_BORDER, DEFAULT_OPT_FILL_BORDER)
@@ -837,6 +802,9 @@ get_opt_enum (GstVideoConverter * convert, const gchar * opt, GType type,
     DEFAULT_OPT_DITHER_METHOD)
 #define GET_OPT_DITHER_QUANTIZATION(c) get_opt_uint(c, \
     GST_VIDEO_CONVERTER_OPT_DITHER_QUANTIZATION, DEFAULT_OPT_DITHER_QUANTIZATION)
+#define GET_OPT_DEINTERLACE_METHOD(c) get_opt_enum(c, \
+    GST_VIDEO_CONVERTER_OPT_DEINTERLACE_METHOD, \
+    GST_TYPE_VIDEO_DEINTERLACE_METHOD, DEFAULT_OPT_DEINTERLACE_METHOD)
 
 #define CHECK_ALPHA_COPY(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_COPY)
 #define CHECK_ALPHA_SET(c) (GET_OPT_ALPHA_MODE(c) == GST_VIDEO_ALPHA_MODE_SET)
@@ -906,6 +874,30 @@ chain_upsample (GstVideoConverter * convert, GstLineCache * prev, gint idx)
   return prev;
 }
 
+static GstLineCache *
+chain_deinterlace (GstVideoConverter * convert, GstLineCache * prev, gint idx)
+{
+  switch (convert->deinterlace_method) {
+    case GST_VIDEO_DEINTERLACE_METHOD_BOB:
+    case GST_VIDEO_DEINTERLACE_METHOD_BLEND:
+      GST_DEBUG ("chain deinterlace, method %d", convert->deinterlace_method);
+      prev = convert->deinterlace_lines[idx] = gst_line_cache_new (prev);
+      prev->write_input = FALSE;
+      prev->pass_alloc = FALSE;
+      prev->n_lines =
+          (convert->deinterlace_method ==
+          GST_VIDEO_DEINTERLACE_METHOD_BLEND ? 3 : 1);
+      prev->stride = convert->current_pstride * convert->current_width;
+      gst_line_cache_set_need_line_func (prev,
+          do_deinterlace_lines, idx, convert, NULL);
+      break;
+    default:
+      /* weave keeps the woven frame, nothing to do */
+      break;
+  }
+  return prev;
+}
+
 static void
 color_matrix_set_identity (MatrixData * m)
 {
@@ -1330,6 +1322,14 @@ video_converter_matrix16 (MatrixData * data, gpointer pixels)
   }
 }
 
+#ifdef CHECK_X86
+static void
+video_converter_matrix16_avx2 (MatrixData * data, gpointer pixels)
+{
+  video_converter_avx2_matrix16 (pixels, (const gint *) data->im, SCALE,
+      data->width);
+}
+#endif
 
 static void
 prepare_matrix (GstVideoConverter * convert, MatrixData * data)
@@ -1375,8 +1375,16 @@ prepare_matrix (GstVideoConverter * convert, MatrixData * data)
           (((guint64) (guint16) a13) << 32) | (((guint64) (guint16) a03) << 16);
     }
   } else {
-    GST_DEBUG ("use 16bit matrix");
-    data->matrix_func = video_converter_matrix16;
+#ifdef CHECK_X86
+    if (video_converter_use_avx2) {
+      GST_DEBUG ("use AVX2 16bit matrix");
+      data->matrix_func = video_converter_matrix16_avx2;
+    } else
+#endif
+    {
+      GST_DEBUG ("use 16bit matrix");
+      data->matrix_func = video_converter_matrix16;
+    }
   }
 }
 
@@ -1504,12 +1512,89 @@ gamma_convert_u16_u16 (GammaData * data, gpointer dest, gpointer src)
   }
 }
 
+/* The gamma tables only depend on the transfer function and the
+ * conversion variant, so they are shared between all converters in the
+ * process. The key space is small (one table per transfer function and
+ * variant) and the tables are immutable once built, so they are kept
+ * for the lifetime of the process. */
+typedef enum
+{
+  GAMMA_TABLE_DECODE_U8_U16,
+  GAMMA_TABLE_DECODE_U16_U16,
+  GAMMA_TABLE_ENCODE_U16_U8,
+  GAMMA_TABLE_ENCODE_U16_U16
+} GammaTableVariant;
+
+static GMutex gamma_table_lock;
+static GHashTable *gamma_table_cache;
+
+static gpointer
+gamma_table_get (GstVideoTransferFunction func, GammaTableVariant variant)
+{
+  gpointer key, t;
+  gint i;
+
+  key = GUINT_TO_POINTER (((guint) func << 2) | variant);
+
+  g_mutex_lock (&gamma_table_lock);
+  if (gamma_table_cache == NULL)
+    gamma_table_cache = g_hash_table_new (NULL, NULL);
+
+  t = g_hash_table_lookup (gamma_table_cache, key);
+  if (t == NULL) {
+    switch (variant) {
+      case GAMMA_TABLE_DECODE_U8_U16:{
+        guint16 *table = g_malloc (sizeof (guint16) * 256);
+
+        for (i = 0; i < 256; i++)
+          table[i] =
+              rint (gst_video_color_transfer_decode (func,
+                  i / 255.0) * 65535.0);
+        t = table;
+        break;
+      }
+      case GAMMA_TABLE_DECODE_U16_U16:{
+        guint16 *table = g_malloc (sizeof (guint16) * 65536);
+
+        for (i = 0; i < 65536; i++)
+          table[i] =
+              rint (gst_video_color_transfer_decode (func,
+                  i / 65535.0) * 65535.0);
+        t = table;
+        break;
+      }
+      case GAMMA_TABLE_ENCODE_U16_U8:{
+        guint8 *table = g_malloc (sizeof (guint8) * 65536);
+
+        for (i = 0; i < 65536; i++)
+          table[i] =
+              rint (gst_video_color_transfer_encode (func,
+                  i / 65535.0) * 255.0);
+        t = table;
+        break;
+      }
+      case GAMMA_TABLE_ENCODE_U16_U16:{
+        guint16 *table = g_malloc (sizeof (guint16) * 65536);
+
+        for (i = 0; i < 65536; i++)
+          table[i] =
+              rint (gst_video_color_transfer_encode (func,
+                  i / 65535.0) * 65535.0);
+        t = table;
+        break;
+      }
+    }
+    g_hash_table_insert (gamma_table_cache, key, t);
+  }
+  g_mutex_unlock (&gamma_table_lock);
+
+  return t;
+}
+
 static void
 setup_gamma_decode (GstVideoConverter * convert)
 {
   GstVideoTransferFunction func;
-  guint16 *t;
-  gint i;
 
   func = convert->in_info.colorimetry.transfer;
 
@@ -1517,18 +1602,13 @@ setup_gamma_decode (GstVideoConverter * convert)
   if (convert->current_bits == 8) {
     GST_DEBUG ("gamma decode 8->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u8_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 256);
-
-    for (i = 0; i < 256; i++)
-      t[i] = rint (gst_video_color_transfer_decode (func, i / 255.0) * 65535.0);
+    convert->gamma_dec.gamma_table =
+        gamma_table_get (func, GAMMA_TABLE_DECODE_U8_U16);
   } else {
     GST_DEBUG ("gamma decode 16->16: %d", func);
     convert->gamma_dec.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_dec.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_decode (func, i / 65535.0) * 65535.0);
+    convert->gamma_dec.gamma_table =
+        gamma_table_get (func, GAMMA_TABLE_DECODE_U16_U16);
   }
   convert->current_bits = 16;
   convert->current_pstride = 8;
@@ -1539,30 +1619,20 @@ static void
 setup_gamma_encode (GstVideoConverter * convert, gint target_bits)
 {
   GstVideoTransferFunction func;
-  gint i;
 
   func = convert->out_info.colorimetry.transfer;
 
   convert->gamma_enc.width = convert->current_width;
   if (target_bits == 8) {
-    guint8 *t;
-
     GST_DEBUG ("gamma encode 16->8: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u8;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint8) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] = rint (gst_video_color_transfer_encode (func, i / 65535.0) * 255.0);
+    convert->gamma_enc.gamma_table =
+        gamma_table_get (func, GAMMA_TABLE_ENCODE_U16_U8);
   } else {
-    guint16 *t;
-
     GST_DEBUG ("gamma encode 16->16: %d", func);
     convert->gamma_enc.gamma_func = gamma_convert_u16_u16;
-    t = convert->gamma_enc.gamma_table = g_malloc (sizeof (guint16) * 65536);
-
-    for (i = 0; i < 65536; i++)
-      t[i] =
-          rint (gst_video_color_transfer_encode (func, i / 65535.0) * 65535.0);
+    convert->gamma_enc.gamma_table =
+        gamma_table_get (func, GAMMA_TABLE_ENCODE_U16_U16);
   }
 }
 
@@ -2265,9 +2335,24 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   /* we won't ever do framerate conversion */
   g_return_val_if_fail (in_info->fps_n == out_info->fps_n, NULL);
   g_return_val_if_fail (in_info->fps_d == out_info->fps_d, NULL);
-  /* we won't ever do deinterlace */
-  g_return_val_if_fail (in_info->interlace_mode == out_info->interlace_mode,
-      NULL);
+  /* deinterlacing must be requested explicitly with the deinterlace-method
+   * option, everything else is refused */
+  g_return_val_if_fail (in_info->interlace_mode == out_info->interlace_mode
+      || (GST_VIDEO_INFO_IS_INTERLACED (in_info)
+          && !GST_VIDEO_INFO_IS_INTERLACED (out_info)), NULL);
+
+#ifdef CHECK_X86
+  {
+    static gsize simd_once = 0;
+
+    if (g_once_init_enter (&simd_once)) {
+      video_converter_use_avx2 = video_converter_avx2_available ();
+      GST_DEBUG ("AVX2 matrix kernels %s",
+          video_converter_use_avx2 ? "enabled" : "not available");
+      g_once_init_leave (&simd_once, 1);
+    }
+  }
+#endif
 
   convert = g_slice_new0 (GstVideoConverter);
 
@@ -2328,6 +2413,13 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   convert->alpha_value = 255 * alpha_value;
   convert->alpha_mode = convert_get_alpha_mode (convert);
 
+  convert->deinterlace_method = GET_OPT_DEINTERLACE_METHOD (convert);
+  if (!GST_VIDEO_INFO_IS_INTERLACED (in_info)
+      || GST_VIDEO_INFO_IS_INTERLACED (out_info)) {
+    /* only deinterlace when going from interlaced to progressive */
+    convert->deinterlace_method = GST_VIDEO_DEINTERLACE_METHOD_NONE;
+  }
+
   convert->unpack_format = in_info->finfo->unpack_format;
   finfo = gst_video_format_get_info (convert->unpack_format);
   convert->unpack_bits = GST_VIDEO_FORMAT_INFO_DEPTH (finfo, 0);
@@ -2362,6 +2454,19 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   if (MAX (convert->out_height, convert->in_height) / n_threads < 200)
     n_threads = (MAX (convert->out_height, convert->in_height) + 199) / 200;
   convert->conversion_runner = gst_parallelized_task_runner_new (n_threads);
+  if (convert->conversion_runner == NULL) {
+    /* failed to spawn worker threads, fall back to single-threaded
+     * conversion instead of crashing on the first frame */
+    GST_WARNING ("failed to start %d conversion threads, "
+        "continuing single-threaded", n_threads);
+    n_threads = 1;
+    convert->conversion_runner = gst_parallelized_task_runner_new (n_threads);
+  }
+
+  if (GST_VIDEO_INFO_IS_INTERLACED (in_info)
+      && !GST_VIDEO_INFO_IS_INTERLACED (out_info)
+      && convert->deinterlace_method == GST_VIDEO_DEINTERLACE_METHOD_NONE)
+    goto no_deinterlace_method;
 
   if (video_converter_lookup_fastpath (convert))
     goto done;
@@ -2383,6 +2488,7 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
   convert->h_scaler = g_new0 (GstVideoScaler *, n_threads);
   convert->unpack_lines = g_new0 (GstLineCache *, n_threads);
   convert->pack_lines = g_new0 (GstLineCache *, n_threads);
+  convert->deinterlace_lines = g_new0 (GstLineCache *, n_threads);
   convert->upsample_lines = g_new0 (GstLineCache *, n_threads);
   convert->to_RGB_lines = g_new0 (GstLineCache *, n_threads);
   convert->hscale_lines = g_new0 (GstLineCache *, n_threads);
@@ -2403,6 +2509,8 @@ gst_video_converter_new (GstVideoInfo * in_info, GstVideoInfo * out_info,
     prev = chain_unpack_line (convert, i);
     /* upsample chroma */
     prev = chain_upsample (convert, prev, i);
+    /* deinterlace */
+    prev = chain_deinterlace (convert, prev, i);
     /* convert to gamma decoded RGB */
     prev = chain_convert_to_RGB (convert, prev, i);
     /* do all downscaling */
@@ -2431,6 +2539,13 @@ done:
   return convert;
 
   /* ERRORS */
+no_deinterlace_method:
+  {
+    GST_ERROR ("progressive output from interlaced input needs a "
+        "deinterlace-method");
+    gst_video_converter_free (convert);
+    return NULL;
+  }
 no_unpack_func:
   {
     GST_ERROR ("no unpack_func for format %s",
@@ -2487,6 +2602,8 @@ gst_video_converter_free (GstVideoConverter * convert)
       gst_video_scaler_free (convert->h_scaler[i]);
     if (convert->unpack_lines && convert->unpack_lines[i])
       gst_line_cache_free (convert->unpack_lines[i]);
+    if (convert->deinterlace_lines && convert->deinterlace_lines[i])
+      gst_line_cache_free (convert->deinterlace_lines[i]);
     if (convert->upsample_lines && convert->upsample_lines[i])
       gst_line_cache_free (convert->upsample_lines[i]);
     if (convert->to_RGB_lines && convert->to_RGB_lines[i])
@@ -2517,6 +2634,7 @@ gst_video_converter_free (GstVideoConverter * convert)
   g_free (convert->h_scaler);
   g_free (convert->unpack_lines);
   g_free (convert->pack_lines);
+  g_free (convert->deinterlace_lines);
   g_free (convert->upsample_lines);
   g_free (convert->to_RGB_lines);
   g_free (convert->hscale_lines);
@@ -2528,9 +2646,6 @@ gst_video_converter_free (GstVideoConverter * convert)
   g_free (convert->dither_lines);
   g_free (convert->dither);
 
-  g_free (convert->gamma_dec.gamma_table);
-  g_free (convert->gamma_enc.gamma_table);
-
   if (convert->tmpline) {
     for (i = 0; i < convert->conversion_runner->n_threads; i++)
       g_free (convert->tmpline[i]);
@@ -2642,6 +2757,59 @@ gst_video_converter_frame (GstVideoConverter * convert,
   convert->convert (convert, src, dest);
 }
 
+/**
+ * gst_video_converter_frame_region:
+ * @convert: a #GstVideoConverter
+ * @src: a #GstVideoFrame
+ * @dest: a #GstVideoFrame
+ * @src_x: x position of the source rectangle
+ * @src_y: y position of the source rectangle
+ * @dest_x: x position of the destination rectangle
+ * @dest_y: y position of the destination rectangle
+ *
+ * Convert the pixels of @src into @dest like gst_video_converter_frame(),
+ * but take the source rectangle at @src_x, @src_y and write the result at
+ * @dest_x, @dest_y instead of at the configured positions. All other
+ * conversion state is reused, so moving the rectangles around, for example
+ * to convert many small regions of interest of a larger frame, does not
+ * require a new converter for every position. The new positions replace
+ * the configured ones and stay in effect for subsequent conversions.
+ *
+ * The sizes of the rectangles are part of the scaler state and can not
+ * change per frame; select them with #GST_VIDEO_CONVERTER_OPT_SRC_WIDTH,
+ * #GST_VIDEO_CONVERTER_OPT_SRC_HEIGHT, #GST_VIDEO_CONVERTER_OPT_DEST_WIDTH
+ * and #GST_VIDEO_CONVERTER_OPT_DEST_HEIGHT when creating the converter.
+ * Like the position options, the positions are rounded down to the chroma
+ * subsampling alignment of the video formats and the rectangles must fall
+ * completely inside their frames.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_converter_frame_region (GstVideoConverter * convert,
+    const GstVideoFrame * src, GstVideoFrame * dest,
+    gint src_x, gint src_y, gint dest_x, gint dest_y)
+{
+  g_return_if_fail (convert != NULL);
+  g_return_if_fail (src != NULL);
+  g_return_if_fail (dest != NULL);
+  g_return_if_fail (src_x >= 0 && src_y >= 0);
+  g_return_if_fail (dest_x >= 0 && dest_y >= 0);
+  g_return_if_fail (src_x + convert->in_width <= convert->in_maxwidth);
+  g_return_if_fail (src_y + convert->in_height <= convert->in_maxheight);
+  g_return_if_fail (dest_x + convert->out_width <= convert->out_maxwidth);
+  g_return_if_fail (dest_y + convert->out_height <= convert->out_maxheight);
+
+  convert->in_x = src_x & ~((1 << convert->in_info.finfo->w_sub[1]) - 1);
+  convert->in_y = src_y & ~((1 << convert->in_info.finfo->h_sub[1]) - 1);
+  convert->out_x = dest_x & ~((1 << convert->out_info.finfo->w_sub[1]) - 1);
+  convert->out_y = dest_y & ~((1 << convert->out_info.finfo->h_sub[1]) - 1);
+
+  video_converter_update_fastpath_offsets (convert);
+
+  convert->convert (convert, src, dest);
+}
+
 static void
 video_converter_compute_matrix (GstVideoConverter * convert)
 {
@@ -2726,6 +2894,15 @@ video_converter_compute_resample (GstVideoConverter * convert, gint idx)
 #define FRAME_GET_V_STRIDE(frame)    FRAME_GET_COMP_STRIDE(frame, GST_VIDEO_COMP_V)
 #define FRAME_GET_A_STRIDE(frame)    FRAME_GET_COMP_STRIDE(frame, GST_VIDEO_COMP_A)
 
+/* Hint that @ptr will be read once soon, bypassing the caches where the
+ * CPU supports it (prefetchnta on x86). Source lines are only read once
+ * per conversion so there is no point in keeping them cached. */
+#ifdef __GNUC__
+#define PREFETCH_READ_ONCE(ptr) __builtin_prefetch ((ptr), 0, 0)
+#else
+#define PREFETCH_READ_ONCE(ptr)
+#endif
+
 
 #define UNPACK_FRAME(frame,dest,line,x,width)        \
   frame->info.finfo->unpack_func (frame->info.finfo, \
@@ -2779,6 +2956,12 @@ do_unpack_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
 
   cline = CLAMP (in_line + convert->in_y, 0, convert->in_maxheight - 1);
 
+  /* start fetching the next source line while we unpack this one; the
+   * hardware prefetcher only kicks in after the first miss in a row */
+  if (cline + 1 < (guint) convert->in_maxheight)
+    PREFETCH_READ_ONCE (((guint8 *) FRAME_GET_LINE (convert->src, cline + 1)) +
+        convert->in_x * convert->unpack_pstride);
+
   if (cache->alloc_writable || !convert->identity_unpack) {
     tmpline = gst_line_cache_alloc_line (cache, out_line);
     GST_DEBUG ("unpack line %d (%u) %p", in_line, cline, tmpline);
@@ -2827,6 +3010,53 @@ do_upsample_lines (GstLineCache * cache, gint idx, gint out_line, gint in_line,
   return TRUE;
 }
 
+static gboolean
+do_deinterlace_lines (GstLineCache * cache, gint idx, gint out_line,
+    gint in_line, gpointer user_data)
+{
+  GstVideoConverter *convert = user_data;
+  gpointer *lines, destline;
+
+  destline = gst_line_cache_alloc_line (cache, out_line);
+
+  if (convert->deinterlace_method == GST_VIDEO_DEINTERLACE_METHOD_BOB) {
+    gint sline;
+
+    /* line-double the dominant field */
+    if (GST_VIDEO_FRAME_IS_TFF (convert->src))
+      sline = in_line & ~1;
+    else
+      sline = MIN (in_line | 1, convert->in_height - 1);
+
+    lines = gst_line_cache_get_lines (cache->prev, idx, out_line, sline, 1);
+
+    GST_DEBUG ("bob line %d (%d) %p->%p", in_line, sline, lines[0], destline);
+    memcpy (destline, lines[0],
+        convert->current_pstride * convert->current_width);
+  } else {
+    gint l0, l2;
+
+    /* blend the line with the field lines directly above and below it,
+     * clamped at the frame edges */
+    l0 = MAX (in_line - 1, 0);
+    l2 = MIN (in_line + 1, convert->in_height - 1);
+
+    lines =
+        gst_line_cache_get_lines (cache->prev, idx, out_line, l0, l2 - l0 + 1);
+
+    GST_DEBUG ("blend line %d (%d-%d) %p", in_line, l0, l2, destline);
+    if (convert->current_bits == 8)
+      video_orc_deinterlace_blend_u8 (destline, lines[in_line - l0], lines[0],
+          lines[l2 - l0], convert->current_width * 4);
+    else
+      video_orc_deinterlace_blend_u16 (destline, lines[in_line - l0], lines[0],
+          lines[l2 - l0], convert->current_width * 4);
+  }
+  gst_line_cache_add_line (cache, in_line, destline);
+
+  return TRUE;
+}
+
 static gboolean
 do_convert_to_RGB_lines (GstLineCache * cache, gint idx, gint out_line,
     gint in_line, gpointer user_data)
@@ -3107,11 +3337,20 @@ video_converter_generic (GstVideoConverter * convert, const GstVideoFrame * src,
   convert->src = src;
   convert->dest = dest;
 
-  if (GST_VIDEO_FRAME_IS_INTERLACED (src)) {
+  if (GST_VIDEO_FRAME_IS_INTERLACED (src) &&
+      convert->deinterlace_method == GST_VIDEO_DEINTERLACE_METHOD_NONE) {
     GST_DEBUG ("setup interlaced frame");
     convert->upsample = convert->upsample_i;
     convert->downsample = convert->downsample_i;
     convert->v_scaler = convert->v_scaler_i;
+  } else if (GST_VIDEO_FRAME_IS_INTERLACED (src) &&
+      convert->deinterlace_method != GST_VIDEO_DEINTERLACE_METHOD_WEAVE) {
+    GST_DEBUG ("setup deinterlaced frame");
+    /* the chroma is still interlaced when it is upsampled, the deinterlace
+     * stage then makes everything downstream progressive */
+    convert->upsample = convert->upsample_i;
+    convert->downsample = convert->downsample_p;
+    convert->v_scaler = convert->v_scaler_p;
   } else {
     GST_DEBUG ("setup progressive frame");
     convert->upsample = convert->upsample_p;
@@ -3695,6 +3934,212 @@ convert_YUY2_Y444 (GstVideoConverter * convert, const GstVideoFrame * src,
   convert_fill_border (convert, dest);
 }
 
+static void
+convert_I420_NV12_task (FConvertPlaneTask * task)
+{
+  video_orc_memcpy_2d (task->d, task->dstride, task->s, task->sstride,
+      task->width, task->height);
+  video_orc_convert_I420_NV12 (task->du, task->dustride,
+      task->su, task->sustride, task->sv, task->svstride,
+      (task->width + 1) / 2, (task->height + 1) / 2);
+}
+
+static void
+convert_I420_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  guint8 *sy, *su, *sv, *dy, *duv;
+  FConvertPlaneTask *tasks;
+  FConvertPlaneTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+  gint i;
+
+  sy = FRAME_GET_Y_LINE (src, convert->in_y);
+  sy += convert->in_x;
+  su = FRAME_GET_U_LINE (src, convert->in_y >> 1);
+  su += convert->in_x >> 1;
+  sv = FRAME_GET_V_LINE (src, convert->in_y >> 1);
+  sv += convert->in_x >> 1;
+
+  dy = FRAME_GET_PLANE_LINE (dest, 0, convert->out_y);
+  dy += convert->out_x;
+  duv = FRAME_GET_PLANE_LINE (dest, 1, convert->out_y >> 1);
+  duv += (convert->out_x >> 1) * 2;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertPlaneTask, n_threads);
+  tasks_p = g_newa (FConvertPlaneTask *, n_threads);
+
+  /* 2-line bands so every task gets whole chroma lines */
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].dstride = FRAME_GET_PLANE_STRIDE (dest, 0);
+    tasks[i].dustride = FRAME_GET_PLANE_STRIDE (dest, 1);
+    tasks[i].sstride = FRAME_GET_Y_STRIDE (src);
+    tasks[i].sustride = FRAME_GET_U_STRIDE (src);
+    tasks[i].svstride = FRAME_GET_V_STRIDE (src);
+    tasks[i].d = dy + i * lines_per_thread * tasks[i].dstride;
+    tasks[i].du = duv + (i * lines_per_thread / 2) * tasks[i].dustride;
+    tasks[i].s = sy + i * lines_per_thread * tasks[i].sstride;
+    tasks[i].su = su + (i * lines_per_thread / 2) * tasks[i].sustride;
+    tasks[i].sv = sv + (i * lines_per_thread / 2) * tasks[i].svstride;
+
+    tasks[i].width = width;
+    tasks[i].height = (i + 1) * lines_per_thread;
+    tasks[i].height = MIN (tasks[i].height, height);
+    tasks[i].height -= i * lines_per_thread;
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_I420_NV12_task, (gpointer) tasks_p);
+
+  convert_fill_border (convert, dest);
+}
+
+static void
+convert_NV12_I420_task (FConvertPlaneTask * task)
+{
+  video_orc_memcpy_2d (task->d, task->dstride, task->s, task->sstride,
+      task->width, task->height);
+  video_orc_convert_NV12_I420 (task->du, task->dustride,
+      task->dv, task->dvstride, task->su, task->sustride,
+      (task->width + 1) / 2, (task->height + 1) / 2);
+}
+
+static void
+convert_NV12_I420 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  guint8 *sy, *suv, *dy, *du, *dv;
+  FConvertPlaneTask *tasks;
+  FConvertPlaneTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+  gint i;
+
+  sy = FRAME_GET_PLANE_LINE (src, 0, convert->in_y);
+  sy += convert->in_x;
+  suv = FRAME_GET_PLANE_LINE (src, 1, convert->in_y >> 1);
+  suv += (convert->in_x >> 1) * 2;
+
+  dy = FRAME_GET_Y_LINE (dest, convert->out_y);
+  dy += convert->out_x;
+  du = FRAME_GET_U_LINE (dest, convert->out_y >> 1);
+  du += convert->out_x >> 1;
+  dv = FRAME_GET_V_LINE (dest, convert->out_y >> 1);
+  dv += convert->out_x >> 1;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertPlaneTask, n_threads);
+  tasks_p = g_newa (FConvertPlaneTask *, n_threads);
+
+  /* 2-line bands so every task gets whole chroma lines */
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].dstride = FRAME_GET_Y_STRIDE (dest);
+    tasks[i].dustride = FRAME_GET_U_STRIDE (dest);
+    tasks[i].dvstride = FRAME_GET_V_STRIDE (dest);
+    tasks[i].sstride = FRAME_GET_PLANE_STRIDE (src, 0);
+    tasks[i].sustride = FRAME_GET_PLANE_STRIDE (src, 1);
+    tasks[i].d = dy + i * lines_per_thread * tasks[i].dstride;
+    tasks[i].du = du + (i * lines_per_thread / 2) * tasks[i].dustride;
+    tasks[i].dv = dv + (i * lines_per_thread / 2) * tasks[i].dvstride;
+    tasks[i].s = sy + i * lines_per_thread * tasks[i].sstride;
+    tasks[i].su = suv + (i * lines_per_thread / 2) * tasks[i].sustride;
+
+    tasks[i].width = width;
+    tasks[i].height = (i + 1) * lines_per_thread;
+    tasks[i].height = MIN (tasks[i].height, height);
+    tasks[i].height -= i * lines_per_thread;
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_NV12_I420_task, (gpointer) tasks_p);
+
+  convert_fill_border (convert, dest);
+}
+
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+static void
+convert_P010_NV12_task (FConvertPlaneTask * task)
+{
+  gint i;
+
+  for (i = 0; i < task->height; i++)
+    video_orc_convert_u16_to_u8 (task->d + i * task->dstride,
+        (const guint16 *) (task->s + i * task->sstride), task->width);
+  for (i = 0; i < (task->height + 1) / 2; i++)
+    video_orc_convert_u16_to_u8 (task->du + i * task->dustride,
+        (const guint16 *) (task->su + i * task->sustride),
+        GST_ROUND_UP_2 (task->width));
+}
+
+static void
+convert_P010_NV12 (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  guint8 *sy, *suv, *dy, *duv;
+  FConvertPlaneTask *tasks;
+  FConvertPlaneTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+  gint i;
+
+  sy = FRAME_GET_PLANE_LINE (src, 0, convert->in_y);
+  sy += convert->in_x * 2;
+  suv = FRAME_GET_PLANE_LINE (src, 1, convert->in_y >> 1);
+  suv += (convert->in_x >> 1) * 4;
+
+  dy = FRAME_GET_PLANE_LINE (dest, 0, convert->out_y);
+  dy += convert->out_x;
+  duv = FRAME_GET_PLANE_LINE (dest, 1, convert->out_y >> 1);
+  duv += (convert->out_x >> 1) * 2;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertPlaneTask, n_threads);
+  tasks_p = g_newa (FConvertPlaneTask *, n_threads);
+
+  /* 2-line bands so every task gets whole chroma lines */
+  lines_per_thread = GST_ROUND_UP_2 ((height + n_threads - 1) / n_threads);
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].dstride = FRAME_GET_PLANE_STRIDE (dest, 0);
+    tasks[i].dustride = FRAME_GET_PLANE_STRIDE (dest, 1);
+    tasks[i].sstride = FRAME_GET_PLANE_STRIDE (src, 0);
+    tasks[i].sustride = FRAME_GET_PLANE_STRIDE (src, 1);
+    tasks[i].d = dy + i * lines_per_thread * tasks[i].dstride;
+    tasks[i].du = duv + (i * lines_per_thread / 2) * tasks[i].dustride;
+    tasks[i].s = sy + i * lines_per_thread * tasks[i].sstride;
+    tasks[i].su = suv + (i * lines_per_thread / 2) * tasks[i].sustride;
+
+    tasks[i].width = width;
+    tasks[i].height = (i + 1) * lines_per_thread;
+    tasks[i].height = MIN (tasks[i].height, height);
+    tasks[i].height -= i * lines_per_thread;
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_P010_NV12_task, (gpointer) tasks_p);
+
+  convert_fill_border (convert, dest);
+}
+#endif
+
 static void
 convert_UYVY_I420_task (FConvertTask * task)
 {
@@ -5020,6 +5465,75 @@ convert_I420_BGRA (GstVideoConverter * convert, const GstVideoFrame * src,
   convert_fill_border (convert, dest);
 }
 
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+static void
+convert_NV12_BGRA_task (FConvertTask * task)
+{
+  gint i;
+
+  for (i = task->height_0; i < task->height_1; i++) {
+    guint8 *sy, *suv, *d;
+
+    d = FRAME_GET_LINE (task->dest, i + task->out_y);
+    d += (task->out_x * 4);
+    sy = FRAME_GET_PLANE_LINE (task->src, 0, i + task->in_y);
+    sy += task->in_x;
+    suv = FRAME_GET_PLANE_LINE (task->src, 1, (i + task->in_y) >> 1);
+    suv += ((task->in_x >> 1) * 2);
+
+    /* the kernel produces two pixels per element, the fastpath entry
+     * requires an even width */
+    video_orc_convert_NV12_BGRA (d, sy, suv,
+        task->data->im[0][0], task->data->im[0][2],
+        task->data->im[2][1], task->data->im[1][1], task->data->im[1][2],
+        task->width / 2);
+  }
+}
+
+static void
+convert_NV12_BGRA (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  int i;
+  gint width = convert->in_width;
+  gint height = convert->in_height;
+  MatrixData *data = &convert->convert_matrix;
+  FConvertTask *tasks;
+  FConvertTask **tasks_p;
+  gint n_threads;
+  gint lines_per_thread;
+
+  n_threads = convert->conversion_runner->n_threads;
+  tasks = g_newa (FConvertTask, n_threads);
+  tasks_p = g_newa (FConvertTask *, n_threads);
+
+  lines_per_thread = (height + n_threads - 1) / n_threads;
+
+  for (i = 0; i < n_threads; i++) {
+    tasks[i].src = src;
+    tasks[i].dest = dest;
+
+    tasks[i].width = width;
+    tasks[i].data = data;
+    tasks[i].in_x = convert->in_x;
+    tasks[i].in_y = convert->in_y;
+    tasks[i].out_x = convert->out_x;
+    tasks[i].out_y = convert->out_y;
+
+    tasks[i].height_0 = i * lines_per_thread;
+    tasks[i].height_1 = tasks[i].height_0 + lines_per_thread;
+    tasks[i].height_1 = MIN (height, tasks[i].height_1);
+
+    tasks_p[i] = &tasks[i];
+  }
+
+  gst_parallelized_task_runner_run (convert->conversion_runner,
+      (GstParallelizedTaskFunc) convert_NV12_BGRA_task, (gpointer) tasks_p);
+
+  convert_fill_border (convert, dest);
+}
+#endif
+
 static void
 convert_I420_ARGB_task (FConvertTask * task)
 {
@@ -5887,6 +6401,90 @@ get_scale_format (GstVideoFormat format, gint plane)
   return res;
 }
 
+/* Copy the cropped source region into the destination region plane by
+ * plane, without going through the unpack/pack machinery. Only used when
+ * video_converter_can_copy_planes() returned TRUE. */
+static void
+convert_plane_copy (GstVideoConverter * convert, const GstVideoFrame * src,
+    GstVideoFrame * dest)
+{
+  const GstVideoFormatInfo *finfo = src->info.finfo;
+  gint c, n_comp;
+  guint copied = 0;
+
+  n_comp = GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo);
+
+  for (c = 0; c < n_comp; c++) {
+    gint p = GST_VIDEO_FORMAT_INFO_PLANE (finfo, c);
+    gint pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c);
+    gint in_x, in_y, out_x, out_y, h, bytes, j;
+    gint ss, ds;
+    const guint8 *sp;
+    guint8 *dp;
+
+    /* packed and semi-planar formats have multiple components in the
+     * same plane, copy each plane only once */
+    if (copied & (1 << p))
+      continue;
+    copied |= 1 << p;
+
+    in_x = GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (finfo, c, convert->in_x);
+    in_y = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, c, convert->in_y);
+    out_x = GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (finfo, c, convert->out_x);
+    out_y = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, c, convert->out_y);
+
+    bytes =
+        GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (finfo, c,
+        convert->in_width) * pstride;
+    h = GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (finfo, c, convert->in_height);
+
+    ss = GST_VIDEO_FRAME_PLANE_STRIDE (src, p);
+    ds = GST_VIDEO_FRAME_PLANE_STRIDE (dest, p);
+    sp = (const guint8 *) GST_VIDEO_FRAME_PLANE_DATA (src, p) +
+        in_y * ss + in_x * pstride;
+    dp = (guint8 *) GST_VIDEO_FRAME_PLANE_DATA (dest, p) +
+        out_y * ds + out_x * pstride;
+
+    for (j = 0; j < h; j++) {
+      memcpy (dp, sp, bytes);
+      sp += ss;
+      dp += ds;
+    }
+  }
+  convert_fill_border (convert, dest);
+}
+
+/* Check if the conversion degenerates to copying the (cropped) source
+ * planes into the destination: same format, no scaling and crop/border
+ * offsets that don't fall in the middle of a subsampled pixel group. */
+static gboolean
+video_converter_can_copy_planes (GstVideoConverter * convert)
+{
+  const GstVideoFormatInfo *finfo = convert->in_info.finfo;
+  gint c, n_comp;
+
+  if (GST_VIDEO_FORMAT_INFO_IS_TILED (finfo) ||
+      GST_VIDEO_FORMAT_INFO_HAS_PALETTE (finfo))
+    return FALSE;
+
+  n_comp = GST_VIDEO_FORMAT_INFO_N_COMPONENTS (finfo);
+
+  for (c = 0; c < n_comp; c++) {
+    gint w_sub = GST_VIDEO_FORMAT_INFO_W_SUB (finfo, c);
+    gint h_sub = GST_VIDEO_FORMAT_INFO_H_SUB (finfo, c);
+
+    /* no pixel stride means bit-packed lines (v210 and friends) */
+    if (GST_VIDEO_FORMAT_INFO_PSTRIDE (finfo, c) == 0)
+      return FALSE;
+
+    if ((convert->in_x | convert->out_x) & ((1 << w_sub) - 1))
+      return FALSE;
+    if ((convert->in_y | convert->out_y) & ((1 << h_sub) - 1))
+      return FALSE;
+  }
+  return TRUE;
+}
+
 static gboolean
 is_merge_yuv (GstVideoInfo * info)
 {
@@ -5901,6 +6499,48 @@ is_merge_yuv (GstVideoInfo * info)
   }
 }
 
+/* Recompute the per-plane offsets used by the plane fastpaths from the
+ * current in_x/in_y/out_x/out_y, mirroring what setup_scale() computed for
+ * the configured positions. Harmless for the other conversion paths, which
+ * read the positions directly. */
+static void
+video_converter_update_fastpath_offsets (GstVideoConverter * convert)
+{
+  const GstVideoFormatInfo *in_finfo = convert->in_info.finfo;
+  const GstVideoFormatInfo *out_finfo = convert->out_info.finfo;
+  gint i, n_planes, pstride;
+
+  n_planes = GST_VIDEO_INFO_N_PLANES (&convert->out_info);
+
+  if (n_planes == 1 && !GST_VIDEO_FORMAT_INFO_IS_GRAY (out_finfo)) {
+    if (is_merge_yuv (&convert->in_info)) {
+      pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (out_finfo, GST_VIDEO_COMP_Y);
+      convert->fin_x[0] = GST_ROUND_UP_2 (convert->in_x) * pstride;
+      convert->fout_x[0] = GST_ROUND_UP_2 (convert->out_x) * pstride;
+    } else {
+      pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (out_finfo, GST_VIDEO_COMP_R);
+      convert->fin_x[0] = convert->in_x * pstride;
+      convert->fout_x[0] = convert->out_x * pstride;
+    }
+    convert->fin_y[0] = convert->in_y;
+    convert->fout_y[0] = convert->out_y;
+  } else {
+    for (i = 0; i < n_planes; i++) {
+      pstride = GST_VIDEO_FORMAT_INFO_PSTRIDE (out_finfo, i);
+      convert->fin_x[i] =
+          GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (in_finfo, i, convert->in_x);
+      convert->fin_x[i] *= pstride;
+      convert->fin_y[i] =
+          GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (in_finfo, i, convert->in_y);
+      convert->fout_x[i] =
+          GST_VIDEO_FORMAT_INFO_SCALE_WIDTH (out_finfo, i, convert->out_x);
+      convert->fout_x[i] *= pstride;
+      convert->fout_y[i] =
+          GST_VIDEO_FORMAT_INFO_SCALE_HEIGHT (out_finfo, i, convert->out_y);
+    }
+  }
+}
+
 static gboolean
 setup_scale (GstVideoConverter * convert)
 {
@@ -6464,7 +7104,21 @@ static const VideoTransform transforms[] = {
   {GST_VIDEO_FORMAT_YVU9, GST_VIDEO_FORMAT_YVU9, FALSE, FALSE, FALSE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
 
+  /* planar <-> semiplanar */
+  {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_NV12},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_I420, TRUE, FALSE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_YV12, TRUE, FALSE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_NV12_I420},
+
   /* sempiplanar -> semiplanar */
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+  {GST_VIDEO_FORMAT_P010_10LE, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 0, 0, convert_P010_NV12},
+#endif
   {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_NV12, TRUE, FALSE, FALSE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_scale_planes},
   {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_NV16, TRUE, FALSE, FALSE, TRUE,
@@ -6519,6 +7173,12 @@ static const VideoTransform transforms[] = {
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_BGRA},
   {GST_VIDEO_FORMAT_YV12, GST_VIDEO_FORMAT_BGRx, FALSE, TRUE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_BGRA},
+#if G_BYTE_ORDER == G_LITTLE_ENDIAN
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_BGRA, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 1, 0, convert_NV12_BGRA},
+  {GST_VIDEO_FORMAT_NV12, GST_VIDEO_FORMAT_BGRx, FALSE, TRUE, TRUE, TRUE,
+      TRUE, FALSE, FALSE, FALSE, 1, 0, convert_NV12_BGRA},
+#endif
 
   {GST_VIDEO_FORMAT_I420, GST_VIDEO_FORMAT_ARGB, FALSE, TRUE, TRUE, TRUE,
       TRUE, FALSE, FALSE, FALSE, 0, 0, convert_I420_ARGB},
@@ -6640,6 +7300,10 @@ video_converter_lookup_fastpath (GstVideoConverter * convert)
   if (GET_OPT_DITHER_QUANTIZATION (convert) != 1)
     return FALSE;
 
+  /* deinterlacing is only done in the generic chain */
+  if (convert->deinterlace_method != GST_VIDEO_DEINTERLACE_METHOD_NONE)
+    return FALSE;
+
   /* we don't do gamma conversion in fastpath */
   in_transf = convert->in_info.colorimetry.transfer;
   out_transf = convert->out_info.colorimetry.transfer;
@@ -6688,6 +7352,18 @@ video_converter_lookup_fastpath (GstVideoConverter * convert)
       || convert->out_width < convert->out_maxwidth
       || convert->out_height < convert->out_maxheight;
 
+  /* identity conversions degenerate to a per-plane copy of the cropped
+   * region, without the unpack/pack round trip */
+  if (in_format == out_format && same_size && same_matrix && same_primaries
+      && !need_set && !need_mult
+      && video_converter_can_copy_planes (convert)) {
+    GST_DEBUG ("using plane copy fastpath");
+    convert->convert = convert_plane_copy;
+    if (border)
+      setup_borderline (convert);
+    return TRUE;
+  }
+
   for (i = 0; i < sizeof (transforms) / sizeof (transforms[0]); i++) {
     if (transforms[i].in_format == in_format &&
         transforms[i].out_format == out_format &&
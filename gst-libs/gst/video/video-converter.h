@@ -265,6 +265,39 @@ typedef enum {
  */
 #define GST_VIDEO_CONVERTER_OPT_PRIMARIES_MODE   "GstVideoConverter.primaries-mode"
 
+/**
+ * GstVideoDeinterlaceMethod:
+ * @GST_VIDEO_DEINTERLACE_METHOD_NONE: no deinterlacing, converting an
+ *	  interlaced input to a progressive output is refused
+ * @GST_VIDEO_DEINTERLACE_METHOD_WEAVE: keep both fields woven together in
+ *	  one frame. The pixel data is passed through unchanged, which is
+ *	  only suitable for static content
+ * @GST_VIDEO_DEINTERLACE_METHOD_BOB: duplicate the lines of the dominant
+ *	  field over the lines of the other field
+ * @GST_VIDEO_DEINTERLACE_METHOD_BLEND: blend each line with the field
+ *	  lines directly above and below it
+ *
+ * Different methods for converting interlaced input to progressive output.
+ *
+ * Since: 1.14
+ */
+typedef enum {
+  GST_VIDEO_DEINTERLACE_METHOD_NONE,
+  GST_VIDEO_DEINTERLACE_METHOD_WEAVE,
+  GST_VIDEO_DEINTERLACE_METHOD_BOB,
+  GST_VIDEO_DEINTERLACE_METHOD_BLEND
+} GstVideoDeinterlaceMethod;
+/**
+ * GST_VIDEO_CONVERTER_OPT_DEINTERLACE_METHOD:
+ *
+ * #GST_TYPE_VIDEO_DEINTERLACE_METHOD, set the deinterlace method to use when
+ * the input is interlaced and the output is progressive.
+ * Default is #GST_VIDEO_DEINTERLACE_METHOD_NONE.
+ *
+ * Since: 1.14
+ */
+#define GST_VIDEO_CONVERTER_OPT_DEINTERLACE_METHOD   "GstVideoConverter.deinterlace-method"
+
 /**
  * GST_VIDEO_CONVERTER_OPT_THREADS:
  *
@@ -293,6 +326,12 @@ GST_EXPORT
 void                 gst_video_converter_frame          (GstVideoConverter * convert,
                                                          const GstVideoFrame *src, GstVideoFrame *dest);
 
+GST_EXPORT
+void                 gst_video_converter_frame_region   (GstVideoConverter * convert,
+                                                         const GstVideoFrame *src, GstVideoFrame *dest,
+                                                         gint src_x, gint src_y,
+                                                         gint dest_x, gint dest_y);
+
 
 G_END_DECLS
 
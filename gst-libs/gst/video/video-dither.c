@@ -18,6 +18,7 @@
  */
 
 #include <string.h>
+#include <math.h>
 
 #include "video-dither.h"
 #include "video-orc.h"
@@ -277,6 +278,93 @@ dither_ordered_u16_mask (GstVideoDither * dither, gpointer pixels, guint x,
   video_orc_dither_ordered_4u16_mask (p, c, dither->orc_mask64, width);
 }
 
+/* A 64x64 blue-noise threshold matrix, generated once at runtime with a
+ * greedy void-and-cluster style ranking: each rank goes to the cell with
+ * the lowest accumulated energy and then splats a toroidal gaussian
+ * around itself. Unlike the bayer matrix there is no visible regular
+ * structure, and like it there is no serial error state so lines can be
+ * dithered independently. */
+#define BLUE_NOISE_SIZE 64
+
+static guint8 blue_noise_map[BLUE_NOISE_SIZE][BLUE_NOISE_SIZE];
+
+static void
+ensure_blue_noise_map (void)
+{
+  static gsize init = 0;
+
+  if (g_once_init_enter (&init)) {
+    const gint n = BLUE_NOISE_SIZE * BLUE_NOISE_SIZE;
+    const gdouble sigma2 = 2 * 1.9 * 1.9;
+    gdouble *energy = g_new0 (gdouble, n);
+    gboolean *taken = g_new0 (gboolean, n);
+    gint rank, i, dx, dy;
+
+    for (rank = 0; rank < n; rank++) {
+      gint best = -1;
+      gdouble best_energy = G_MAXDOUBLE;
+      gint bx, by;
+
+      for (i = 0; i < n; i++) {
+        if (!taken[i] && energy[i] < best_energy) {
+          best_energy = energy[i];
+          best = i;
+        }
+      }
+      taken[best] = TRUE;
+      bx = best % BLUE_NOISE_SIZE;
+      by = best / BLUE_NOISE_SIZE;
+      blue_noise_map[by][bx] = rank / (n / 256);
+
+      for (dy = -8; dy <= 8; dy++) {
+        gint yy = (by + dy) & (BLUE_NOISE_SIZE - 1);
+
+        for (dx = -8; dx <= 8; dx++) {
+          gint xx = (bx + dx) & (BLUE_NOISE_SIZE - 1);
+
+          energy[yy * BLUE_NOISE_SIZE + xx] +=
+              exp (-(dx * dx + dy * dy) / sigma2);
+        }
+      }
+    }
+    g_free (energy);
+    g_free (taken);
+
+    g_once_init_leave (&init, 1);
+  }
+}
+
+static void
+dither_blue_noise_u8 (GstVideoDither * dither, gpointer pixels, guint x,
+    guint y, guint width)
+{
+  guint8 *p = pixels;
+  guint8 *c = (guint8 *) dither->errors +
+      (((y & 63) * width + (x & 63)) * 4);
+
+  video_orc_dither_ordered_u8 (p, c, width * 4);
+}
+
+static void
+dither_blue_noise_u8_mask (GstVideoDither * dither, gpointer pixels, guint x,
+    guint y, guint width)
+{
+  guint8 *p = pixels;
+  guint16 *c = (guint16 *) dither->errors + ((y & 63) * width + (x & 63)) * 4;
+
+  video_orc_dither_ordered_4u8_mask (p, c, dither->orc_mask64, width);
+}
+
+static void
+dither_blue_noise_u16_mask (GstVideoDither * dither, gpointer pixels, guint x,
+    guint y, guint width)
+{
+  guint16 *p = pixels;
+  guint16 *c = (guint16 *) dither->errors + ((y & 63) * width + (x & 63)) * 4;
+
+  video_orc_dither_ordered_4u16_mask (p, c, dither->orc_mask64, width);
+}
+
 static void
 alloc_errors (GstVideoDither * dither, guint lines)
 {
@@ -340,6 +428,60 @@ setup_bayer (GstVideoDither * dither)
   }
 }
 
+static void
+setup_blue_noise (GstVideoDither * dither)
+{
+  guint i, j, k, width, n_comp, errdepth;
+  guint8 *shift;
+
+  width = dither->width;
+  shift = dither->shift;
+  n_comp = dither->n_comp;
+
+  ensure_blue_noise_map ();
+
+  if (dither->depth == 8) {
+    if (dither->flags & GST_VIDEO_DITHER_FLAG_QUANTIZE) {
+      dither->func = dither_blue_noise_u8_mask;
+      errdepth = 16;
+    } else {
+      dither->func = dither_blue_noise_u8;
+      errdepth = 8;
+    }
+  } else {
+    dither->func = dither_blue_noise_u16_mask;
+    errdepth = 16;
+  }
+
+  alloc_errors (dither, BLUE_NOISE_SIZE);
+
+  if (errdepth == 8) {
+    for (i = 0; i < BLUE_NOISE_SIZE; i++) {
+      guint8 *p = (guint8 *) dither->errors + (n_comp * width * i), v;
+      for (j = 0; j < width; j++) {
+        for (k = 0; k < n_comp; k++) {
+          v = blue_noise_map[i][j & 63];
+          if (shift[k] < 8)
+            v = v >> (8 - shift[k]);
+          p[n_comp * j + k] = v;
+        }
+      }
+    }
+  } else {
+    for (i = 0; i < BLUE_NOISE_SIZE; i++) {
+      guint16 *p = (guint16 *) dither->errors + (n_comp * width * i), v;
+      for (j = 0; j < width; j++) {
+        for (k = 0; k < n_comp; k++) {
+          v = blue_noise_map[i][j & 63];
+          if (shift[k] < 8)
+            v = v >> (8 - shift[k]);
+          p[n_comp * j + k] = v;
+        }
+      }
+    }
+  }
+}
+
 static gint
 count_power (guint v)
 {
@@ -451,6 +593,9 @@ gst_video_dither_new (GstVideoDitherMethod method, GstVideoDitherFlags flags,
     case GST_VIDEO_DITHER_BAYER:
       setup_bayer (dither);
       break;
+    case GST_VIDEO_DITHER_BLUE_NOISE:
+      setup_blue_noise (dither);
+      break;
   }
   return dither;
 }
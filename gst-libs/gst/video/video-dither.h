@@ -31,6 +31,10 @@ G_BEGIN_DECLS
  * @GST_VIDEO_DITHER_FLOYD_STEINBERG: Dither with floyd-steinberg error diffusion
  * @GST_VIDEO_DITHER_SIERRA_LITE: Dither with Sierra Lite error diffusion
  * @GST_VIDEO_DITHER_BAYER: ordered dither using a bayer pattern
+ * @GST_VIDEO_DITHER_BLUE_NOISE: ordered dither using a precomputed blue-noise
+ *    pattern. Like the bayer pattern there is no serial error propagation, so
+ *    lines can be dithered in parallel, but without the regular structure of
+ *    the bayer matrix. (Since: 1.14)
  *
  * Different dithering methods to use.
  */
@@ -40,6 +44,7 @@ typedef enum {
   GST_VIDEO_DITHER_FLOYD_STEINBERG,
   GST_VIDEO_DITHER_SIERRA_LITE,
   GST_VIDEO_DITHER_BAYER,
+  GST_VIDEO_DITHER_BLUE_NOISE,
 } GstVideoDitherMethod;
 
 /**
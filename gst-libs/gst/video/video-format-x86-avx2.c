@@ -0,0 +1,178 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-format-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+/* Store two 128-bit halves as one unaligned 256-bit store */
+static inline void
+store_2x128 (guint8 * d, __m128i lo, __m128i hi)
+{
+  _mm256_storeu_si256 ((__m256i *) d,
+      _mm256_inserti128_si256 (_mm256_castsi128_si256 (lo), hi, 1));
+}
+
+/* Interleave one line of 4:2:0 into AYUV. yv holds 16 luma samples, uv
+ * holds the 8 corresponding U0V0..U7V7 chroma byte pairs, each shared by
+ * two pixels. */
+static inline void
+unpack_420_16pix (guint8 * d, __m128i yv, __m128i uv)
+{
+  const __m128i aa = _mm_set1_epi8 ((char) 0xff);
+  __m128i ay_lo, ay_hi, uv_lo, uv_hi;
+
+  ay_lo = _mm_unpacklo_epi8 (aa, yv);
+  ay_hi = _mm_unpackhi_epi8 (aa, yv);
+  uv_lo = _mm_unpacklo_epi16 (uv, uv);
+  uv_hi = _mm_unpackhi_epi16 (uv, uv);
+
+  store_2x128 (d + 0,
+      _mm_unpacklo_epi16 (ay_lo, uv_lo), _mm_unpackhi_epi16 (ay_lo, uv_lo));
+  store_2x128 (d + 32,
+      _mm_unpacklo_epi16 (ay_hi, uv_hi), _mm_unpackhi_epi16 (ay_hi, uv_hi));
+}
+
+void
+video_format_avx2_unpack_I420 (guint8 * d, const guint8 * sy,
+    const guint8 * su, const guint8 * sv, gint width)
+{
+  gint i = 0;
+
+  for (; i + 16 <= width; i += 16) {
+    __m128i yv = _mm_loadu_si128 ((const __m128i *) (sy + i));
+    __m128i uu = _mm_loadl_epi64 ((const __m128i *) (su + (i >> 1)));
+    __m128i vv = _mm_loadl_epi64 ((const __m128i *) (sv + (i >> 1)));
+
+    unpack_420_16pix (d + i * 4, yv, _mm_unpacklo_epi8 (uu, vv));
+  }
+  for (; i < width; i++) {
+    d[i * 4 + 0] = 0xff;
+    d[i * 4 + 1] = sy[i];
+    d[i * 4 + 2] = su[i >> 1];
+    d[i * 4 + 3] = sv[i >> 1];
+  }
+}
+
+void
+video_format_avx2_unpack_NV12 (guint8 * d, const guint8 * sy,
+    const guint8 * suv, gint width)
+{
+  gint i = 0;
+
+  for (; i + 16 <= width; i += 16) {
+    __m128i yv = _mm_loadu_si128 ((const __m128i *) (sy + i));
+    __m128i uv = _mm_loadu_si128 ((const __m128i *) (suv + i));
+
+    unpack_420_16pix (d + i * 4, yv, uv);
+  }
+  for (; i < width; i++) {
+    d[i * 4 + 0] = 0xff;
+    d[i * 4 + 1] = sy[i];
+    d[i * 4 + 2] = suv[i & ~1];
+    d[i * 4 + 3] = suv[(i & ~1) + 1];
+  }
+}
+
+/* BGRA <-> ARGB is a byte reversal inside every 32-bit pixel, in both
+ * directions */
+static inline void
+swizzle_reverse4 (guint8 * d, const guint8 * s, gint width)
+{
+  const __m256i mask = _mm256_set_epi8 (
+      12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3,
+      12, 13, 14, 15, 8, 9, 10, 11, 4, 5, 6, 7, 0, 1, 2, 3);
+  gint i = 0;
+
+  for (; i + 8 <= width; i += 8) {
+    __m256i t = _mm256_loadu_si256 ((const __m256i *) (s + i * 4));
+    _mm256_storeu_si256 ((__m256i *) (d + i * 4),
+        _mm256_shuffle_epi8 (t, mask));
+  }
+  for (; i < width; i++) {
+    d[i * 4 + 0] = s[i * 4 + 3];
+    d[i * 4 + 1] = s[i * 4 + 2];
+    d[i * 4 + 2] = s[i * 4 + 1];
+    d[i * 4 + 3] = s[i * 4 + 0];
+  }
+}
+
+void
+video_format_avx2_unpack_BGRA (guint8 * d, const guint8 * s, gint width)
+{
+  swizzle_reverse4 (d, s, width);
+}
+
+void
+video_format_avx2_pack_BGRA (guint8 * d, const guint8 * s, gint width)
+{
+  swizzle_reverse4 (d, s, width);
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stubs so that the dispatch code in video-format.c always links; they are
+ * never called because video_format_avx2_available() returns FALSE. */
+
+void
+video_format_avx2_unpack_I420 (guint8 * d, const guint8 * sy,
+    const guint8 * su, const guint8 * sv, gint width)
+{
+  g_assert_not_reached ();
+}
+
+void
+video_format_avx2_unpack_NV12 (guint8 * d, const guint8 * sy,
+    const guint8 * suv, gint width)
+{
+  g_assert_not_reached ();
+}
+
+void
+video_format_avx2_unpack_BGRA (guint8 * d, const guint8 * s, gint width)
+{
+  g_assert_not_reached ();
+}
+
+void
+video_format_avx2_pack_BGRA (guint8 * d, const guint8 * s, gint width)
+{
+  g_assert_not_reached ();
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+video_format_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
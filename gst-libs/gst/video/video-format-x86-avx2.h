@@ -0,0 +1,36 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_FORMAT_X86_AVX2_H
+#define VIDEO_FORMAT_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the avx2 kernels below were compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean video_format_avx2_available (void);
+
+void video_format_avx2_unpack_I420 (guint8 * d, const guint8 * sy,
+    const guint8 * su, const guint8 * sv, gint width);
+void video_format_avx2_unpack_NV12 (guint8 * d, const guint8 * sy,
+    const guint8 * suv, gint width);
+void video_format_avx2_unpack_BGRA (guint8 * d, const guint8 * s, gint width);
+void video_format_avx2_pack_BGRA (guint8 * d, const guint8 * s, gint width);
+
+#endif /* VIDEO_FORMAT_X86_AVX2_H */
@@ -29,6 +29,15 @@
 #include "video-format.h"
 #include "video-orc.h"
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "video-format-x86-avx2.h"
+
+/* set up once in gst_video_format_get_info() */
+static gboolean video_format_use_avx2 = FALSE;
+#endif
+
 #ifndef restrict
 #if defined(__STDC_VERSION__) && __STDC_VERSION__ >= 199901L
 /* restrict should be available */
@@ -110,6 +119,12 @@ unpack_planar_420 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     width--;
     d += 4;
   }
+#ifdef CHECK_X86
+  if (video_format_use_avx2) {
+    video_format_avx2_unpack_I420 (d, sy, su, sv, width);
+    return;
+  }
+#endif
   video_orc_unpack_I420 (d, sy, su, sv, width);
 }
 
@@ -1304,6 +1319,12 @@ unpack_BGRA (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
 
   s += x * 4;
 
+#ifdef CHECK_X86
+  if (video_format_use_avx2) {
+    video_format_avx2_unpack_BGRA (dest, s, width);
+    return;
+  }
+#endif
   video_orc_unpack_BGRA (dest, s, width);
 }
 
@@ -1315,6 +1336,12 @@ pack_BGRA (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
 {
   guint8 *restrict d = GET_LINE (y);
 
+#ifdef CHECK_X86
+  if (video_format_use_avx2) {
+    video_format_avx2_pack_BGRA (d, src, width);
+    return;
+  }
+#endif
   video_orc_pack_BGRA (d, src, width);
 }
 
@@ -1464,6 +1491,12 @@ unpack_NV12 (const GstVideoFormatInfo * info, GstVideoPackFlags flags,
     suv += 2;
   }
 
+#ifdef CHECK_X86
+  if (video_format_use_avx2) {
+    video_format_avx2_unpack_NV12 (d, sy, suv, width);
+    return;
+  }
+#endif
   if (IS_ALIGNED (d, 8))
     video_orc_unpack_NV12 (d, sy, suv, width / 2);
   else {
@@ -5153,6 +5186,17 @@ gst_video_format_to_string (GstVideoFormat format)
 const GstVideoFormatInfo *
 gst_video_format_get_info (GstVideoFormat format)
 {
+#ifdef CHECK_X86
+  static gsize simd_once = 0;
+
+  if (g_once_init_enter (&simd_once)) {
+    video_format_use_avx2 = video_format_avx2_available ();
+    GST_DEBUG ("AVX2 pack/unpack kernels %s",
+        video_format_use_avx2 ? "enabled" : "not available");
+    g_once_init_leave (&simd_once, 1);
+  }
+#endif
+
   g_return_val_if_fail ((gint) format < G_N_ELEMENTS (formats), NULL);
 
   return &formats[format].info;
@@ -0,0 +1,95 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include <string.h>
+
+#include "video-frame-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+/* Copy one line with streaming stores. The destination must be written
+ * 32-byte aligned, so the unaligned head and tail go through memcpy and
+ * stay in the cache; that's at most 62 bytes per line. */
+static inline void
+copy_line_nt (guint8 * dp, const guint8 * sp, gsize width)
+{
+  gsize head = MIN ((gsize) (-(guintptr) dp & 31), width);
+  gsize i;
+
+  memcpy (dp, sp, head);
+  dp += head;
+  sp += head;
+  width -= head;
+
+  for (i = 0; i + 32 <= width; i += 32) {
+    __m256i t = _mm256_loadu_si256 ((const __m256i *) (sp + i));
+
+    _mm256_stream_si256 ((__m256i *) (dp + i), t);
+  }
+  memcpy (dp + i, sp + i, width - i);
+}
+
+void
+video_frame_avx2_copy_plane_nt (guint8 * dp, gint ds, const guint8 * sp,
+    gint ss, gint width, gint height)
+{
+  gint j;
+
+  for (j = 0; j < height; j++) {
+    copy_line_nt (dp, sp, width);
+    dp += ds;
+    sp += ss;
+  }
+  /* make the streaming stores visible to other cores before the buffer
+   * is handed downstream */
+  _mm_sfence ();
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stub so that the dispatch code in video-frame.c always links; it is
+ * never called because video_frame_avx2_available() returns FALSE. */
+
+void
+video_frame_avx2_copy_plane_nt (guint8 * dp, gint ds, const guint8 * sp,
+    gint ss, gint width, gint height)
+{
+  g_assert_not_reached ();
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+video_frame_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
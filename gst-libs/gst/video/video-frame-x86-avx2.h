@@ -0,0 +1,34 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_FRAME_X86_AVX2_H
+#define VIDEO_FRAME_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the copy kernel below was compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean video_frame_avx2_available (void);
+
+/* Plane copy with non-temporal stores, bypassing the caches. Only
+ * worthwhile for planes much bigger than the LLC working set. */
+void video_frame_avx2_copy_plane_nt (guint8 * dp, gint ds, const guint8 * sp,
+    gint ss, gint width, gint height);
+
+#endif /* VIDEO_FRAME_X86_AVX2_H */
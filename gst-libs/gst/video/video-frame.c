@@ -31,6 +31,16 @@
 #include "video-tile.h"
 #include "gstvideometa.h"
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "video-frame-x86-avx2.h"
+
+/* use streaming stores for planes that would trash a sizable part of
+ * the LLC anyway */
+#define NT_COPY_THRESHOLD (512 * 1024)
+#endif
+
 #define CAT_PERFORMANCE video_frame_get_perf_category()
 
 static inline GstDebugCategory *
@@ -62,7 +72,9 @@ video_frame_get_perf_category (void)
  * will return %FALSE when there is no GstVideoMeta with that id.
  *
  * All video planes of @buffer will be mapped and the pointers will be set in
- * @frame->data.
+ * @frame->data, unless @flags contains #GST_VIDEO_FRAME_MAP_FLAG_LAZY; in
+ * that case planes are only mapped when first accessed with
+ * gst_video_frame_map_plane().
  *
  * Returns: %TRUE on success.
  */
@@ -100,7 +112,13 @@ gst_video_frame_map_id (GstVideoFrame * frame, GstVideoInfo * info,
 
     for (i = 0; i < meta->n_planes; i++) {
       frame->info.offset[i] = meta->offset[i];
-      if (!gst_video_meta_map (meta, i, &frame->map[i], &frame->data[i],
+      if (flags & GST_VIDEO_FRAME_MAP_FLAG_LAZY) {
+        /* plane is mapped on first gst_video_frame_map_plane(), just
+         * remember the flags for later */
+        frame->data[i] = NULL;
+        memset (&frame->map[i], 0, sizeof (GstMapInfo));
+        frame->map[i].flags = flags;
+      } else if (!gst_video_meta_map (meta, i, &frame->map[i], &frame->data[i],
               &frame->info.stride[i], flags))
         goto frame_map_failed;
     }
@@ -113,16 +131,23 @@ gst_video_frame_map_id (GstVideoFrame * frame, GstVideoInfo * info,
     frame->id = id;
     frame->flags = 0;
 
-    if (!gst_buffer_map (buffer, &frame->map[0], flags))
-      goto map_failed;
-
-    /* do some sanity checks */
-    if (frame->map[0].size < info->size)
-      goto invalid_size;
-
-    /* set up pointers */
-    for (i = 0; i < info->finfo->n_planes; i++) {
-      frame->data[i] = frame->map[0].data + info->offset[i];
+    if (flags & GST_VIDEO_FRAME_MAP_FLAG_LAZY) {
+      for (i = 0; i < info->finfo->n_planes; i++)
+        frame->data[i] = NULL;
+      memset (&frame->map[0], 0, sizeof (GstMapInfo));
+      frame->map[0].flags = flags;
+    } else {
+      if (!gst_buffer_map (buffer, &frame->map[0], flags))
+        goto map_failed;
+
+      /* do some sanity checks */
+      if (frame->map[0].size < info->size)
+        goto invalid_size;
+
+      /* set up pointers */
+      for (i = 0; i < info->finfo->n_planes; i++) {
+        frame->data[i] = frame->map[0].data + info->offset[i];
+      }
     }
   }
   frame->buffer = buffer;
@@ -239,6 +264,79 @@ gst_video_frame_map (GstVideoFrame * frame, GstVideoInfo * info,
   return gst_video_frame_map_id (frame, info, buffer, -1, flags);
 }
 
+/**
+ * gst_video_frame_map_plane:
+ * @frame: a #GstVideoFrame mapped with #GST_VIDEO_FRAME_MAP_FLAG_LAZY
+ * @plane: a plane
+ *
+ * Map plane @plane of @frame and set up the data pointer. Does nothing
+ * when the plane was mapped before, so it is safe to call this from the
+ * accessing code directly before each use.
+ *
+ * When @frame has no #GstVideoMeta, the underlying buffer can only be
+ * mapped as a whole; the first call maps it and sets up the data
+ * pointers of all planes at once.
+ *
+ * Returns: %TRUE when the plane is mapped in @frame.
+ *
+ * Since: 1.14
+ */
+gboolean
+gst_video_frame_map_plane (GstVideoFrame * frame, guint plane)
+{
+  GstVideoMeta *meta;
+  GstMapFlags flags;
+  gint i;
+
+  g_return_val_if_fail (frame != NULL, FALSE);
+  g_return_val_if_fail (GST_IS_BUFFER (frame->buffer), FALSE);
+  g_return_val_if_fail (plane < frame->info.finfo->n_planes, FALSE);
+
+  meta = frame->meta;
+
+  if (meta) {
+    if (frame->map[plane].memory != NULL)
+      return TRUE;
+
+    flags = frame->map[plane].flags;
+    if (!gst_video_meta_map (meta, plane, &frame->map[plane],
+            &frame->data[plane], &frame->info.stride[plane], flags))
+      goto map_failed;
+  } else {
+    if (frame->map[0].memory != NULL)
+      return TRUE;
+
+    flags = frame->map[0].flags;
+    if (!gst_buffer_map (frame->buffer, &frame->map[0], flags))
+      goto map_failed;
+
+    if (frame->map[0].size < frame->info.size)
+      goto invalid_size;
+
+    /* one mapping covers all planes */
+    for (i = 0; i < frame->info.finfo->n_planes; i++) {
+      frame->data[i] = frame->map[0].data + frame->info.offset[i];
+    }
+  }
+  return TRUE;
+
+  /* ERRORS */
+map_failed:
+  {
+    GST_ERROR ("failed to map video frame plane %d", plane);
+    return FALSE;
+  }
+invalid_size:
+  {
+    GST_ERROR ("invalid buffer size %" G_GSIZE_FORMAT " < %" G_GSIZE_FORMAT,
+        frame->map[0].size, frame->info.size);
+    gst_buffer_unmap (frame->buffer, &frame->map[0]);
+    memset (&frame->map[0], 0, sizeof (GstMapInfo));
+    frame->map[0].flags = flags;
+    return FALSE;
+  }
+}
+
 /**
  * gst_video_frame_unmap:
  * @frame: a #GstVideoFrame
@@ -261,10 +359,15 @@ gst_video_frame_unmap (GstVideoFrame * frame)
 
   if (meta) {
     for (i = 0; i < frame->info.finfo->n_planes; i++) {
+      /* skip planes that were never mapped because of
+       * GST_VIDEO_FRAME_MAP_FLAG_LAZY */
+      if (frame->map[i].memory == NULL)
+        continue;
       gst_video_meta_unmap (meta, i, &frame->map[i]);
     }
   } else {
-    gst_buffer_unmap (buffer, &frame->map[0]);
+    if (frame->map[0].memory != NULL)
+      gst_buffer_unmap (buffer, &frame->map[0]);
   }
 
   if ((flags & GST_VIDEO_FRAME_MAP_FLAG_NO_REF) == 0)
@@ -371,10 +474,37 @@ gst_video_frame_copy_plane (GstVideoFrame * dest, const GstVideoFrame * src,
 
     GST_CAT_DEBUG (CAT_PERFORMANCE, "copy plane %d, w:%d h:%d ", plane, w, h);
 
-    for (j = 0; j < h; j++) {
+    if (ss == ds && (gint) w == ss) {
+      /* no padding between the lines, the plane is contiguous */
+      w *= h;
+      h = 1;
+    }
+
+#ifdef CHECK_X86
+    {
+      static gsize simd_once = 0;
+      static gboolean use_avx2 = FALSE;
+
+      if (g_once_init_enter (&simd_once)) {
+        use_avx2 = video_frame_avx2_available ();
+        g_once_init_leave (&simd_once, 1);
+      }
+
+      if (use_avx2 && (gsize) w * h >= NT_COPY_THRESHOLD) {
+        video_frame_avx2_copy_plane_nt (dp, ds, sp, ss, w, h);
+        return TRUE;
+      }
+    }
+#endif
+
+    if (h == 1) {
       memcpy (dp, sp, w);
-      dp += ds;
-      sp += ss;
+    } else {
+      for (j = 0; j < h; j++) {
+        memcpy (dp, sp, w);
+        dp += ds;
+        sp += ss;
+      }
     }
   }
 
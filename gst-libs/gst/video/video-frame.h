@@ -92,6 +92,9 @@ GST_EXPORT
 gboolean    gst_video_frame_map_id        (GstVideoFrame *frame, GstVideoInfo *info,
                                            GstBuffer *buffer, gint id, GstMapFlags flags);
 
+GST_EXPORT
+gboolean    gst_video_frame_map_plane     (GstVideoFrame *frame, guint plane);
+
 GST_EXPORT
 void        gst_video_frame_unmap         (GstVideoFrame *frame);
 
@@ -185,6 +188,11 @@ typedef enum {
  *                                    the GstVideoFrame. This makes sure that the buffer stays
  *                                    writable while the frame is mapped, but requires that the
  *                                    buffer reference stays valid until the frame is unmapped again.
+ * @GST_VIDEO_FRAME_MAP_FLAG_LAZY:    Don't map any planes yet. Planes are
+ *                                    mapped on demand with gst_video_frame_map_plane()
+ *                                    and the plane data pointers stay %NULL until
+ *                                    then. Unmapped planes are skipped by
+ *                                    gst_video_frame_unmap(). (Since: 1.14)
  * @GST_VIDEO_FRAME_MAP_FLAG_LAST:    Offset to define more flags
  *
  * Additional mapping flags for gst_video_frame_map().
@@ -193,6 +201,7 @@ typedef enum {
  */
 typedef enum {
   GST_VIDEO_FRAME_MAP_FLAG_NO_REF   = (GST_MAP_FLAG_LAST << 0),
+  GST_VIDEO_FRAME_MAP_FLAG_LAZY     = (GST_MAP_FLAG_LAST << 1),
   GST_VIDEO_FRAME_MAP_FLAG_LAST     = (GST_MAP_FLAG_LAST << 8)
   /* 8 more flags possible afterwards */
 } GstVideoFrameMapFlags;
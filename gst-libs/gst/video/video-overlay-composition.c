@@ -136,9 +136,17 @@ struct _GstVideoOverlayRectangle
    * pixel blobs */
   GMutex lock;
 
+  /* cached scaled/converted variants; the list is kept in LRU order and
+   * the hash table indexes it by (width, height, format, alpha type) */
   GList *scaled_rectangles;
+  GHashTable *scaled_index;
 };
 
+/* bound on the number of cached variants per rectangle; real pipelines
+ * only ever ask for a couple of (size, format, alpha type) combinations,
+ * so eviction only kicks in for pathological callers */
+#define MAX_SCALED_RECTANGLES 8
+
 #define GST_RECTANGLE_LOCK(rect)   g_mutex_lock(&rect->lock)
 #define GST_RECTANGLE_UNLOCK(rect) g_mutex_unlock(&rect->lock)
 
@@ -638,6 +646,8 @@ gst_video_overlay_rectangle_free (GstMiniObject * mini_obj)
     rect->scaled_rectangles =
         g_list_delete_link (rect->scaled_rectangles, rect->scaled_rectangles);
   }
+  if (rect->scaled_index != NULL)
+    g_hash_table_unref (rect->scaled_index);
 
   g_free (rect->initial_alpha);
   g_mutex_clear (&rect->lock);
@@ -661,6 +671,83 @@ gst_video_overlay_rectangle_is_same_alpha_type (GstVideoOverlayFormatFlags
       == 0;
 }
 
+static guint64
+gst_video_overlay_rectangle_cache_key (guint width, guint height,
+    GstVideoFormat format, GstVideoOverlayFormatFlags flags)
+{
+  return ((guint64) width << 42) | ((guint64) height << 20) |
+      ((guint64) format << 1) |
+      ((flags & GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA) ? 1 : 0);
+}
+
+/* with the rectangle lock. Moves a hit to the front of the LRU list. */
+static GstVideoOverlayRectangle *
+gst_video_overlay_rectangle_cache_lookup (GstVideoOverlayRectangle * rectangle,
+    guint width, guint height, GstVideoFormat format,
+    GstVideoOverlayFormatFlags flags)
+{
+  GstVideoOverlayRectangle *r;
+  guint64 key;
+
+  if (rectangle->scaled_index == NULL)
+    return NULL;
+
+  key = gst_video_overlay_rectangle_cache_key (width, height, format, flags);
+  r = g_hash_table_lookup (rectangle->scaled_index, &key);
+  if (r != NULL && rectangle->scaled_rectangles->data != r) {
+    rectangle->scaled_rectangles =
+        g_list_remove (rectangle->scaled_rectangles, r);
+    rectangle->scaled_rectangles =
+        g_list_prepend (rectangle->scaled_rectangles, r);
+  }
+  return r;
+}
+
+/* with the rectangle lock. Takes ownership of the caller's implicit ref on
+ * @r and evicts the least recently used variant over the bound. */
+static void
+gst_video_overlay_rectangle_cache_insert (GstVideoOverlayRectangle * rectangle,
+    GstVideoOverlayRectangle * r)
+{
+  GstVideoOverlayRectangle *old;
+  guint64 *key;
+
+  if (rectangle->scaled_index == NULL)
+    rectangle->scaled_index =
+        g_hash_table_new_full (g_int64_hash, g_int64_equal, g_free, NULL);
+
+  key = g_new (guint64, 1);
+  *key = gst_video_overlay_rectangle_cache_key (GST_VIDEO_INFO_WIDTH (&r->info),
+      GST_VIDEO_INFO_HEIGHT (&r->info), GST_VIDEO_INFO_FORMAT (&r->info),
+      r->flags);
+
+  /* racing insert of the same variant, drop the older one */
+  old = g_hash_table_lookup (rectangle->scaled_index, key);
+  if (old != NULL) {
+    rectangle->scaled_rectangles =
+        g_list_remove (rectangle->scaled_rectangles, old);
+    gst_video_overlay_rectangle_unref (old);
+  }
+  g_hash_table_replace (rectangle->scaled_index, key, r);
+  rectangle->scaled_rectangles =
+      g_list_prepend (rectangle->scaled_rectangles, r);
+
+  if (g_list_length (rectangle->scaled_rectangles) > MAX_SCALED_RECTANGLES) {
+    GList *last = g_list_last (rectangle->scaled_rectangles);
+    guint64 old_key;
+
+    old = last->data;
+    old_key =
+        gst_video_overlay_rectangle_cache_key (GST_VIDEO_INFO_WIDTH
+        (&old->info), GST_VIDEO_INFO_HEIGHT (&old->info),
+        GST_VIDEO_INFO_FORMAT (&old->info), old->flags);
+    g_hash_table_remove (rectangle->scaled_index, &old_key);
+    rectangle->scaled_rectangles =
+        g_list_delete_link (rectangle->scaled_rectangles, last);
+    gst_video_overlay_rectangle_unref (old);
+  }
+}
+
 
 /**
  * gst_video_overlay_rectangle_new_raw:
@@ -730,6 +817,7 @@ gst_video_overlay_rectangle_new_raw (GstBuffer * pixels,
 
   rect->pixels = gst_buffer_ref (pixels);
   rect->scaled_rectangles = NULL;
+  rect->scaled_index = NULL;
 
   gst_video_info_init (&rect->info);
   if (!gst_video_info_set_format (&rect->info, format, width, height)) {
@@ -1143,6 +1231,7 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
 {
   GstVideoOverlayFormatFlags new_flags;
   GstVideoOverlayRectangle *scaled_rect = NULL, *conv_rect = NULL;
+  GstVideoOverlayRectangle *src_rect;
   GstVideoInfo info;
   GstVideoFrame frame;
   GstBuffer *buf;
@@ -1190,19 +1279,10 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
 
   /* see if we've got one cached already */
   GST_RECTANGLE_LOCK (rectangle);
-  for (l = rectangle->scaled_rectangles; l != NULL; l = l->next) {
-    GstVideoOverlayRectangle *r = l->data;
-
-    if (GST_VIDEO_INFO_WIDTH (&r->info) == wanted_width &&
-        GST_VIDEO_INFO_HEIGHT (&r->info) == wanted_height &&
-        GST_VIDEO_INFO_FORMAT (&r->info) == wanted_format &&
-        gst_video_overlay_rectangle_is_same_alpha_type (r->flags, flags)) {
-      /* we'll keep these rectangles around until finalize, so it's ok not
-       * to take our own ref here */
-      scaled_rect = r;
-      break;
-    }
-  }
+  /* the cache keeps its own ref for as long as the variant is cached, so
+   * it's ok not to take our own ref here */
+  scaled_rect = gst_video_overlay_rectangle_cache_lookup (rectangle,
+      wanted_width, wanted_height, wanted_format, flags);
   GST_RECTANGLE_UNLOCK (rectangle);
 
   if (scaled_rect != NULL)
@@ -1242,8 +1322,7 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
     gst_buffer_unref (buf);
     /* keep this converted one around as well in any case */
     GST_RECTANGLE_LOCK (rectangle);
-    rectangle->scaled_rectangles =
-        g_list_prepend (rectangle->scaled_rectangles, conv_rect);
+    gst_video_overlay_rectangle_cache_insert (rectangle, conv_rect);
     GST_RECTANGLE_UNLOCK (rectangle);
   }
 
@@ -1251,17 +1330,34 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
   width = GST_VIDEO_INFO_WIDTH (&conv_rect->info);
   height = GST_VIDEO_INFO_HEIGHT (&conv_rect->info);
   format = GST_VIDEO_INFO_FORMAT (&conv_rect->info);
+  src_rect = conv_rect;
 
   /* not cached yet, do the preprocessing and put the result into our cache */
   if (wanted_width != width || wanted_height != height) {
-    GstVideoInfo scaled_info;
+    GstVideoOverlayRectangle *other;
 
-    /* we could check the cache for a scaled rect with global_alpha == 1 here */
-    gst_video_blend_scale_linear_RGBA (&conv_rect->info, conv_rect->pixels,
-        wanted_height, wanted_width, &scaled_info, &buf);
-    info = scaled_info;
-    gst_buffer_add_video_meta (buf, GST_VIDEO_FRAME_FLAG_NONE,
-        GST_VIDEO_INFO_FORMAT (&conv_rect->info), wanted_width, wanted_height);
+    /* if the other alpha variant was already scaled to this size then
+     * converting a copy of it is cheaper than scaling again */
+    GST_RECTANGLE_LOCK (rectangle);
+    other = gst_video_overlay_rectangle_cache_lookup (rectangle, wanted_width,
+        wanted_height, wanted_format,
+        flags ^ GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA);
+    GST_RECTANGLE_UNLOCK (rectangle);
+
+    if (other != NULL && other->applied_global_alpha == 1.0) {
+      buf = gst_buffer_copy (other->pixels);
+      info = other->info;
+      src_rect = other;
+    } else {
+      GstVideoInfo scaled_info;
+
+      gst_video_blend_scale_linear_RGBA (&conv_rect->info, conv_rect->pixels,
+          wanted_height, wanted_width, &scaled_info, &buf);
+      info = scaled_info;
+      gst_buffer_add_video_meta (buf, GST_VIDEO_FRAME_FLAG_NONE,
+          GST_VIDEO_INFO_FORMAT (&conv_rect->info), wanted_width,
+          wanted_height);
+    }
   } else if (!gst_video_overlay_rectangle_is_same_alpha_type (conv_rect->flags,
           flags)) {
     /* if we don't have to scale, we have to modify the alpha values, so we
@@ -1274,10 +1370,10 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
     goto done;
   }
 
-  new_flags = conv_rect->flags;
+  new_flags = src_rect->flags;
   gst_video_frame_map (&frame, &info, buf, GST_MAP_READWRITE);
-  if (!gst_video_overlay_rectangle_is_same_alpha_type (conv_rect->flags, flags)) {
-    if (rectangle->flags & GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA) {
+  if (!gst_video_overlay_rectangle_is_same_alpha_type (src_rect->flags, flags)) {
+    if (src_rect->flags & GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA) {
       gst_video_overlay_rectangle_unpremultiply (&frame);
       new_flags &= ~GST_VIDEO_OVERLAY_FORMAT_FLAG_PREMULTIPLIED_ALPHA;
     } else {
@@ -1289,14 +1385,13 @@ gst_video_overlay_rectangle_get_pixels_raw_internal (GstVideoOverlayRectangle *
 
   scaled_rect = gst_video_overlay_rectangle_new_raw (buf,
       0, 0, wanted_width, wanted_height, new_flags);
-  if (conv_rect->global_alpha != 1.0)
+  if (src_rect->global_alpha != 1.0)
     gst_video_overlay_rectangle_set_global_alpha (scaled_rect,
-        conv_rect->global_alpha);
+        src_rect->global_alpha);
   gst_buffer_unref (buf);
 
   GST_RECTANGLE_LOCK (rectangle);
-  rectangle->scaled_rectangles =
-      g_list_prepend (rectangle->scaled_rectangles, scaled_rect);
+  gst_video_overlay_rectangle_cache_insert (rectangle, scaled_rect);
   GST_RECTANGLE_UNLOCK (rectangle);
 
 done:
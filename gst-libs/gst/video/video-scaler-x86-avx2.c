@@ -0,0 +1,95 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "video-scaler-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+void
+video_scaler_avx2_resample_v_4tap_u8_lq (guint8 * d, const guint8 * s1,
+    const guint8 * s2, const guint8 * s3, const guint8 * s4,
+    gint p1, gint p2, gint p3, gint p4, gint count)
+{
+  const __m256i t1 = _mm256_set1_epi16 (p1);
+  const __m256i t2 = _mm256_set1_epi16 (p2);
+  const __m256i t3 = _mm256_set1_epi16 (p3);
+  const __m256i t4 = _mm256_set1_epi16 (p4);
+  const __m256i round = _mm256_set1_epi16 (32);
+  gint i = 0;
+
+  for (; i + 16 <= count; i += 16) {
+    __m256i x, sum;
+
+    x = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) (s1 + i)));
+    sum = _mm256_mullo_epi16 (x, t1);
+    x = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) (s2 + i)));
+    sum = _mm256_add_epi16 (sum, _mm256_mullo_epi16 (x, t2));
+    x = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) (s3 + i)));
+    sum = _mm256_add_epi16 (sum, _mm256_mullo_epi16 (x, t3));
+    x = _mm256_cvtepu8_epi16 (_mm_loadu_si128 ((const __m128i *) (s4 + i)));
+    sum = _mm256_add_epi16 (sum, _mm256_mullo_epi16 (x, t4));
+
+    sum = _mm256_srai_epi16 (_mm256_add_epi16 (sum, round), 6);
+
+    /* pack back to bytes with unsigned saturation */
+    _mm_storeu_si128 ((__m128i *) (d + i),
+        _mm_packus_epi16 (_mm256_castsi256_si128 (sum),
+            _mm256_extracti128_si256 (sum, 1)));
+  }
+  for (; i < count; i++) {
+    gint sum = s1[i] * p1 + s2[i] * p2 + s3[i] * p3 + s4[i] * p4;
+
+    sum = (sum + 32) >> 6;
+    d[i] = CLAMP (sum, 0, 255);
+  }
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stub so that the dispatch code in video-scaler.c always links; it is
+ * never called because video_scaler_avx2_available() returns FALSE. */
+
+void
+video_scaler_avx2_resample_v_4tap_u8_lq (guint8 * d, const guint8 * s1,
+    const guint8 * s2, const guint8 * s3, const guint8 * s4,
+    gint p1, gint p2, gint p3, gint p4, gint count)
+{
+  g_assert_not_reached ();
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+video_scaler_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
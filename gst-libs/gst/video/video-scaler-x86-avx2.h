@@ -0,0 +1,35 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef VIDEO_SCALER_X86_AVX2_H
+#define VIDEO_SCALER_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the avx2 kernels below were compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean video_scaler_avx2_available (void);
+
+/* 4-tap vertical resampling with 6-bit (SCALE_U8_LQ) coefficients,
+ * equivalent to video_orc_resample_v_4tap_u8_lq */
+void video_scaler_avx2_resample_v_4tap_u8_lq (guint8 * d, const guint8 * s1,
+    const guint8 * s2, const guint8 * s3, const guint8 * s4,
+    gint p1, gint p2, gint p3, gint p4, gint count);
+
+#endif /* VIDEO_SCALER_X86_AVX2_H */
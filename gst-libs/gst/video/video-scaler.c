@@ -67,6 +67,15 @@ ensure_debug_category (void)
 #define ensure_debug_category() /* NOOP */
 #endif /* GST_DISABLE_GST_DEBUG */
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "video-scaler-x86-avx2.h"
+
+/* set up once in gst_video_scaler_new() */
+static gboolean video_scaler_use_avx2 = FALSE;
+#endif
+
 #define SCALE_U8          12
 #define SCALE_U8_ROUND    (1 << (SCALE_U8 -1))
 #define SCALE_U8_LQ       6
@@ -105,6 +114,162 @@ struct _GstVideoScaler
   gpointer tmpline2;
 };
 
+/* Process-wide cache of computed coefficient tables so that converters
+ * and scalers doing the same conversion don't all recompute them. Keyed
+ * by everything that influences the table. Entries hold a private deep
+ * copy that gets copied out on a hit, so the normal ownership and
+ * clear/free paths of GstVideoScaler are unchanged. */
+typedef struct
+{
+  GstVideoResamplerMethod method;
+  GstVideoScalerFlags flags;
+  guint n_taps;
+  guint in_size;
+  guint out_size;
+} ScalerCacheKey;
+
+typedef struct
+{
+  ScalerCacheKey key;
+  GstVideoResampler resampler;
+  guint64 age;
+} ScalerCacheEntry;
+
+#define DEFAULT_CACHE_LIMIT 16
+
+static GMutex scaler_cache_lock;
+static GHashTable *scaler_cache;        /* ScalerCacheKey -> ScalerCacheEntry */
+static guint scaler_cache_limit = DEFAULT_CACHE_LIMIT;
+static guint64 scaler_cache_age;
+
+static guint
+scaler_cache_key_hash (gconstpointer data)
+{
+  const ScalerCacheKey *key = data;
+
+  return key->method ^ (key->flags << 4) ^ (key->n_taps << 8) ^
+      (key->in_size << 12) ^ (key->out_size << 22);
+}
+
+static gboolean
+scaler_cache_key_equal (gconstpointer a, gconstpointer b)
+{
+  return memcmp (a, b, sizeof (ScalerCacheKey)) == 0;
+}
+
+static void
+resampler_copy (GstVideoResampler * dest, const GstVideoResampler * src)
+{
+  *dest = *src;
+  dest->offset = g_memdup (src->offset, sizeof (guint32) * src->out_size);
+  dest->phase = g_memdup (src->phase, sizeof (guint32) * src->n_phases);
+  dest->n_taps = g_memdup (src->n_taps, sizeof (guint32) * src->out_size);
+  dest->taps =
+      g_memdup (src->taps, sizeof (gdouble) * src->max_taps * src->n_phases);
+}
+
+static void
+scaler_cache_entry_free (gpointer data)
+{
+  ScalerCacheEntry *entry = data;
+
+  gst_video_resampler_clear (&entry->resampler);
+  g_slice_free (ScalerCacheEntry, entry);
+}
+
+static gboolean
+scaler_cache_lookup (const ScalerCacheKey * key, GstVideoResampler * resampler)
+{
+  ScalerCacheEntry *entry;
+  gboolean found = FALSE;
+
+  g_mutex_lock (&scaler_cache_lock);
+  if (scaler_cache && (entry = g_hash_table_lookup (scaler_cache, key))) {
+    resampler_copy (resampler, &entry->resampler);
+    entry->age = ++scaler_cache_age;
+    found = TRUE;
+  }
+  g_mutex_unlock (&scaler_cache_lock);
+
+  return found;
+}
+
+static void
+scaler_cache_store (const ScalerCacheKey * key,
+    const GstVideoResampler * resampler)
+{
+  ScalerCacheEntry *entry;
+
+  g_mutex_lock (&scaler_cache_lock);
+  if (scaler_cache_limit == 0)
+    goto done;
+
+  if (scaler_cache == NULL)
+    scaler_cache = g_hash_table_new_full (scaler_cache_key_hash,
+        scaler_cache_key_equal, NULL, scaler_cache_entry_free);
+
+  while (g_hash_table_size (scaler_cache) >= scaler_cache_limit) {
+    GHashTableIter iter;
+    gpointer value;
+    ScalerCacheEntry *oldest = NULL;
+
+    g_hash_table_iter_init (&iter, scaler_cache);
+    while (g_hash_table_iter_next (&iter, NULL, &value)) {
+      entry = value;
+      if (oldest == NULL || entry->age < oldest->age)
+        oldest = entry;
+    }
+    g_hash_table_remove (scaler_cache, &oldest->key);
+  }
+
+  entry = g_slice_new0 (ScalerCacheEntry);
+  entry->key = *key;
+  entry->age = ++scaler_cache_age;
+  resampler_copy (&entry->resampler, resampler);
+  g_hash_table_insert (scaler_cache, &entry->key, entry);
+
+done:
+  g_mutex_unlock (&scaler_cache_lock);
+}
+
+/**
+ * gst_video_scaler_cache_set_limit:
+ * @limit: the maximum number of coefficient tables to keep
+ *
+ * Set the maximum number of coefficient tables kept in the process-wide
+ * cache that is consulted by gst_video_scaler_new(). Use 0 to disable
+ * caching; this also drops the tables that are currently cached.
+ *
+ * Since: 1.14
+ */
+void
+gst_video_scaler_cache_set_limit (guint limit)
+{
+  g_mutex_lock (&scaler_cache_lock);
+  scaler_cache_limit = limit;
+  if (scaler_cache) {
+    if (limit == 0) {
+      g_hash_table_unref (scaler_cache);
+      scaler_cache = NULL;
+    } else {
+      while (g_hash_table_size (scaler_cache) > limit) {
+        GHashTableIter iter;
+        gpointer value;
+        ScalerCacheEntry *oldest = NULL, *entry;
+
+        g_hash_table_iter_init (&iter, scaler_cache);
+        while (g_hash_table_iter_next (&iter, NULL, &value)) {
+          entry = value;
+          if (oldest == NULL || entry->age < oldest->age)
+            oldest = entry;
+        }
+        g_hash_table_remove (scaler_cache, &oldest->key);
+      }
+    }
+  }
+  g_mutex_unlock (&scaler_cache_lock);
+}
+
 static void
 resampler_zip (GstVideoResampler * resampler, const GstVideoResampler * r1,
     const GstVideoResampler * r2)
@@ -211,10 +376,25 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
     guint n_taps, guint in_size, guint out_size, GstStructure * options)
 {
   GstVideoScaler *scale;
+  ScalerCacheKey cache_key = { method, flags, n_taps, in_size, out_size };
+  gboolean cacheable, from_cache = FALSE;
 
   g_return_val_if_fail (in_size != 0, NULL);
   g_return_val_if_fail (out_size != 0, NULL);
 
+#ifdef CHECK_X86
+  {
+    static gsize simd_once = 0;
+
+    if (g_once_init_enter (&simd_once)) {
+      video_scaler_use_avx2 = video_scaler_avx2_available ();
+      GST_DEBUG ("AVX2 resample kernels %s",
+          video_scaler_use_avx2 ? "enabled" : "not available");
+      g_once_init_leave (&simd_once, 1);
+    }
+  }
+#endif
+
   scale = g_slice_new0 (GstVideoScaler);
 
   GST_DEBUG ("%d %u  %u->%u", method, n_taps, in_size, out_size);
@@ -222,7 +402,14 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
   scale->method = method;
   scale->flags = flags;
 
-  if (flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
+  /* options can influence the computed coefficients in ways the cache
+   * key doesn't capture */
+  cacheable = (options == NULL);
+
+  if (cacheable && scaler_cache_lookup (&cache_key, &scale->resampler)) {
+    GST_DEBUG ("using cached coefficient table");
+    from_cache = TRUE;
+  } else if (flags & GST_VIDEO_SCALER_FLAG_INTERLACED) {
     GstVideoResampler tresamp, bresamp;
     gdouble shift;
 
@@ -247,6 +434,9 @@ gst_video_scaler_new (GstVideoResamplerMethod method, GstVideoScalerFlags flags,
         options);
   }
 
+  if (cacheable && !from_cache)
+    scaler_cache_store (&cache_key, &scale->resampler);
+
   if (out_size == 1)
     scale->inc = 0;
   else
@@ -971,6 +1161,13 @@ video_scale_v_4tap_u8 (GstVideoScaler * scale,
   p4 = taps[3];
 
 #ifdef LQ
+#ifdef CHECK_X86
+  if (video_scaler_use_avx2) {
+    video_scaler_avx2_resample_v_4tap_u8_lq (d, s1, s2, s3, s4, p1, p2, p3,
+        p4, width * n_elems);
+    return;
+  }
+#endif
   video_orc_resample_v_4tap_u8_lq (d, s1, s2, s3, s4, p1, p2, p3, p4,
       width * n_elems);
 #else
@@ -60,6 +60,9 @@ GstVideoScaler *      gst_video_scaler_new            (GstVideoResamplerMethod m
 GST_EXPORT
 void                  gst_video_scaler_free           (GstVideoScaler *scale);
 
+GST_EXPORT
+void                  gst_video_scaler_cache_set_limit (guint limit);
+
 GST_EXPORT
 guint                 gst_video_scaler_get_max_taps   (GstVideoScaler *scale);
 
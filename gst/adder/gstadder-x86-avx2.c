@@ -0,0 +1,95 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include "config.h"
+#endif
+
+#include "gstadder-x86-avx2.h"
+
+#if defined (__x86_64__) && \
+    defined (HAVE_IMMINTRIN_H) && defined (__AVX2__)
+
+#include <immintrin.h>
+
+#define HAVE_AVX2_KERNELS 1
+
+void
+adder_avx2_add_s16 (gint16 * dest, const gint16 * src, gint n)
+{
+  gint i = 0;
+
+  /* 16 samples per iteration, saturating like the addssw opcode the
+   * Orc kernel uses */
+  for (; i + 16 <= n; i += 16) {
+    __m256i d = _mm256_loadu_si256 ((const __m256i *) (dest + i));
+    __m256i s = _mm256_loadu_si256 ((const __m256i *) (src + i));
+
+    _mm256_storeu_si256 ((__m256i *) (dest + i), _mm256_adds_epi16 (d, s));
+  }
+  for (; i < n; i++) {
+    gint sum = (gint) dest[i] + (gint) src[i];
+
+    dest[i] = CLAMP (sum, G_MININT16, G_MAXINT16);
+  }
+}
+
+void
+adder_avx2_add_f32 (gfloat * dest, const gfloat * src, gint n)
+{
+  gint i = 0;
+
+  for (; i + 8 <= n; i += 8) {
+    __m256 d = _mm256_loadu_ps (dest + i);
+    __m256 s = _mm256_loadu_ps (src + i);
+
+    _mm256_storeu_ps (dest + i, _mm256_add_ps (d, s));
+  }
+  for (; i < n; i++)
+    dest[i] += src[i];
+}
+
+#else /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+/* Stubs so that the dispatch code in gstadder.c always links; they are
+ * never called because adder_avx2_available() returns FALSE. */
+
+void
+adder_avx2_add_s16 (gint16 * dest, const gint16 * src, gint n)
+{
+  g_assert_not_reached ();
+}
+
+void
+adder_avx2_add_f32 (gfloat * dest, const gfloat * src, gint n)
+{
+  g_assert_not_reached ();
+}
+
+#endif /* __x86_64__ && HAVE_IMMINTRIN_H && __AVX2__ */
+
+gboolean
+adder_avx2_available (void)
+{
+#ifdef HAVE_AVX2_KERNELS
+  return __builtin_cpu_supports ("avx2") != 0;
+#else
+  return FALSE;
+#endif
+}
@@ -0,0 +1,36 @@
+/* GStreamer
+ * Copyright (C) <2017> Wim Taymans <wim.taymans@gmail.com>
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+#ifndef GST_ADDER_X86_AVX2_H
+#define GST_ADDER_X86_AVX2_H
+
+#include <glib.h>
+
+/* Returns TRUE when the avx2 kernels below were compiled in and the
+ * CPU we are running on supports AVX2 */
+gboolean adder_avx2_available (void);
+
+/* Add @n samples of @src to @dest with signed saturation; equivalent
+ * to adder_orc_add_s16 */
+void adder_avx2_add_s16 (gint16 * dest, const gint16 * src, gint n);
+
+/* Add @n samples of @src to @dest; equivalent to adder_orc_add_f32 */
+void adder_avx2_add_f32 (gfloat * dest, const gfloat * src, gint n);
+
+#endif /* GST_ADDER_X86_AVX2_H */
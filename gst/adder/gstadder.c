@@ -50,8 +50,20 @@
 #include "gstadder.h"
 #include <gst/audio/audio.h>
 #include <string.h>             /* strcmp */
+#ifdef HAVE_ORC
+#include <orc/orc.h>
+#endif
 #include "gstadderorc.h"
 
+#if defined (HAVE_AVX2) && HAVE_AVX2 && \
+    (defined (__i386__) || defined (__x86_64__))
+#define CHECK_X86
+#include "gstadder-x86-avx2.h"
+
+/* set up once in plugin_init() */
+static gboolean adder_use_avx2 = FALSE;
+#endif
+
 #define GST_CAT_DEFAULT gst_adder_debug
 GST_DEBUG_CATEGORY_STATIC (GST_CAT_DEFAULT);
 
@@ -75,7 +87,9 @@ enum
 {
   PROP_PAD_0,
   PROP_PAD_VOLUME,
-  PROP_PAD_MUTE
+  PROP_PAD_MUTE,
+  PROP_PAD_BYTES_MIXED,
+  PROP_PAD_STARVED_CYCLES
 };
 
 G_DEFINE_TYPE (GstAdderPad, gst_adder_pad, GST_TYPE_PAD);
@@ -93,6 +107,16 @@ gst_adder_pad_get_property (GObject * object, guint prop_id,
     case PROP_PAD_MUTE:
       g_value_set_boolean (value, pad->mute);
       break;
+    case PROP_PAD_BYTES_MIXED:
+      GST_OBJECT_LOCK (pad);
+      g_value_set_uint64 (value, pad->bytes_mixed);
+      GST_OBJECT_UNLOCK (pad);
+      break;
+    case PROP_PAD_STARVED_CYCLES:
+      GST_OBJECT_LOCK (pad);
+      g_value_set_uint (value, pad->starved_cycles);
+      GST_OBJECT_UNLOCK (pad);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -141,6 +165,24 @@ gst_adder_pad_class_init (GstAdderPadClass * klass)
       g_param_spec_boolean ("mute", "Mute", "Mute this pad",
           DEFAULT_PAD_MUTE,
           G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstAdderPad:bytes-mixed:
+   *
+   * Number of bytes of this pad that went into the mix so far.
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_BYTES_MIXED,
+      g_param_spec_uint64 ("bytes-mixed", "Bytes mixed",
+          "Number of bytes of this pad mixed into the output so far",
+          0, G_MAXUINT64, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstAdderPad:starved-cycles:
+   *
+   * Number of mix cycles in which this pad had no data to contribute.
+   */
+  g_object_class_install_property (gobject_class, PROP_PAD_STARVED_CYCLES,
+      g_param_spec_uint ("starved-cycles", "Starved cycles",
+          "Number of mix cycles in which this pad had no data",
+          0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 }
 
 static void
@@ -923,6 +965,11 @@ gst_adder_dispose (GObject * object)
     adder->pending_events = NULL;
   }
 
+  if (adder->mix_pool) {
+    g_thread_pool_free (adder->mix_pool, FALSE, TRUE);
+    adder->mix_pool = NULL;
+  }
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -1061,6 +1108,211 @@ gst_adder_do_clip (GstCollectPads * pads, GstCollectData * data,
   return GST_FLOW_OK;
 }
 
+/* one input queued for the mixing phase; the volume is snapshotted under
+ * the pad's object lock when the buffer is taken from collectpads */
+typedef struct
+{
+  GstBuffer *buf;
+  GstMapInfo map;
+  gdouble volume;
+  gint volume_i8;
+  gint volume_i16;
+  gint volume_i32;
+} GstAdderInput;
+
+typedef struct
+{
+  GstAdder *adder;
+  GArray *inputs;
+  guint8 *outdata;
+  gsize offset;
+  gsize length;
+  gint *pending;
+  GMutex *lock;
+  GCond *cond;
+} GstAdderMixJob;
+
+/* don't bother spinning up workers for less than this much data each */
+#define GST_ADDER_MIN_PARALLEL_CHUNK 4096
+
+/* adds @length bytes at @offset of every queued input into the output
+ * buffer. Inputs are applied in pad order for every sample, so splitting
+ * the range over several workers is bit-exact with the serial loop even
+ * for the saturating integer kernels. */
+static void
+gst_adder_mix_range (GstAdder * adder, GArray * inputs, guint8 * outdata,
+    gsize offset, gsize length)
+{
+  gint bps = GST_AUDIO_INFO_BPS (&adder->info);
+  guint i, n;
+
+  n = length / bps;
+
+  for (i = 0; i < inputs->len; i++) {
+    GstAdderInput *input = &g_array_index (inputs, GstAdderInput, i);
+    gpointer out = outdata + offset;
+    gpointer in = input->map.data + offset;
+
+    if (input->volume == 1.0) {
+      switch (adder->info.finfo->format) {
+        case GST_AUDIO_FORMAT_U8:
+          adder_orc_add_u8 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_S8:
+          adder_orc_add_s8 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_U16:
+          adder_orc_add_u16 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_S16:
+#ifdef CHECK_X86
+          if (adder_use_avx2)
+            adder_avx2_add_s16 (out, in, n);
+          else
+#endif
+            adder_orc_add_s16 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_U32:
+          adder_orc_add_u32 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_S32:
+          adder_orc_add_s32 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_F32:
+#ifdef CHECK_X86
+          if (adder_use_avx2)
+            adder_avx2_add_f32 (out, in, n);
+          else
+#endif
+            adder_orc_add_f32 (out, in, n);
+          break;
+        case GST_AUDIO_FORMAT_F64:
+          adder_orc_add_f64 (out, in, n);
+          break;
+        default:
+          g_assert_not_reached ();
+          break;
+      }
+    } else {
+      switch (adder->info.finfo->format) {
+        case GST_AUDIO_FORMAT_U8:
+          adder_orc_add_volume_u8 (out, in, input->volume_i8, n);
+          break;
+        case GST_AUDIO_FORMAT_S8:
+          adder_orc_add_volume_s8 (out, in, input->volume_i8, n);
+          break;
+        case GST_AUDIO_FORMAT_U16:
+          adder_orc_add_volume_u16 (out, in, input->volume_i16, n);
+          break;
+        case GST_AUDIO_FORMAT_S16:
+          adder_orc_add_volume_s16 (out, in, input->volume_i16, n);
+          break;
+        case GST_AUDIO_FORMAT_U32:
+          adder_orc_add_volume_u32 (out, in, input->volume_i32, n);
+          break;
+        case GST_AUDIO_FORMAT_S32:
+          adder_orc_add_volume_s32 (out, in, input->volume_i32, n);
+          break;
+        case GST_AUDIO_FORMAT_F32:
+          adder_orc_add_volume_f32 (out, in, input->volume, n);
+          break;
+        case GST_AUDIO_FORMAT_F64:
+          adder_orc_add_volume_f64 (out, in, input->volume, n);
+          break;
+        default:
+          g_assert_not_reached ();
+          break;
+      }
+    }
+  }
+}
+
+static void
+gst_adder_mix_job (gpointer data, gpointer user_data)
+{
+  GstAdderMixJob *job = data;
+
+  gst_adder_mix_range (job->adder, job->inputs, job->outdata, job->offset,
+      job->length);
+
+  g_mutex_lock (job->lock);
+  (*job->pending)--;
+  g_cond_signal (job->cond);
+  g_mutex_unlock (job->lock);
+}
+
+/* mixes all queued inputs into the output, splitting the sample range
+ * over worker threads when there is enough work to go around */
+static void
+gst_adder_mix_inputs (GstAdder * adder, GArray * inputs, guint8 * outdata,
+    gsize outsize)
+{
+  gint bpf = GST_AUDIO_INFO_BPF (&adder->info);
+  GstAdderMixJob *jobs;
+  guint n_chunks, i;
+  gsize chunk, offset;
+  GMutex lock;
+  GCond cond;
+  gint pending;
+
+  n_chunks = MIN (g_get_num_processors (),
+      outsize / GST_ADDER_MIN_PARALLEL_CHUNK);
+
+  if (n_chunks <= 1 || inputs->len < 2) {
+    gst_adder_mix_range (adder, inputs, outdata, 0, outsize);
+    return;
+  }
+
+  if (adder->mix_pool == NULL) {
+    adder->mix_pool = g_thread_pool_new (gst_adder_mix_job, adder,
+        g_get_num_processors (), FALSE, NULL);
+    if (adder->mix_pool == NULL) {
+      gst_adder_mix_range (adder, inputs, outdata, 0, outsize);
+      return;
+    }
+  }
+
+  GST_LOG_OBJECT (adder, "mixing %u inputs in %u chunks", inputs->len,
+      n_chunks);
+
+  g_mutex_init (&lock);
+  g_cond_init (&cond);
+  pending = n_chunks - 1;
+
+  jobs = g_newa (GstAdderMixJob, n_chunks);
+  chunk = ((outsize / n_chunks) / bpf) * bpf;
+  offset = 0;
+
+  for (i = 0; i < n_chunks; i++) {
+    jobs[i].adder = adder;
+    jobs[i].inputs = inputs;
+    jobs[i].outdata = outdata;
+    jobs[i].offset = offset;
+    jobs[i].length = (i == n_chunks - 1) ? outsize - offset : chunk;
+    jobs[i].pending = &pending;
+    jobs[i].lock = &lock;
+    jobs[i].cond = &cond;
+    offset += jobs[i].length;
+
+    if (i < n_chunks - 1) {
+      if (!g_thread_pool_push (adder->mix_pool, &jobs[i], NULL))
+        gst_adder_mix_job (&jobs[i], adder);
+    }
+  }
+
+  /* mix the last chunk on the streaming thread instead of sleeping */
+  gst_adder_mix_range (adder, inputs, outdata, jobs[n_chunks - 1].offset,
+      jobs[n_chunks - 1].length);
+
+  g_mutex_lock (&lock);
+  while (pending > 0)
+    g_cond_wait (&cond, &lock);
+  g_mutex_unlock (&lock);
+
+  g_mutex_clear (&lock);
+  g_cond_clear (&cond);
+}
+
 static GstFlowReturn
 gst_adder_collected (GstCollectPads * pads, gpointer user_data)
 {
@@ -1085,6 +1337,7 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
   GstFlowReturn ret;
   GstBuffer *outbuf = NULL, *gapbuf = NULL;
   GstMapInfo outmap = { NULL };
+  GArray *inputs;
   guint outsize;
   gint64 next_offset;
   gint64 next_timestamp;
@@ -1182,6 +1435,8 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
       "starting to cycle through channels, %d bytes available (bps = %d, bpf = %d)",
       outsize, bps, bpf);
 
+  inputs = g_array_new (FALSE, FALSE, sizeof (GstAdderInput));
+
   for (collected = pads->data; collected; collected = next) {
     GstCollectData *collect_data;
     GstBuffer *inbuf;
@@ -1207,6 +1462,9 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
      * case of an empty buffer. */
     if (inbuf == NULL) {
       GST_LOG_OBJECT (adder, "channel %p: no bytes available", collect_data);
+      GST_OBJECT_LOCK (pad);
+      pad->starved_cycles++;
+      GST_OBJECT_UNLOCK (pad);
       continue;
     }
 
@@ -1256,6 +1514,8 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
       outbuf = gst_buffer_make_writable (inbuf);
       gst_buffer_map (outbuf, &outmap, GST_MAP_READWRITE);
 
+      pad->bytes_mixed += outmap.size;
+
       if (pad->volume != 1.0) {
         switch (adder->info.finfo->format) {
           case GST_AUDIO_FORMAT_U8:
@@ -1297,106 +1557,53 @@ gst_adder_collected (GstCollectPads * pads, gpointer user_data)
       }
     } else {
       if (!is_gap) {
-        /* we had a previous output buffer, mix this non-GAP buffer */
-        GstMapInfo inmap;
-
-        gst_buffer_map (inbuf, &inmap, GST_MAP_READ);
+        /* we had a previous output buffer, queue this non-GAP buffer for
+         * the mixing phase below, snapshotting the volume while we hold
+         * the pad lock */
+        GstAdderInput input;
+
+        input.buf = inbuf;
+        input.volume = pad->volume;
+        input.volume_i8 = pad->volume_i8;
+        input.volume_i16 = pad->volume_i16;
+        input.volume_i32 = pad->volume_i32;
+        gst_buffer_map (inbuf, &input.map, GST_MAP_READ);
 
         /* all buffers should have outsize, there are no short buffers because we
          * asked for the max size above */
-        g_assert (inmap.size == outmap.size);
-
-        GST_LOG_OBJECT (adder, "channel %p: mixing %" G_GSIZE_FORMAT " bytes"
-            " from data %p", collect_data, inmap.size, inmap.data);
-
-        /* further buffers, need to add them */
-        if (pad->volume == 1.0) {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        } else {
-          switch (adder->info.finfo->format) {
-            case GST_AUDIO_FORMAT_U8:
-              adder_orc_add_volume_u8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S8:
-              adder_orc_add_volume_s8 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i8, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U16:
-              adder_orc_add_volume_u16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S16:
-              adder_orc_add_volume_s16 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i16, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_U32:
-              adder_orc_add_volume_u32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_S32:
-              adder_orc_add_volume_s32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume_i32, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F32:
-              adder_orc_add_volume_f32 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            case GST_AUDIO_FORMAT_F64:
-              adder_orc_add_volume_f64 ((gpointer) outmap.data,
-                  (gpointer) inmap.data, pad->volume, inmap.size / bps);
-              break;
-            default:
-              g_assert_not_reached ();
-              break;
-          }
-        }
-        gst_buffer_unmap (inbuf, &inmap);
+        g_assert (input.map.size == outmap.size);
+
+        GST_LOG_OBJECT (adder, "channel %p: queued %" G_GSIZE_FORMAT " bytes"
+            " from data %p for mixing", collect_data, input.map.size,
+            input.map.data);
+
+        pad->bytes_mixed += input.map.size;
+
+        g_array_append_val (inputs, input);
       } else {
         /* skip gap buffer */
         GST_LOG_OBJECT (adder, "channel %p: skipping GAP buffer", collect_data);
+        gst_buffer_unref (inbuf);
       }
-      gst_buffer_unref (inbuf);
     }
     GST_OBJECT_UNLOCK (pad);
   }
 
+  if (inputs->len > 0) {
+    guint i;
+
+    /* mixing phase: add all queued inputs into the output buffer */
+    gst_adder_mix_inputs (adder, inputs, outmap.data, outmap.size);
+
+    for (i = 0; i < inputs->len; i++) {
+      GstAdderInput *input = &g_array_index (inputs, GstAdderInput, i);
+
+      gst_buffer_unmap (input->buf, &input->map);
+      gst_buffer_unref (input->buf);
+    }
+  }
+  g_array_free (inputs, TRUE);
+
   if (outbuf)
     gst_buffer_unmap (outbuf, &outmap);
 
@@ -1584,6 +1791,34 @@ plugin_init (GstPlugin * plugin)
   GST_DEBUG_CATEGORY_INIT (GST_CAT_DEFAULT, "adder", 0,
       "audio channel mixing element");
 
+#ifdef HAVE_ORC
+  {
+    OrcTarget *target;
+
+    orc_init ();
+    /* report what the mixing loops will be compiled for; without any
+     * target flags they fall back to scalar code */
+    if ((target = orc_target_get_default ())) {
+      guint flags = orc_target_get_default_flags (target);
+      gint i;
+
+      GST_INFO ("orc target %s, default flags %08x",
+          orc_target_get_name (target), flags);
+      for (i = 0; i < 32; i++) {
+        if (flags & (1U << i))
+          GST_INFO ("orc target flag %s",
+              orc_target_get_flag_name (target, i));
+      }
+    }
+  }
+#endif
+
+#ifdef CHECK_X86
+  adder_use_avx2 = adder_avx2_available ();
+  GST_INFO ("AVX2 mixing kernels %s",
+      adder_use_avx2 ? "enabled" : "not available");
+#endif
+
   if (!gst_element_register (plugin, "adder", GST_RANK_NONE, GST_TYPE_ADDER)) {
     return FALSE;
   }
@@ -73,9 +73,12 @@ struct _GstAdder {
 
   /* Pending inline events */
   GList *pending_events;
-  
+
   gboolean send_stream_start;
   gboolean send_caps;
+
+  /* worker threads for mixing large cycles in parallel, created lazily */
+  GThreadPool *mix_pool;
 };
 
 struct _GstAdderClass {
@@ -99,6 +102,10 @@ struct _GstAdderPad {
   gint volume_i16;
   gint volume_i8;
   gboolean mute;
+
+  /* fill statistics, protected by the pad's object lock */
+  guint64 bytes_mixed;
+  guint starved_cycles;
 };
 
 struct _GstAdderPadClass {
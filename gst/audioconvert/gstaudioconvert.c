@@ -29,6 +29,9 @@
  * It supports integer to float conversion, width/depth conversion,
  * signedness and endianness conversion and channel transformations
  * (ie. upmixing and downmixing), as well as dithering and noise-shaping.
+ * With the #GstAudioConvert:resample property it can additionally convert
+ * the sample rate in the same pass, saving an unpack/pack cycle compared
+ * to a separate audioresample element.
  *
  * ## Example launch line
  * |[
@@ -79,6 +82,9 @@ static void gst_audio_convert_dispose (GObject * obj);
 /* gstreamer functions */
 static gboolean gst_audio_convert_get_unit_size (GstBaseTransform * base,
     GstCaps * caps, gsize * size);
+static gboolean gst_audio_convert_transform_size (GstBaseTransform * base,
+    GstPadDirection direction, GstCaps * caps, gsize size,
+    GstCaps * othercaps, gsize * othersize);
 static GstCaps *gst_audio_convert_transform_caps (GstBaseTransform * base,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter);
 static GstCaps *gst_audio_convert_fixate_caps (GstBaseTransform * base,
@@ -110,6 +116,7 @@ enum
   PROP_0,
   PROP_DITHERING,
   PROP_NOISE_SHAPING,
+  PROP_RESAMPLE,
 };
 
 #define DEBUG_INIT \
@@ -123,7 +130,7 @@ G_DEFINE_TYPE_WITH_CODE (GstAudioConvert, gst_audio_convert,
 
 #define STATIC_CAPS \
 GST_STATIC_CAPS (GST_AUDIO_CAPS_MAKE (GST_AUDIO_FORMATS_ALL) \
-    ", layout = (string) interleaved")
+    ", layout = (string) { interleaved, non-interleaved }")
 
 static GstStaticPadTemplate gst_audio_convert_src_template =
 GST_STATIC_PAD_TEMPLATE ("src",
@@ -162,6 +169,20 @@ gst_audio_convert_class_init (GstAudioConvertClass * klass)
           GST_TYPE_AUDIO_NOISE_SHAPING_METHOD, GST_AUDIO_NOISE_SHAPING_NONE,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioConvert:resample:
+   *
+   * Also convert the sample rate in the same pass. Format, channel and rate
+   * conversion then share one unpack/pack cycle instead of each element
+   * doing its own, which makes a downstream audioresample run in
+   * passthrough. Note that the resampler tail is not drained on EOS, so the
+   * last few samples of the stream are dropped when the rates differ.
+   */
+  g_object_class_install_property (gobject_class, PROP_RESAMPLE,
+      g_param_spec_boolean ("resample", "Resample",
+          "Also convert the sample rate in the same pass",
+          FALSE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (element_class,
       &gst_audio_convert_src_template);
   gst_element_class_add_static_pad_template (element_class,
@@ -172,6 +193,8 @@ gst_audio_convert_class_init (GstAudioConvertClass * klass)
 
   basetransform_class->get_unit_size =
       GST_DEBUG_FUNCPTR (gst_audio_convert_get_unit_size);
+  basetransform_class->transform_size =
+      GST_DEBUG_FUNCPTR (gst_audio_convert_transform_size);
   basetransform_class->transform_caps =
       GST_DEBUG_FUNCPTR (gst_audio_convert_transform_caps);
   basetransform_class->fixate_caps =
@@ -239,9 +262,50 @@ parse_error:
   }
 }
 
+/* the default transform_size() assumes the same number of units on both
+ * sides, which no longer holds when we also convert the rate; ask the
+ * converter how many frames it will produce or consume instead */
+static gboolean
+gst_audio_convert_transform_size (GstBaseTransform * base,
+    GstPadDirection direction, GstCaps * caps, gsize size,
+    GstCaps * othercaps, gsize * othersize)
+{
+  GstAudioConvert *this = GST_AUDIO_CONVERT (base);
+  GstAudioInfo info, other_info;
+  gsize frames, other_frames;
+
+  if (!gst_audio_info_from_caps (&info, caps))
+    goto parse_error;
+  if (!gst_audio_info_from_caps (&other_info, othercaps))
+    goto parse_error;
+
+  frames = size / info.bpf;
+
+  if (info.rate == other_info.rate || this->convert == NULL) {
+    other_frames = frames;
+  } else if (direction == GST_PAD_SINK) {
+    other_frames = gst_audio_converter_get_out_frames (this->convert, frames);
+  } else {
+    other_frames = gst_audio_converter_get_in_frames (this->convert, frames);
+  }
+
+  *othersize = other_frames * other_info.bpf;
+  GST_LOG_OBJECT (base, "transformed size %" G_GSIZE_FORMAT " to %"
+      G_GSIZE_FORMAT, size, *othersize);
+
+  return TRUE;
+
+parse_error:
+  {
+    GST_INFO_OBJECT (base, "failed to parse caps to transform size");
+    return FALSE;
+  }
+}
+
 /* copies the given caps */
 static GstCaps *
-gst_audio_convert_caps_remove_format_info (GstCaps * caps, gboolean channels)
+gst_audio_convert_caps_remove_format_info (GstCaps * caps, gboolean channels,
+    gboolean rate)
 {
   GstStructure *st;
   gint i, n;
@@ -264,6 +328,9 @@ gst_audio_convert_caps_remove_format_info (GstCaps * caps, gboolean channels)
     st = gst_structure_copy (st);
     gst_structure_remove_field (st, "format");
 
+    if (rate)
+      gst_structure_remove_field (st, "rate");
+
     /* Only remove the channels and channel-mask for non-NONE layouts */
     if (gst_structure_get (st, "channel-mask", GST_TYPE_BITMASK, &channel_mask,
             NULL)) {
@@ -289,11 +356,12 @@ static GstCaps *
 gst_audio_convert_transform_caps (GstBaseTransform * btrans,
     GstPadDirection direction, GstCaps * caps, GstCaps * filter)
 {
+  GstAudioConvert *this = GST_AUDIO_CONVERT (btrans);
   GstCaps *tmp, *tmp2;
   GstCaps *result;
 
   /* Get all possible caps that we can transform to */
-  tmp = gst_audio_convert_caps_remove_format_info (caps, TRUE);
+  tmp = gst_audio_convert_caps_remove_format_info (caps, TRUE, this->resample);
 
   if (filter) {
     tmp2 = gst_caps_intersect_full (filter, tmp, GST_CAPS_INTERSECT_FIRST);
@@ -593,6 +661,18 @@ gst_audio_convert_fixate_channels (GstBaseTransform * base, GstStructure * ins,
   }
 }
 
+static void
+gst_audio_convert_fixate_rate (GstBaseTransform * base, GstStructure * ins,
+    GstStructure * outs)
+{
+  gint rate;
+
+  /* when resampling is enabled the output rate may still be a range here;
+   * prefer the input rate so that we stay in passthrough when possible */
+  if (gst_structure_get_int (ins, "rate", &rate))
+    gst_structure_fixate_field_nearest_int (outs, "rate", rate);
+}
+
 /* try to keep as many of the structure members the same by fixating the
  * possible ranges; this way we convert the least amount of things as possible
  */
@@ -613,7 +693,8 @@ gst_audio_convert_fixate_caps (GstBaseTransform * base,
     if (result)
       gst_caps_unref (result);
     /* try to preserve channels */
-    removed = gst_audio_convert_caps_remove_format_info (caps, FALSE);
+    removed = gst_audio_convert_caps_remove_format_info (caps, FALSE,
+        GST_AUDIO_CONVERT (base)->resample);
     result = gst_caps_intersect (othercaps, removed);
     gst_caps_unref (removed);
     if (gst_caps_is_empty (result)) {
@@ -637,6 +718,7 @@ gst_audio_convert_fixate_caps (GstBaseTransform * base,
 
   gst_audio_convert_fixate_channels (base, ins, outs);
   gst_audio_convert_fixate_format (base, ins, outs);
+  gst_audio_convert_fixate_rate (base, ins, outs);
 
   /* fixate remaining */
   result = gst_caps_fixate (result);
@@ -715,17 +797,20 @@ gst_audio_convert_transform (GstBaseTransform * base, GstBuffer * inbuf,
   gint insize, outsize;
   gboolean inbuf_writable;
   GstAudioConverterFlags flags;
-  gsize samples;
+  gsize samples, out_samples;
 
   /* get amount of samples to convert. */
   samples = gst_buffer_get_size (inbuf) / this->in_info.bpf;
+  out_samples = gst_audio_converter_get_out_frames (this->convert, samples);
 
   /* get in/output sizes, to see if the buffers we got are of correct
    * sizes */
   insize = samples * this->in_info.bpf;
-  outsize = samples * this->out_info.bpf;
+  outsize = out_samples * this->out_info.bpf;
 
-  if (insize == 0 || outsize == 0)
+  /* when resampling, an input buffer can be swallowed completely by the
+   * resampler history; it must still be fed to the converter then */
+  if (insize == 0 || (outsize == 0 && this->in_info.rate == this->out_info.rate))
     return GST_FLOW_OK;
 
   /* get src and dst data */
@@ -756,12 +841,28 @@ gst_audio_convert_transform (GstBaseTransform * base, GstBuffer * inbuf,
   if (inbuf_writable)
     flags |= GST_AUDIO_CONVERTER_FLAG_IN_WRITABLE;
 
-  if (!GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP)) {
-    gpointer in[1] = { srcmap.data };
-    gpointer out[1] = { dstmap.data };
+  /* gap buffers hold neutral data; when resampling they are run through
+   * the converter anyway to keep the resampler history in sync */
+  if (!GST_BUFFER_FLAG_IS_SET (inbuf, GST_BUFFER_FLAG_GAP)
+      || this->in_info.rate != this->out_info.rate) {
+    gint i, in_planes = 1, out_planes = 1;
+    gpointer *in, *out;
+
+    /* non-interleaved buffers carry the channel planes back to back in one
+     * memory block */
+    if (this->in_info.layout == GST_AUDIO_LAYOUT_NON_INTERLEAVED) {
+      in_planes = this->in_info.channels;
+      out_planes = this->out_info.channels;
+    }
+    in = g_newa (gpointer, in_planes);
+    out = g_newa (gpointer, out_planes);
+    for (i = 0; i < in_planes; i++)
+      in[i] = srcmap.data + i * (insize / in_planes);
+    for (i = 0; i < out_planes; i++)
+      out[i] = dstmap.data + i * (outsize / out_planes);
 
     if (!gst_audio_converter_samples (this->convert, flags,
-            inbuf != outbuf ? in : out, samples, out, samples))
+            inbuf != outbuf ? in : out, samples, out, out_samples))
       goto convert_error;
   } else {
     /* Create silence buffer */
@@ -865,6 +966,11 @@ gst_audio_convert_set_property (GObject * object, guint prop_id,
     case PROP_NOISE_SHAPING:
       this->ns = g_value_get_enum (value);
       break;
+    case PROP_RESAMPLE:
+      this->resample = g_value_get_boolean (value);
+      /* changes what transform_caps produces */
+      gst_base_transform_reconfigure_src (GST_BASE_TRANSFORM (this));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -884,6 +990,9 @@ gst_audio_convert_get_property (GObject * object, guint prop_id,
     case PROP_NOISE_SHAPING:
       g_value_set_enum (value, this->ns);
       break;
+    case PROP_RESAMPLE:
+      g_value_set_boolean (value, this->resample);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
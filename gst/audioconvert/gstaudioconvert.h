@@ -47,6 +47,7 @@ struct _GstAudioConvert
   /* properties */
   GstAudioDitherMethod dither;
   GstAudioNoiseShapingMethod ns;
+  gboolean resample;
 
   GstAudioInfo in_info;
   GstAudioInfo out_info;
@@ -222,6 +222,9 @@ gst_audio_rate_setcaps (GstAudioRate * audiorate, GstCaps * caps)
 
   audiorate->info = info;
 
+  /* cached silence is in the old format */
+  gst_buffer_replace (&audiorate->silence_buf, NULL);
+
   return TRUE;
 
   /* ERRORS */
@@ -429,6 +432,31 @@ gst_audio_rate_notify_add (GstAudioRate * audiorate)
   g_object_notify_by_pspec ((GObject *) audiorate, pspec_add);
 }
 
+/* Get a buffer with @samples samples of silence, sharing the memory of a
+ * cached one-second silence buffer so that filling a long gap does not
+ * allocate and clear fresh memory for every pushed chunk. */
+static GstBuffer *
+gst_audio_rate_get_silence_buffer (GstAudioRate * audiorate, guint64 samples)
+{
+  gint rate = GST_AUDIO_INFO_RATE (&audiorate->info);
+  gint bpf = GST_AUDIO_INFO_BPF (&audiorate->info);
+
+  if (audiorate->silence_buf == NULL) {
+    GstBuffer *silence;
+    GstMapInfo map;
+
+    silence = gst_buffer_new_and_alloc (rate * bpf);
+    gst_buffer_map (silence, &map, GST_MAP_WRITE);
+    gst_audio_format_fill_silence (audiorate->info.finfo, map.data, map.size);
+    gst_buffer_unmap (silence, &map);
+
+    audiorate->silence_buf = silence;
+  }
+
+  return gst_buffer_copy_region (audiorate->silence_buf,
+      GST_BUFFER_COPY_MEMORY, 0, samples * bpf);
+}
+
 static GstFlowReturn
 gst_audio_rate_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
 {
@@ -527,27 +555,20 @@ gst_audio_rate_chain (GstPad * pad, GstObject * parent, GstBuffer * buf)
   /* do we need to insert samples */
   if (in_offset > audiorate->next_offset) {
     GstBuffer *fill;
-    gint fillsize;
     guint64 fillsamples;
 
-    /* We don't want to allocate a single unreasonably huge buffer - it might
+    /* We don't want to push a single unreasonably huge buffer - it might
        be hundreds of megabytes. So, limit each output buffer to one second of
-       audio */
+       audio. The buffers all share the memory of one cached silence second,
+       so a long dropout costs one allocation, not one per pushed second. */
     fillsamples = in_offset - audiorate->next_offset;
 
     while (fillsamples > 0) {
       guint64 cursamples = MIN (fillsamples, rate);
-      GstMapInfo fillmap;
 
       fillsamples -= cursamples;
-      fillsize = cursamples * bpf;
-
-      fill = gst_buffer_new_and_alloc (fillsize);
 
-      gst_buffer_map (fill, &fillmap, GST_MAP_WRITE);
-      gst_audio_format_fill_silence (audiorate->info.finfo, fillmap.data,
-          fillmap.size);
-      gst_buffer_unmap (fill, &fillmap);
+      fill = gst_audio_rate_get_silence_buffer (audiorate, cursamples);
 
       GST_DEBUG_OBJECT (audiorate, "inserting %" G_GUINT64_FORMAT " samples",
           cursamples);
@@ -753,6 +774,7 @@ gst_audio_rate_change_state (GstElement * element, GstStateChange transition)
 
   switch (transition) {
     case GST_STATE_CHANGE_PAUSED_TO_READY:
+      gst_buffer_replace (&audiorate->silence_buf, NULL);
       break;
     case GST_STATE_CHANGE_READY_TO_PAUSED:
       audiorate->in = 0;
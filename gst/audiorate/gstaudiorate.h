@@ -70,6 +70,10 @@ struct _GstAudioRate
   GstSegment sink_segment;
   /* we output TIME format on the src */
   GstSegment src_segment;
+
+  /* cached silence for gap filling, valid for the current caps; the
+   * buffers pushed downstream share this memory */
+  GstBuffer *silence_buf;
 };
 
 struct _GstAudioRateClass
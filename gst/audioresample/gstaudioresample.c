@@ -34,6 +34,13 @@
  * to initialize when the element is created. A third mode exists, which uses the full table
  * unless said table would become too large, in which case the interpolated one is used instead.
  *
+ * When the #GstAudioResample:adaptive-quality property is enabled, the element
+ * monitors how much of each buffer's duration is spent resampling it and
+ * steps the filter quality down (and back up) so that audio keeps flowing in
+ * real time under CPU pressure instead of being dropped. The quality the
+ * resampler is currently running at is reported by the read-only
+ * #GstAudioResample:effective-quality property.
+ *
  * ## Example launch line
  * |[
  * gst-launch-1.0 -v uridecodebin uri=file:///path/to/audio.ogg ! audioconvert ! audioresample ! audio/x-raw, rate=8000 ! autoaudiosink
@@ -73,6 +80,18 @@ GST_DEBUG_CATEGORY_STATIC (GST_CAT_PERFORMANCE);
 #define DEFAULT_SINC_FILTER_MODE GST_AUDIO_RESAMPLER_FILTER_MODE_AUTO
 #define DEFAULT_SINC_FILTER_AUTO_THRESHOLD (1*1048576)
 #define DEFAULT_SINC_FILTER_INTERPOLATION GST_AUDIO_RESAMPLER_FILTER_INTERPOLATION_CUBIC
+#define DEFAULT_ADAPTIVE_QUALITY FALSE
+
+/* adaptive quality: keep an exponential average of the fraction of each
+ * buffer's duration that is spent resampling it. Above the high-water
+ * mark the effective quality is stepped down, below the low-water mark
+ * it is stepped back up towards the configured quality. The thresholds
+ * are far apart and a hold-off of a number of buffers is applied after
+ * each step so the filter doesn't oscillate between two qualities. */
+#define ADAPTIVE_LOAD_ALPHA (1.0 / 8.0)
+#define ADAPTIVE_LOAD_HIGH 0.9
+#define ADAPTIVE_LOAD_LOW 0.5
+#define ADAPTIVE_HOLDOFF 32
 
 enum
 {
@@ -81,7 +100,9 @@ enum
   PROP_RESAMPLE_METHOD,
   PROP_SINC_FILTER_MODE,
   PROP_SINC_FILTER_AUTO_THRESHOLD,
-  PROP_SINC_FILTER_INTERPOLATION
+  PROP_SINC_FILTER_INTERPOLATION,
+  PROP_ADAPTIVE_QUALITY,
+  PROP_EFFECTIVE_QUALITY
 };
 
 #define SUPPORTED_CAPS \
@@ -177,6 +198,35 @@ gst_audio_resample_class_init (GstAudioResampleClass * klass)
           DEFAULT_SINC_FILTER_INTERPOLATION,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstAudioResample:adaptive-quality:
+   *
+   * Automatically lower the effective resampler quality when resampling a
+   * buffer takes up most of that buffer's duration, and raise it again when
+   * there is headroom, instead of always running the configured quality.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_ADAPTIVE_QUALITY,
+      g_param_spec_boolean ("adaptive-quality", "Adaptive quality",
+          "Degrade resampler quality under CPU pressure instead of "
+          "falling behind", DEFAULT_ADAPTIVE_QUALITY,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
+  /**
+   * GstAudioResample:effective-quality:
+   *
+   * The quality the resampler is currently running at. Equal to
+   * #GstAudioResample:quality unless adaptive quality stepped it down.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_EFFECTIVE_QUALITY,
+      g_param_spec_int ("effective-quality", "Effective quality",
+          "Quality the resampler is currently running at",
+          GST_AUDIO_RESAMPLER_QUALITY_MIN, GST_AUDIO_RESAMPLER_QUALITY_MAX,
+          DEFAULT_QUALITY, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_add_static_pad_template (gstelement_class,
       &gst_audio_resample_src_template);
   gst_element_class_add_static_pad_template (gstelement_class,
@@ -222,6 +272,8 @@ gst_audio_resample_init (GstAudioResample * resample)
   resample->sinc_filter_mode = DEFAULT_SINC_FILTER_MODE;
   resample->sinc_filter_auto_threshold = DEFAULT_SINC_FILTER_AUTO_THRESHOLD;
   resample->sinc_filter_interpolation = DEFAULT_SINC_FILTER_INTERPOLATION;
+  resample->adaptive_quality = DEFAULT_ADAPTIVE_QUALITY;
+  resample->effective_quality = DEFAULT_QUALITY;
 
   gst_base_transform_set_gap_aware (trans, TRUE);
   gst_pad_set_query_function (trans->srcpad, gst_audio_resample_query);
@@ -243,6 +295,10 @@ gst_audio_resample_start (GstBaseTransform * base)
   resample->samples_in = 0;
   resample->samples_out = 0;
 
+  resample->effective_quality = resample->quality;
+  resample->avg_load = 0.0;
+  resample->adapt_holdoff = 0;
+
   return TRUE;
 }
 
@@ -363,7 +419,7 @@ make_options (GstAudioResample * resample, GstAudioInfo * in,
   options = gst_structure_new_empty ("resampler-options");
   if (in != NULL && out != NULL)
     gst_audio_resampler_options_set_quality (resample->method,
-        resample->quality, in->rate, out->rate, options);
+        resample->effective_quality, in->rate, out->rate, options);
 
   gst_structure_set (options,
       GST_AUDIO_CONVERTER_OPT_RESAMPLER_METHOD, GST_TYPE_AUDIO_RESAMPLER_METHOD,
@@ -449,6 +505,46 @@ gst_audio_resample_reset_state (GstAudioResample * resample)
     gst_audio_converter_reset (resample->converter);
 }
 
+/* Called after each processed buffer with the time we spent on it and its
+ * duration; steps the effective quality when the load leaves the
+ * low/high-water band. */
+static void
+gst_audio_resample_adapt_quality (GstAudioResample * resample,
+    GstClockTime elapsed, GstClockTime duration)
+{
+  gint target = resample->effective_quality;
+
+  resample->avg_load = (1.0 - ADAPTIVE_LOAD_ALPHA) * resample->avg_load +
+      ADAPTIVE_LOAD_ALPHA * ((gdouble) elapsed / duration);
+
+  if (resample->adapt_holdoff > 0) {
+    resample->adapt_holdoff--;
+    return;
+  }
+
+  if (resample->avg_load > ADAPTIVE_LOAD_HIGH
+      && target > GST_AUDIO_RESAMPLER_QUALITY_MIN)
+    target--;
+  else if (resample->avg_load < ADAPTIVE_LOAD_LOW
+      && target < resample->quality)
+    target++;
+
+  if (target == resample->effective_quality)
+    return;
+
+  GST_DEBUG_OBJECT (resample, "load %.2f, changing effective quality %d -> %d",
+      resample->avg_load, resample->effective_quality, target);
+
+  resample->effective_quality = target;
+  resample->adapt_holdoff = ADAPTIVE_HOLDOFF;
+
+  /* updating the converter config keeps the resampler history, so the new
+   * filter takes over at the buffer boundary without an audible reset */
+  gst_audio_resample_update_state (resample, &resample->in, &resample->out);
+
+  g_object_notify (G_OBJECT (resample), "effective-quality");
+}
+
 static gboolean
 gst_audio_resample_transform_size (GstBaseTransform * base,
     GstPadDirection direction, GstCaps * caps, gsize size, GstCaps * othercaps,
@@ -834,6 +930,7 @@ gst_audio_resample_transform (GstBaseTransform * base, GstBuffer * inbuf,
     GstBuffer * outbuf)
 {
   GstAudioResample *resample = GST_AUDIO_RESAMPLE (base);
+  GstClockTime processing_start = GST_CLOCK_TIME_NONE;
   GstFlowReturn ret;
 
   GST_LOG_OBJECT (resample, "transforming buffer of %" G_GSIZE_FORMAT " bytes,"
@@ -890,7 +987,21 @@ gst_audio_resample_transform (GstBaseTransform * base, GstBuffer * inbuf,
     resample->need_discont = FALSE;
   }
 
+  if (G_UNLIKELY (resample->adaptive_quality))
+    processing_start = gst_util_get_timestamp ();
+
   ret = gst_audio_resample_process (resample, inbuf, outbuf);
+
+  if (G_UNLIKELY (GST_CLOCK_TIME_IS_VALID (processing_start))) {
+    gsize in_frames = gst_buffer_get_size (inbuf) / resample->in.bpf;
+    GstClockTime duration = gst_util_uint64_scale_int (in_frames, GST_SECOND,
+        resample->in.rate);
+
+    if (duration > 0)
+      gst_audio_resample_adapt_quality (resample,
+          gst_util_get_timestamp () - processing_start, duration);
+  }
+
   if (G_UNLIKELY (ret != GST_FLOW_OK))
     return ret;
 
@@ -1021,6 +1132,11 @@ gst_audio_resample_set_property (GObject * object, guint prop_id,
       /* FIXME locking! */
       resample->quality = g_value_get_int (value);
       GST_DEBUG_OBJECT (resample, "new quality %d", resample->quality);
+      if (resample->adaptive_quality)
+        resample->effective_quality =
+            MIN (resample->effective_quality, resample->quality);
+      else
+        resample->effective_quality = resample->quality;
       gst_audio_resample_update_state (resample, NULL, NULL);
       break;
     case PROP_RESAMPLE_METHOD:
@@ -1042,6 +1158,20 @@ gst_audio_resample_set_property (GObject * object, guint prop_id,
       resample->sinc_filter_interpolation = g_value_get_enum (value);
       gst_audio_resample_update_state (resample, NULL, NULL);
       break;
+    case PROP_ADAPTIVE_QUALITY:
+      /* FIXME locking! */
+      resample->adaptive_quality = g_value_get_boolean (value);
+      resample->avg_load = 0.0;
+      resample->adapt_holdoff = 0;
+      if (!resample->adaptive_quality
+          && resample->effective_quality != resample->quality) {
+        /* go back to the configured quality */
+        resample->effective_quality = resample->quality;
+        if (resample->converter)
+          gst_audio_resample_update_state (resample, &resample->in,
+              &resample->out);
+      }
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1072,6 +1202,12 @@ gst_audio_resample_get_property (GObject * object, guint prop_id,
     case PROP_SINC_FILTER_INTERPOLATION:
       g_value_set_enum (value, resample->sinc_filter_interpolation);
       break;
+    case PROP_ADAPTIVE_QUALITY:
+      g_value_set_boolean (value, resample->adaptive_quality);
+      break;
+    case PROP_EFFECTIVE_QUALITY:
+      g_value_set_int (value, resample->effective_quality);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -68,11 +68,17 @@ struct _GstAudioResample {
   GstAudioResamplerFilterMode sinc_filter_mode;
   guint32 sinc_filter_auto_threshold;
   GstAudioResamplerFilterInterpolation sinc_filter_interpolation;
+  gboolean adaptive_quality;
 
   /* state */
   GstAudioInfo in;
   GstAudioInfo out;
   GstAudioConverter *converter;
+
+  /* adaptive quality state */
+  gint effective_quality;
+  gdouble avg_load;
+  guint adapt_holdoff;
 };
 
 struct _GstAudioResampleClass {
@@ -62,6 +62,12 @@ GST_DEBUG_CATEGORY_STATIC (audio_test_src_debug);
 #define DEFAULT_TIMESTAMP_OFFSET     G_GINT64_CONSTANT (0)
 #define DEFAULT_CAN_ACTIVATE_PUSH    TRUE
 #define DEFAULT_CAN_ACTIVATE_PULL    FALSE
+#define DEFAULT_USE_WAVETABLE        FALSE
+
+/* number of entries in the interpolated wavetable; one extra entry
+ * duplicating the first one is kept so that linear interpolation never
+ * has to wrap the index */
+#define INTERP_TABLE_SIZE            4096
 
 enum
 {
@@ -73,7 +79,8 @@ enum
   PROP_IS_LIVE,
   PROP_TIMESTAMP_OFFSET,
   PROP_CAN_ACTIVATE_PUSH,
-  PROP_CAN_ACTIVATE_PULL
+  PROP_CAN_ACTIVATE_PULL,
+  PROP_USE_WAVETABLE
 };
 
 #define FORMAT_STR  " { S16LE, S16BE, U16LE, U16BE, " \
@@ -208,6 +215,20 @@ gst_audio_test_src_class_init (GstAudioTestSrcClass * klass)
       g_param_spec_boolean ("can-activate-pull", "Can activate pull",
           "Can activate in pull mode", DEFAULT_CAN_ACTIVATE_PULL,
           G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+  /**
+   * GstAudioTestSrc:use-wavetable:
+   *
+   * Generate the periodic waves (sine, square, saw, triangle) from a
+   * precalculated, linearly interpolated wavetable instead of evaluating
+   * the waveform per sample. This is much cheaper, especially for sine,
+   * at the price of a small approximation error. The exact sample values
+   * differ from the default synthesis, which is why this is not enabled
+   * by default.
+   */
+  g_object_class_install_property (gobject_class, PROP_USE_WAVETABLE,
+      g_param_spec_boolean ("use-wavetable", "Use wavetable",
+          "Generate periodic waves from an interpolated wavetable",
+          DEFAULT_USE_WAVETABLE, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_static_pad_template (gstelement_class,
       &gst_audio_test_src_src_template);
@@ -247,6 +268,7 @@ gst_audio_test_src_init (GstAudioTestSrc * src)
   src->gen = NULL;
 
   src->wave = DEFAULT_WAVE;
+  src->use_wavetable = DEFAULT_USE_WAVETABLE;
   gst_base_src_set_blocksize (GST_BASE_SRC (src), -1);
 }
 
@@ -261,6 +283,8 @@ gst_audio_test_src_finalize (GObject * object)
   g_free (src->tmp);
   src->tmp = NULL;
   src->tmpsize = 0;
+  g_free (src->interp_table);
+  src->interp_table = NULL;
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
 }
@@ -733,6 +757,92 @@ static const ProcessFunc sine_table_funcs[] = {
   (ProcessFunc) gst_audio_test_src_create_sine_table_double
 };
 
+/*
+ * gst_audio_test_src_init_interp_table:
+ * Sample one period of the current waveform into the interpolation table,
+ * using the same formulas as the per-sample generators. The guard entry at
+ * the end duplicates the first one so the process functions can always
+ * interpolate between entry i and i + 1.
+ */
+static void
+gst_audio_test_src_init_interp_table (GstAudioTestSrc * src)
+{
+  gdouble ang, amp = src->volume;
+  gdouble step = M_PI_M2 / INTERP_TABLE_SIZE;
+  gint i;
+
+  if (src->interp_table == NULL)
+    src->interp_table = g_new (gdouble, INTERP_TABLE_SIZE + 1);
+
+  for (i = 0; i < INTERP_TABLE_SIZE; i++) {
+    ang = step * i;
+    switch (src->wave) {
+      case GST_AUDIO_TEST_SRC_WAVE_SQUARE:
+        src->interp_table[i] = (ang < G_PI) ? amp : -amp;
+        break;
+      case GST_AUDIO_TEST_SRC_WAVE_SAW:
+        if (ang < G_PI)
+          src->interp_table[i] = ang * (amp / G_PI);
+        else
+          src->interp_table[i] = (M_PI_M2 - ang) * (-amp / G_PI);
+        break;
+      case GST_AUDIO_TEST_SRC_WAVE_TRIANGLE:
+        if (ang < G_PI_2)
+          src->interp_table[i] = ang * (amp / G_PI_2);
+        else if (ang < (G_PI * 1.5))
+          src->interp_table[i] = (ang - G_PI) * (-amp / G_PI_2);
+        else
+          src->interp_table[i] = (M_PI_M2 - ang) * (-amp / G_PI_2);
+        break;
+      default:
+        src->interp_table[i] = sin (ang) * amp;
+        break;
+    }
+  }
+  src->interp_table[INTERP_TABLE_SIZE] = src->interp_table[0];
+}
+
+#define DEFINE_INTERP(type,scale) \
+static void \
+gst_audio_test_src_create_interp_##type (GstAudioTestSrc * src, g##type * samples) \
+{ \
+  gint i, c, j, channels; \
+  gdouble step, scl, idx; \
+  g##type val; \
+  \
+  channels = GST_AUDIO_INFO_CHANNELS (&src->info); \
+  step = M_PI_M2 * src->freq / GST_AUDIO_INFO_RATE (&src->info); \
+  scl = INTERP_TABLE_SIZE / M_PI_M2; \
+  \
+  i = 0; \
+  while (i < (src->generate_samples_per_buffer * channels)) { \
+    src->accumulator += step; \
+    if (src->accumulator >= M_PI_M2) \
+      src->accumulator -= M_PI_M2; \
+    \
+    idx = src->accumulator * scl; \
+    j = (gint) idx; \
+    idx -= j; \
+    val = (g##type) (scale * (src->interp_table[j] + \
+            (src->interp_table[j + 1] - src->interp_table[j]) * idx)); \
+    \
+    for (c = 0; c < channels; ++c) \
+      samples[i++] = val; \
+  } \
+}
+
+DEFINE_INTERP (int16, 32767.0);
+DEFINE_INTERP (int32, 2147483647.0);
+DEFINE_INTERP (float, 1.0);
+DEFINE_INTERP (double, 1.0);
+
+static const ProcessFunc interp_funcs[] = {
+  (ProcessFunc) gst_audio_test_src_create_interp_int16,
+  (ProcessFunc) gst_audio_test_src_create_interp_int32,
+  (ProcessFunc) gst_audio_test_src_create_interp_float,
+  (ProcessFunc) gst_audio_test_src_create_interp_double
+};
+
 #define DEFINE_TICKS(type,scale) \
 static void \
 gst_audio_test_src_create_tick_##type (GstAudioTestSrc * src, g##type * samples) \
@@ -968,6 +1078,21 @@ gst_audio_test_src_change_wave (GstAudioTestSrc * src)
       }
   }
 
+  /* the periodic waves can all be generated from the interpolation table */
+  if (src->use_wavetable) {
+    switch (src->wave) {
+      case GST_AUDIO_TEST_SRC_WAVE_SINE:
+      case GST_AUDIO_TEST_SRC_WAVE_SQUARE:
+      case GST_AUDIO_TEST_SRC_WAVE_SAW:
+      case GST_AUDIO_TEST_SRC_WAVE_TRIANGLE:
+        gst_audio_test_src_init_interp_table (src);
+        src->process = interp_funcs[idx];
+        return;
+      default:
+        break;
+    }
+  }
+
   switch (src->wave) {
     case GST_AUDIO_TEST_SRC_WAVE_SINE:
       src->process = sine_funcs[idx];
@@ -1040,6 +1165,14 @@ static void
 gst_audio_test_src_change_volume (GstAudioTestSrc * src)
 {
   switch (src->wave) {
+    case GST_AUDIO_TEST_SRC_WAVE_SINE:
+    case GST_AUDIO_TEST_SRC_WAVE_SQUARE:
+    case GST_AUDIO_TEST_SRC_WAVE_SAW:
+    case GST_AUDIO_TEST_SRC_WAVE_TRIANGLE:
+      /* the volume is baked into the interpolation table */
+      if (src->use_wavetable)
+        gst_audio_test_src_init_interp_table (src);
+      break;
     case GST_AUDIO_TEST_SRC_WAVE_SINE_TAB:
       gst_audio_test_src_init_sine_table (src);
       break;
@@ -1328,6 +1461,10 @@ gst_audio_test_src_set_property (GObject * object, guint prop_id,
     case PROP_CAN_ACTIVATE_PULL:
       src->can_activate_pull = g_value_get_boolean (value);
       break;
+    case PROP_USE_WAVETABLE:
+      src->use_wavetable = g_value_get_boolean (value);
+      gst_audio_test_src_change_wave (src);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1365,6 +1502,9 @@ gst_audio_test_src_get_property (GObject * object, guint prop_id,
     case PROP_CAN_ACTIVATE_PULL:
       g_value_set_boolean (value, src->can_activate_pull);
       break;
+    case PROP_USE_WAVETABLE:
+      g_value_set_boolean (value, src->use_wavetable);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
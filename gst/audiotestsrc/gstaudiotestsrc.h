@@ -113,6 +113,7 @@ struct _GstAudioTestSrc {
   GstAudioTestSrcWave wave;
   gdouble volume;
   gdouble freq;
+  gboolean use_wavetable;
 
   /* audio parameters */
   GstAudioInfo info;
@@ -137,6 +138,7 @@ struct _GstAudioTestSrc {
   GstPinkNoise pink;
   GstRedNoise red;
   gdouble wave_table[1024];
+  gdouble *interp_table;    /* one period + guard entry, allocated on demand */
 };
 
 struct _GstAudioTestSrcClass {
@@ -90,6 +90,16 @@
  * #GstBus, allowing systems that support the missing-plugin system to offer the
  * user a way to install the missing element.
  *
+ * ## Parallelizing long transcodes
+ *
+ * An encodebin encodes a single timeline; it does not split the input into
+ * time ranges on its own. To use more cores on one long file, run several
+ * pipelines over non-overlapping ranges of the source (seeking each to its
+ * range start, with range boundaries placed on keyframes so each part starts
+ * decodable) against the same #GstEncodingProfile, and concatenate the
+ * resulting parts afterwards. The segment handling described above makes
+ * each part's output fit its requested range exactly.
+ *
  */
 
 
@@ -481,26 +491,63 @@ gst_encode_bin_dispose (GObject * object)
   G_OBJECT_CLASS (gst_encode_bin_parent_class)->dispose (object);
 }
 
+/* Process-wide cache of the factory lists; every encodebin instance
+ * needs the same four lists and walking and rank-sorting the registry
+ * is costly when many pipelines spin up at once. Refreshed when the
+ * registry changes. */
+static GMutex factories_lock;
+static guint32 factories_cookie = 0;
+static GList *cached_muxers = NULL;
+static GList *cached_formatters = NULL;
+static GList *cached_encoders = NULL;
+static GList *cached_parsers = NULL;
+
 static void
-gst_encode_bin_init (GstEncodeBin * encode_bin)
+gst_encode_bin_get_factory_lists (GstEncodeBin * encode_bin)
 {
-  GstPadTemplate *tmpl;
-
-  encode_bin->muxers =
-      gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_MUXER,
-      GST_RANK_MARGINAL);
+  guint32 cookie;
+
+  g_mutex_lock (&factories_lock);
+  cookie = gst_registry_get_feature_list_cookie (gst_registry_get ());
+  if (cached_muxers == NULL || factories_cookie != cookie) {
+    if (cached_muxers)
+      gst_plugin_feature_list_free (cached_muxers);
+    if (cached_formatters)
+      gst_plugin_feature_list_free (cached_formatters);
+    if (cached_encoders)
+      gst_plugin_feature_list_free (cached_encoders);
+    if (cached_parsers)
+      gst_plugin_feature_list_free (cached_parsers);
+
+    cached_muxers =
+        gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_MUXER,
+        GST_RANK_MARGINAL);
+    cached_formatters =
+        gst_element_factory_list_get_elements
+        (GST_ELEMENT_FACTORY_TYPE_FORMATTER, GST_RANK_SECONDARY);
+    cached_encoders =
+        gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_ENCODER,
+        GST_RANK_MARGINAL);
+    cached_parsers =
+        gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_PARSER,
+        GST_RANK_MARGINAL);
+
+    factories_cookie = cookie;
+  }
 
-  encode_bin->formatters =
-      gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_FORMATTER,
-      GST_RANK_SECONDARY);
+  encode_bin->muxers = gst_plugin_feature_list_copy (cached_muxers);
+  encode_bin->formatters = gst_plugin_feature_list_copy (cached_formatters);
+  encode_bin->encoders = gst_plugin_feature_list_copy (cached_encoders);
+  encode_bin->parsers = gst_plugin_feature_list_copy (cached_parsers);
+  g_mutex_unlock (&factories_lock);
+}
 
-  encode_bin->encoders =
-      gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_ENCODER,
-      GST_RANK_MARGINAL);
+static void
+gst_encode_bin_init (GstEncodeBin * encode_bin)
+{
+  GstPadTemplate *tmpl;
 
-  encode_bin->parsers =
-      gst_element_factory_list_get_elements (GST_ELEMENT_FACTORY_TYPE_PARSER,
-      GST_RANK_MARGINAL);
+  gst_encode_bin_get_factory_lists (encode_bin);
 
   encode_bin->raw_video_caps = gst_caps_from_string ("video/x-raw");
   encode_bin->raw_audio_caps = gst_caps_from_string ("audio/x-raw");
@@ -54,6 +54,7 @@ struct _GstGioBaseSink
 
   /* < private > */
   GOutputStream *stream;
+  guint buffer_size;
 };
 
 struct _GstGioBaseSinkClass 
@@ -30,6 +30,14 @@
 GST_DEBUG_CATEGORY_STATIC (gst_gio_base_src_debug);
 #define GST_CAT_DEFAULT gst_gio_base_src_debug
 
+enum
+{
+  PROP_0,
+  PROP_CACHE_SIZE
+};
+
+#define DEFAULT_CACHE_SIZE 4096
+
 static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
     GST_PAD_SRC,
     GST_PAD_ALWAYS,
@@ -39,6 +47,10 @@ static GstStaticPadTemplate src_factory = GST_STATIC_PAD_TEMPLATE ("src",
 G_DEFINE_TYPE (GstGioBaseSrc, gst_gio_base_src, GST_TYPE_BASE_SRC);
 
 static void gst_gio_base_src_finalize (GObject * object);
+static void gst_gio_base_src_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec);
+static void gst_gio_base_src_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec);
 
 static gboolean gst_gio_base_src_start (GstBaseSrc * base_src);
 static gboolean gst_gio_base_src_stop (GstBaseSrc * base_src);
@@ -63,6 +75,26 @@ gst_gio_base_src_class_init (GstGioBaseSrcClass * klass)
       "GIO base source");
 
   gobject_class->finalize = gst_gio_base_src_finalize;
+  gobject_class->set_property = gst_gio_base_src_set_property;
+  gobject_class->get_property = gst_gio_base_src_get_property;
+
+  /**
+   * GstGioBaseSrc:cache-size:
+   *
+   * Number of bytes to read ahead from the stream per read operation.
+   * Reads and seeks within the cached range are then served from memory
+   * instead of going back to the stream. Larger values reduce the number
+   * of round trips on slow backends (for example GVfs mounts, where every
+   * read goes over DBus), at the cost of more memory and higher first-use
+   * latency.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_CACHE_SIZE,
+      g_param_spec_uint ("cache-size", "Cache size",
+          "Number of bytes to read ahead per read operation",
+          1, G_MAXUINT, DEFAULT_CACHE_SIZE,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
   gst_element_class_add_static_pad_template (gstelement_class, &src_factory);
 
@@ -82,6 +114,43 @@ static void
 gst_gio_base_src_init (GstGioBaseSrc * src)
 {
   src->cancel = g_cancellable_new ();
+  src->cache_size = DEFAULT_CACHE_SIZE;
+}
+
+static void
+gst_gio_base_src_set_property (GObject * object, guint prop_id,
+    const GValue * value, GParamSpec * pspec)
+{
+  GstGioBaseSrc *src = GST_GIO_BASE_SRC (object);
+
+  switch (prop_id) {
+    case PROP_CACHE_SIZE:
+      GST_OBJECT_LOCK (src);
+      src->cache_size = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (src);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
+}
+
+static void
+gst_gio_base_src_get_property (GObject * object, guint prop_id,
+    GValue * value, GParamSpec * pspec)
+{
+  GstGioBaseSrc *src = GST_GIO_BASE_SRC (object);
+
+  switch (prop_id) {
+    case PROP_CACHE_SIZE:
+      GST_OBJECT_LOCK (src);
+      g_value_set_uint (value, src->cache_size);
+      GST_OBJECT_UNLOCK (src);
+      break;
+    default:
+      G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
+      break;
+  }
 }
 
 static void
@@ -318,7 +387,7 @@ gst_gio_base_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
     GST_BUFFER_OFFSET (buf) = offset;
     GST_BUFFER_OFFSET_END (buf) = offset + size;
   } else {
-    guint cachesize = MAX (4096, size);
+    guint cachesize;
     GstMapInfo map;
     gssize read, streamread, res;
     guint64 readoffset;
@@ -327,6 +396,10 @@ gst_gio_base_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
     GstBuffer *newbuffer;
     GstMemory *mem;
 
+    GST_OBJECT_LOCK (src);
+    cachesize = MAX (src->cache_size, size);
+    GST_OBJECT_UNLOCK (src);
+
     newbuffer = gst_buffer_new ();
 
     /* copy any overlapping data from the cached buffer */
@@ -368,9 +441,12 @@ gst_gio_base_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
 
     /* GIO sometimes gives less bytes than requested although
      * it's not at the end of file. SMB for example only
-     * supports reads up to 64k. So we loop here until we get at
-     * at least the requested amount of bytes or a read returns
-     * nothing. */
+     * supports reads up to 64k. So we loop here until the whole
+     * cache chunk has been read or a read returns nothing. Filling
+     * the complete chunk (instead of stopping once the requested
+     * amount is available) is what gives us the readahead: the
+     * following create calls are then served from the cache without
+     * touching the stream at all. */
     mem = gst_allocator_alloc (NULL, cachesize, NULL);
     if (mem == NULL) {
       GST_ERROR_OBJECT (src, "Failed to allocate %u bytes", cachesize);
@@ -379,7 +455,7 @@ gst_gio_base_src_create (GstBaseSrc * base_src, guint64 offset, guint size,
 
     gst_memory_map (mem, &map, GST_MAP_WRITE);
     streamread = 0;
-    while (size - read > 0 && (res =
+    while ((gsize) streamread < cachesize && (res =
             g_input_stream_read (G_INPUT_STREAM (src->stream),
                 map.data + streamread, cachesize - streamread, src->cancel,
                 &err)) > 0) {
@@ -55,6 +55,7 @@ struct _GstGioBaseSrc
   /* < private > */
   GInputStream *stream;
   GstBuffer *cache;
+  guint cache_size;
 };
 
 struct _GstGioBaseSrcClass 
@@ -1370,9 +1370,8 @@ gst_decode_bin_autoplug_factories (GstElement * element, GstPad * pad,
   /* return all compatible factories for caps */
   g_mutex_lock (&dbin->factories_lock);
   gst_decode_bin_update_factories_list (dbin);
-  list =
-      gst_element_factory_list_filter (dbin->factories, caps, GST_PAD_SINK,
-      gst_caps_is_fixed (caps));
+  list = gst_playback_utils_filter_factories (dbin->factories,
+      dbin->factories_cookie, caps);
   g_mutex_unlock (&dbin->factories_lock);
 
   result = g_value_array_new (g_list_length (list));
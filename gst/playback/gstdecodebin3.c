@@ -252,6 +252,11 @@ struct _GstDecodebin3
 
   /* Properties */
   GstCaps *caps;
+  guint max_cached_decoders;
+
+  /* Decoders kept alive after they stopped being used, most recently
+   * released first. Protected by selection_lock */
+  GList *cached_decoders;
 };
 
 struct _GstDecodebin3Class
@@ -350,11 +355,13 @@ typedef struct _PendingPad
 
 /* properties */
 #define DEFAULT_CAPS (gst_static_caps_get (&default_raw_caps))
+#define DEFAULT_MAX_CACHED_DECODERS 0
 
 enum
 {
   PROP_0,
-  PROP_CAPS
+  PROP_CAPS,
+  PROP_MAX_CACHED_DECODERS
 };
 
 /* signals */
@@ -495,6 +502,8 @@ static void free_multiqueue_slot (GstDecodebin3 * dbin, MultiQueueSlot * slot);
 static void free_multiqueue_slot_async (GstDecodebin3 * dbin,
     MultiQueueSlot * slot);
 
+static void decoder_cache_flush (GstDecodebin3 * dbin);
+
 static GstStreamCollection *get_merged_collection (GstDecodebin3 * dbin);
 static void update_requested_selection (GstDecodebin3 * dbin,
     GstStreamCollection * collection);
@@ -534,6 +543,25 @@ gst_decodebin3_class_init (GstDecodebin3Class * klass)
           "The caps on which to stop decoding. (NULL = default)",
           GST_TYPE_CAPS, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstDecodebin3:max-cached-decoders:
+   *
+   * Maximum number of decoders to keep alive after they stopped being
+   * used by the current stream selection, so that selecting a stream of
+   * the same format again (switching back to a previous audio language
+   * for example) does not have to create and configure a new decoder
+   * from scratch. When set to 0, decoders are destroyed as soon as they
+   * are not used anymore.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_klass, PROP_MAX_CACHED_DECODERS,
+      g_param_spec_uint ("max-cached-decoders", "Max cached decoders",
+          "Maximum number of unused decoders to keep alive for future "
+          "stream selections (0 = disabled)",
+          0, G_MAXUINT, DEFAULT_MAX_CACHED_DECODERS,
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   /* FIXME : ADD SIGNALS ! */
   /**
    * GstDecodebin3::select-stream
@@ -600,6 +628,7 @@ gst_decodebin3_init (GstDecodebin3 * dbin)
   g_mutex_init (&dbin->input_lock);
 
   dbin->caps = gst_static_caps_get (&default_raw_caps);
+  dbin->max_cached_decoders = DEFAULT_MAX_CACHED_DECODERS;
 
   GST_OBJECT_FLAG_SET (dbin, GST_BIN_FLAG_STREAMS_AWARE);
 }
@@ -621,6 +650,7 @@ gst_decodebin3_dispose (GObject * object)
   g_list_free (dbin->to_activate);
   g_list_free (dbin->pending_select_streams);
   g_clear_object (&dbin->collection);
+  decoder_cache_flush (dbin);
 
   free_input (dbin, dbin->main_input);
 
@@ -651,6 +681,11 @@ gst_decodebin3_set_property (GObject * object, guint prop_id,
       dbin->caps = g_value_dup_boxed (value);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_MAX_CACHED_DECODERS:
+      GST_OBJECT_LOCK (dbin);
+      dbin->max_cached_decoders = g_value_get_uint (value);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -670,6 +705,11 @@ gst_decodebin3_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_boxed (value, dbin->caps);
       GST_OBJECT_UNLOCK (dbin);
       break;
+    case PROP_MAX_CACHED_DECODERS:
+      GST_OBJECT_LOCK (dbin);
+      g_value_set_uint (value, dbin->max_cached_decoders);
+      GST_OBJECT_UNLOCK (dbin);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -1844,6 +1884,88 @@ create_decoder (GstDecodebin3 * dbin, GstStream * stream)
   return create_element (dbin, stream, GST_ELEMENT_FACTORY_TYPE_DECODER);
 }
 
+/* Takes ownership of @decoder, which must be in NULL state with locked
+ * state, and keeps it around for a future decoder_cache_acquire().
+ * Call with SELECTION_LOCK taken */
+static void
+decoder_cache_store (GstDecodebin3 * dbin, GstElement * decoder)
+{
+  guint max;
+
+  GST_OBJECT_LOCK (dbin);
+  max = dbin->max_cached_decoders;
+  GST_OBJECT_UNLOCK (dbin);
+
+  if (max == 0) {
+    gst_object_unref (decoder);
+    return;
+  }
+
+  while (g_list_length (dbin->cached_decoders) >= max) {
+    GList *last = g_list_last (dbin->cached_decoders);
+
+    GST_DEBUG_OBJECT (dbin, "Evicting decoder %" GST_PTR_FORMAT,
+        GST_ELEMENT (last->data));
+    gst_object_unref (last->data);
+    dbin->cached_decoders = g_list_delete_link (dbin->cached_decoders, last);
+  }
+
+  GST_DEBUG_OBJECT (dbin, "Caching decoder %" GST_PTR_FORMAT " for reuse",
+      decoder);
+  dbin->cached_decoders = g_list_prepend (dbin->cached_decoders, decoder);
+}
+
+/* Returns a cached decoder that accepts the caps of @stream, or NULL.
+ * Like create_decoder(), the returned element is floating.
+ * Call with SELECTION_LOCK taken */
+static GstElement *
+decoder_cache_acquire (GstDecodebin3 * dbin, GstStream * stream)
+{
+  GstCaps *caps = gst_stream_get_caps (stream);
+  GstElement *decoder = NULL;
+  GList *tmp;
+
+  for (tmp = dbin->cached_decoders; tmp; tmp = tmp->next) {
+    GstElement *candidate = (GstElement *) tmp->data;
+    GstPad *sinkpad = gst_element_get_static_pad (candidate, "sink");
+    gboolean accepted = FALSE;
+
+    if (sinkpad) {
+      accepted = gst_pad_query_accept_caps (sinkpad, caps);
+      gst_object_unref (sinkpad);
+    }
+    if (accepted) {
+      decoder = candidate;
+      dbin->cached_decoders = g_list_delete_link (dbin->cached_decoders, tmp);
+      break;
+    }
+  }
+  gst_caps_unref (caps);
+
+  if (decoder) {
+    GST_DEBUG_OBJECT (dbin, "Reusing cached decoder %" GST_PTR_FORMAT,
+        decoder);
+    gst_element_set_locked_state (decoder, FALSE);
+    /* hand our reference back as floating so that the caller can treat
+     * the decoder exactly like a newly created element */
+    g_object_force_floating ((GObject *) decoder);
+  }
+
+  return decoder;
+}
+
+static void
+decoder_cache_flush (GstDecodebin3 * dbin)
+{
+  if (dbin->cached_decoders) {
+    GST_DEBUG_OBJECT (dbin, "Flushing %d cached decoders",
+        g_list_length (dbin->cached_decoders));
+    g_list_free_full (dbin->cached_decoders,
+        (GDestroyNotify) gst_object_unref);
+    dbin->cached_decoders = NULL;
+  }
+}
+
 static GstPadProbeReturn
 keyframe_waiter_probe (GstPad * pad, GstPadProbeInfo * info,
     DecodebinOutputStream * output)
@@ -1932,7 +2054,9 @@ reconfigure_output_stream (DecodebinOutputStream * output,
     gst_element_set_locked_state (output->decoder, TRUE);
     gst_element_set_state (output->decoder, GST_STATE_NULL);
 
+    gst_object_ref (output->decoder);
     gst_bin_remove ((GstBin *) dbin, output->decoder);
+    decoder_cache_store (dbin, output->decoder);
     output->decoder = NULL;
   }
 
@@ -1943,8 +2067,11 @@ reconfigure_output_stream (DecodebinOutputStream * output,
 
   /* If a decoder is required, create one */
   if (needs_decoder) {
-    /* If we don't have a decoder yet, instantiate one */
-    output->decoder = create_decoder (dbin, slot->active_stream);
+    /* If we don't have a decoder yet, try a cached one before
+     * instantiating a new one */
+    output->decoder = decoder_cache_acquire (dbin, slot->active_stream);
+    if (output->decoder == NULL)
+      output->decoder = create_decoder (dbin, slot->active_stream);
     if (output->decoder == NULL) {
       GstCaps *caps;
 
@@ -2625,6 +2752,10 @@ gst_decodebin3_change_state (GstElement * element, GstStateChange transition)
       }
       g_list_free (dbin->slots);
       dbin->slots = NULL;
+      /* Free cached decoders */
+      SELECTION_LOCK (dbin);
+      decoder_cache_flush (dbin);
+      SELECTION_UNLOCK (dbin);
       /* Free inputs */
     }
       break;
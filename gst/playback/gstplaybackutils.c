@@ -158,3 +158,57 @@ gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2)
    * and then by factory name */
   return gst_plugin_feature_rank_compare_func (p1, p2);
 }
+
+/* One process-wide cache of gst_element_factory_list_filter() results,
+ * keyed by the caps string and shared by all decodebin and parsebin
+ * instances. Both build their factory list in exactly the same way
+ * (decodable factories of at least marginal rank, sorted with
+ * gst_playback_utils_compare_factories_func()), which is what allows
+ * sharing one table. Flushed when the registry changes. */
+static GMutex filter_cache_lock;
+static GHashTable *filter_cache = NULL;
+static guint32 filter_cache_cookie = 0;
+
+/* Filter @factories for factories that can sink @caps, like
+ * gst_element_factory_list_filter(), but with the result cached across
+ * calls, instances and elements. @cookie must be the registry feature
+ * list cookie @factories was built against. Must be called with the
+ * caller's factories lock held. Returns a list of factory references
+ * owned by the caller; free with gst_plugin_feature_list_free(). */
+GList *
+gst_playback_utils_filter_factories (GList * factories, guint32 cookie,
+    GstCaps * caps)
+{
+  GList *list;
+  gchar *caps_str;
+
+  /* Only fixed caps are cached: they are what typefind and demuxer source
+   * pads report during startup, and unfixed caps use the opposite subset
+   * direction for filtering */
+  if (!gst_caps_is_fixed (caps))
+    return gst_element_factory_list_filter (factories, caps,
+        GST_PAD_SINK, FALSE);
+
+  caps_str = gst_caps_to_string (caps);
+
+  g_mutex_lock (&filter_cache_lock);
+  if (filter_cache && filter_cache_cookie != cookie)
+    g_hash_table_remove_all (filter_cache);
+  if (filter_cache == NULL)
+    filter_cache = g_hash_table_new_full (g_str_hash, g_str_equal,
+        g_free, (GDestroyNotify) gst_plugin_feature_list_free);
+  filter_cache_cookie = cookie;
+
+  if (!g_hash_table_lookup_extended (filter_cache, caps_str, NULL,
+          (gpointer *) & list)) {
+    list = gst_element_factory_list_filter (factories, caps,
+        GST_PAD_SINK, TRUE);
+    g_hash_table_insert (filter_cache, g_strdup (caps_str), list);
+  }
+  list = gst_plugin_feature_list_copy (list);
+  g_mutex_unlock (&filter_cache_lock);
+
+  g_free (caps_str);
+
+  return list;
+}
@@ -36,6 +36,11 @@ gst_playback_utils_get_n_common_capsfeatures (GstElementFactory * fact1,
 G_GNUC_INTERNAL
 gint
 gst_playback_utils_compare_factories_func (gconstpointer p1, gconstpointer p2);
+
+G_GNUC_INTERNAL
+GList *
+gst_playback_utils_filter_factories (GList * factories, guint32 cookie,
+                                        GstCaps * caps);
 G_END_DECLS
 
 #endif /* __GST_PLAYBACK_UTILS_H__ */
@@ -127,6 +127,17 @@
  * streams or samplerate/number of channels of audio streams can be obtained
  * from the negotiated caps on the sink pads of the sinks.
  *
+ * ## Startup instrumentation
+ *
+ * While playbin3 goes from READY to PAUSED it posts `playbin3-startup-phase`
+ * element messages on the bus whenever a notable phase of the startup
+ * sequence is reached. The message structure has a `phase` string field
+ * (`source-activated`, `stream-collection`, `pads-linked` or
+ * `preroll-done`) and an `elapsed` #guint64 field with the time since the
+ * READY to PAUSED transition in nanoseconds. Applications can use these
+ * to monitor time-to-first-frame and attribute regressions to the phase
+ * that got slower.
+ *
  * ## Buffering
  * Playbin3 handles buffering automatically for the most part, but applications
  * need to handle parts of the buffering process as well. Whenever playbin3 is
@@ -489,6 +500,11 @@ struct _GstPlayBin3
 
   /* Active stream collection */
   GstStreamCollection *collection;
+
+  /* Monotonic time when the current startup sequence began, 0 when no
+   * startup is in progress. Used to post playbin3-startup-phase
+   * messages for time-to-first-frame tracking. */
+  gint64 startup_stamp;
 };
 
 struct _GstPlayBin3Class
@@ -1047,6 +1063,31 @@ gst_play_bin3_class_init (GstPlayBin3Class * klass)
       GST_DEBUG_FUNCPTR (gst_play_bin3_deep_element_added);
 }
 
+/* Posts a playbin3-startup-phase element message carrying @phase and the
+ * time elapsed since the startup sequence began (the READY to PAUSED
+ * transition), so applications can attribute time-to-first-frame to the
+ * individual startup phases. Does nothing when no startup is in
+ * progress, e.g. for pad callbacks during gapless group switches. */
+static void
+post_startup_phase (GstPlayBin3 * playbin, const gchar * phase)
+{
+  GstStructure *s;
+  guint64 elapsed;
+
+  if (playbin->startup_stamp == 0)
+    return;
+
+  elapsed = (g_get_monotonic_time () - playbin->startup_stamp) * GST_USECOND;
+
+  GST_INFO_OBJECT (playbin, "startup phase '%s' reached after %"
+      GST_TIME_FORMAT, phase, GST_TIME_ARGS (elapsed));
+
+  s = gst_structure_new ("playbin3-startup-phase",
+      "phase", G_TYPE_STRING, phase, "elapsed", G_TYPE_UINT64, elapsed, NULL);
+  gst_element_post_message (GST_ELEMENT_CAST (playbin),
+      gst_message_new_element (GST_OBJECT_CAST (playbin), s));
+}
+
 static void
 do_async_start (GstPlayBin3 * playbin)
 {
@@ -1073,6 +1114,11 @@ do_async_done (GstPlayBin3 * playbin)
         message);
 
     playbin->async_pending = FALSE;
+
+    /* preroll is complete, the sinks have their first frame; the startup
+     * sequence ends here */
+    post_startup_phase (playbin, "preroll-done");
+    playbin->startup_stamp = 0;
   }
 }
 
@@ -2562,6 +2608,8 @@ gst_play_bin3_handle_message (GstBin * bin, GstMessage * msg)
         playbin->do_stream_selections = TRUE;
       GST_PLAY_BIN3_UNLOCK (playbin);
 
+      post_startup_phase (playbin, "stream-collection");
+
       gst_object_unref (collection);
     }
   } else if (GST_MESSAGE_TYPE (msg) == GST_MESSAGE_STREAMS_SELECTED) {
@@ -3187,6 +3235,8 @@ no_more_pads_cb (GstElement * decodebin, GstPlayBin3 * playbin)
 
   GST_PLAY_BIN3_SHUTDOWN_UNLOCK (playbin);
 
+  post_startup_phase (playbin, "pads-linked");
+
   if (configure) {
     do_async_done (playbin);
   }
@@ -4841,6 +4891,8 @@ activate_group (GstPlayBin3 * playbin, GstSourceGroup * group, GstState target)
   group->active = TRUE;
   GST_SOURCE_GROUP_UNLOCK (group);
 
+  post_startup_phase (playbin, "source-activated");
+
   return state_ret;
 
   /* ERRORS */
@@ -5143,6 +5195,7 @@ gst_play_bin3_change_state (GstElement * element, GstStateChange transition)
       GST_LOG_OBJECT (playbin, "clearing shutdown flag");
       memset (&playbin->duration, 0, sizeof (playbin->duration));
       g_atomic_int_set (&playbin->shutdown, 0);
+      playbin->startup_stamp = g_get_monotonic_time ();
       do_async_start (playbin);
       break;
     case GST_STATE_CHANGE_PAUSED_TO_READY:
@@ -2416,6 +2416,15 @@ out:
 /* make an element for playback of video with subtitles embedded.
  * Only used for *raw* video streams.
  *
+ * Note that playsink itself never blends subtitles: rendering is done by
+ * whatever renderer subtitleoverlay autoplugs for the subtitle format.
+ * Whether that renderer blends on the CPU or merely attaches a
+ * GstVideoOverlayCompositionMeta for the sink to composite is negotiated
+ * between the renderer and the sink through the allocation query, which
+ * all elements in this chain proxy. A sink that advertises
+ * GST_VIDEO_OVERLAY_COMPOSITION_META_API_TYPE therefore automatically
+ * gets attach-only subtitles without any configuration here.
+ *
  *  +--------------------------------------------+
  *  | tbin                                       |
  *  |     +--------+      +-----------------+    |
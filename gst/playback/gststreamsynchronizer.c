@@ -83,6 +83,24 @@ typedef struct
   guint group_id;
 } GstSyncStream;
 
+/* Must be called with lock, after any change to a stream's is_eos or
+ * eos_sent flags or to the stream list! */
+static void
+gst_stream_synchronizer_update_eos_streams (GstStreamSynchronizer * self)
+{
+  GList *l;
+  gint n = 0;
+
+  for (l = self->streams; l; l = l->next) {
+    GstSyncStream *stream = l->data;
+
+    if (stream->is_eos && !stream->eos_sent)
+      n++;
+  }
+
+  g_atomic_int_set (&self->eos_streams, n);
+}
+
 /* Must be called with lock! */
 static inline GstPad *
 gst_stream_get_other_pad (GstSyncStream * stream, GstPad * pad)
@@ -310,6 +328,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         stream->flushing = FALSE;
         stream->stream_start_seqnum = seqnum;
         stream->group_id = group_id;
+        gst_stream_synchronizer_update_eos_streams (self);
 
         if (!have_group_id) {
           /* Check if this belongs to a stream that is already there,
@@ -500,6 +519,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         stream->eos_sent = FALSE;
         stream->flushing = FALSE;
         stream->wait = FALSE;
+        gst_stream_synchronizer_update_eos_streams (self);
         g_cond_broadcast (&stream->stream_finish_cond);
       }
 
@@ -545,6 +565,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
           stream->is_eos = FALSE;
           stream->eos_sent = FALSE;
           stream->wait = FALSE;
+          gst_stream_synchronizer_update_eos_streams (self);
           g_cond_broadcast (&stream->stream_finish_cond);
         }
         GST_STREAM_SYNCHRONIZER_UNLOCK (self);
@@ -570,6 +591,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
 
       GST_DEBUG_OBJECT (pad, "Have EOS for stream %d", stream->stream_number);
       stream->is_eos = TRUE;
+      gst_stream_synchronizer_update_eos_streams (self);
 
       seen_data = stream->seen_data;
       srcpad = gst_object_ref (stream->srcpad);
@@ -643,6 +665,7 @@ gst_stream_synchronizer_sink_event (GstPad * pad, GstObject * parent,
         stream = gst_pad_get_element_private (pad);
         if (stream) {
           stream->eos_sent = TRUE;
+          gst_stream_synchronizer_update_eos_streams (self);
         }
       }
 
@@ -713,7 +736,13 @@ gst_stream_synchronizer_sink_chain (GstPad * pad, GstObject * parent,
   }
 
   GST_LOG_OBJECT (pad, "Push returned: %s", gst_flow_get_name (ret));
-  if (ret == GST_FLOW_OK) {
+
+  /* While no stream is at EOS nothing reads our position until the next
+   * buffer updates it again, and there is nothing to advance either, so
+   * the running streams can skip the post-push work and its lock. A
+   * stream reaching EOS concurrently sees a position that is at most one
+   * buffer behind, which the 1-second gap threshold below absorbs. */
+  if (ret == GST_FLOW_OK && g_atomic_int_get (&self->eos_streams) > 0) {
     GList *l;
 
     GST_STREAM_SYNCHRONIZER_LOCK (self);
@@ -867,6 +896,7 @@ gst_stream_synchronizer_release_stream (GstStreamSynchronizer * self,
     self->have_group_id = TRUE;
     self->group_id = G_MAXUINT;
   }
+  gst_stream_synchronizer_update_eos_streams (self);
 
   /* we can drop the lock, since stream exists now only local.
    * Moreover, we should drop, to prevent deadlock with STREAM_LOCK
@@ -995,6 +1025,7 @@ gst_stream_synchronizer_change_state (GstElement * element,
         stream->flushing = FALSE;
         stream->send_gap_event = FALSE;
       }
+      gst_stream_synchronizer_update_eos_streams (self);
       GST_STREAM_SYNCHRONIZER_UNLOCK (self);
       break;
     }
@@ -53,6 +53,12 @@ struct _GstStreamSynchronizer
   GList *streams;
   guint current_stream_number;
 
+  /* number of streams that received EOS but did not send it downstream
+   * yet. Maintained under the lock, read atomically from the chain
+   * functions so the steady-state data path can skip the post-push
+   * synchronization work when no stream is at EOS. */
+  gint eos_streams;
+
   GstClockTime group_start_time;
 
   gboolean have_group_id;
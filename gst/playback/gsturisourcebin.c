@@ -1182,13 +1182,17 @@ get_output_slot (GstURISourceBin * urisrc, gboolean do_download,
     for (cur = urisrc->out_slots; cur != NULL; cur = g_slist_next (cur)) {
       slot = (OutputSlotInfo *) (cur->data);
       if (slot->linked_info == NULL) {
+        gboolean cur_caps_match;
+
         cur_caps = gst_pad_get_current_caps (slot->sinkpad);
-        if (cur_caps == NULL || gst_caps_is_equal (caps, cur_caps)) {
-          GST_LOG_OBJECT (urisrc, "Found existing slot %p to link to", slot);
+        cur_caps_match = (cur_caps == NULL
+            || gst_caps_is_equal (caps, cur_caps));
+        if (cur_caps)
           gst_caps_unref (cur_caps);
+        if (cur_caps_match) {
+          GST_LOG_OBJECT (urisrc, "Found existing slot %p to link to", slot);
           return slot;
         }
-        gst_caps_unref (cur_caps);
       }
     }
   }
@@ -168,6 +168,9 @@ static gint gst_raw_video_parse_get_overhead_size (GstRawBaseParse *
 
 static gboolean gst_raw_video_parse_is_using_sink_caps (GstRawVideoParse *
     raw_video_parse);
+static gboolean
+gst_raw_video_parse_downstream_supports_videometa (GstRawVideoParse *
+    raw_video_parse);
 static GstRawVideoParseConfig
     * gst_raw_video_parse_get_config_ptr (GstRawVideoParse * raw_video_parse,
     GstRawBaseParseConfig config);
@@ -751,6 +754,9 @@ gst_raw_video_parse_stop (GstBaseParse * parse)
    * its ready status is always TRUE.) */
   raw_video_parse->sink_caps_config.ready = FALSE;
 
+  /* Force a fresh downstream video meta check for the next stream */
+  gst_caps_replace (&(raw_video_parse->videometa_check_caps), NULL);
+
   return GST_BASE_PARSE_CLASS (parent_class)->stop (parse);
 }
 
@@ -834,6 +840,8 @@ gst_raw_video_parse_set_config_from_caps (GstRawBaseParse * raw_base_parse,
     config_ptr->height = GST_VIDEO_INFO_HEIGHT (&(config_ptr->info));
     config_ptr->top_field_first = 0;
     config_ptr->frame_size = 0;
+    /* Caps-derived video info always uses the default plane layout */
+    config_ptr->needs_videometa = FALSE;
 
     for (i = 0; i < GST_VIDEO_MAX_PLANES; ++i) {
       config_ptr->plane_offsets[i] =
@@ -908,6 +916,7 @@ gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
       gst_raw_video_parse_get_config_ptr (raw_video_parse, config);
   guint frame_flags = 0;
   GstVideoInfo *video_info = &(config_ptr->info);
+  GstVideoInfo default_info;
   GstVideoMeta *videometa;
   GstBuffer *out_data;
 
@@ -941,13 +950,61 @@ gst_raw_video_parse_process (GstRawBaseParse * raw_base_parse,
     gst_buffer_remove_meta (out_data, (GstMeta *) videometa);
   }
 
+  /* The video meta added below is all downstream needs to deal with
+   * custom plane strides & offsets; the frame data itself is passed
+   * through (or sliced out of the input buffer) without being copied.
+   * If the layout is a custom one and downstream cannot make use of
+   * the video meta, the frame has to be repacked into the default
+   * layout instead, otherwise downstream would misinterpret the plane
+   * strides & offsets. This is the only case where frame data is
+   * actually copied. */
+  if (config_ptr->needs_videometa
+      && !gst_raw_video_parse_downstream_supports_videometa (raw_video_parse)) {
+    GstVideoFrame in_frame, out_frame;
+    GstBuffer *repacked_data;
+    gboolean repacked = FALSE;
+
+    gst_video_info_set_format (&default_info, config_ptr->format,
+        config_ptr->width, config_ptr->height);
+
+    repacked_data =
+        gst_buffer_new_allocate (NULL, GST_VIDEO_INFO_SIZE (&default_info),
+        NULL);
+    gst_buffer_copy_into (repacked_data, out_data,
+        GST_BUFFER_COPY_FLAGS | GST_BUFFER_COPY_TIMESTAMPS, 0, -1);
+
+    if (gst_video_frame_map (&in_frame, video_info, out_data, GST_MAP_READ)) {
+      if (gst_video_frame_map (&out_frame, &default_info, repacked_data,
+              GST_MAP_WRITE)) {
+        repacked = gst_video_frame_copy (&out_frame, &in_frame);
+        gst_video_frame_unmap (&out_frame);
+      }
+      gst_video_frame_unmap (&in_frame);
+    }
+
+    if (repacked) {
+      GST_LOG_OBJECT (raw_video_parse,
+          "downstream does not support video metadata - repacked frame "
+          "into default plane layout");
+      if (*processed_data != NULL)
+        gst_buffer_unref (*processed_data);
+      *processed_data = out_data = repacked_data;
+      /* The repacked frame uses the default plane strides & offsets */
+      video_info = &default_info;
+    } else {
+      GST_WARNING_OBJECT (raw_video_parse,
+          "could not repack frame - pushing it with its custom layout");
+      gst_buffer_unref (repacked_data);
+    }
+  }
+
   gst_buffer_add_video_meta_full (out_data,
       frame_flags,
       config_ptr->format,
       config_ptr->width,
       config_ptr->height,
       GST_VIDEO_INFO_N_PLANES (video_info),
-      config_ptr->plane_offsets, config_ptr->plane_strides);
+      video_info->offset, video_info->stride);
 
 
   return TRUE;
@@ -1035,6 +1092,41 @@ gst_raw_video_parse_is_using_sink_caps (GstRawVideoParse * raw_video_parse)
       &(raw_video_parse->sink_caps_config);
 }
 
+static gboolean
+gst_raw_video_parse_downstream_supports_videometa (GstRawVideoParse *
+    raw_video_parse)
+{
+  GstPad *srcpad = GST_BASE_PARSE_SRC_PAD (raw_video_parse);
+  GstCaps *caps;
+
+  caps = gst_pad_get_current_caps (srcpad);
+  if (caps == NULL)
+    return FALSE;
+
+  /* Only query downstream again when the source caps changed, since a
+   * renegotiation is the only point where the allocation preferences
+   * of the peer can change */
+  if (caps != raw_video_parse->videometa_check_caps) {
+    GstQuery *query = gst_query_new_allocation (caps, FALSE);
+
+    raw_video_parse->downstream_supports_videometa =
+        gst_pad_peer_query (srcpad, query)
+        && gst_query_find_allocation_meta (query, GST_VIDEO_META_API_TYPE,
+        NULL);
+    gst_query_unref (query);
+
+    gst_caps_replace (&(raw_video_parse->videometa_check_caps), caps);
+
+    GST_DEBUG_OBJECT (raw_video_parse, "downstream %s video metadata",
+        raw_video_parse->downstream_supports_videometa ?
+        "supports" : "does not support");
+  }
+
+  gst_caps_unref (caps);
+
+  return raw_video_parse->downstream_supports_videometa;
+}
+
 static GstRawVideoParseConfig *
 gst_raw_video_parse_get_config_ptr (GstRawVideoParse * raw_video_parse,
     GstRawBaseParseConfig config)
@@ -1071,6 +1163,7 @@ gst_raw_video_parse_init_config (GstRawVideoParseConfig * config)
 
   config->top_field_first = DEFAULT_TOP_FIELD_FIRST;
   config->frame_size = DEFAULT_FRAME_STRIDE;
+  config->needs_videometa = FALSE;
 
   gst_video_info_set_format (&(config->info), DEFAULT_FORMAT, DEFAULT_WIDTH,
       DEFAULT_HEIGHT);
@@ -1108,12 +1201,23 @@ gst_raw_video_parse_update_info (GstRawVideoParseConfig * config)
   /* Check if there are custom plane strides & offsets that need to be preserved */
   if (config->custom_plane_strides) {
     /* In case there are, overwrite the offsets&strides computed by
-     * gst_video_info_set_format with the custom ones */
+     * gst_video_info_set_format with the custom ones, and remember
+     * whether any of them actually differs from the computed default;
+     * if so, downstream needs the video metadata to make sense of
+     * the frames */
+    config->needs_videometa = FALSE;
     for (i = 0; i < GST_VIDEO_MAX_PLANES; ++i) {
+      if ((i < GST_VIDEO_INFO_N_PLANES (info))
+          && ((GST_VIDEO_INFO_PLANE_OFFSET (info, i) !=
+                  config->plane_offsets[i])
+              || (GST_VIDEO_INFO_PLANE_STRIDE (info, i) !=
+                  config->plane_strides[i])))
+        config->needs_videometa = TRUE;
       GST_VIDEO_INFO_PLANE_OFFSET (info, i) = config->plane_offsets[i];
       GST_VIDEO_INFO_PLANE_STRIDE (info, i) = config->plane_strides[i];
     }
   } else {
+    config->needs_videometa = FALSE;
     /* No custom planes&offsets; copy the computed ones into
      * the plane_offsets & plane_strides arrays to ensure they
      * are equal to the ones in the videoinfo */
@@ -78,6 +78,11 @@ struct _GstRawVideoParseConfig
   GstVideoInfo info;
 
   gboolean custom_plane_strides;
+
+  /* If TRUE, then the plane offsets & strides in the video info differ
+   * from the default ones computed out of the format and resolution, so
+   * downstream needs the video metadata to interpret the frames correctly */
+  gboolean needs_videometa;
 };
 
 struct _GstRawVideoParse
@@ -98,6 +103,13 @@ struct _GstRawVideoParse
   /* Currently active configuration. Points either to properties_config
    * or to sink_caps_config. This is never NULL. */
   GstRawVideoParseConfig *current_config;
+
+  /* Source caps the last downstream video meta support check was done
+   * against, and the result of that check. Downstream is re-queried
+   * whenever the source caps change (= whenever a renegotiation could
+   * have altered its allocation preferences). */
+  GstCaps *videometa_check_caps;
+  gboolean downstream_supports_videometa;
 };
 
 struct _GstRawVideoParseClass
@@ -120,6 +120,8 @@ gst_sub_parse_dispose (GObject * object)
     subparse->textbuf = NULL;
   }
 
+  gst_buffer_replace (&subparse->last_buffer, NULL);
+
   GST_CALL_PARENT (G_OBJECT_CLASS, dispose, (object));
 }
 
@@ -671,33 +673,39 @@ strip_trailing_newlines (gchar * txt)
  * escaping everything (the text between these simple markers isn't
  * necessarily escaped, so it seems best to do it like this) */
 static void
-subrip_unescape_formatting (gchar * txt, gconstpointer allowed_tags_ptr,
-    gboolean allows_tag_attributes)
+subrip_unescape_formatting (ParserState * state, gchar * txt)
 {
   gchar *res;
-  GRegex *tag_regex;
-  gchar *allowed_tags_pattern, *search_pattern;
   const gchar *replace_pattern;
 
   /* No processing needed if no escaped tag marker found in the string. */
   if (strstr (txt, "&lt;") == NULL)
     return;
 
-  /* Build a list of alternates for our regexp.
-   * FIXME: Could be built once and stored */
-  allowed_tags_pattern = g_strjoinv ("|", (gchar **) allowed_tags_ptr);
-  /* Look for starting/ending escaped tags with optional attributes. */
-  search_pattern = g_strdup_printf ("&lt;(/)?\\ *(%s)(%s)&gt;",
-      allowed_tags_pattern, ATTRIBUTE_REGEX);
+  if (state->unescape_regex == NULL) {
+    gchar *allowed_tags_pattern, *search_pattern;
+
+    /* Build a list of alternates for our regexp, compiled once for the
+     * stream and reused for every cue */
+    allowed_tags_pattern = g_strjoinv ("|", (gchar **) state->allowed_tags);
+    /* Look for starting/ending escaped tags with optional attributes. */
+    search_pattern = g_strdup_printf ("&lt;(/)?\\ *(%s)(%s)&gt;",
+        allowed_tags_pattern, ATTRIBUTE_REGEX);
+
+    state->unescape_regex = g_regex_new (search_pattern, 0, 0, NULL);
+
+    g_free (search_pattern);
+    g_free (allowed_tags_pattern);
+  }
+
   /* And unescape appropriately */
-  if (allows_tag_attributes) {
+  if (state->allows_tag_attributes) {
     replace_pattern = "<\\1\\2\\3>";
   } else {
     replace_pattern = "<\\1\\2>";
   }
 
-  tag_regex = g_regex_new (search_pattern, 0, 0, NULL);
-  res = g_regex_replace (tag_regex, txt, strlen (txt), 0,
+  res = g_regex_replace (state->unescape_regex, txt, strlen (txt), 0,
       replace_pattern, 0, NULL);
 
   /* res will always be shorter than the input or identical, so this
@@ -705,10 +713,6 @@ subrip_unescape_formatting (gchar * txt, gconstpointer allowed_tags_ptr,
   strcpy (txt, res);
 
   g_free (res);
-  g_free (search_pattern);
-  g_free (allowed_tags_pattern);
-
-  g_regex_unref (tag_regex);
 }
 
 
@@ -753,7 +757,7 @@ subrip_remove_unhandled_tags (gchar * txt)
  * input! This function adds missing closing markup tags and removes
  * broken closing tags for tags that have never been opened. */
 static void
-subrip_fix_up_markup (gchar ** p_txt, gconstpointer allowed_tags_ptr)
+subrip_fix_up_markup (ParserState * state, gchar ** p_txt)
 {
   gchar *cur, *next_tag;
   gchar *open_tags[32];
@@ -761,14 +765,27 @@ subrip_fix_up_markup (gchar ** p_txt, gconstpointer allowed_tags_ptr)
   const gchar *iter_tag;
   guint offset = 0;
   guint index;
-  gchar *cur_tag;
   gchar *end_tag;
-  GRegex *tag_regex;
   GMatchInfo *match_info;
-  gchar **allowed_tags = (gchar **) allowed_tags_ptr;
+  gchar **allowed_tags = (gchar **) state->allowed_tags;
 
   g_assert (*p_txt != NULL);
 
+  /* compile one regex per white listed tag on first use, they get used
+   * for every single cue of the stream */
+  if (state->tag_regexes == NULL) {
+    state->n_tag_regexes = g_strv_length (allowed_tags);
+    state->tag_regexes = g_new0 (GRegex *, state->n_tag_regexes);
+    for (index = 0; index < state->n_tag_regexes; index++) {
+      gchar *cur_tag;
+
+      cur_tag =
+          g_strconcat ("<", allowed_tags[index], ATTRIBUTE_REGEX, ">", NULL);
+      state->tag_regexes[index] = g_regex_new (cur_tag, 0, 0, NULL);
+      g_free (cur_tag);
+    }
+  }
+
   cur = *p_txt;
   while (*cur != '\0') {
     next_tag = strchr (cur, '<');
@@ -776,12 +793,11 @@ subrip_fix_up_markup (gchar ** p_txt, gconstpointer allowed_tags_ptr)
       break;
     offset = 0;
     index = 0;
-    while (index < g_strv_length (allowed_tags)) {
+    while (index < state->n_tag_regexes) {
       iter_tag = allowed_tags[index];
       /* Look for a white listed tag */
-      cur_tag = g_strconcat ("<", iter_tag, ATTRIBUTE_REGEX, ">", NULL);
-      tag_regex = g_regex_new (cur_tag, 0, 0, NULL);
-      (void) g_regex_match (tag_regex, next_tag, 0, &match_info);
+      (void) g_regex_match (state->tag_regexes[index], next_tag, 0,
+          &match_info);
 
       if (g_match_info_matches (match_info)) {
         gint start_pos, end_pos;
@@ -793,8 +809,6 @@ subrip_fix_up_markup (gchar ** p_txt, gconstpointer allowed_tags_ptr)
         g_free (word);
       }
       g_match_info_free (match_info);
-      g_regex_unref (tag_regex);
-      g_free (cur_tag);
       index++;
       if (offset) {
         /* OK we found a tag, let's keep track of it */
@@ -1050,11 +1064,10 @@ parse_subrip (ParserState * state, const gchar * line)
         ret = g_markup_escape_text (state->buf->str, state->buf->len);
         g_string_truncate (state->buf, 0);
         state->state = 0;
-        subrip_unescape_formatting (ret, state->allowed_tags,
-            state->allows_tag_attributes);
+        subrip_unescape_formatting (state, ret);
         subrip_remove_unhandled_tags (ret);
         strip_trailing_newlines (ret);
-        subrip_fix_up_markup (&ret, state->allowed_tags);
+        subrip_fix_up_markup (state, &ret);
         return ret;
       }
       return NULL;
@@ -1365,6 +1378,24 @@ parser_state_init (ParserState * state)
   state->segment = NULL;
 }
 
+static void
+parser_state_free_tag_regexes (ParserState * state)
+{
+  guint i;
+
+  if (state->unescape_regex) {
+    g_regex_unref (state->unescape_regex);
+    state->unescape_regex = NULL;
+  }
+  if (state->tag_regexes) {
+    for (i = 0; i < state->n_tag_regexes; i++)
+      g_regex_unref (state->tag_regexes[i]);
+    g_free (state->tag_regexes);
+    state->tag_regexes = NULL;
+    state->n_tag_regexes = 0;
+  }
+}
+
 static void
 parser_state_dispose (GstSubParse * self, ParserState * state)
 {
@@ -1391,6 +1422,7 @@ parser_state_dispose (GstSubParse * self, ParserState * state)
     }
   }
   state->allowed_tags = NULL;
+  parser_state_free_tag_regexes (state);
 }
 
 /* regex type enum */
@@ -1591,6 +1623,7 @@ gst_sub_parse_format_autodetect (GstSubParse * self)
   self->subtitle_codec = gst_sub_parse_get_format_description (format);
   parser_state_init (&self->state);
   self->state.allowed_tags = NULL;
+  parser_state_free_tag_regexes (&self->state);
 
   switch (format) {
     case GST_SUB_PARSE_FORMAT_MDVDSUB:
@@ -1769,13 +1802,36 @@ handle_buffer (GstSubParse * self, GstBuffer * buf)
 
     if (subtitle) {
       guint subtitle_len = strlen (subtitle);
+      gboolean repeated = FALSE;
+
+      GST_DEBUG_OBJECT (self, "Sending text '%s', %" GST_TIME_FORMAT " + %"
+          GST_TIME_FORMAT, subtitle, GST_TIME_ARGS (self->state.start_time),
+          GST_TIME_ARGS (self->state.duration));
+
+      /* live caption streams repeat the same cue a lot; share the memory
+       * of the previous buffer when the text did not change */
+      if (self->last_buffer != NULL
+          && gst_buffer_get_size (self->last_buffer) == subtitle_len) {
+        GstMapInfo map;
+
+        gst_buffer_map (self->last_buffer, &map, GST_MAP_READ);
+        repeated = memcmp (map.data, subtitle, subtitle_len) == 0;
+        gst_buffer_unmap (self->last_buffer, &map);
+      }
 
-      /* +1 for terminating NUL character */
-      buf = gst_buffer_new_and_alloc (subtitle_len + 1);
+      if (repeated) {
+        buf = gst_buffer_copy (self->last_buffer);
+        g_free (subtitle);
+        subtitle = NULL;
+      } else {
+        /* wrap the parsed string, including the terminating NUL character,
+         * instead of copying it into a fresh allocation */
+        buf = gst_buffer_new_wrapped (subtitle, subtitle_len + 1);
+        gst_buffer_set_size (buf, subtitle_len);
+        subtitle = NULL;
 
-      /* copy terminating NUL character as well */
-      gst_buffer_fill (buf, 0, subtitle, subtitle_len + 1);
-      gst_buffer_set_size (buf, subtitle_len);
+        gst_buffer_replace (&self->last_buffer, buf);
+      }
 
       GST_BUFFER_TIMESTAMP (buf) = self->state.start_time;
       GST_BUFFER_DURATION (buf) = self->state.duration;
@@ -1792,10 +1848,6 @@ handle_buffer (GstSubParse * self, GstBuffer * buf)
 
       self->segment.position = self->state.start_time;
 
-      GST_DEBUG_OBJECT (self, "Sending text '%s', %" GST_TIME_FORMAT " + %"
-          GST_TIME_FORMAT, subtitle, GST_TIME_ARGS (self->state.start_time),
-          GST_TIME_ARGS (self->state.duration));
-
       g_free (self->state.vertical);
       self->state.vertical = NULL;
       g_free (self->state.alignment);
@@ -1807,9 +1859,6 @@ handle_buffer (GstSubParse * self, GstBuffer * buf)
       if (self->state.duration != GST_CLOCK_TIME_NONE)
         self->state.start_time += self->state.duration;
 
-      g_free (subtitle);
-      subtitle = NULL;
-
       if (ret != GST_FLOW_OK) {
         GST_DEBUG_OBJECT (self, "flow: %s", gst_flow_get_name (ret));
         break;
@@ -1923,6 +1972,7 @@ gst_sub_parse_change_state (GstElement * element, GstStateChange transition)
       self->detected_encoding = NULL;
       g_string_truncate (self->textbuf, 0);
       gst_adapter_clear (self->adapter);
+      gst_buffer_replace (&self->last_buffer, NULL);
       break;
     default:
       break;
@@ -78,6 +78,12 @@ typedef struct {
   gchar *alignment;       /* "", "start", "middle", "end" */
   gconstpointer allowed_tags; /* list of markup tags allowed in the cue text. */
   gboolean allows_tag_attributes;
+
+  /* compiled regexes for the allowed tags, built on first use and kept
+   * for the stream instead of being recompiled for every cue */
+  GRegex  *unescape_regex;
+  GRegex **tag_regexes;
+  guint    n_tag_regexes;
 } ParserState;
 
 typedef gchar* (*Parser) (ParserState *state, const gchar *line);
@@ -113,8 +119,12 @@ struct _GstSubParse {
 
   gboolean first_buffer;
 
+  /* last pushed buffer, its memory is reused when consecutive cues
+   * carry the same text */
+  GstBuffer *last_buffer;
+
   /* used by frame based parsers */
-  gint fps_n, fps_d;          
+  gint fps_n, fps_d;
 };
 
 struct _GstSubParseClass {
@@ -197,7 +197,8 @@ enum
 
   PROP_RESEND_STREAMHEADER,
 
-  PROP_NUM_HANDLES
+  PROP_NUM_HANDLES,
+  PROP_STATS
 };
 
 GType
@@ -443,6 +444,23 @@ gst_multi_handle_sink_class_init (GstMultiHandleSinkClass * klass)
           "The current number of client handles",
           0, G_MAXUINT, 0, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstMultiHandleSink:stats:
+   *
+   * A snapshot of the statistics of all connected clients, as a
+   * #GstStructure with a "clients" field holding an array of the same
+   * per-client structures that the "get-stats" signal returns. Reading
+   * this takes the clients lock once for the whole snapshot, so polling
+   * telemetry for many clients is much cheaper than emitting "get-stats"
+   * per client.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_STATS,
+      g_param_spec_boxed ("stats", "Statistics",
+          "Statistics of all connected clients",
+          GST_TYPE_STRUCTURE, G_PARAM_READABLE | G_PARAM_STATIC_STRINGS));
+
   /**
    * GstMultiHandleSink::clear:
    * @gstmultihandlesink: the multihandlesink element to emit this signal on
@@ -495,6 +513,7 @@ gst_multi_handle_sink_init (GstMultiHandleSink * this)
   this->clients = NULL;
 
   this->bufqueue = g_array_new (FALSE, TRUE, sizeof (GstBuffer *));
+  this->syncframes = g_array_new (FALSE, FALSE, sizeof (guint64));
   this->unit_format = DEFAULT_UNIT_FORMAT;
   this->units_max = DEFAULT_UNITS_MAX;
   this->units_soft_max = DEFAULT_UNITS_SOFT_MAX;
@@ -522,7 +541,10 @@ gst_multi_handle_sink_finalize (GObject * object)
   this = GST_MULTI_HANDLE_SINK (object);
 
   CLIENTS_LOCK_CLEAR (this);
+  gst_caps_replace (&this->header_caps, NULL);
+  gst_buffer_replace (&this->header_block, NULL);
   g_array_free (this->bufqueue, TRUE);
+  g_array_free (this->syncframes, TRUE);
   g_hash_table_destroy (this->handle_hash);
 
   G_OBJECT_CLASS (parent_class)->finalize (object);
@@ -853,6 +875,68 @@ restart:
 }
 
 
+/* build the stats structure for one client.
+ * Must be called with the CLIENTS_LOCK held. */
+static GstStructure *
+gst_multi_handle_sink_create_client_stats (GstMultiHandleClient * mhclient)
+{
+  GstStructure *result;
+  guint64 interval;
+
+  result = gst_structure_new_empty ("multihandlesink-stats");
+
+  if (mhclient->disconnect_time == 0) {
+    GTimeVal nowtv;
+
+    g_get_current_time (&nowtv);
+
+    interval = GST_TIMEVAL_TO_TIME (nowtv) - mhclient->connect_time;
+  } else {
+    interval = mhclient->disconnect_time - mhclient->connect_time;
+  }
+
+  gst_structure_set (result,
+      "bytes-sent", G_TYPE_UINT64, mhclient->bytes_sent,
+      "connect-time", G_TYPE_UINT64, mhclient->connect_time,
+      "disconnect-time", G_TYPE_UINT64, mhclient->disconnect_time,
+      "connect-duration", G_TYPE_UINT64, interval,
+      "last-activity-time", G_TYPE_UINT64, mhclient->last_activity_time,
+      "buffers-dropped", G_TYPE_UINT64, mhclient->dropped_buffers,
+      "first-buffer-ts", G_TYPE_UINT64, mhclient->first_buffer_ts,
+      "last-buffer-ts", G_TYPE_UINT64, mhclient->last_buffer_ts, NULL);
+
+  return result;
+}
+
+/* snapshot the stats of all clients in one pass over the client list,
+ * taking the CLIENTS_LOCK once for the whole snapshot */
+static GstStructure *
+gst_multi_handle_sink_create_stats (GstMultiHandleSink * sink)
+{
+  GstStructure *result;
+  GValue array = G_VALUE_INIT;
+  GList *clients;
+
+  result = gst_structure_new_empty ("multihandlesink-stats");
+  g_value_init (&array, GST_TYPE_ARRAY);
+
+  CLIENTS_LOCK (sink);
+  for (clients = sink->clients; clients; clients = clients->next) {
+    GstMultiHandleClient *mhclient = (GstMultiHandleClient *) clients->data;
+    GValue value = G_VALUE_INIT;
+
+    g_value_init (&value, GST_TYPE_STRUCTURE);
+    g_value_take_boxed (&value,
+        gst_multi_handle_sink_create_client_stats (mhclient));
+    gst_value_array_append_and_take_value (&array, &value);
+  }
+  CLIENTS_UNLOCK (sink);
+
+  gst_structure_take_value (result, "clients", &array);
+
+  return result;
+}
+
 /* "get-stats" signal implementation
  */
 GstStructure *
@@ -878,29 +962,8 @@ gst_multi_handle_sink_get_stats (GstMultiHandleSink * sink,
   client = clink->data;
   if (client != NULL) {
     GstMultiHandleClient *mhclient = (GstMultiHandleClient *) client;
-    guint64 interval;
-
-    result = gst_structure_new_empty ("multihandlesink-stats");
-
-    if (mhclient->disconnect_time == 0) {
-      GTimeVal nowtv;
-
-      g_get_current_time (&nowtv);
-
-      interval = GST_TIMEVAL_TO_TIME (nowtv) - mhclient->connect_time;
-    } else {
-      interval = mhclient->disconnect_time - mhclient->connect_time;
-    }
 
-    gst_structure_set (result,
-        "bytes-sent", G_TYPE_UINT64, mhclient->bytes_sent,
-        "connect-time", G_TYPE_UINT64, mhclient->connect_time,
-        "disconnect-time", G_TYPE_UINT64, mhclient->disconnect_time,
-        "connect-duration", G_TYPE_UINT64, interval,
-        "last-activity-time", G_TYPE_UINT64, mhclient->last_activity_time,
-        "buffers-dropped", G_TYPE_UINT64, mhclient->dropped_buffers,
-        "first-buffer-ts", G_TYPE_UINT64, mhclient->first_buffer_ts,
-        "last-buffer-ts", G_TYPE_UINT64, mhclient->last_buffer_ts, NULL);
+    result = gst_multi_handle_sink_create_client_stats (mhclient);
   }
 
 noclient:
@@ -1022,6 +1085,45 @@ gst_multi_handle_sink_remove_client_link (GstMultiHandleSink * sink,
   CLIENTS_LOCK (sink);
 }
 
+/* Get the current streamheader buffers flattened into a single buffer,
+ * rebuilding the cached copy when the caps changed. The flattening is a
+ * shallow copy, the header memories are shared, so a joining client costs
+ * one buffer ref instead of one per header.
+ *
+ * Called with the CLIENTS_LOCK held. */
+static GstBuffer *
+gst_multi_handle_sink_get_streamheader_block (GstMultiHandleSink * mhsink,
+    GstCaps * caps, const GValue * sh)
+{
+  GArray *buffers;
+  GstBuffer *block;
+  int i;
+
+  if (mhsink->header_caps != NULL
+      && gst_caps_is_equal (mhsink->header_caps, caps))
+    return gst_buffer_ref (mhsink->header_block);
+
+  buffers = g_value_peek_pointer (sh);
+  GST_DEBUG_OBJECT (mhsink, "flattening %d streamheader buffers",
+      buffers->len);
+
+  block = gst_buffer_new ();
+  for (i = 0; i < buffers->len; ++i) {
+    GValue *bufval;
+
+    bufval = &g_array_index (buffers, GValue, i);
+    g_assert (G_VALUE_TYPE (bufval) == GST_TYPE_BUFFER);
+    block = gst_buffer_append (block,
+        gst_buffer_copy (g_value_peek_pointer (bufval)));
+  }
+
+  gst_caps_replace (&mhsink->header_caps, caps);
+  gst_buffer_replace (&mhsink->header_block, NULL);
+  mhsink->header_block = block;
+
+  return gst_buffer_ref (block);
+}
+
 static gboolean
 gst_multi_handle_sink_client_queue_buffer (GstMultiHandleSink * mhsink,
     GstMultiHandleClient * mhclient, GstBuffer * buffer)
@@ -1092,8 +1194,6 @@ gst_multi_handle_sink_client_queue_buffer (GstMultiHandleSink * mhsink,
 
   if (G_UNLIKELY (send_streamheader)) {
     const GValue *sh;
-    GArray *buffers;
-    int i;
 
     GST_LOG_OBJECT (sink,
         "%s sending streamheader from caps %" GST_PTR_FORMAT,
@@ -1103,27 +1203,15 @@ gst_multi_handle_sink_client_queue_buffer (GstMultiHandleSink * mhsink,
       GST_DEBUG_OBJECT (sink,
           "%s no new streamheader, so nothing to send", mhclient->debug);
     } else {
-      GST_LOG_OBJECT (sink,
-          "%s sending streamheader from caps %" GST_PTR_FORMAT,
-          mhclient->debug, caps);
+      GstBuffer *header;
+
       sh = gst_structure_get_value (s, "streamheader");
       g_assert (G_VALUE_TYPE (sh) == GST_TYPE_ARRAY);
-      buffers = g_value_peek_pointer (sh);
-      GST_DEBUG_OBJECT (sink, "%d streamheader buffers", buffers->len);
-      for (i = 0; i < buffers->len; ++i) {
-        GValue *bufval;
-        GstBuffer *buffer;
-
-        bufval = &g_array_index (buffers, GValue, i);
-        g_assert (G_VALUE_TYPE (bufval) == GST_TYPE_BUFFER);
-        buffer = g_value_peek_pointer (bufval);
-        GST_DEBUG_OBJECT (sink,
-            "%s queueing streamheader buffer of length %" G_GSIZE_FORMAT,
-            mhclient->debug, gst_buffer_get_size (buffer));
-        gst_buffer_ref (buffer);
-
-        mhclient->sending = g_slist_append (mhclient->sending, buffer);
-      }
+      header = gst_multi_handle_sink_get_streamheader_block (mhsink, caps, sh);
+      GST_DEBUG_OBJECT (sink,
+          "%s queueing streamheader block of length %" G_GSIZE_FORMAT,
+          mhclient->debug, gst_buffer_get_size (header));
+      mhclient->sending = g_slist_append (mhclient->sending, header);
     }
   }
 
@@ -1148,33 +1236,60 @@ is_sync_frame (GstMultiHandleSink * sink, GstBuffer * buffer)
 }
 
 /* find the keyframe in the list of buffers starting the
- * search from @idx. @direction as -1 will search backwards, 
+ * search from @idx. @direction as -1 will search backwards,
  * 1 will search forwards.
+ * The search is a binary search over the maintained keyframe index so
+ * each joining client pays O(log n) instead of walking the queue.
  * Returns: the index or -1 if there is no keyframe after idx.
  */
 gint
 find_syncframe (GstMultiHandleSink * sink, gint idx, gint direction)
 {
-  gint i, len, result;
-
-  /* take length of queued buffers */
-  len = sink->bufqueue->len;
-
-  /* assume we don't find a keyframe */
-  result = -1;
-
-  /* then loop over all buffers to find the first keyframe */
-  for (i = idx; i >= 0 && i < len; i += direction) {
-    GstBuffer *buf;
-
-    buf = g_array_index (sink->bufqueue, GstBuffer *, i);
-    if (is_sync_frame (sink, buf)) {
-      GST_LOG_OBJECT (sink, "found keyframe at %d from %d, direction %d",
-          i, idx, direction);
-      result = i;
-      break;
+  GArray *sf = sink->syncframes;
+  guint64 target, found;
+  gint lo, hi, result;
+
+  if (sf->len == 0 || idx < 0 || idx >= (gint) sink->bufqueue->len)
+    return -1;
+
+  /* the buffer at @idx has this absolute number, the index entries are
+   * absolute numbers in ascending order, newest (smallest queue index)
+   * last */
+  target = sink->buffers_total - 1 - idx;
+
+  lo = 0;
+  hi = sf->len - 1;
+  if (direction == 1) {
+    /* towards older buffers: the newest keyframe at or before @idx */
+    if (g_array_index (sf, guint64, 0) > target)
+      return -1;
+    while (lo < hi) {
+      gint mid = (lo + hi + 1) / 2;
+
+      if (g_array_index (sf, guint64, mid) <= target)
+        lo = mid;
+      else
+        hi = mid - 1;
+    }
+  } else {
+    /* towards newer buffers: the oldest keyframe at or after @idx */
+    if (g_array_index (sf, guint64, hi) < target)
+      return -1;
+    while (lo < hi) {
+      gint mid = (lo + hi) / 2;
+
+      if (g_array_index (sf, guint64, mid) >= target)
+        hi = mid;
+      else
+        lo = mid + 1;
     }
   }
+  found = g_array_index (sf, guint64, lo);
+  result = sink->buffers_total - 1 - found;
+
+  GST_LOG_OBJECT (sink, "found keyframe at %d from %d, direction %d",
+      result, idx, direction);
+
   return result;
 }
 
@@ -1690,6 +1805,9 @@ gst_multi_handle_sink_queue_buffer (GstMultiHandleSink * mhsink,
   CLIENTS_LOCK (mhsink);
   /* add buffer to queue */
   g_array_prepend_val (mhsink->bufqueue, buffer);
+  if (is_sync_frame (mhsink, buffer))
+    g_array_append_val (mhsink->syncframes, mhsink->buffers_total);
+  mhsink->buffers_total++;
   queuelen = mhsink->bufqueue->len;
 
   if (mhsink->units_max > 0)
@@ -1803,7 +1921,6 @@ restart:
       mhsink->def_sync_method == GST_SYNC_METHOD_BURST_KEYFRAME) {
     /* no point in searching beyond the queue length */
     gint limit = queuelen;
-    GstBuffer *buf;
 
     /* no point in searching beyond the soft-max if any. */
     if (soft_max_buffers > 0) {
@@ -1812,14 +1929,11 @@ restart:
     GST_LOG_OBJECT (sink,
         "extending queue to include sync point, now at %d, limit is %d",
         max_buffer_usage, limit);
-    for (i = 0; i < limit; i++) {
-      buf = g_array_index (mhsink->bufqueue, GstBuffer *, i);
-      if (is_sync_frame (mhsink, buf)) {
-        /* found a sync frame, now extend the buffer usage to
-         * include at least this frame. */
-        max_buffer_usage = MAX (max_buffer_usage, i);
-        break;
-      }
+    i = find_next_syncframe (mhsink, 0);
+    if (i != -1 && i < limit) {
+      /* found a sync frame, now extend the buffer usage to
+       * include at least this frame. */
+      max_buffer_usage = MAX (max_buffer_usage, i);
     }
     GST_LOG_OBJECT (sink, "max buffer usage is now %d", max_buffer_usage);
   }
@@ -1840,6 +1954,17 @@ restart:
     /* unref tail buffer */
     gst_buffer_unref (old);
   }
+  /* drop index entries of keyframes that fell off the tail */
+  {
+    guint64 oldest = mhsink->buffers_total - queuelen;
+    guint n = 0;
+
+    while (n < mhsink->syncframes->len
+        && g_array_index (mhsink->syncframes, guint64, n) < oldest)
+      n++;
+    if (n > 0)
+      g_array_remove_range (mhsink->syncframes, 0, n);
+  }
   /* save for stats */
   mhsink->buffers_queued = max_buffer_usage + 1;
   CLIENTS_UNLOCK (sink);
@@ -2131,6 +2256,10 @@ gst_multi_handle_sink_get_property (GObject * object, guint prop_id,
       g_value_set_uint (value,
           g_hash_table_size (multihandlesink->handle_hash));
       break;
+    case PROP_STATS:
+      g_value_take_boxed (value,
+          gst_multi_handle_sink_create_stats (multihandlesink));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -2215,6 +2344,9 @@ gst_multi_handle_sink_stop (GstBaseSink * bsink)
     }
     /* freeing the array is done in _finalize */
   }
+  g_array_set_size (mhsink->syncframes, 0);
+  gst_caps_replace (&mhsink->header_caps, NULL);
+  gst_buffer_replace (&mhsink->header_block, NULL);
   GST_OBJECT_FLAG_UNSET (mhsink, GST_MULTI_HANDLE_SINK_OPEN);
 
   return TRUE;
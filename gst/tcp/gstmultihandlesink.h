@@ -205,6 +205,10 @@ struct _GstMultiHandleSink {
   gint qos_dscp;
 
   GArray *bufqueue;     /* global queue of buffers */
+  GArray *syncframes;   /* ascending absolute numbers of the keyframes
+                         * still in bufqueue, for O(log n) burst lookup */
+  guint64 buffers_total; /* total buffers ever queued; the head of
+                          * bufqueue has absolute number buffers_total - 1 */
 
   gboolean running;     /* the thread state */
   GThread *thread;      /* the sender thread */
@@ -230,6 +234,9 @@ struct _GstMultiHandleSink {
 
   gboolean resend_streamheader; /* resend streamheader if it changes */
 
+  GstCaps   *header_caps;  /* caps the flattened streamheader was built from */
+  GstBuffer *header_block; /* all streamheader buffers merged into one */
+
   /* stats */
   gint buffers_queued;  /* number of queued buffers */
   gint bytes_queued;    /* number of queued bytes */
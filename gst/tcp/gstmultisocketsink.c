@@ -773,22 +773,46 @@ gst_buffer_get_cmsg_list (GstBuffer * buf, GSocketControlMessage ** msgs,
 }
 
 #define CMSG_MAX 255
+#define VEC_MAX 32
 
+/* Send data from as many queued buffers as fit into one scatter-gather
+ * write, starting at @bufoffset into the first buffer of @sending.
+ * Control messages are only taken from the first buffer; a later buffer
+ * carrying its own control messages ends the batch so that the messages
+ * stay attached to their payload bytes. */
 static gssize
 gst_multi_socket_sink_write (GstMultiSocketSink * sink,
-    GSocket * sock, GstBuffer * buffer, gsize bufoffset,
+    GSocket * sock, GSList * sending, gsize bufoffset,
     GCancellable * cancellable, GError ** err)
 {
-  GstMapInfo maps[8];
-  GOutputVector vec[8];
-  guint mems_mapped;
+  GstMapInfo maps[VEC_MAX];
+  GOutputVector vec[VEC_MAX];
+  guint mems_mapped = 0;
   gssize wrote;
   GSocketControlMessage *cmsgs[CMSG_MAX];
   gsize msg_count;
+  GSList *walk;
 
-  mems_mapped = map_n_memory_output_vector (buffer, bufoffset, vec, maps, 8);
+  msg_count = gst_buffer_get_cmsg_list (sending->data, cmsgs, CMSG_MAX);
 
-  msg_count = gst_buffer_get_cmsg_list (buffer, cmsgs, CMSG_MAX);
+  for (walk = sending; walk != NULL && mems_mapped < VEC_MAX;
+      walk = walk->next) {
+    GstBuffer *buffer = walk->data;
+
+    if (walk != sending) {
+      GSocketControlMessage *scratch[1];
+
+      /* the dispatched event is emitted per completed write */
+      if (sink->send_dispatched)
+        break;
+      if (gst_buffer_get_cmsg_list (buffer, scratch, 1) > 0)
+        break;
+    }
+
+    mems_mapped += map_n_memory_output_vector (buffer,
+        walk == sending ? bufoffset : 0, vec + mems_mapped, maps + mems_mapped,
+        VEC_MAX - mems_mapped);
+  }
 
   wrote =
       g_socket_send_message (sock, NULL, vec, mems_mapped, cmsgs, msg_count, 0,
@@ -908,13 +932,10 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
     /* see if we need to send something */
     if (mhclient->sending) {
       gssize wrote;
-      GstBuffer *head;
-
-      /* pick first buffer from list */
-      head = GST_BUFFER (mhclient->sending->data);
 
-      wrote = gst_multi_socket_sink_write (sink, mhclient->handle.socket, head,
-          mhclient->bufoffset, sink->cancellable, &err);
+      /* write as much of the sending queue as fits in one call */
+      wrote = gst_multi_socket_sink_write (sink, mhclient->handle.socket,
+          mhclient->sending, mhclient->bufoffset, sink->cancellable, &err);
 
       if (wrote < 0) {
         /* hmm error.. */
@@ -930,30 +951,41 @@ gst_multi_socket_sink_handle_client_write (GstMultiSocketSink * sink,
           goto write_error;
         }
       } else {
-        if (wrote < (gst_buffer_get_size (head) - mhclient->bufoffset)) {
-          /* partial write, try again now */
-          GST_LOG_OBJECT (sink,
-              "partial write on %p of %" G_GSSIZE_FORMAT " bytes",
-              mhclient->handle.socket, wrote);
-          mhclient->bufoffset += wrote;
-        } else {
-          if (sink->send_dispatched) {
-            gst_pad_push_event (GST_BASE_SINK_PAD (mhsink),
-                gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
-                    gst_structure_new ("GstNetworkMessageDispatched",
-                        "object", G_TYPE_OBJECT, mhclient->handle.socket,
-                        "buffer", GST_TYPE_BUFFER, head, NULL)));
-          }
-          /* complete buffer was written, we can proceed to the next one */
-          mhclient->sending = g_slist_remove (mhclient->sending, head);
-          gst_buffer_unref (head);
-          /* make sure we start from byte 0 for the next buffer */
-          mhclient->bufoffset = 0;
-        }
+        gssize left = wrote;
+
         /* update stats */
         mhclient->bytes_sent += wrote;
         mhclient->last_activity_time = now;
         mhsink->bytes_served += wrote;
+
+        /* drop all buffers that were written out completely */
+        while (left > 0 && mhclient->sending) {
+          GstBuffer *head = GST_BUFFER (mhclient->sending->data);
+          gsize headleft = gst_buffer_get_size (head) - mhclient->bufoffset;
+
+          if ((gsize) left < headleft) {
+            /* partial write, try again now */
+            GST_LOG_OBJECT (sink,
+                "partial write on %p of %" G_GSSIZE_FORMAT " bytes",
+                mhclient->handle.socket, left);
+            mhclient->bufoffset += left;
+            left = 0;
+          } else {
+            if (sink->send_dispatched) {
+              gst_pad_push_event (GST_BASE_SINK_PAD (mhsink),
+                  gst_event_new_custom (GST_EVENT_CUSTOM_UPSTREAM,
+                      gst_structure_new ("GstNetworkMessageDispatched",
+                          "object", G_TYPE_OBJECT, mhclient->handle.socket,
+                          "buffer", GST_TYPE_BUFFER, head, NULL)));
+            }
+            /* complete buffer was written, we can proceed to the next one */
+            left -= headleft;
+            mhclient->sending = g_slist_remove (mhclient->sending, head);
+            gst_buffer_unref (head);
+            /* make sure we start from byte 0 for the next buffer */
+            mhclient->bufoffset = 0;
+          }
+        }
       }
     }
   } while (more);
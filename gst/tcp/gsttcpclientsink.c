@@ -169,12 +169,17 @@ gst_tcp_client_sink_setcaps (GstBaseSink * bsink, GstCaps * caps)
   return TRUE;
 }
 
+#define MAX_VEC 16
+
 static GstFlowReturn
 gst_tcp_client_sink_render (GstBaseSink * bsink, GstBuffer * buf)
 {
   GstTCPClientSink *sink;
-  GstMapInfo map;
-  gsize written = 0;
+  GstMapInfo maps[MAX_VEC];
+  GOutputVector vec[MAX_VEC];
+  guint n_mem, i;
+  gboolean merged = FALSE;
+  gsize size = 0, written = 0;
   gssize rret;
   GError *err = NULL;
 
@@ -183,26 +188,86 @@ gst_tcp_client_sink_render (GstBaseSink * bsink, GstBuffer * buf)
   g_return_val_if_fail (GST_OBJECT_FLAG_IS_SET (sink, GST_TCP_CLIENT_SINK_OPEN),
       GST_FLOW_FLUSHING);
 
-  gst_buffer_map (buf, &map, GST_MAP_READ);
+  /* map the memories separately so that buffers made of multiple
+   * GstMemory are sent with scatter-gather instead of being merged
+   * into a temporary copy by gst_buffer_map() */
+  n_mem = gst_buffer_n_memory (buf);
+  if (n_mem == 0)
+    return GST_FLOW_OK;
+
+  if (n_mem <= MAX_VEC) {
+    for (i = 0; i < n_mem; i++) {
+      GstMemory *mem = gst_buffer_peek_memory (buf, i);
+
+      if (!gst_memory_map (mem, &maps[i], GST_MAP_READ)) {
+        while (i-- > 0)
+          gst_memory_unmap (maps[i].memory, &maps[i]);
+        goto map_error;
+      }
+      vec[i].buffer = maps[i].data;
+      vec[i].size = maps[i].size;
+      size += maps[i].size;
+    }
+  } else {
+    /* unusually fragmented buffer, fall back to a merged map */
+    if (!gst_buffer_map (buf, &maps[0], GST_MAP_READ))
+      goto map_error;
+    vec[0].buffer = maps[0].data;
+    vec[0].size = maps[0].size;
+    size = maps[0].size;
+    n_mem = 1;
+    merged = TRUE;
+  }
+
   GST_LOG_OBJECT (sink, "writing %" G_GSIZE_FORMAT " bytes for buffer data",
-      map.size);
+      size);
 
   /* write buffer data */
-  while (written < map.size) {
-    rret =
-        g_socket_send (sink->socket, (gchar *) map.data + written,
-        map.size - written, sink->cancellable, &err);
-    if (rret < 0)
-      goto write_error;
-    written += rret;
+  {
+    GOutputVector *cur = vec;
+    guint n_left = n_mem;
+
+    while (written < size) {
+      gsize skip;
+
+      rret = g_socket_send_message (sink->socket, NULL, cur, n_left, NULL, 0,
+          0, sink->cancellable, &err);
+      if (rret < 0)
+        goto write_error;
+      written += rret;
+
+      /* skip the part that was sent for the next iteration */
+      skip = rret;
+      while (skip > 0 && skip >= cur->size) {
+        skip -= cur->size;
+        cur++;
+        n_left--;
+      }
+      if (skip > 0) {
+        cur->buffer = (const guint8 *) cur->buffer + skip;
+        cur->size -= skip;
+      }
+    }
+  }
+
+  if (merged) {
+    gst_buffer_unmap (buf, &maps[0]);
+  } else {
+    for (i = 0; i < n_mem; i++)
+      gst_memory_unmap (maps[i].memory, &maps[i]);
   }
-  gst_buffer_unmap (buf, &map);
 
   sink->data_written += written;
 
   return GST_FLOW_OK;
 
   /* ERRORS */
+map_error:
+  {
+    GST_ELEMENT_ERROR (sink, RESOURCE, READ, (NULL),
+        ("Failed to map the buffer for reading"));
+    return GST_FLOW_ERROR;
+  }
 write_error:
   {
     GstFlowReturn ret;
@@ -214,10 +279,15 @@ write_error:
       GST_ELEMENT_ERROR (sink, RESOURCE, WRITE,
           (_("Error while sending data to \"%s:%d\"."), sink->host, sink->port),
           ("Only %" G_GSIZE_FORMAT " of %" G_GSIZE_FORMAT " bytes written: %s",
-              written, map.size, err->message));
+              written, size, err->message));
       ret = GST_FLOW_ERROR;
     }
-    gst_buffer_unmap (buf, &map);
+    if (merged) {
+      gst_buffer_unmap (buf, &maps[0]);
+    } else {
+      for (i = 0; i < n_mem; i++)
+        gst_memory_unmap (maps[i].memory, &maps[i]);
+    }
     g_clear_error (&err);
     return ret;
   }
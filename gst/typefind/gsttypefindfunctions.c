@@ -2401,7 +2401,13 @@ static GstStaticCaps mpegts_caps = GST_STATIC_CAPS ("video/mpegts, "
 
 #define GST_MPEGTS_TYPEFIND_MIN_HEADERS 4
 #define GST_MPEGTS_TYPEFIND_MAX_HEADERS 10
+#define GST_MPEGTS_MIN_PACKET_SIZE 188
 #define GST_MPEGTS_MAX_PACKET_SIZE 208
+/* the smallest window that can still produce a positive result: the
+ * minimum number of headers spaced at the smallest packet size */
+#define GST_MPEGTS_TYPEFIND_MIN_SYNC_SIZE \
+            ((GST_MPEGTS_TYPEFIND_MIN_HEADERS - 1) * \
+             GST_MPEGTS_MIN_PACKET_SIZE + MPEGTS_HDR_SIZE)
 #define GST_MPEGTS_TYPEFIND_SYNC_SIZE \
             (GST_MPEGTS_TYPEFIND_MIN_HEADERS * GST_MPEGTS_MAX_PACKET_SIZE)
 #define GST_MPEGTS_TYPEFIND_MAX_SYNC \
@@ -2430,6 +2436,27 @@ mpeg_ts_probe_headers (GstTypeFind * tf, guint64 offset, gint packet_size)
   const guint8 *data = NULL;
 
   GST_LOG ("looking for mpeg-ts packets of size %u", packet_size);
+
+  /* try to grab the whole span in one go, so the per-packet checks run
+   * over a single mapped region instead of doing one peek per header */
+  data = gst_type_find_peek (tf, offset,
+      (GST_MPEGTS_TYPEFIND_MAX_HEADERS - 1) * packet_size + MPEGTS_HDR_SIZE);
+  if (data != NULL) {
+    while (found < GST_MPEGTS_TYPEFIND_MAX_HEADERS) {
+      data += packet_size;
+      offset += packet_size;
+
+      if (!IS_MPEGTS_HEADER (data))
+        break;
+
+      found++;
+      GST_LOG ("mpeg-ts sync #%2d at offset %" G_GUINT64_FORMAT, found,
+          offset);
+    }
+    return found;
+  }
+
+  /* not that much data available, check packet by packet */
   while (found < GST_MPEGTS_TYPEFIND_MAX_HEADERS) {
     offset += packet_size;
 
@@ -2459,12 +2486,42 @@ mpeg_ts_type_find (GstTypeFind * tf, gpointer unused)
   while (skipped < GST_MPEGTS_TYPEFIND_SCAN_LENGTH) {
     if (size < MPEGTS_HDR_SIZE) {
       data = gst_type_find_peek (tf, skipped, GST_MPEGTS_TYPEFIND_SYNC_SIZE);
-      if (!data)
-        break;
-      size = GST_MPEGTS_TYPEFIND_SYNC_SIZE;
+      if (data) {
+        size = GST_MPEGTS_TYPEFIND_SYNC_SIZE;
+      } else {
+        /* a short first buffer from a network source may not fill the
+         * full scan window yet; work with the smallest window that can
+         * still give a positive result, the per-packet probe copes with
+         * data running out */
+        data =
+            gst_type_find_peek (tf, skipped,
+            GST_MPEGTS_TYPEFIND_MIN_SYNC_SIZE);
+        if (!data)
+          break;
+        size = GST_MPEGTS_TYPEFIND_MIN_SYNC_SIZE;
+      }
     }
 
     /* Have at least MPEGTS_HDR_SIZE bytes at this point */
+
+    /* when not at a sync byte, let memchr() skip ahead to the next
+     * candidate; it tests the window in word-sized chunks */
+    if (data[0] != 0x47) {
+      const guint8 *sync;
+      guint flush;
+
+      sync = memchr (data, 0x47, size - (MPEGTS_HDR_SIZE - 1));
+      if (sync == NULL)
+        flush = size - (MPEGTS_HDR_SIZE - 1);
+      else
+        flush = sync - data;
+
+      skipped += flush;
+      data += flush;
+      size -= flush;
+      continue;
+    }
+
     if (IS_MPEGTS_HEADER (data)) {
       gint p;
 
@@ -711,9 +711,10 @@ gst_video_rate_flush_prev (GstVideoRate * videorate, gboolean duplicate,
   if (!videorate->prevbuf)
     goto eos_before_buffers;
 
-  outbuf = gst_buffer_ref (videorate->prevbuf);
-  /* make sure we can write to the metadata */
-  outbuf = gst_buffer_make_writable (outbuf);
+  /* we need a writable buffer to update the metadata. The copy shares
+   * the frame's GstMemory, so duplicating costs no pixel copies; only a
+   * downstream element asking for a writable frame would trigger one. */
+  outbuf = gst_buffer_copy (videorate->prevbuf);
 
   return gst_video_rate_push_buffer (videorate, outbuf, duplicate, next_intime);
 
@@ -93,6 +93,7 @@ GST_DEBUG_CATEGORY_STATIC (CAT_PERFORMANCE);
 #define DEFAULT_PROP_ENVELOPE     2.0
 #define DEFAULT_PROP_GAMMA_DECODE FALSE
 #define DEFAULT_PROP_N_THREADS    1
+#define DEFAULT_PROP_CASCADE_THRESHOLD 0.0
 
 enum
 {
@@ -105,7 +106,8 @@ enum
   PROP_SUBMETHOD,
   PROP_ENVELOPE,
   PROP_GAMMA_DECODE,
-  PROP_N_THREADS
+  PROP_N_THREADS,
+  PROP_CASCADE_THRESHOLD
 };
 
 #undef GST_VIDEO_SIZE_RANGE
@@ -270,6 +272,26 @@ gst_video_scale_class_init (GstVideoScaleClass * klass)
           DEFAULT_PROP_N_THREADS,
           G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstVideoScale:cascade-threshold:
+   *
+   * When both the horizontal and vertical downscale factor exceed this
+   * threshold, the image is first reduced in repeated 2:1 passes with a
+   * cheap 2-tap box filter before the configured method runs over the
+   * small remainder. This is much faster for large reductions and avoids
+   * the aliasing that short kernels produce there, at the cost of no
+   * longer being bit-identical to the single-pass output. A value of 0
+   * (the default) always scales in a single pass.
+   *
+   * Since: 1.14
+   */
+  g_object_class_install_property (gobject_class, PROP_CASCADE_THRESHOLD,
+      g_param_spec_double ("cascade-threshold", "Cascade Threshold",
+          "Downscale factor above which scaling runs as cascaded 2:1 "
+          "reductions followed by one precise pass (0 = single pass)",
+          0.0, G_MAXDOUBLE, DEFAULT_PROP_CASCADE_THRESHOLD,
+          G_PARAM_CONSTRUCT | G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class,
       "Video scaler", "Filter/Converter/Video/Scaler",
       "Resizes video", "Wim Taymans <wim.taymans@gmail.com>");
@@ -301,6 +323,21 @@ gst_video_scale_init (GstVideoScale * videoscale)
   videoscale->envelope = DEFAULT_PROP_ENVELOPE;
   videoscale->gamma_decode = DEFAULT_PROP_GAMMA_DECODE;
   videoscale->n_threads = DEFAULT_PROP_N_THREADS;
+  videoscale->cascade_threshold = DEFAULT_PROP_CASCADE_THRESHOLD;
+}
+
+static void
+gst_video_scale_free_prescale (GstVideoScale * videoscale)
+{
+  guint i;
+
+  for (i = 0; i < videoscale->n_prescale; i++) {
+    gst_video_converter_free (videoscale->prescale[i]);
+    videoscale->prescale[i] = NULL;
+    gst_buffer_unref (videoscale->prescale_buf[i]);
+    videoscale->prescale_buf[i] = NULL;
+  }
+  videoscale->n_prescale = 0;
 }
 
 static void
@@ -308,6 +345,7 @@ gst_video_scale_finalize (GstVideoScale * videoscale)
 {
   if (videoscale->convert)
     gst_video_converter_free (videoscale->convert);
+  gst_video_scale_free_prescale (videoscale);
 
   G_OBJECT_CLASS (parent_class)->finalize (G_OBJECT (videoscale));
 }
@@ -365,6 +403,12 @@ gst_video_scale_set_property (GObject * object, guint prop_id,
       vscale->n_threads = g_value_get_uint (value);
       GST_OBJECT_UNLOCK (vscale);
       break;
+    case PROP_CASCADE_THRESHOLD:
+      GST_OBJECT_LOCK (vscale);
+      vscale->cascade_threshold = g_value_get_double (value);
+      GST_OBJECT_UNLOCK (vscale);
+      gst_base_transform_reconfigure_src (GST_BASE_TRANSFORM_CAST (vscale));
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -423,6 +467,11 @@ gst_video_scale_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_uint (value, vscale->n_threads);
       GST_OBJECT_UNLOCK (vscale);
       break;
+    case PROP_CASCADE_THRESHOLD:
+      GST_OBJECT_LOCK (vscale);
+      g_value_set_double (value, vscale->cascade_threshold);
+      GST_OBJECT_UNLOCK (vscale);
+      break;
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -532,14 +581,72 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
     }
   }
 
+  gst_video_scale_free_prescale (videoscale);
+
   if (in_info->width == out_info->width && in_info->height == out_info->height
       && videoscale->borders_w == 0 && videoscale->borders_h == 0) {
     gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (filter), TRUE);
   } else {
     GstStructure *options;
+    GstVideoInfo scale_in = *in_info;
+    gint dest_w = out_info->width - videoscale->borders_w;
+    gint dest_h = out_info->height - videoscale->borders_h;
+
     GST_CAT_DEBUG_OBJECT (CAT_PERFORMANCE, filter, "setup videoscaling");
     gst_base_transform_set_passthrough (GST_BASE_TRANSFORM (filter), FALSE);
 
+    /* For large reductions, first halve the image in cheap 2-tap box
+     * passes until we are within a factor of 2 of the target, then let
+     * the configured method do the remaining precise pass. Each pass only
+     * reads half the data of the previous one, so the total cost is
+     * bounded by roughly twice the first halving. */
+    if (videoscale->cascade_threshold >= 2.0 && dest_w > 0 && dest_h > 0
+        && in_info->width >= dest_w * videoscale->cascade_threshold
+        && in_info->height >= dest_h * videoscale->cascade_threshold) {
+      while (videoscale->n_prescale < GST_VIDEO_SCALE_MAX_PRESCALE
+          && scale_in.width >= 2 * dest_w && scale_in.height >= 2 * dest_h) {
+        GstVideoInfo half;
+        GstStructure *popt;
+        guint n = videoscale->n_prescale;
+
+        gst_video_info_set_format (&half, GST_VIDEO_INFO_FORMAT (&scale_in),
+            GST_ROUND_UP_2 (scale_in.width / 2),
+            GST_ROUND_UP_2 (scale_in.height / 2));
+        half.interlace_mode = scale_in.interlace_mode;
+        half.colorimetry = scale_in.colorimetry;
+        half.chroma_site = scale_in.chroma_site;
+
+        popt = gst_structure_new_empty ("videoscale-prescale");
+        gst_structure_set (popt,
+            GST_VIDEO_CONVERTER_OPT_RESAMPLER_METHOD,
+            GST_TYPE_VIDEO_RESAMPLER_METHOD, GST_VIDEO_RESAMPLER_METHOD_LINEAR,
+            GST_VIDEO_RESAMPLER_OPT_MAX_TAPS, G_TYPE_INT, 2,
+            GST_VIDEO_CONVERTER_OPT_MATRIX_MODE, GST_TYPE_VIDEO_MATRIX_MODE,
+            GST_VIDEO_MATRIX_MODE_NONE,
+            GST_VIDEO_CONVERTER_OPT_DITHER_METHOD,
+            GST_TYPE_VIDEO_DITHER_METHOD, GST_VIDEO_DITHER_NONE,
+            GST_VIDEO_CONVERTER_OPT_CHROMA_MODE, GST_TYPE_VIDEO_CHROMA_MODE,
+            GST_VIDEO_CHROMA_MODE_NONE,
+            GST_VIDEO_CONVERTER_OPT_THREADS, G_TYPE_UINT,
+            videoscale->n_threads, NULL);
+
+        videoscale->prescale[n] = gst_video_converter_new (&scale_in, &half,
+            popt);
+        if (videoscale->prescale[n] == NULL)
+          break;
+
+        videoscale->prescale_info[n] = half;
+        videoscale->prescale_buf[n] = gst_buffer_new_allocate (NULL,
+            half.size, NULL);
+        videoscale->n_prescale++;
+        scale_in = half;
+      }
+      GST_CAT_DEBUG_OBJECT (CAT_PERFORMANCE, filter,
+          "using %u cascaded 2:1 passes down to %dx%d before the %dx%d pass",
+          videoscale->n_prescale, scale_in.width, scale_in.height,
+          dest_w, dest_h);
+    }
+
     options = gst_structure_new_empty ("videoscale");
 
     switch (videoscale->method) {
@@ -638,7 +745,8 @@ gst_video_scale_set_info (GstVideoFilter * filter, GstCaps * in,
 
     if (videoscale->convert)
       gst_video_converter_free (videoscale->convert);
-    videoscale->convert = gst_video_converter_new (in_info, out_info, options);
+    videoscale->convert = gst_video_converter_new (&scale_in, out_info,
+        options);
   }
 
   GST_DEBUG_OBJECT (videoscale, "from=%dx%d (par=%d/%d dar=%d/%d), size %"
@@ -1103,6 +1211,37 @@ gst_video_scale_transform_frame (GstVideoFilter * filter,
 
   GST_CAT_DEBUG_OBJECT (CAT_PERFORMANCE, filter, "doing video scaling");
 
+  if (videoscale->n_prescale > 0) {
+    GstVideoFrame tmp[GST_VIDEO_SCALE_MAX_PRESCALE];
+    GstVideoFrame *cur = in_frame;
+    guint i;
+
+    /* run the 2:1 reductions into the reusable intermediate buffers,
+     * then the precise pass from the last one into the output */
+    for (i = 0; i < videoscale->n_prescale; i++) {
+      if (!gst_video_frame_map (&tmp[i], &videoscale->prescale_info[i],
+              videoscale->prescale_buf[i], GST_MAP_READWRITE))
+        goto map_failed;
+      gst_video_converter_frame (videoscale->prescale[i], cur, &tmp[i]);
+      if (i > 0)
+        gst_video_frame_unmap (&tmp[i - 1]);
+      cur = &tmp[i];
+    }
+    gst_video_converter_frame (videoscale->convert, cur, out_frame);
+    gst_video_frame_unmap (&tmp[videoscale->n_prescale - 1]);
+
+    return ret;
+
+  map_failed:
+    {
+      if (i > 0)
+        gst_video_frame_unmap (&tmp[i - 1]);
+      GST_ELEMENT_ERROR (videoscale, RESOURCE, FAILED, (NULL),
+          ("failed to map intermediate scaling buffer"));
+      return GST_FLOW_ERROR;
+    }
+  }
+
   gst_video_converter_frame (videoscale->convert, in_frame, out_frame);
 
   return ret;
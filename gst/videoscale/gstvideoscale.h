@@ -71,6 +71,9 @@ typedef enum {
 typedef struct _GstVideoScale GstVideoScale;
 typedef struct _GstVideoScaleClass GstVideoScaleClass;
 
+/* enough for a 256:1 reduction before the final pass */
+#define GST_VIDEO_SCALE_MAX_PRESCALE 8
+
 /**
  * GstVideoScale:
  *
@@ -89,9 +92,17 @@ struct _GstVideoScale {
   double envelope;
   gboolean gamma_decode;
   gint n_threads;
+  gdouble cascade_threshold;
 
   GstVideoConverter *convert;
 
+  /* cascaded 2:1 box reductions done before @convert when the downscale
+   * factor exceeds cascade-threshold, with reusable intermediate buffers */
+  GstVideoConverter *prescale[GST_VIDEO_SCALE_MAX_PRESCALE];
+  GstVideoInfo prescale_info[GST_VIDEO_SCALE_MAX_PRESCALE];
+  GstBuffer *prescale_buf[GST_VIDEO_SCALE_MAX_PRESCALE];
+  guint n_prescale;
+
   gint borders_h;
   gint borders_w;
 };
@@ -670,6 +670,9 @@ gst_video_test_src_set_property (GObject * object, guint prop_id,
     default:
       break;
   }
+  /* any property can change what a static pattern looks like, including
+   * via a controller, so drop the cached rendering */
+  gst_buffer_replace (&src->cached_frame, NULL);
 }
 
 static void
@@ -902,6 +905,8 @@ gst_video_test_src_setcaps (GstBaseSrc * bsrc, GstCaps * caps)
     goto unsupported_caps;
   }
 
+  gst_buffer_replace (&videotestsrc->cached_frame, NULL);
+
   /* create chroma subsampler */
   if (videotestsrc->subsample)
     gst_video_chroma_resample_free (videotestsrc->subsample);
@@ -1113,6 +1118,39 @@ gst_video_test_src_is_seekable (GstBaseSrc * psrc)
   return TRUE;
 }
 
+/* patterns that produce the same image for every frame; smpte is not in
+ * this list because of its random noise segment, and scrolling makes
+ * any pattern time-dependent */
+static gboolean
+gst_video_test_src_pattern_is_static (GstVideoTestSrc * src)
+{
+  if (src->horizontal_speed != 0)
+    return FALSE;
+
+  switch (src->pattern_type) {
+    case GST_VIDEO_TEST_SRC_BLACK:
+    case GST_VIDEO_TEST_SRC_WHITE:
+    case GST_VIDEO_TEST_SRC_RED:
+    case GST_VIDEO_TEST_SRC_GREEN:
+    case GST_VIDEO_TEST_SRC_BLUE:
+    case GST_VIDEO_TEST_SRC_CHECKERS1:
+    case GST_VIDEO_TEST_SRC_CHECKERS2:
+    case GST_VIDEO_TEST_SRC_CHECKERS4:
+    case GST_VIDEO_TEST_SRC_CHECKERS8:
+    case GST_VIDEO_TEST_SRC_CIRCULAR:
+    case GST_VIDEO_TEST_SRC_SMPTE75:
+    case GST_VIDEO_TEST_SRC_GAMUT:
+    case GST_VIDEO_TEST_SRC_SOLID:
+    case GST_VIDEO_TEST_SRC_SMPTE100:
+    case GST_VIDEO_TEST_SRC_BAR:
+    case GST_VIDEO_TEST_SRC_GRADIENT:
+    case GST_VIDEO_TEST_SRC_COLORS:
+      return TRUE;
+    default:
+      return FALSE;
+  }
+}
+
 static GstFlowReturn
 gst_video_test_src_fill (GstPushSrc * psrc, GstBuffer * buffer)
 {
@@ -1149,7 +1187,38 @@ gst_video_test_src_fill (GstPushSrc * psrc, GstBuffer * buffer)
 
   gst_object_sync_values (GST_OBJECT (psrc), GST_BUFFER_PTS (buffer));
 
-  src->make_image (src, GST_BUFFER_PTS (buffer), &frame);
+  /* render time-invariant patterns once and then only copy the cached
+   * image; regenerating them per frame walks every pixel through the
+   * scalar paint functions */
+  if (src->cached_frame == NULL
+      && gst_video_test_src_pattern_is_static (src)) {
+    GstVideoFrame cframe;
+    GstBuffer *cached;
+
+    cached = gst_buffer_new_allocate (NULL, src->info.size, NULL);
+    if (cached != NULL
+        && gst_video_frame_map (&cframe, &src->info, cached, GST_MAP_WRITE)) {
+      src->make_image (src, GST_BUFFER_PTS (buffer), &cframe);
+      gst_video_frame_unmap (&cframe);
+      src->cached_frame = cached;
+    } else if (cached != NULL) {
+      gst_buffer_unref (cached);
+    }
+  }
+
+  if (src->cached_frame != NULL) {
+    GstVideoFrame cframe;
+
+    if (gst_video_frame_map (&cframe, &src->info, src->cached_frame,
+            GST_MAP_READ)) {
+      gst_video_frame_copy (&frame, &cframe);
+      gst_video_frame_unmap (&cframe);
+    } else {
+      src->make_image (src, GST_BUFFER_PTS (buffer), &frame);
+    }
+  } else {
+    src->make_image (src, GST_BUFFER_PTS (buffer), &frame);
+  }
 
   if ((pal = gst_video_format_get_palette (GST_VIDEO_FRAME_FORMAT (&frame),
               &palsize))) {
@@ -1239,6 +1308,7 @@ gst_video_test_src_stop (GstBaseSrc * basesrc)
   if (src->subsample)
     gst_video_chroma_resample_free (src->subsample);
   src->subsample = NULL;
+  gst_buffer_replace (&src->cached_frame, NULL);
 
   for (i = 0; i < src->n_lines; i++)
     g_free (src->lines[i]);
@@ -197,6 +197,10 @@ struct _GstVideoTestSrc {
 
   void (*make_image) (GstVideoTestSrc *v, GstClockTime pts, GstVideoFrame *frame);
 
+  /* rendering of a time-invariant pattern for the current caps and
+   * properties, or NULL when the pattern animates or was invalidated */
+  GstBuffer *cached_frame;
+
   /* temporary AYUV/ARGB scanline */
   guint8 *tmpline_u8;
   guint8 *tmpline;
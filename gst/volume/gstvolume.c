@@ -49,6 +49,7 @@
 #include <gst/audio/gstaudiofilter.h>
 
 #ifdef HAVE_ORC
+#include <orc/orc.h>
 #include <orc/orcfunctions.h>
 #else
 #define orc_memset memset
@@ -96,7 +97,8 @@ enum
 {
   PROP_0,
   PROP_MUTE,
-  PROP_VOLUME
+  PROP_VOLUME,
+  PROP_CHANNEL_VOLUMES
 };
 
 #if G_BYTE_ORDER == G_LITTLE_ENDIAN
@@ -159,6 +161,18 @@ static void volume_process_int8_clamp (GstVolume * self, gpointer bytes,
     guint n_bytes);
 static void volume_process_controlled_int8_clamp (GstVolume * self,
     gpointer bytes, gdouble * volume, guint channels, guint n_bytes);
+static void volume_process_channels_double (GstVolume * self, gpointer bytes,
+    guint n_bytes);
+static void volume_process_channels_float (GstVolume * self, gpointer bytes,
+    guint n_bytes);
+static void volume_process_channels_int32_clamp (GstVolume * self,
+    gpointer bytes, guint n_bytes);
+static void volume_process_channels_int24_clamp (GstVolume * self,
+    gpointer bytes, guint n_bytes);
+static void volume_process_channels_int16_clamp (GstVolume * self,
+    gpointer bytes, guint n_bytes);
+static void volume_process_channels_int8_clamp (GstVolume * self,
+    gpointer bytes, guint n_bytes);
 
 
 /* helper functions */
@@ -170,6 +184,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
 
   self->process = NULL;
   self->process_controlled = NULL;
+  self->process_channels = NULL;
 
   format = GST_AUDIO_INFO_FORMAT (info);
 
@@ -185,6 +200,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int32;
       }
       self->process_controlled = volume_process_controlled_int32_clamp;
+      self->process_channels = volume_process_channels_int32_clamp;
       break;
     case GST_AUDIO_FORMAT_S24:
       /* only clamp if the gain is greater than 1.0 */
@@ -194,6 +210,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int24;
       }
       self->process_controlled = volume_process_controlled_int24_clamp;
+      self->process_channels = volume_process_channels_int24_clamp;
       break;
     case GST_AUDIO_FORMAT_S16:
       /* only clamp if the gain is greater than 1.0 */
@@ -203,6 +220,7 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int16;
       }
       self->process_controlled = volume_process_controlled_int16_clamp;
+      self->process_channels = volume_process_channels_int16_clamp;
       break;
     case GST_AUDIO_FORMAT_S8:
       /* only clamp if the gain is greater than 1.0 */
@@ -212,14 +230,17 @@ volume_choose_func (GstVolume * self, const GstAudioInfo * info)
         self->process = volume_process_int8;
       }
       self->process_controlled = volume_process_controlled_int8_clamp;
+      self->process_channels = volume_process_channels_int8_clamp;
       break;
     case GST_AUDIO_FORMAT_F32:
       self->process = volume_process_float;
       self->process_controlled = volume_process_controlled_float;
+      self->process_channels = volume_process_channels_float;
       break;
     case GST_AUDIO_FORMAT_F64:
       self->process = volume_process_double;
       self->process_controlled = volume_process_controlled_double;
+      self->process_channels = volume_process_channels_double;
       break;
     default:
       break;
@@ -263,6 +284,32 @@ volume_update_volume (GstVolume * self, const GstAudioInfo * info,
     passthrough = (self->current_vol_i16 == VOLUME_UNITY_INT16);
   }
 
+  /* refresh the per-channel gain table; the main volume is premultiplied
+   * so the process functions only do one multiply per sample */
+  g_free (self->current_chan_vols);
+  self->current_chan_vols = NULL;
+  GST_OBJECT_LOCK (self);
+  if (!mute && self->n_channel_volumes > 0) {
+    guint channels = GST_AUDIO_INFO_CHANNELS (info);
+
+    if (self->n_channel_volumes == channels) {
+      guint i;
+
+      self->current_chan_vols = g_new (gdouble, channels);
+      for (i = 0; i < channels; i++)
+        self->current_chan_vols[i] = volume * self->channel_volumes[i];
+    } else {
+      GST_WARNING_OBJECT (self, "channel-volumes has %u values but the "
+          "stream has %u channels, ignoring it", self->n_channel_volumes,
+          channels);
+    }
+  }
+  self->channel_volumes_dirty = FALSE;
+  GST_OBJECT_UNLOCK (self);
+
+  if (self->current_chan_vols)
+    passthrough = FALSE;
+
   /* If a controller is used, never use passthrough mode
    * because the property can change from 1.0 to something
    * else in the middle of a buffer.
@@ -292,6 +339,12 @@ gst_volume_dispose (GObject * object)
     volume->tracklist = NULL;
   }
 
+  g_free (volume->channel_volumes);
+  volume->channel_volumes = NULL;
+  volume->n_channel_volumes = 0;
+  g_free (volume->current_chan_vols);
+  volume->current_chan_vols = NULL;
+
   G_OBJECT_CLASS (parent_class)->dispose (object);
 }
 
@@ -323,6 +376,22 @@ gst_volume_class_init (GstVolumeClass * klass)
           0.0, VOLUME_MAX_DOUBLE, DEFAULT_PROP_VOLUME,
           G_PARAM_READWRITE | GST_PARAM_CONTROLLABLE | G_PARAM_STATIC_STRINGS));
 
+  /**
+   * GstVolume:channel-volumes:
+   *
+   * Per-channel volume factors, applied on top of the main volume. The
+   * array must either be empty (per-channel scaling disabled) or have
+   * exactly one value per channel of the negotiated format. This allows
+   * e.g. balance corrections without a second element in the chain.
+   */
+  g_object_class_install_property (gobject_class, PROP_CHANNEL_VOLUMES,
+      gst_param_spec_array ("channel-volumes", "Channel volumes",
+          "Per-channel volume factors applied on top of the main volume",
+          g_param_spec_double ("volume", "Volume",
+              "Volume factor for one channel", 0.0, VOLUME_MAX_DOUBLE,
+              DEFAULT_PROP_VOLUME, G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS),
+          G_PARAM_READWRITE | G_PARAM_STATIC_STRINGS));
+
   gst_element_class_set_static_metadata (element_class, "Volume",
       "Filter/Effect/Audio",
       "Set volume on audio/raw streams", "Andy Wingo <wingo@pobox.com>");
@@ -345,6 +414,10 @@ gst_volume_init (GstVolume * self)
   self->mute = DEFAULT_PROP_MUTE;
   self->volume = DEFAULT_PROP_VOLUME;
 
+  self->channel_volumes = NULL;
+  self->n_channel_volumes = 0;
+  self->current_chan_vols = NULL;
+
   self->tracklist = NULL;
   self->negotiated = FALSE;
 
@@ -639,6 +712,117 @@ volume_process_controlled_int8_clamp (GstVolume * self, gpointer bytes,
   }
 }
 
+/* per-channel variants, used when the "channel-volumes" property is set;
+ * the gains in current_chan_vols already include the main volume */
+
+static void
+volume_process_channels_double (GstVolume * self, gpointer bytes,
+    guint n_bytes)
+{
+  gdouble *data = (gdouble *) bytes;
+  const gdouble *vols = self->current_chan_vols;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (self);
+  guint num_samples = n_bytes / (sizeof (gdouble) * channels);
+  guint i, j;
+
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++)
+      *data++ *= vols[j];
+  }
+}
+
+static void
+volume_process_channels_float (GstVolume * self, gpointer bytes, guint n_bytes)
+{
+  gfloat *data = (gfloat *) bytes;
+  const gdouble *vols = self->current_chan_vols;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (self);
+  guint num_samples = n_bytes / (sizeof (gfloat) * channels);
+  guint i, j;
+
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++)
+      *data++ *= vols[j];
+  }
+}
+
+static void
+volume_process_channels_int32_clamp (GstVolume * self, gpointer bytes,
+    guint n_bytes)
+{
+  gint32 *data = (gint32 *) bytes;
+  const gdouble *vols = self->current_chan_vols;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (self);
+  guint num_samples = n_bytes / (sizeof (gint32) * channels);
+  guint i, j;
+  gdouble val;
+
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++) {
+      val = *data * vols[j];
+      *data++ = (gint32) CLAMP (val, VOLUME_MIN_INT32, VOLUME_MAX_INT32);
+    }
+  }
+}
+
+static void
+volume_process_channels_int24_clamp (GstVolume * self, gpointer bytes,
+    guint n_bytes)
+{
+  gint8 *data = (gint8 *) bytes;        /* treat the data as a byte stream */
+  const gdouble *vols = self->current_chan_vols;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (self);
+  guint num_samples = n_bytes / (sizeof (gint8) * 3 * channels);
+  guint i, j;
+  gdouble val;
+
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++) {
+      val = get_unaligned_i24 (data) * vols[j];
+      val = CLAMP (val, VOLUME_MIN_INT24, VOLUME_MAX_INT24);
+      write_unaligned_u24 (data, (gint32) val);
+    }
+  }
+}
+
+static void
+volume_process_channels_int16_clamp (GstVolume * self, gpointer bytes,
+    guint n_bytes)
+{
+  gint16 *data = (gint16 *) bytes;
+  const gdouble *vols = self->current_chan_vols;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (self);
+  guint num_samples = n_bytes / (sizeof (gint16) * channels);
+  guint i, j;
+  gdouble val;
+
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++) {
+      val = *data * vols[j];
+      *data++ = (gint16) CLAMP (val, VOLUME_MIN_INT16, VOLUME_MAX_INT16);
+    }
+  }
+}
+
+static void
+volume_process_channels_int8_clamp (GstVolume * self, gpointer bytes,
+    guint n_bytes)
+{
+  gint8 *data = (gint8 *) bytes;
+  const gdouble *vols = self->current_chan_vols;
+  guint channels = GST_AUDIO_FILTER_CHANNELS (self);
+  guint num_samples = n_bytes / (sizeof (gint8) * channels);
+  guint i, j;
+  gdouble val;
+
+  for (i = 0; i < num_samples; i++) {
+    for (j = 0; j < channels; j++) {
+      val = *data * vols[j];
+      *data++ = (gint8) CLAMP (val, VOLUME_MIN_INT8, VOLUME_MAX_INT8);
+    }
+  }
+}
+
 /* GstBaseTransform vmethod implementations */
 
 /* get notified of caps and plug in the correct process function */
@@ -706,7 +890,8 @@ volume_before_transform (GstBaseTransform * base, GstBuffer * buffer)
   mute = self->mute;
   GST_OBJECT_UNLOCK (self);
 
-  if ((volume != self->current_volume) || (mute != self->current_mute)) {
+  if ((volume != self->current_volume) || (mute != self->current_mute)
+      || self->channel_volumes_dirty) {
     /* the volume or mute was updated, update our internal state before
      * we continue processing. */
     volume_update_volume (self, GST_AUDIO_FILTER_INFO (self), volume, mute);
@@ -796,6 +981,8 @@ volume_transform_ip (GstBaseTransform * base, GstBuffer * outbuf)
   if (self->current_volume == 0.0 || self->current_mute) {
     orc_memset (map.data, 0, map.size);
     GST_BUFFER_FLAG_SET (outbuf, GST_BUFFER_FLAG_GAP);
+  } else if (self->current_chan_vols != NULL) {
+    self->process_channels (self, map.data, map.size);
   } else if (self->current_volume != 1.0) {
     self->process (self, map.data, map.size);
   }
@@ -831,6 +1018,23 @@ volume_set_property (GObject * object, guint prop_id, const GValue * value,
       self->volume = g_value_get_double (value);
       GST_OBJECT_UNLOCK (self);
       break;
+    case PROP_CHANNEL_VOLUMES:{
+      guint i, n = gst_value_array_get_size (value);
+      gdouble *vols = NULL;
+
+      if (n > 0) {
+        vols = g_new (gdouble, n);
+        for (i = 0; i < n; i++)
+          vols[i] = g_value_get_double (gst_value_array_get_value (value, i));
+      }
+      GST_OBJECT_LOCK (self);
+      g_free (self->channel_volumes);
+      self->channel_volumes = vols;
+      self->n_channel_volumes = n;
+      self->channel_volumes_dirty = TRUE;
+      GST_OBJECT_UNLOCK (self);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -854,6 +1058,20 @@ volume_get_property (GObject * object, guint prop_id, GValue * value,
       g_value_set_double (value, self->volume);
       GST_OBJECT_UNLOCK (self);
       break;
+    case PROP_CHANNEL_VOLUMES:{
+      guint i;
+
+      GST_OBJECT_LOCK (self);
+      for (i = 0; i < self->n_channel_volumes; i++) {
+        GValue v = G_VALUE_INIT;
+
+        g_value_init (&v, G_TYPE_DOUBLE);
+        g_value_set_double (&v, self->channel_volumes[i]);
+        gst_value_array_append_and_take_value (value, &v);
+      }
+      GST_OBJECT_UNLOCK (self);
+      break;
+    }
     default:
       G_OBJECT_WARN_INVALID_PROPERTY_ID (object, prop_id, pspec);
       break;
@@ -865,6 +1083,28 @@ plugin_init (GstPlugin * plugin)
 {
   GST_DEBUG_CATEGORY_INIT (GST_CAT_DEFAULT, "volume", 0, "Volume gain");
 
+#ifdef HAVE_ORC
+  {
+    /* log the code generation target once, so the debug log shows when
+     * the processing loops run on a scalar fallback */
+    OrcTarget *target;
+
+    orc_init ();
+    if ((target = orc_target_get_default ())) {
+      guint flags = orc_target_get_default_flags (target);
+      gint i;
+
+      GST_INFO ("orc target %s, default flags %08x",
+          orc_target_get_name (target), flags);
+      for (i = 0; i < 32; i++) {
+        if (flags & (1U << i))
+          GST_INFO ("orc target flag %s",
+              orc_target_get_flag_name (target, i));
+      }
+    }
+  }
+#endif
+
   return gst_element_register (plugin, "volume", GST_RANK_NONE,
       GST_TYPE_VOLUME);
 }
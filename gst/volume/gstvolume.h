@@ -56,13 +56,24 @@ struct _GstVolume {
 
   void (*process)(GstVolume*, gpointer, guint);
   void (*process_controlled)(GstVolume*, gpointer, gdouble *, guint, guint);
+  void (*process_channels)(GstVolume*, gpointer, guint);
 
   gboolean mute;
   gfloat volume;
 
+  /* per-channel volume factors ("channel-volumes" property), protected
+   * by the object lock; empty means disabled */
+  gdouble *channel_volumes;
+  guint n_channel_volumes;
+  gboolean channel_volumes_dirty;
+
   gboolean current_mute;
   gdouble current_volume;
 
+  /* main volume premultiplied with the per-channel factors, one entry
+   * per negotiated channel, or NULL when per-channel scaling is off */
+  gdouble *current_chan_vols;
+
   gint   current_vol_i32;
   gint   current_vol_i24; /* the _i(nt) values get synchronized with the */
   gint   current_vol_i16; /* the _i(nt) values get synchronized with the */
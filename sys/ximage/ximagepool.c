@@ -56,6 +56,82 @@ gst_ximage_memory_alloc (GstAllocator * allocator, gsize size,
   return NULL;
 }
 
+#ifdef HAVE_XSHM
+/* an XShm segment that is still attached on both sides, kept on the sink
+ * so it survives buffer pool renegotiation. All cache functions must be
+ * called with x_lock held. */
+typedef struct
+{
+  XShmSegmentInfo SHMInfo;
+  size_t size;
+} GstXImageShmSegment;
+
+#define GST_XIMAGE_SHM_CACHE_MAX 8
+
+/* take a cached segment of at least @size bytes, or return FALSE */
+static gboolean
+gst_ximage_shm_cache_take (GstXImageSink * ximagesink, size_t size,
+    XShmSegmentInfo * SHMInfo, size_t * seg_size)
+{
+  GSList *l;
+
+  for (l = ximagesink->shm_cache; l != NULL; l = l->next) {
+    GstXImageShmSegment *seg = l->data;
+
+    if (seg->size >= size) {
+      *SHMInfo = seg->SHMInfo;
+      *seg_size = seg->size;
+      ximagesink->shm_cache = g_slist_delete_link (ximagesink->shm_cache, l);
+      g_slice_free (GstXImageShmSegment, seg);
+      return TRUE;
+    }
+  }
+  return FALSE;
+}
+
+/* keep a segment attached for later reuse; returns FALSE if the cache
+ * is full and the caller should detach it normally */
+static gboolean
+gst_ximage_shm_cache_offer (GstXImageSink * ximagesink,
+    const XShmSegmentInfo * SHMInfo, size_t size)
+{
+  GstXImageShmSegment *seg;
+
+  if (g_slist_length (ximagesink->shm_cache) >= GST_XIMAGE_SHM_CACHE_MAX)
+    return FALSE;
+
+  seg = g_slice_new (GstXImageShmSegment);
+  seg->SHMInfo = *SHMInfo;
+  seg->size = size;
+  ximagesink->shm_cache = g_slist_prepend (ximagesink->shm_cache, seg);
+
+  return TRUE;
+}
+
+/* detach and free all cached segments; the display must still be open */
+void
+gst_ximage_shm_cache_clear (GstXImageSink * ximagesink, GstXContext * xcontext)
+{
+  GSList *l;
+
+  if (ximagesink->shm_cache == NULL)
+    return;
+
+  for (l = ximagesink->shm_cache; l != NULL; l = l->next) {
+    GstXImageShmSegment *seg = l->data;
+
+    GST_DEBUG_OBJECT (ximagesink, "XServer ShmDetaching from 0x%x id 0x%lx",
+        seg->SHMInfo.shmid, seg->SHMInfo.shmseg);
+    XShmDetach (xcontext->disp, &seg->SHMInfo);
+    shmdt (seg->SHMInfo.shmaddr);
+    g_slice_free (GstXImageShmSegment, seg);
+  }
+  XSync (xcontext->disp, FALSE);
+  g_slist_free (ximagesink->shm_cache);
+  ximagesink->shm_cache = NULL;
+}
+#endif /* HAVE_XSHM */
+
 static void
 gst_ximage_memory_free (GstAllocator * allocator, GstMemory * gmem)
 {
@@ -89,11 +165,18 @@ gst_ximage_memory_free (GstAllocator * allocator, GstMemory * gmem)
 #ifdef HAVE_XSHM
   if (ximagesink->xcontext->use_xshm) {
     if (mem->SHMInfo.shmaddr != ((void *) -1)) {
-      GST_DEBUG_OBJECT (ximagesink, "XServer ShmDetaching from 0x%x id 0x%lx",
-          mem->SHMInfo.shmid, mem->SHMInfo.shmseg);
-      XShmDetach (ximagesink->xcontext->disp, &mem->SHMInfo);
-      XSync (ximagesink->xcontext->disp, FALSE);
-      shmdt (mem->SHMInfo.shmaddr);
+      /* try to keep the segment attached for the next pool generation */
+      if (gst_ximage_shm_cache_offer (ximagesink, &mem->SHMInfo,
+              mem->shm_size)) {
+        GST_DEBUG_OBJECT (ximagesink, "caching shm segment 0x%x id 0x%lx",
+            mem->SHMInfo.shmid, mem->SHMInfo.shmseg);
+      } else {
+        GST_DEBUG_OBJECT (ximagesink, "XServer ShmDetaching from 0x%x id 0x%lx",
+            mem->SHMInfo.shmid, mem->SHMInfo.shmseg);
+        XShmDetach (ximagesink->xcontext->disp, &mem->SHMInfo);
+        XSync (ximagesink->xcontext->disp, FALSE);
+        shmdt (mem->SHMInfo.shmaddr);
+      }
       mem->SHMInfo.shmaddr = (void *) -1;
     }
     if (mem->ximage)
@@ -277,32 +360,44 @@ ximage_memory_alloc (GstXImageBufferPool * xpool)
 
     /* get shared memory */
     align = 0;
-    mem->SHMInfo.shmid =
-        shmget (IPC_PRIVATE, mem->size + align, IPC_CREAT | 0777);
-    if (mem->SHMInfo.shmid == -1)
-      goto shmget_failed;
-
-    /* attach */
-    mem->SHMInfo.shmaddr = shmat (mem->SHMInfo.shmid, NULL, 0);
-    if (mem->SHMInfo.shmaddr == ((void *) -1))
-      goto shmat_failed;
-
-    /* now we can set up the image data */
-    mem->ximage->data = mem->SHMInfo.shmaddr;
-    mem->SHMInfo.readOnly = FALSE;
-
-    if (XShmAttach (xcontext->disp, &mem->SHMInfo) == 0)
-      goto xattach_failed;
-
-    XSync (xcontext->disp, FALSE);
-
-    /* Now that everyone has attached, we can delete the shared memory segment.
-     * This way, it will be deleted as soon as we detach later, and not
-     * leaked if we crash. */
-    shmctl (mem->SHMInfo.shmid, IPC_RMID, NULL);
 
-    GST_DEBUG_OBJECT (ximagesink, "XServer ShmAttached to 0x%x, id 0x%lx",
-        mem->SHMInfo.shmid, mem->SHMInfo.shmseg);
+    if (gst_ximage_shm_cache_take (ximagesink, mem->size, &mem->SHMInfo,
+            &mem->shm_size)) {
+      /* segment is still attached on both sides, just point the image
+       * at it */
+      GST_DEBUG_OBJECT (ximagesink, "reusing shm segment 0x%x id 0x%lx for "
+          "%" G_GSIZE_FORMAT " bytes", mem->SHMInfo.shmid,
+          mem->SHMInfo.shmseg, mem->size);
+      mem->ximage->data = mem->SHMInfo.shmaddr;
+    } else {
+      mem->SHMInfo.shmid =
+          shmget (IPC_PRIVATE, mem->size + align, IPC_CREAT | 0777);
+      if (mem->SHMInfo.shmid == -1)
+        goto shmget_failed;
+
+      /* attach */
+      mem->SHMInfo.shmaddr = shmat (mem->SHMInfo.shmid, NULL, 0);
+      if (mem->SHMInfo.shmaddr == ((void *) -1))
+        goto shmat_failed;
+
+      /* now we can set up the image data */
+      mem->ximage->data = mem->SHMInfo.shmaddr;
+      mem->SHMInfo.readOnly = FALSE;
+      mem->shm_size = mem->size;
+
+      if (XShmAttach (xcontext->disp, &mem->SHMInfo) == 0)
+        goto xattach_failed;
+
+      XSync (xcontext->disp, FALSE);
+
+      /* Now that everyone has attached, we can delete the shared memory
+       * segment. This way, it will be deleted as soon as we detach later,
+       * and not leaked if we crash. */
+      shmctl (mem->SHMInfo.shmid, IPC_RMID, NULL);
+
+      GST_DEBUG_OBJECT (ximagesink, "XServer ShmAttached to 0x%x, id 0x%lx",
+          mem->SHMInfo.shmid, mem->SHMInfo.shmseg);
+    }
   } else
   no_xshm:
 #endif /* HAVE_XSHM */
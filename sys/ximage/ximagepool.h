@@ -67,6 +67,8 @@ struct _GstXImageMemory
 
 #ifdef HAVE_XSHM
   XShmSegmentInfo SHMInfo;
+  size_t shm_size;              /* size of the segment, can be bigger than
+                                 * the image when the segment was recycled */
 #endif                          /* HAVE_XSHM */
 
   gint x, y;
@@ -108,6 +110,11 @@ GstBufferPool * gst_ximage_buffer_pool_new     (GstXImageSink * ximagesink);
 gboolean gst_x_image_sink_check_xshm_calls (GstXImageSink * ximagesink,
         GstXContext * xcontext);
 
+#ifdef HAVE_XSHM
+void gst_ximage_shm_cache_clear (GstXImageSink * ximagesink,
+        GstXContext * xcontext);
+#endif /* HAVE_XSHM */
+
 G_END_DECLS
 
 #endif /* __GST_XIMAGEPOOL_H__ */
@@ -997,6 +997,10 @@ gst_x_image_sink_xcontext_clear (GstXImageSink * ximagesink)
 
   g_mutex_lock (&ximagesink->x_lock);
 
+#ifdef HAVE_XSHM
+  gst_ximage_shm_cache_clear (ximagesink, xcontext);
+#endif
+
   XCloseDisplay (xcontext->disp);
 
   g_mutex_unlock (&ximagesink->x_lock);
@@ -1896,6 +1900,7 @@ gst_x_image_sink_init (GstXImageSink * ximagesink)
   ximagesink->par = NULL;
 
   ximagesink->pool = NULL;
+  ximagesink->shm_cache = NULL;
 
   ximagesink->synchronous = FALSE;
   ximagesink->keep_aspect = TRUE;
@@ -189,6 +189,11 @@ struct _GstXImageSink
   /* the buffer pool */
   GstBufferPool *pool;
 
+  /* XShm segments kept attached across buffer pool generations so
+   * renegotiation doesn't redo the shmget/shmat/XShmAttach dance;
+   * protected by x_lock */
+  GSList *shm_cache;
+
   gboolean synchronous;
   gboolean keep_aspect;
   gboolean handle_events;
@@ -169,6 +169,13 @@ struct _GstXvContext
   gint last_format;
   gint last_width;
   gint last_height;
+
+  /* asynchronous XvShmPutImage: the XShmCompletionEvent event type of
+   * this display and whether a put is still in flight, so we only have
+   * to wait for the previous frame when submitting the next one instead
+   * of doing a full XSync round trip per frame. Protected by lock. */
+  gint shm_completion_type;
+  gboolean shm_put_pending;
 };
 
 GType gst_xvcontext_get_type (void);
@@ -624,6 +624,33 @@ gst_xwindow_draw_borders (GstXWindow * window, GstVideoRectangle * rect)
   }
 }
 
+#ifdef HAVE_XSHM
+/* wait for the completion event of the previous XvShmPutImage so the
+ * buffer it was reading from can safely be handed out again. Polls the
+ * event queue with a bounded timeout and falls back to XSync if the
+ * event never shows up. Called with the context lock held. */
+static void
+gst_xvimage_memory_wait_put (GstXvContext * context)
+{
+  gint64 end_time;
+  XEvent ev;
+
+  if (!context->shm_put_pending)
+    return;
+
+  end_time = g_get_monotonic_time () + 100 * G_TIME_SPAN_MILLISECOND;
+  while (!XCheckTypedEvent (context->disp, context->shm_completion_type, &ev)) {
+    if (g_get_monotonic_time () > end_time) {
+      GST_WARNING ("timeout waiting for XShm completion event, syncing");
+      XSync (context->disp, FALSE);
+      break;
+    }
+    g_usleep (100);
+  }
+  context->shm_put_pending = FALSE;
+}
+#endif /* HAVE_XSHM */
+
 void
 gst_xvimage_memory_render (GstXvImageMemory * mem, GstVideoRectangle * src_crop,
     GstXWindow * window, GstVideoRectangle * dst_crop, gboolean draw_border)
@@ -645,12 +672,20 @@ gst_xvimage_memory_render (GstXvImageMemory * mem, GstVideoRectangle * src_crop,
         src_crop->w, src_crop->h, window->render_rect.w, window->render_rect.h,
         mem);
 
+    /* make sure the server is done reading the previous frame; usually
+     * it finished long ago and this doesn't block at all */
+    gst_xvimage_memory_wait_put (context);
+
+    /* ask for a completion event and only flush the request out instead
+     * of blocking on a full XSync round trip per frame */
     XvShmPutImage (context->disp,
         context->xv_port_id,
         window->win,
         window->gc, xvimage,
         src_crop->x, src_crop->y, src_crop->w, src_crop->h,
-        dst_crop->x, dst_crop->y, dst_crop->w, dst_crop->h, FALSE);
+        dst_crop->x, dst_crop->y, dst_crop->w, dst_crop->h, TRUE);
+    context->shm_put_pending = TRUE;
+    XFlush (context->disp);
   } else
 #endif /* HAVE_XSHM */
   {
@@ -660,8 +695,8 @@ gst_xvimage_memory_render (GstXvImageMemory * mem, GstVideoRectangle * src_crop,
         window->gc, xvimage,
         src_crop->x, src_crop->y, src_crop->w, src_crop->h,
         dst_crop->x, dst_crop->y, dst_crop->w, dst_crop->h);
+    XSync (context->disp, FALSE);
   }
-  XSync (context->disp, FALSE);
 
   g_mutex_unlock (&context->lock);
 }
@@ -0,0 +1,138 @@
+/* GStreamer audio channel mixer benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures gst_audio_channel_mixer_samples() throughput for a set of
+ * layout pairs. Output is one CSV line per case:
+ *
+ *   audio-channel-mixer,FORMAT,IN_LAYOUT,OUT_LAYOUT,samples,seconds,samples_per_sec,realtime_streams_48k
+ */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+#define BENCH_DURATION (1 * GST_SECOND)
+#define CHUNK_SAMPLES 4096
+
+static GstAudioChannelPosition pos_mono[] = {
+  GST_AUDIO_CHANNEL_POSITION_MONO,
+};
+
+static GstAudioChannelPosition pos_stereo[] = {
+  GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+  GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+};
+
+static GstAudioChannelPosition pos_5_1[] = {
+  GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+  GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+  GST_AUDIO_CHANNEL_POSITION_FRONT_CENTER,
+  GST_AUDIO_CHANNEL_POSITION_LFE1,
+  GST_AUDIO_CHANNEL_POSITION_REAR_LEFT,
+  GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT,
+};
+
+static GstAudioChannelPosition pos_7_1[] = {
+  GST_AUDIO_CHANNEL_POSITION_FRONT_LEFT,
+  GST_AUDIO_CHANNEL_POSITION_FRONT_RIGHT,
+  GST_AUDIO_CHANNEL_POSITION_FRONT_CENTER,
+  GST_AUDIO_CHANNEL_POSITION_LFE1,
+  GST_AUDIO_CHANNEL_POSITION_REAR_LEFT,
+  GST_AUDIO_CHANNEL_POSITION_REAR_RIGHT,
+  GST_AUDIO_CHANNEL_POSITION_SIDE_LEFT,
+  GST_AUDIO_CHANNEL_POSITION_SIDE_RIGHT,
+};
+
+static const struct
+{
+  const gchar *name;
+  GstAudioChannelPosition *position;
+  gint channels;
+} layouts[] = {
+  {"mono", pos_mono, G_N_ELEMENTS (pos_mono)},
+  {"stereo", pos_stereo, G_N_ELEMENTS (pos_stereo)},
+  {"5.1", pos_5_1, G_N_ELEMENTS (pos_5_1)},
+  {"7.1", pos_7_1, G_N_ELEMENTS (pos_7_1)},
+};
+
+static const gint layout_pairs[][2] = {
+  {0, 1},                       /* mono -> stereo */
+  {1, 0},                       /* stereo -> mono */
+  {2, 1},                       /* 5.1 -> stereo */
+  {3, 2},                       /* 7.1 -> 5.1 */
+  {3, 1},                       /* 7.1 -> stereo */
+};
+
+static void
+run_pair (GstAudioFormat format, const gchar * format_name, gint in_layout,
+    gint out_layout)
+{
+  GstAudioChannelMixer *mix;
+  GstClockTime start, elapsed;
+  guint64 samples = 0;
+  gdouble seconds;
+  gsize bps;
+  gpointer in[1], out[1];
+
+  mix = gst_audio_channel_mixer_new (GST_AUDIO_CHANNEL_MIXER_FLAGS_NONE,
+      format, layouts[in_layout].channels, layouts[in_layout].position,
+      layouts[out_layout].channels, layouts[out_layout].position);
+
+  bps = (format == GST_AUDIO_FORMAT_S16 ? 2 : 4);
+
+  in[0] = g_malloc0 (CHUNK_SAMPLES * layouts[in_layout].channels * bps);
+  out[0] = g_malloc0 (CHUNK_SAMPLES * layouts[out_layout].channels * bps);
+
+  start = gst_util_get_timestamp ();
+  do {
+    gst_audio_channel_mixer_samples (mix, (const gpointer *) in, out,
+        CHUNK_SAMPLES);
+    samples += CHUNK_SAMPLES;
+    elapsed = gst_util_get_timestamp () - start;
+  } while (elapsed < BENCH_DURATION);
+
+  seconds = (gdouble) elapsed / GST_SECOND;
+
+  g_print ("audio-channel-mixer,%s,%s,%s,%" G_GUINT64_FORMAT ",%.6f,%.0f,"
+      "%.1f\n", format_name, layouts[in_layout].name, layouts[out_layout].name,
+      samples, seconds, samples / seconds, samples / seconds / 48000.0);
+
+  g_free (in[0]);
+  g_free (out[0]);
+  gst_audio_channel_mixer_free (mix);
+}
+
+int
+main (int argc, char **argv)
+{
+  guint i;
+
+  gst_init (&argc, &argv);
+
+  for (i = 0; i < G_N_ELEMENTS (layout_pairs); i++) {
+    run_pair (GST_AUDIO_FORMAT_S16, "S16", layout_pairs[i][0],
+        layout_pairs[i][1]);
+    run_pair (GST_AUDIO_FORMAT_F32, "F32", layout_pairs[i][0],
+        layout_pairs[i][1]);
+  }
+
+  return 0;
+}
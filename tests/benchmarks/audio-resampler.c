@@ -0,0 +1,103 @@
+/* GStreamer audio resampler benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures gst_audio_resampler_resample() throughput for a set of rate
+ * pairs at default quality. Output is one CSV line per case:
+ *
+ *   audio-resampler,FORMAT,CHANNELS,IN_RATE,OUT_RATE,in_frames,seconds,frames_per_sec,realtime_streams
+ *
+ * realtime_streams is how many such streams could be resampled in
+ * real time on one core. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <gst/gst.h>
+#include <gst/audio/audio.h>
+
+#define BENCH_DURATION (1 * GST_SECOND)
+#define CHANNELS 2
+#define CHUNK_FRAMES 1024
+
+static const gint rate_pairs[][2] = {
+  {44100, 48000},
+  {48000, 44100},
+  {32000, 48000},
+  {48000, 96000},
+  {96000, 48000},
+  {48000, 8000},
+};
+
+static void
+run_pair (GstAudioFormat format, const gchar * format_name, gint in_rate,
+    gint out_rate)
+{
+  GstAudioResampler *resampler;
+  GstClockTime start, elapsed;
+  guint64 in_frames = 0;
+  gdouble seconds;
+  gsize bps, max_out;
+  gpointer in[1], out[1];
+
+  resampler = gst_audio_resampler_new (GST_AUDIO_RESAMPLER_METHOD_KAISER,
+      GST_AUDIO_RESAMPLER_FLAG_NONE, format, CHANNELS, in_rate, out_rate,
+      NULL);
+
+  bps = (format == GST_AUDIO_FORMAT_S16 ? 2 : 4) * CHANNELS;
+  max_out = gst_audio_resampler_get_out_frames (resampler, CHUNK_FRAMES) + 64;
+
+  in[0] = g_malloc0 (CHUNK_FRAMES * bps);
+  out[0] = g_malloc0 (max_out * bps);
+
+  start = gst_util_get_timestamp ();
+  do {
+    gsize out_frames;
+
+    out_frames = gst_audio_resampler_get_out_frames (resampler, CHUNK_FRAMES);
+    gst_audio_resampler_resample (resampler, in, CHUNK_FRAMES, out,
+        out_frames);
+    in_frames += CHUNK_FRAMES;
+    elapsed = gst_util_get_timestamp () - start;
+  } while (elapsed < BENCH_DURATION);
+
+  seconds = (gdouble) elapsed / GST_SECOND;
+
+  g_print ("audio-resampler,%s,%d,%d,%d,%" G_GUINT64_FORMAT ",%.6f,%.0f,"
+      "%.1f\n", format_name, CHANNELS, in_rate, out_rate, in_frames, seconds,
+      in_frames / seconds, in_frames / seconds / in_rate);
+
+  g_free (in[0]);
+  g_free (out[0]);
+  gst_audio_resampler_free (resampler);
+}
+
+int
+main (int argc, char **argv)
+{
+  guint i;
+
+  gst_init (&argc, &argv);
+
+  for (i = 0; i < G_N_ELEMENTS (rate_pairs); i++) {
+    run_pair (GST_AUDIO_FORMAT_S16, "S16", rate_pairs[i][0], rate_pairs[i][1]);
+    run_pair (GST_AUDIO_FORMAT_F32, "F32", rate_pairs[i][0], rate_pairs[i][1]);
+  }
+
+  return 0;
+}
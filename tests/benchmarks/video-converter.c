@@ -0,0 +1,133 @@
+/* GStreamer video converter benchmark
+ *
+ * This library is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Library General Public
+ * License as published by the Free Software Foundation; either
+ * version 2 of the License, or (at your option) any later version.
+ *
+ * This library is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+ * Library General Public License for more details.
+ *
+ * You should have received a copy of the GNU Library General Public
+ * License along with this library; if not, write to the
+ * Free Software Foundation, Inc., 51 Franklin St, Fifth Floor,
+ * Boston, MA 02110-1301, USA.
+ */
+
+/* Measures gst_video_converter_frame() throughput for a set of format
+ * pairs. Output is one CSV line per case:
+ *
+ *   video-converter,IN_FORMAT,INWxINH,OUT_FORMAT,OUTWxOUTH,frames,seconds,fps,mpixels_per_sec
+ *
+ * Usage: video-converter [INWxINH] [OUTWxOUTH]
+ *
+ * The default is a 1920x1080 to 1920x1080 conversion; pass e.g.
+ * "3840x2160 1920x1080" to also exercise the scaler. */
+
+#ifdef HAVE_CONFIG_H
+#include "config.h"
+#endif
+
+#include <stdio.h>
+#include <gst/gst.h>
+#include <gst/video/video.h>
+
+#define BENCH_DURATION (1 * GST_SECOND)
+
+static const gchar *format_pairs[][2] = {
+  {"I420", "I420"},
+  {"I420", "NV12"},
+  {"NV12", "I420"},
+  {"I420", "YUY2"},
+  {"YUY2", "I420"},
+  {"I420", "BGRA"},
+  {"BGRA", "I420"},
+  {"NV12", "BGRA"},
+  {"I420", "RGB"},
+  {"AYUV", "I420"},
+};
+
+static gboolean
+parse_size (const gchar * str, gint * width, gint * height)
+{
+  return sscanf (str, "%dx%d", width, height) == 2 && *width > 0 &&
+      *height > 0;
+}
+
+static void
+run_pair (const gchar * in_format, const gchar * out_format, gint in_width,
+    gint in_height, gint out_width, gint out_height)
+{
+  GstVideoInfo in_info, out_info;
+  GstVideoConverter *convert;
+  GstVideoFrame in_frame, out_frame;
+  GstBuffer *inbuf, *outbuf;
+  GstClockTime start, elapsed;
+  guint frames = 0;
+  gdouble seconds;
+
+  gst_video_info_set_format (&in_info,
+      gst_video_format_from_string (in_format), in_width, in_height);
+  gst_video_info_set_format (&out_info,
+      gst_video_format_from_string (out_format), out_width, out_height);
+
+  inbuf = gst_buffer_new_allocate (NULL, in_info.size, NULL);
+  gst_buffer_memset (inbuf, 0, 0x40, in_info.size);
+  outbuf = gst_buffer_new_allocate (NULL, out_info.size, NULL);
+
+  convert = gst_video_converter_new (&in_info, &out_info, NULL);
+
+  gst_video_frame_map (&in_frame, &in_info, inbuf, GST_MAP_READ);
+  gst_video_frame_map (&out_frame, &out_info, outbuf, GST_MAP_WRITE);
+
+  /* warmup, makes sure any lazily set up tables exist before we time */
+  gst_video_converter_frame (convert, &in_frame, &out_frame);
+
+  start = gst_util_get_timestamp ();
+  do {
+    gst_video_converter_frame (convert, &in_frame, &out_frame);
+    frames++;
+    elapsed = gst_util_get_timestamp () - start;
+  } while (elapsed < BENCH_DURATION);
+
+  seconds = (gdouble) elapsed / GST_SECOND;
+
+  g_print ("video-converter,%s,%dx%d,%s,%dx%d,%u,%.6f,%.2f,%.2f\n",
+      in_format, in_width, in_height, out_format, out_width, out_height,
+      frames, seconds, frames / seconds,
+      (frames / seconds) * in_width * in_height / 1e6);
+
+  gst_video_frame_unmap (&out_frame);
+  gst_video_frame_unmap (&in_frame);
+  gst_video_converter_free (convert);
+  gst_buffer_unref (inbuf);
+  gst_buffer_unref (outbuf);
+}
+
+int
+main (int argc, char **argv)
+{
+  gint in_width = 1920, in_height = 1080;
+  gint out_width = 1920, out_height = 1080;
+  guint i;
+
+  gst_init (&argc, &argv);
+
+  if (argc > 1 && !parse_size (argv[1], &in_width, &in_height)) {
+    g_printerr ("usage: %s [INWxINH] [OUTWxOUTH]\n", argv[0]);
+    return 1;
+  }
+  if (argc > 2 && !parse_size (argv[2], &out_width, &out_height)) {
+    g_printerr ("usage: %s [INWxINH] [OUTWxOUTH]\n", argv[0]);
+    return 1;
+  }
+
+  for (i = 0; i < G_N_ELEMENTS (format_pairs); i++) {
+    run_pair (format_pairs[i][0], format_pairs[i][1], in_width, in_height,
+        out_width, out_height);
+  }
+
+  return 0;
+}
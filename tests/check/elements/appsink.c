@@ -503,6 +503,57 @@ GST_START_TEST (test_pull_with_timeout)
 
 GST_END_TEST;
 
+GST_START_TEST (test_try_pull_samples)
+{
+  GstElement *sink;
+  GstBuffer *buffer;
+  GstSample *samples[4];
+  guint i, n;
+
+  sink = setup_appsink ();
+
+  ASSERT_SET_STATE (sink, GST_STATE_PLAYING, GST_STATE_CHANGE_ASYNC);
+
+  /* no waiting, no buffers pending */
+  n = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), samples,
+      G_N_ELEMENTS (samples), 0);
+  fail_unless_equals_int (n, 0);
+
+  for (i = 0; i < 3; i++) {
+    buffer = gst_buffer_new_and_alloc (4);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+
+  /* all queued buffers should come out with a single call */
+  n = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), samples,
+      G_N_ELEMENTS (samples), GST_SECOND / 20);
+  fail_unless_equals_int (n, 3);
+  for (i = 0; i < n; i++)
+    gst_sample_unref (samples[i]);
+
+  /* the array must not be overrun when more buffers are queued */
+  for (i = 0; i < 3; i++) {
+    buffer = gst_buffer_new_and_alloc (4);
+    fail_unless (gst_pad_push (mysrcpad, buffer) == GST_FLOW_OK);
+  }
+  n = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), samples, 2,
+      GST_SECOND / 20);
+  fail_unless_equals_int (n, 2);
+  for (i = 0; i < n; i++)
+    gst_sample_unref (samples[i]);
+
+  /* and the remainder is still there */
+  n = gst_app_sink_try_pull_samples (GST_APP_SINK (sink), samples,
+      G_N_ELEMENTS (samples), 0);
+  fail_unless_equals_int (n, 1);
+  gst_sample_unref (samples[0]);
+
+  ASSERT_SET_STATE (sink, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  cleanup_appsink (sink);
+}
+
+GST_END_TEST;
+
 static Suite *
 appsink_suite (void)
 {
@@ -520,6 +571,7 @@ appsink_suite (void)
   tcase_add_test (tc_chain, test_buffer_list_signal);
   tcase_add_test (tc_chain, test_segment);
   tcase_add_test (tc_chain, test_pull_with_timeout);
+  tcase_add_test (tc_chain, test_try_pull_samples);
 
   return s;
 }
@@ -122,6 +122,45 @@ GST_START_TEST (test_appsrc_non_null_caps)
 
 GST_END_TEST;
 
+/*
+ * Pushes a buffer list with 4 buffers into appsrc and checks that all
+ * buffers of the list come out on the other side.
+ */
+GST_START_TEST (test_appsrc_push_buffer_list)
+{
+  GstElement *src;
+  GstBufferList *buffer_list;
+  GstCaps *caps;
+  guint i;
+
+  src = setup_appsrc ();
+
+  caps = gst_caps_from_string (SAMPLE_CAPS);
+  g_object_set (src, "caps", caps, NULL);
+
+  ASSERT_SET_STATE (src, GST_STATE_PLAYING, GST_STATE_CHANGE_SUCCESS);
+
+  buffer_list = gst_buffer_list_new ();
+  for (i = 0; i < 4; i++)
+    gst_buffer_list_add (buffer_list, gst_buffer_new_and_alloc (4));
+
+  fail_unless (gst_app_src_push_buffer_list (GST_APP_SRC (src),
+          buffer_list) == GST_FLOW_OK);
+
+  fail_unless (gst_app_src_end_of_stream (GST_APP_SRC (src)) == GST_FLOW_OK);
+
+  /* Give some time to the appsrc loop to push the buffers */
+  g_usleep (G_USEC_PER_SEC * 3);
+
+  fail_unless (g_list_length (buffers) == 4);
+
+  ASSERT_SET_STATE (src, GST_STATE_NULL, GST_STATE_CHANGE_SUCCESS);
+  gst_caps_unref (caps);
+  cleanup_appsrc (src);
+}
+
+GST_END_TEST;
+
 static GstAppSinkCallbacks app_callbacks;
 
 typedef struct
@@ -426,6 +465,7 @@ appsrc_suite (void)
   TCase *tc_chain = tcase_create ("general");
 
   tcase_add_test (tc_chain, test_appsrc_non_null_caps);
+  tcase_add_test (tc_chain, test_appsrc_push_buffer_list);
   tcase_add_test (tc_chain, test_appsrc_set_caps_twice);
   tcase_add_test (tc_chain, test_appsrc_caps_in_push_modes);
 
@@ -37,6 +37,7 @@ static void my_g_string_append_printf (GString * str, int depth, const gchar * f
 static gboolean async = FALSE;
 static gboolean show_toc = FALSE;
 static gboolean verbose = FALSE;
+static gint jobs = 1;
 
 typedef struct
 {
@@ -540,6 +541,8 @@ main (int argc, char **argv)
   GOptionEntry options[] = {
     {"async", 'a', 0, G_OPTION_ARG_NONE, &async,
         "Run asynchronously", NULL},
+    {"jobs", 'j', 0, G_OPTION_ARG_INT, &jobs,
+        "Number of parallel discoveries (implies --async, default 1)", "N"},
     {"timeout", 't', 0, G_OPTION_ARG_INT, &timeout,
         "Specify timeout (in seconds, default 10)", "T"},
     /* {"elem", 'e', 0, G_OPTION_ARG_NONE, &elem_seek, */
@@ -574,12 +577,21 @@ main (int argc, char **argv)
     exit (-1);
   }
 
+  if (jobs < 1 || jobs > 64) {
+    g_print ("Invalid number of jobs: %d\n", jobs);
+    exit (-1);
+  }
+  /* parallel discovery only works in async mode */
+  if (jobs > 1)
+    async = TRUE;
+
   dc = gst_discoverer_new (timeout * GST_SECOND, &err);
   if (G_UNLIKELY (dc == NULL)) {
     g_print ("Error initializing: %s\n", err->message);
     g_clear_error (&err);
     exit (1);
   }
+  g_object_set (dc, "n-parallel", jobs, NULL);
 
   if (!async) {
     gint i;
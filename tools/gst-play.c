@@ -91,9 +91,14 @@ typedef struct
 
   GstPlayTrickMode trick_mode;
   gdouble rate;
+
+  /* seek timing (--seek-stats) */
+  gint64 seek_start;            /* monotonic time the seek was sent, 0 if none */
+  GArray *seek_times;           /* microseconds per completed seek */
 } GstPlay;
 
 static gboolean quiet = FALSE;
+static gboolean seek_stats = FALSE;
 
 static gboolean play_bus_msg (GstBus * bus, GstMessage * msg, gpointer data);
 static gboolean play_next (GstPlay * play);
@@ -224,9 +229,44 @@ play_new (gchar ** uris, const gchar * audio_sink, const gchar * video_sink,
   play->rate = 1.0;
   play->trick_mode = GST_PLAY_TRICK_MODE_NONE;
 
+  play->seek_start = 0;
+  play->seek_times = g_array_new (FALSE, FALSE, sizeof (gint64));
+
   return play;
 }
 
+static gint
+play_compare_seek_time (gconstpointer a, gconstpointer b)
+{
+  gint64 diff = *(const gint64 *) a - *(const gint64 *) b;
+
+  return (diff > 0) ? 1 : (diff < 0) ? -1 : 0;
+}
+
+static void
+play_print_seek_stats (GstPlay * play)
+{
+  GArray *times = play->seek_times;
+  gint64 sum = 0;
+  guint i;
+
+  if (times->len == 0)
+    return;
+
+  g_array_sort (times, play_compare_seek_time);
+  for (i = 0; i < times->len; i++)
+    sum += g_array_index (times, gint64, i);
+
+  g_print (_("Seek latency over %u seeks: min %.1f ms, median %.1f ms, "
+          "90%% %.1f ms, max %.1f ms, average %.1f ms"), times->len,
+      g_array_index (times, gint64, 0) / 1000.0,
+      g_array_index (times, gint64, times->len / 2) / 1000.0,
+      g_array_index (times, gint64, (times->len * 9) / 10) / 1000.0,
+      g_array_index (times, gint64, times->len - 1) / 1000.0,
+      sum / (1000.0 * times->len));
+  g_print ("\n");
+}
+
 static void
 play_free (GstPlay * play)
 {
@@ -236,6 +276,10 @@ play_free (GstPlay * play)
 
   play_reset (play);
 
+  if (seek_stats)
+    play_print_seek_stats (play);
+  g_array_free (play->seek_times, TRUE);
+
   gst_element_set_state (play->playbin, GST_STATE_NULL);
   gst_object_unref (play->playbin);
 
@@ -297,6 +341,17 @@ play_bus_msg (GstBus * bus, GstMessage * msg, gpointer user_data)
       GST_DEBUG_BIN_TO_DOT_FILE_WITH_TS (GST_BIN (play->playbin),
           GST_DEBUG_GRAPH_SHOW_ALL, "gst-play.async-done");
 
+      /* a pending flushing seek is complete once the sinks preroll on the
+       * first buffer of the new segment */
+      if (play->seek_start != 0) {
+        gint64 elapsed = g_get_monotonic_time () - play->seek_start;
+
+        g_print (_("Seek finished in %.1f ms"), elapsed / 1000.0);
+        g_print ("\n");
+        g_array_append_val (play->seek_times, elapsed);
+        play->seek_start = 0;
+      }
+
       g_print ("Prerolled.\r");
       if (play->missing != NULL && play_install_missing_plugins (play)) {
         g_print ("New plugins installed, trying again...\n");
@@ -872,8 +927,13 @@ play_do_seek (GstPlay * play, gint64 pos, gdouble rate, GstPlayTrickMode mode)
         /* start */ GST_SEEK_TYPE_SET, 0,
         /* stop */ GST_SEEK_TYPE_SET, pos);
 
-  if (!gst_element_send_event (play->playbin, seek))
+  if (seek_stats)
+    play->seek_start = g_get_monotonic_time ();
+
+  if (!gst_element_send_event (play->playbin, seek)) {
+    play->seek_start = 0;
     return FALSE;
+  }
 
   play->rate = rate;
   play->trick_mode = mode;
@@ -1209,6 +1269,10 @@ main (int argc, char **argv)
         N_("Playlist file containing input media files"), NULL},
     {"quiet", 'q', 0, G_OPTION_ARG_NONE, &quiet,
         N_("Do not print any output (apart from errors)"), NULL},
+    {"seek-stats", 0, 0, G_OPTION_ARG_NONE, &seek_stats,
+          N_("Measure the time from each seek to the new preroll and print "
+            "a summary on exit"),
+        NULL},
     {G_OPTION_REMAINING, 0, 0, G_OPTION_ARG_FILENAME_ARRAY, &filenames, NULL},
     {NULL}
   };